@@ -25,6 +25,7 @@
 #include <iostream>
 #include <string>
 #include "geometry.hpp"
+#include "../Maths/rotation.hpp"
 
 namespace smart{
 
@@ -48,6 +49,7 @@ class ellipsoid : public geometry
         double psi_geom;    //geometric orientation of the ellipsoid psi
         double theta_geom;  //geometric orientation of the ellipsoid theta
         double phi_geom;    //geometric orientation of the ellipsoid phi
+        mutable euler_Q Q_geom;  //Rotation matrices of the geometric orientation of the ellipsoid, composed at the first use of the angles
     
 		ellipsoid(); 	//default constructor
         ellipsoid(const double &, const int &, const int &, const double &,const double &, const double &, const double &, const double &, const double &);
@@ -55,6 +57,8 @@ class ellipsoid : public geometry
 		ellipsoid(const ellipsoid&);	//Copy constructor
         virtual ~ellipsoid();
     
+        virtual const euler_Q& rotation() const;   //Rotation matrices of the geometric orientation
+    
 		virtual ellipsoid& operator = (const ellipsoid&);
 		
         friend std::ostream& operator << (std::ostream&, const ellipsoid&);
@@ -25,6 +25,7 @@
 #include <iostream>
 #include <string>
 #include "geometry.hpp"
+#include "../Maths/rotation.hpp"
 
 namespace smart{
 
@@ -45,6 +46,7 @@ class layer : public geometry
         double psi_geom;
         double theta_geom;
         double phi_geom;    
+        mutable euler_Q Q_geom;  //Rotation matrices of the geometric orientation of the layer, composed at the first use of the angles
     
 		layer(); 	//default constructor
         layer(const double &, const int &, const int &, const double &,const double &, const double &); //Constructor with parameters
@@ -52,6 +54,8 @@ class layer : public geometry
 		layer(const layer&);	//Copy constructor
         virtual ~layer();
     
+        virtual const euler_Q& rotation() const;   //Rotation matrices of the geometric orientation
+    
 		virtual layer& operator = (const layer&);
 		
         friend std::ostream& operator << (std::ostream&, const layer&);
@@ -47,12 +47,15 @@ protected:
     arma::mat T_in_loc;
     arma::mat T_in;
     
-    static int mp;
-    static int np;
-    static arma::vec x;
-    static arma::vec wx;
-    static arma::vec y;
-    static arma::vec wy;
+    //Integration points of the Eshelby tensors, per thread : the simulations run at the same time may use different points
+    static thread_local int mp;
+    static thread_local int np;
+    static thread_local arma::vec x;
+    static thread_local arma::vec wx;
+    static thread_local arma::vec y;
+    static thread_local arma::vec wy;
+    
+    static void set_points(const int &, const int &, const int & = 0);   //Builds the integration points, the numbers of points in each direction being bounded (0 : no bound)
     
     ellipsoid_multi(); //default constructor
     ellipsoid_multi(const arma::mat&, const arma::mat&, const arma::mat&, const arma::mat&, const arma::vec&, const arma::mat&, const arma::mat&, const arma::mat&, const arma::mat&, const arma::mat&, const arma::mat&); //Constructor with parameters
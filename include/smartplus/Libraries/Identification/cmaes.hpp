@@ -0,0 +1,84 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file cmaes.hpp
+///@brief Covariance matrix adaptation evolution strategy (CMA-ES), to sample the offsprings of a generation
+///@version 1.0
+
+#pragma once
+#include <iostream>
+#include <vector>
+#include <armadillo>
+#include "parameters.hpp"
+#include "generation.hpp"
+
+namespace smart{
+
+//======================================
+class cmaes
+//======================================
+{
+	private:
+
+	protected:
+
+        arma::vec lower;        //Minimal values of the parameters
+        arma::vec upper;        //Maximal values of the parameters
+        arma::mat X;            //Normalized parameters of the last population sampled, one column per individual
+
+        void decompose();       //Eigen decomposition of C
+
+	public :
+
+        int n;                  //Number of parameters
+        int lambda;             //Number of individuals sampled
+        int mu;                 //Number of individuals that define the next mean
+        arma::vec weights;      //Recombination weights of the mu best individuals
+        double mueff;           //Variance effective selection mass
+        double cc;              //Learning rate of the evolution path of C
+        double cs;              //Learning rate of the evolution path of sigma
+        double c1;              //Learning rate of the rank-one update of C
+        double cmu;             //Learning rate of the rank-mu update of C
+        double damps;           //Damping of sigma
+        double chiN;            //Expectation of the norm of a standard normal vector
+
+        double sigma0;          //Initial step size, relative to the bounds
+        arma::vec mean;         //Mean of the distribution, with the parameters normalized by their bounds (in [0,1])
+        double sigma;           //Step size
+        arma::mat C;            //Covariance matrix
+        arma::mat B;            //Eigen vectors of C
+        arma::vec D;            //Square roots of the eigen values of C
+        arma::vec pc;           //Evolution path of C
+        arma::vec ps;           //Evolution path of sigma
+        int niter;              //Number of updates
+        int nresample;          //Maximal number of samplings of an individual outside the bounds, before it is projected on them
+
+		cmaes(); 	//default constructor
+		cmaes(const std::vector<parameters> &, const int &, const double & = 0.3);	//Constructor with parameters
+		cmaes(const cmaes &);	//Copy constructor
+		virtual ~cmaes();
+
+		virtual void init(const arma::vec &);           //Mean of the distribution at a set of parameters, with the initial step size
+		virtual void sample(generation &, int &);       //Samples the individuals of a generation
+		virtual void update(const generation &);        //Updates the distribution with the costs of the generation sampled last
+
+		virtual cmaes& operator = (const cmaes&);
+
+        friend std::ostream& operator << (std::ostream&, const cmaes&);
+};
+
+} //namespace smart
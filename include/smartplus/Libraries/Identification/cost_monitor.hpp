@@ -0,0 +1,60 @@
+/* This file is part of SMART+.
+ 
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file cost_monitor.hpp
+///@brief Cost function of an individual accumulated during its simulations, to stop the hopeless ones
+///@version 1.0
+
+#pragma once
+#include <iostream>
+#include <vector>
+#include <armadillo>
+#include "opti_data.hpp"
+#include "../Solver/output_backend.hpp"
+
+namespace smart{
+
+//======================================
+class cost_monitor : public output_monitor
+//======================================
+{
+	private:
+
+	protected:
+
+        std::vector<arma::mat> data_exp;        //Experimental data of each file (ndata x ninfo)
+        std::vector<arma::mat> weights;         //Weight of each experimental data, from calcW
+        std::vector<arma::Col<int> > c_data;    //Column of the numerical file (and of the global record) of each info
+        arma::Col<int> skiplines;               //Lines skipped at the beginning of each numerical file
+        int nrecords;                           //Number of records of the current file
+    
+	public :
+
+        int file;           //Index of the file being simulated
+        double cost;        //Weighted cost accumulated over the files of the individual, as in calc_cost
+        double bound;       //The simulation stops when the cost exceeds the bound, 0 for no bound
+    
+        cost_monitor(); 	//default constructor
+        cost_monitor(const arma::vec &, const std::vector<opti_data> &, const std::vector<opti_data> &, const int &); 	//Constructor with parameters
+        virtual ~cost_monitor();
+    
+        virtual void reset(const double & = 0.);        //Beginning of the simulations of an individual, with the bound of its cost
+        virtual void begin(const int &);                //Beginning of the simulation of a file
+        virtual bool check(const arma::vec &);
+};
+    
+} //namespace smart
@@ -41,6 +41,7 @@ class individual
 		int rank;		
         arma::vec p;
         double lambda;   //The step or Lambda applied
+        bool screened;   //The cost comes from the screening simulations (see ident_fidelity.inp)
 		
 		individual(); 	//default constructor
 		individual(const int&,const int&,const double&);	//constructor - allocates memory for statev
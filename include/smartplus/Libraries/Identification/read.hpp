@@ -45,7 +45,16 @@ void read_data_num(const int &, const std::vector<opti_data> &, std::vector<opti
 void ident_essentials(int &, int &, int &, const std::string &, const std::string &);
     
 //Read the control parameters of the optimization algorithm
-void ident_control(int &, int &, int &, int &, int &, int &, int &, double &, double &, double &, double &, double &, const std::string &, const std::string &);
+void ident_control(int &, int &, int &, int &, int &, int &, int &, double &, double &, double &, double &, double &, std::string &, double &, int &, const std::string &, const std::string &);
+
+//Read the early abort of the simulations : bound from the worst cost of the population (1) and fixed bound (0 for none), optional file
+void read_early_abort(int &, double &, const std::string & = "data", const std::string & = "ident_abort.inp");
+
+//Read the multi-fidelity evaluation : solver control file of the screening simulations ("" for none) and number of best individuals evaluated again with the full ones, optional file
+void read_fidelity(std::string &, int &, const std::string & = "data", const std::string & = "ident_fidelity.inp");
+
+//Read the forward sensitivities : integrated by the solver (1) for the parameters that are props of the material, relative perturbation of the props, optional file
+void read_forward_sensi(int &, double &, const std::string & = "data", const std::string & = "ident_sensi.inp");
 
 void read_gen(int &, arma::mat &, const int &);
     
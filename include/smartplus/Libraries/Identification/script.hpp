@@ -28,6 +28,9 @@
 #include "opti_data.hpp"
 #include "individual.hpp"
 #include "generation.hpp"
+#include "cost_monitor.hpp"
+#include "../Solver/sensitivity.hpp"
+#include "../Solver/simulation_tree.hpp"
 
 namespace smart{
 
@@ -44,7 +47,7 @@ void apply_parameters(const std::vector<parameters> &, const std::string &);
 void apply_constants(const std::vector<constants> &, const std::string &);
     
 //Read the control parameters of the optimization algorithm
-void launch_solver(const generation &, const int &, std::vector<parameters> &, std::vector<constants> &, const std::string &, const std::string &, const std::string &, const std::string &, const std::string&);
+void launch_solver(const generation &, const int &, std::vector<parameters> &, std::vector<constants> &, const std::string &, const std::string &, const std::string &, const std::string &, const std::string&, const std::shared_ptr<cost_monitor> &, const std::string &, solver_sensitivity *, simulation_tree * = NULL);
     
 //Read the control parameters of the optimization algorithm
 void launch_odf(const generation &, std::vector<parameters> &, const std::string &, const std::string &, const std::string &, const std::string &, const std::string &, const std::string&);
@@ -52,11 +55,18 @@ void launch_odf(const generation &, std::vector<parameters> &, const std::string
 //Read the control parameters of the optimization algorithm
     void launch_func_N(const generation &, const int &, std::vector<parameters> &, std::vector<constants> &, const std::string &, const std::string &, const std::string &, const std::string &, const std::string &, const std::string&);
     
-void run_simulation(const std::string &, const individual &, const int &, std::vector<parameters> &, std::vector<constants> &, std::vector<opti_data> &, const std::string &, const std::string &, const std::string &, const std::string &, const std::string&);
+//Run the simulations of an individual. With a cost monitor (solver only), the simulations stop once the cost exceeds the bound of the monitor. The solver controls are read in the given file of path_data (solver only).
+//With a solver_sensitivity, the derivatives of the results with respect to its props are written along with them (solver only).
+//The snapshots of the solver are kept in the given simulation tree, in a tree shared by the calls otherwise (solver only)
+void run_simulation(const std::string &, const individual &, const int &, std::vector<parameters> &, std::vector<constants> &, std::vector<opti_data> &, const std::string &, const std::string &, const std::string &, const std::string &, const std::string&, const std::shared_ptr<cost_monitor> & = std::shared_ptr<cost_monitor>(), const std::string & = "solver_control.inp", solver_sensitivity * = NULL, simulation_tree * = NULL);
+
+//Index in the props of the material file (keys version) of each parameter, -1 if the parameter is not a single prop of this file
+arma::Col<int> props_keys(const std::vector<parameters> &, const std::string &, const std::string &);
     
 double calc_cost(const arma::vec &, arma::vec &, const arma::vec &, const std::vector<opti_data> &, const std::vector<opti_data> &, const int &, const int &);
 
-arma::mat calc_sensi(const individual &, generation &, const std::string &, const int &, const int &, std::vector<parameters> &, std::vector<constants> &, arma::vec &, std::vector<opti_data> &, std::vector<opti_data> &, const std::string &, const std::string &, const std::string &, const std::string &, const int &, const arma::vec &, const std::string&);
+//Sensitivity matrix of a gboy : finite differences of whole simulations, or forward sensitivities integrated by the solver for the parameters that are props (solver only)
+arma::mat calc_sensi(const individual &, generation &, const std::string &, const int &, const int &, std::vector<parameters> &, std::vector<constants> &, arma::vec &, std::vector<opti_data> &, std::vector<opti_data> &, const std::string &, const std::string &, const std::string &, const std::string &, const int &, const arma::vec &, const std::string&, const int & = 0, const double & = 1.E-6);
 
     
 } //namespace smart
@@ -60,6 +60,7 @@ class ODF
 
         void construct(const int&);
         double density(const double &);
+        arma::vec density(const arma::vec &);  //Densities at all the points, in one pass per peak
     
 		virtual ODF& operator = (const ODF&);
     
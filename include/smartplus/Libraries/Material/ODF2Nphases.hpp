@@ -25,6 +25,7 @@
 #include <string.h>
 #include <armadillo>
 #include "ODF.hpp"
+#include "ODF3D.hpp"
 #include "../Phase/phase_characteristics.hpp"
 
 namespace smart{
@@ -38,6 +39,12 @@ void fill_angles(const double &, phase_characteristics &, const ODF &, const int
 //This function computes the ODF of the selected angle, according to different methods (Lorentzian, Pearson...)
 phase_characteristics discretize_ODF(const phase_characteristics &, ODF &, const int &, const int &, const int & = 1);
 
+//Fill the three angles of the geom and material (if indicated 1 in angles_mat)
+void fill_angles(const double &, const double &, const double &, phase_characteristics &, const int & = 1);
+
+//Discretizes a phase into representative orientations of a 3D ODF : nb_phases_disc samples, merged when their misorientation is below tol_merge, so that the number of phases is the number of distinct orientations
+phase_characteristics discretize_ODF3D(const phase_characteristics &, ODF3D &, const int &, const int &, const int & = 0, const double & = 0., const int & = 1);
+
 //Writes the Nphases.dat file for multiphase modeling, according to specific ODFs
 //void ODF2Nphases(const arma::Col<int> &, const arma::Col<int> &, const arma::Col<int> &, const std::vector<std::string> &, const arma::mat &, const bool& = false, const double& = 0.);
 
@@ -0,0 +1,76 @@
+/* This file is part of SMART+.
+ 
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file ODF3D.hpp
+///@brief Orientation distribution function over the three Euler angles
+///@version 1.0
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <armadillo>
+#include "../../parameter.hpp"
+#include "peak.hpp"
+
+namespace smart{
+
+//======================================
+class ODF3D
+//======================================
+{
+	private:
+
+	protected:
+
+	public :
+
+        //Each texture component is a peak, evaluated at the misorientation angle to its mean orientation (method 7 : uniform background)
+        std::vector<peak> peaks;
+        arma::mat orientations;     //(3,npeaks) mean orientation psi, theta, phi of each component (radians)
+    
+        int n_psi;                  //Number of cells of the Euler grid along psi, in [0,2pi]
+        int n_theta;                //Number of cells of the Euler grid along theta, in [0,pi]
+        int n_phi;                  //Number of cells of the Euler grid along phi, in [0,2pi]
+        arma::cube densities;       //Densities at the centers of the cells of the Euler grid (psi, theta, phi)
+        arma::cube volumes;         //Volumes of the cells, with the invariant measure sin(theta) dpsi dtheta dphi
+        double norm;                //Integral of the density over the orientations
+    
+		ODF3D(); 	//default constructor
+        ODF3D(const int &, const int &, const int &); //Constructor with the size of the Euler grid
+
+		ODF3D(const ODF3D&);	//Copy constructor
+        virtual ~ODF3D();
+
+        void add_component(const peak &, const double &, const double &, const double &);   //Adds a texture component around the orientation psi, theta, phi
+        double density(const double &, const double &, const double &);     //Density at the orientation psi, theta, phi
+        void construct();           //Evaluates the densities on the Euler grid and their integral
+        void sample(arma::mat &, arma::vec &, const int &, const int & = 0);   //N representative orientations (3,N) and their weights. 0 : equal weights, stratified over the mass of the grid; 1 : quasi-Monte-Carlo orientations weighted by the density
+    
+		virtual ODF3D& operator = (const ODF3D&);
+    
+        friend std::ostream& operator << (std::ostream&, const ODF3D&);
+};
+
+//Misorientation angle between two orientations given by their Euler angles (psi, theta, phi), without crystal symmetry
+double misorientation(const double &, const double &, const double &, const double &, const double &, const double &);
+
+//Merges the orientations (3,N) closer than a misorientation angle, summing their weights. Orientations with a negligible weight are discarded
+void reduce_orientations(arma::mat &, arma::vec &, const double &);
+
+} //namespace smart
@@ -58,6 +58,7 @@ class PDF
 
         void construct(const int&);
         double density(const double &);
+        arma::vec density(const arma::vec &);  //Densities at all the points, in one pass per peak
     
 		virtual PDF& operator = (const PDF&);
     
@@ -54,8 +54,10 @@ class peak
         virtual ~peak();
 
         virtual double get_density_ODF(const double &);
+        virtual arma::vec get_density_ODF(const arma::vec &);   //Densities at all the points at once
 
         virtual double get_density_PDF(const double &);
+        virtual arma::vec get_density_PDF(const arma::vec &);   //Densities at all the points at once
     
 		virtual peak& operator = (const peak&);
     
@@ -0,0 +1,234 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file dual.hpp
+///@brief Forward-mode dual numbers and Voigt tensors of dual numbers, to obtain the exact tangent of a return mapping
+///@brief A constitutive model written with dual_vec<6> seeded on the total strain returns the stress and its derivative dsigma/dEtot
+///@version 1.0
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <assert.h>
+#include <armadillo>
+
+namespace smart{
+
+//======================================
+template<int N> class dual
+//======================================
+{
+	private:
+
+	protected:
+
+	public :
+
+        double val;     //Value
+        double d[N];    //Derivatives with respect to the N seeded variables
+
+        dual() : val(0.) {for (int i=0; i<N; i++) d[i] = 0.;}
+        dual(const double &mval) : val(mval) {for (int i=0; i<N; i++) d[i] = 0.;}  //Constant
+        dual(const double &mval, const int &seed) : val(mval) {     //Independent variable number seed
+            assert((seed >= 0)&&(seed < N));
+            for (int i=0; i<N; i++) d[i] = 0.;
+            d[seed] = 1.;
+        }
+
+        dual& operator += (const dual &b) {val += b.val; for (int i=0; i<N; i++) d[i] += b.d[i]; return *this;}
+        dual& operator -= (const dual &b) {val -= b.val; for (int i=0; i<N; i++) d[i] -= b.d[i]; return *this;}
+        dual& operator *= (const dual &b) {for (int i=0; i<N; i++) d[i] = d[i]*b.val + val*b.d[i]; val *= b.val; return *this;}
+        dual& operator /= (const dual &b) {for (int i=0; i<N; i++) d[i] = (d[i]*b.val - val*b.d[i])/(b.val*b.val); val /= b.val; return *this;}
+        dual& operator += (const double &b) {val += b; return *this;}
+        dual& operator -= (const double &b) {val -= b; return *this;}
+        dual& operator *= (const double &b) {val *= b; for (int i=0; i<N; i++) d[i] *= b; return *this;}
+        dual& operator /= (const double &b) {val /= b; for (int i=0; i<N; i++) d[i] /= b; return *this;}
+};
+
+template<int N> dual<N> operator - (const dual<N> &a) {dual<N> c(a); c *= -1.; return c;}
+template<int N> dual<N> operator + (const dual<N> &a, const dual<N> &b) {dual<N> c(a); c += b; return c;}
+template<int N> dual<N> operator - (const dual<N> &a, const dual<N> &b) {dual<N> c(a); c -= b; return c;}
+template<int N> dual<N> operator * (const dual<N> &a, const dual<N> &b) {dual<N> c(a); c *= b; return c;}
+template<int N> dual<N> operator / (const dual<N> &a, const dual<N> &b) {dual<N> c(a); c /= b; return c;}
+template<int N> dual<N> operator + (const dual<N> &a, const double &b) {dual<N> c(a); c += b; return c;}
+template<int N> dual<N> operator - (const dual<N> &a, const double &b) {dual<N> c(a); c -= b; return c;}
+template<int N> dual<N> operator * (const dual<N> &a, const double &b) {dual<N> c(a); c *= b; return c;}
+template<int N> dual<N> operator / (const dual<N> &a, const double &b) {dual<N> c(a); c /= b; return c;}
+template<int N> dual<N> operator + (const double &a, const dual<N> &b) {dual<N> c(b); c += a; return c;}
+template<int N> dual<N> operator - (const double &a, const dual<N> &b) {dual<N> c(-b); c += a; return c;}
+template<int N> dual<N> operator * (const double &a, const dual<N> &b) {dual<N> c(b); c *= a; return c;}
+template<int N> dual<N> operator / (const double &a, const dual<N> &b) {dual<N> c(a); c /= b; return c;}
+
+//Comparisons act on the values, so that the branches of a return mapping (elastic prediction or plastic correction) are the same as with doubles
+template<int N> bool operator < (const dual<N> &a, const dual<N> &b) {return a.val < b.val;}
+template<int N> bool operator > (const dual<N> &a, const dual<N> &b) {return a.val > b.val;}
+template<int N> bool operator < (const dual<N> &a, const double &b) {return a.val < b;}
+template<int N> bool operator > (const dual<N> &a, const double &b) {return a.val > b;}
+template<int N> bool operator <= (const dual<N> &a, const double &b) {return a.val <= b;}
+template<int N> bool operator >= (const dual<N> &a, const double &b) {return a.val >= b;}
+
+//The overloads of the math functions for dual numbers are found by argument-dependent lookup, the values use the ones of std
+
+//Applies the chain rule : f(a) has the value fa and the derivative dfa
+template<int N> dual<N> chain(const dual<N> &a, const double &fa, const double &dfa) {
+    dual<N> c(fa);
+    for (int i=0; i<N; i++) c.d[i] = dfa*a.d[i];
+    return c;
+}
+
+template<int N> dual<N> sqrt(const dual<N> &a) {
+    double s = std::sqrt(a.val);
+    return chain(a, s, (s > 0.) ? 0.5/s : 0.);   //The derivative is taken as 0 at 0, as for a null Mises stress
+}
+template<int N> dual<N> pow(const dual<N> &a, const double &p) {return chain(a, std::pow(a.val, p), (p == 0.) ? 0. : p*std::pow(a.val, p-1.));}
+template<int N> dual<N> exp(const dual<N> &a) {double e = std::exp(a.val); return chain(a, e, e);}
+template<int N> dual<N> log(const dual<N> &a) {return chain(a, std::log(a.val), 1./a.val);}
+template<int N> dual<N> sin(const dual<N> &a) {return chain(a, std::sin(a.val), std::cos(a.val));}
+template<int N> dual<N> cos(const dual<N> &a) {return chain(a, std::cos(a.val), -std::sin(a.val));}
+template<int N> dual<N> tanh(const dual<N> &a) {double t = std::tanh(a.val); return chain(a, t, 1.-t*t);}
+template<int N> dual<N> fabs(const dual<N> &a) {return (a.val < 0.) ? -a : a;}
+
+///Voigt tensor (6 components) of dual numbers
+template<int N> using dual_vec = std::array<dual<N>, 6>;
+
+///Voigt tensor whose components are the 6 independent variables : derivatives of the results are taken with respect to v
+inline dual_vec<6> seed_voigt(const arma::vec &v) {
+    assert(v.n_elem == 6);
+    dual_vec<6> a;
+    for (int i=0; i<6; i++) a[i] = dual<6>(v(i), i);
+    return a;
+}
+
+///Constant Voigt tensor
+template<int N> dual_vec<N> constant_voigt(const arma::vec &v) {
+    assert(v.n_elem == 6);
+    dual_vec<N> a;
+    for (int i=0; i<6; i++) a[i] = dual<N>(v(i));
+    return a;
+}
+
+///Values of a Voigt tensor of dual numbers
+template<int N> arma::vec value(const dual_vec<N> &a) {
+    arma::vec v(6);
+    for (int i=0; i<6; i++) v(i) = a[i].val;
+    return v;
+}
+
+///Derivatives of a Voigt tensor of dual numbers, (6xN) matrix : for a stress seeded on the strain, it is the tangent modulus
+template<int N> arma::mat jacobian(const dual_vec<N> &a) {
+    arma::mat J(6,N);
+    for (int i=0; i<6; i++) {
+        for (int j=0; j<N; j++) J(i,j) = a[i].d[j];
+    }
+    return J;
+}
+
+template<int N> dual_vec<N> operator + (const dual_vec<N> &a, const dual_vec<N> &b) {dual_vec<N> c; for (int i=0; i<6; i++) c[i] = a[i] + b[i]; return c;}
+template<int N> dual_vec<N> operator - (const dual_vec<N> &a, const dual_vec<N> &b) {dual_vec<N> c; for (int i=0; i<6; i++) c[i] = a[i] - b[i]; return c;}
+template<int N> dual_vec<N> operator + (const dual_vec<N> &a, const arma::vec &b) {dual_vec<N> c; for (int i=0; i<6; i++) c[i] = a[i] + b(i); return c;}
+template<int N> dual_vec<N> operator - (const dual_vec<N> &a, const arma::vec &b) {dual_vec<N> c; for (int i=0; i<6; i++) c[i] = a[i] - b(i); return c;}
+template<int N> dual_vec<N> operator * (const double &a, const dual_vec<N> &b) {dual_vec<N> c; for (int i=0; i<6; i++) c[i] = a*b[i]; return c;}
+template<int N> dual_vec<N> operator * (const dual<N> &a, const dual_vec<N> &b) {dual_vec<N> c; for (int i=0; i<6; i++) c[i] = a*b[i]; return c;}
+template<int N> dual_vec<N> operator * (const arma::vec &a, const dual<N> &b) {dual_vec<N> c; for (int i=0; i<6; i++) c[i] = a(i)*b; return c;}
+
+///Product of a (6x6) matrix (e.g. a stiffness tensor) and a Voigt tensor of dual numbers
+template<int N> dual_vec<N> operator * (const arma::mat &L, const dual_vec<N> &b) {
+    assert((L.n_rows == 6)&&(L.n_cols == 6));
+    dual_vec<N> c;
+    for (int i=0; i<6; i++) {
+        for (int j=0; j<6; j++) c[i] += L(i,j)*b[j];
+    }
+    return c;
+}
+
+//Counterparts of the functions of contimech.hpp, with the same Voigt conventions
+template<int N> dual<N> tr(const dual_vec<N> &v) {return v[0] + v[1] + v[2];}
+
+template<int N> dual_vec<N> dev(const dual_vec<N> &v) {
+    dual_vec<N> vdev = v;
+    dual<N> sph = (1./3.)*tr(v);
+    for (int i=0; i<3; i++) vdev[i] -= sph;
+    return vdev;
+}
+
+template<int N> dual<N> Mises_stress(const dual_vec<N> &v) {
+    dual_vec<N> vdev = dev(v);
+    dual<N> s;
+    for (int i=0; i<3; i++) s += vdev[i]*vdev[i];
+    for (int i=3; i<6; i++) s += 2.*vdev[i]*vdev[i];
+    return sqrt(1.5*s);
+}
+
+template<int N> dual_vec<N> eta_stress(const dual_vec<N> &v) {
+    dual_vec<N> vdev = dev(v);
+    dual<N> n = Mises_stress(v);
+    dual_vec<N> eta;
+    if (n > 0.) {
+        for (int i=0; i<3; i++) eta[i] = 1.5*vdev[i]/n;
+        for (int i=3; i<6; i++) eta[i] = 3.*vdev[i]/n;
+    }
+    return eta;
+}
+
+template<int N> dual<N> Mises_strain(const dual_vec<N> &v) {
+    dual_vec<N> vdev = dev(v);
+    dual<N> s;
+    for (int i=0; i<3; i++) s += vdev[i]*vdev[i];
+    for (int i=3; i<6; i++) s += 0.5*vdev[i]*vdev[i];
+    return sqrt((2./3.)*s);
+}
+
+/*!
+  \brief Tangent of a constitutive function computed with dual numbers
+  \param f functor returning the stress (dual_vec<6>) from the strain (dual_vec<6>)
+  \param E strain at which the tangent is evaluated
+*/
+template<typename F> arma::mat tangent_dual(F f, const arma::vec &E) {
+    return jacobian<6>(f(seed_voigt(E)));
+}
+
+/*!
+  \brief Tangent of a constitutive function computed with centered finite differences (verification mode)
+  \param f functor returning the stress (dual_vec<6>) from the strain (dual_vec<6>), only the values are used
+  \param E strain at which the tangent is evaluated
+  \param h perturbation of the strain components
+*/
+template<typename F> arma::mat tangent_fd(F f, const arma::vec &E, const double &h = 1.E-7) {
+    arma::mat Lt(6,6);
+    for (int j=0; j<6; j++) {
+        arma::vec Ep = E;
+        arma::vec Em = E;
+        Ep(j) += h;
+        Em(j) -= h;
+        Lt.col(j) = (value<6>(f(constant_voigt<6>(Ep))) - value<6>(f(constant_voigt<6>(Em))))/(2.*h);
+    }
+    return Lt;
+}
+
+/*!
+  \brief Verification of the dual number tangent against finite differences
+  \return the relative difference ||Lt_dual - Lt_fd|| / ||Lt_dual||
+*/
+template<typename F> double check_tangent(F f, const arma::vec &E, const double &h = 1.E-7) {
+    arma::mat Lt = tangent_dual(f, E);
+    arma::mat Lt_fd = tangent_fd(f, E, h);
+    double n = arma::norm(Lt, "fro");
+    return (n > 0.) ? arma::norm(Lt - Lt_fd, "fro")/n : arma::norm(Lt_fd, "fro");
+}
+
+} //namespace smart
@@ -14,9 +14,22 @@
 ///@author Chemisky
 
 #pragma once
+#include <functional>
 #include <armadillo>
+#include "../../parameter.hpp"
 
 namespace smart{
+
+///Statistics of a call to complementarity_solve
+struct complementarity_stats {
+    int niter;          //Number of Newton iterations
+    int nbacktrack;     //Number of reductions of the step by the line search
+    double error;       //Final normalized error
+    bool converged;
+};
+
+///Solves A x = b for a small dense matrix with a LU factorization with partial pivoting, returns false if A is singular
+bool lu_solve(const arma::mat &, const arma::vec &, arma::vec &);
     
 void Newton_Raphon(const arma::vec &, const arma::vec &, const arma::mat &, arma::vec &, arma::vec &, double &);
 
@@ -29,5 +42,16 @@ void Fischer_Burmeister_m(const arma::vec &, const arma::vec &, const arma::mat
 void Fischer_Burmeister_m_limits(const arma::vec &, const arma::vec &, const arma::vec &, const arma::mat &, const arma::mat &, arma::vec &, arma::vec &, double &);
     
 arma::mat denom_FB_m(const arma::vec &, const arma::mat &, const arma::vec &);
+
+///Normalized Fischer-Burmeister equations FB and their Jacobian denomFB, given Phi, denom = dPhi/dDp and the multipliers Dp
+void Fischer_Burmeister_m_system(const arma::vec &, const arma::mat &, const arma::vec &, arma::vec &, arma::mat &);
+
+///Semi-smooth Newton solver of the complementarity problem Phi(Dp) <= 0, Dp >= 0, Phi*Dp = 0, with an Armijo backtracking line search
+///The function residual(Dp, Phi, denom) returns Phi and denom = dPhi/dDp for the multipliers Dp
+///Dp is the starting point on input (zeros, or the multipliers of the previous increment for a warm start) and the solution on output
+complementarity_stats complementarity_solve(const std::function<void(const arma::vec &, arma::vec &, arma::mat &)> &, const arma::vec &, arma::vec &, const int &, const double &);
+
+///Same, with the maximal number of iterations and the precision of the return mapping of the material being computed (tolerances::current())
+complementarity_stats complementarity_solve(const std::function<void(const arma::vec &, arma::vec &, arma::mat &)> &, const arma::vec &, arma::vec &);
     
 } //namespace smart
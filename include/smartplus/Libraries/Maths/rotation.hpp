@@ -21,10 +21,93 @@
 
 #pragma once
 
+#include <iostream>
 #include <armadillo>
 
 namespace smart{
 
+//Rotation matrices of a set of Euler angles, composed once: one product replaces the successive single-axis rotations
+//======================================
+class euler_Q
+//======================================
+{
+	private:
+
+        void compose();     //Composes the single-axis rotations
+
+	protected:
+
+	public :
+
+        double psi;
+        double theta;
+        double phi;
+        bool active;                    //Convention of the single-axis rotations (false for rotate_g2l_* and rotate_l2g_*, true for the state variables)
+        bool identity;                  //True if all the angles are null
+    
+        arma::mat::fixed<6,6> QS_g2l;   //Rotation of the stress tensors from global to local
+        arma::mat::fixed<6,6> QE_g2l;   //Rotation of the strain tensors from global to local
+        arma::mat::fixed<6,6> QS_l2g;   //Rotation of the stress tensors from local to global
+        arma::mat::fixed<6,6> QE_l2g;   //Rotation of the strain tensors from local to global
+        arma::mat::fixed<3,3> R_g2l;    //Rotation of the 3x3 tensors from global to local, as rotate_mat : trans(R)*F*R
+        arma::mat::fixed<3,3> R_l2g;    //Rotation of the 3x3 tensors from local to global, as rotate_mat : trans(R)*F*R
+    
+        euler_Q(const bool & = false);  //default constructor, null angles
+        euler_Q(const double &, const double &, const double &, const bool & = false);  //Constructor with the angles psi, theta, phi
+        euler_Q(const euler_Q &);       //Copy constructor
+        virtual ~euler_Q();
+    
+        virtual void set(const double &, const double &, const double &);  //Sets the angles, the matrices are composed again only if they have changed
+    
+        virtual euler_Q& operator = (const euler_Q&);
+    
+        friend std::ostream& operator << (std::ostream&, const euler_Q&);
+};
+
+//Rotation matrices of N orientations, to rotate one or many tensors to all of them at once
+//======================================
+class rotation_batch
+//======================================
+{
+	private:
+
+        void fill(const int &, const arma::mat &);  //Fills the matrices of an orientation from its 3x3 rotation matrix
+
+	protected:
+
+	public :
+
+        int N;                  //Number of orientations
+        bool active;            //Convention of the single-axis rotations, as in euler_Q
+        arma::cube QS_g2l;      //(6,6,N) rotation of the stress tensors from global to local, per orientation
+        arma::cube QE_g2l;      //(6,6,N) rotation of the strain tensors from global to local, per orientation
+                                //From local to global, the stress uses trans(QE_g2l) and the strain trans(QS_g2l)
+    
+        rotation_batch();       //default constructor, no orientation
+        rotation_batch(const arma::vec &, const arma::vec &, const arma::vec &, const bool & = false);    //Constructor with the Euler angles psi, theta, phi of each orientation
+        rotation_batch(const arma::mat &);     //Constructor with the unit quaternions (w,x,y,z) of each orientation, one per column
+        rotation_batch(const rotation_batch &);    //Copy constructor
+        virtual ~rotation_batch();
+    
+        //Same tensor to all the orientations (6,6) -> (6,6,N), (6) -> (6,N), or one tensor per orientation (6,6,N) -> (6,6,N), (6,N) -> (6,N)
+        arma::cube rotate_g2l_L(const arma::mat &) const;
+        arma::cube rotate_g2l_L(const arma::cube &) const;
+        arma::cube rotate_l2g_L(const arma::mat &) const;
+        arma::cube rotate_l2g_L(const arma::cube &) const;
+        arma::cube rotate_g2l_M(const arma::mat &) const;
+        arma::cube rotate_g2l_M(const arma::cube &) const;
+        arma::cube rotate_l2g_M(const arma::mat &) const;
+        arma::cube rotate_l2g_M(const arma::cube &) const;
+        arma::mat rotate_g2l_stress(const arma::mat &) const;
+        arma::mat rotate_l2g_stress(const arma::mat &) const;
+        arma::mat rotate_g2l_strain(const arma::mat &) const;
+        arma::mat rotate_l2g_strain(const arma::mat &) const;
+    
+        virtual rotation_batch& operator = (const rotation_batch&);
+    
+        friend std::ostream& operator << (std::ostream&, const rotation_batch&);
+};
+
 //To rotate a vector, given a rotation matrix
 arma::vec rotate_vec(const arma::vec &, const arma::mat &);
 arma::vec rotate_vec(const arma::vec &, const double &, const int &);
@@ -104,6 +187,26 @@ arma::mat rotate_l2g_M(const arma::mat &, const double &, const double &, const
 
 //To rotate from global to local a compliance matrix (6,6)
 arma::mat rotate_g2l_M(const arma::mat &, const double &, const double &, const double &);
+
+//To rotate a Voigt vector (6, stored as a column or a row) with a composed rotation matrix, without temporaries : out = Q*V
+void rotate_voigt(arma::mat &, const arma::mat &, const arma::mat &);
+
+//To rotate a (6,6) matrix with composed rotation matrices, without temporaries : out = Q*A*trans(P)
+void rotate_voigt(arma::mat &, const arma::mat &, const arma::mat &, const arma::mat &);
+
+//Same rotations from local to global and from global to local, with the composed matrices of a set of Euler angles
+arma::vec rotate_l2g_strain(const arma::vec &, const euler_Q &);
+arma::vec rotate_g2l_strain(const arma::vec &, const euler_Q &);
+arma::vec rotate_l2g_stress(const arma::vec &, const euler_Q &);
+arma::vec rotate_g2l_stress(const arma::vec &, const euler_Q &);
+arma::mat rotate_l2g_L(const arma::mat &, const euler_Q &);
+arma::mat rotate_g2l_L(const arma::mat &, const euler_Q &);
+arma::mat rotate_l2g_M(const arma::mat &, const euler_Q &);
+arma::mat rotate_g2l_M(const arma::mat &, const euler_Q &);
+arma::mat rotate_l2g_A(const arma::mat &, const euler_Q &);
+arma::mat rotate_g2l_A(const arma::mat &, const euler_Q &);
+arma::mat rotate_l2g_B(const arma::mat &, const euler_Q &);
+arma::mat rotate_g2l_B(const arma::mat &, const euler_Q &);
     
     
 } //namespace smart
@@ -26,7 +26,11 @@
 
 #include <iostream>
 #include <string>
+#include <memory>
 #include <armadillo>
+#include "../../Umat/umat_registry.hpp"
+#include "tolerances.hpp"
+#include "../Maths/rotation.hpp"
 
 namespace smart{
 
@@ -50,6 +54,17 @@ class material_characteristics
 		int nprops;
 		arma::vec props;
     
+        int umat_id;                //Number of the model in the umat registry, 0 if umat_name has not been resolved
+        umat_function umat_M;       //Mechanical model resolved from umat_name
+        umat_function umat_T;       //Thermomechanical model resolved from umat_name
+        umat_init_function init_M;  //Precomputation of the constants of the mechanical model, NULL if it has none
+        umat_init_function init_T;  //Precomputation of the constants of the thermomechanical model, NULL if it has none
+        std::shared_ptr<material_constants> sptr_constants_M;  //Constants of the mechanical model, built at its first call after an update of the props
+        std::shared_ptr<material_constants> sptr_constants_T;  //Constants of the thermomechanical model, built at its first call after an update of the props
+        tolerances tol;             //Tolerances of the constitutive model, the global defaults unless set for this material
+        mutable euler_Q Q_mat;      //Rotation matrices of the orientation of the material, composed at the first use of the angles
+        std::string path_data;      //Folder of the data files read by the model (the phases of the multiphase models), "data" unless set by the solver
+    
 		material_characteristics(); 	//default constructor
 		material_characteristics(const int &, const bool& = true, const double& = 0.);	//constructor - allocates memory for props
     
@@ -62,6 +77,9 @@ class material_characteristics
 		virtual void resize(const int &, const bool & = true, const double & = 0.);
 		virtual void update(const int &, const std::string &, const int &, const double &, const double &, const double &, const int &, const arma::vec &);
 		virtual int dimprops () const {return nprops;}       // returns the number of props, nprops
+        virtual void resolve_umat();    //Looks umat_name up in the umat registry
+        virtual void reset_constants(); //Discards the constants derived from the props, to be called if the props are modified directly
+        virtual const euler_Q& rotation() const;   //Rotation matrices of the orientation of the material
     
 		virtual material_characteristics& operator = (const material_characteristics&);
 		
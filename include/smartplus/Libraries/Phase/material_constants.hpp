@@ -0,0 +1,104 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file material_constants.hpp
+///@brief Constants derived from the props of a material, computed once and used by the constitutive models at each call
+///@version 1.0
+
+#pragma once
+
+#include <iostream>
+#include <memory>
+#include <armadillo>
+
+namespace smart{
+
+//======================================
+class material_constants
+//======================================
+{
+private:
+
+protected:
+
+public :
+
+    material_constants();   //default constructor
+    virtual ~material_constants();
+
+    static const material_constants* current();     //Constants of the material being computed in this thread, NULL if there are none
+    static const material_constants* set_current(const material_constants *);   //Sets the constants of the material being computed, returns the previous ones
+};
+
+///Precomputation of the constants of a model from its props : (props)
+typedef std::shared_ptr<material_constants> (*umat_init_function)(const arma::vec &);
+
+///Returns the constants of the material being computed if they are of type C, otherwise builds them from the props into sptr_local (model called outside of select_umat)
+template<class C> const C* current_constants(const arma::vec &props, umat_init_function umat_init, std::shared_ptr<material_constants> &sptr_local)
+{
+    const C *constants = dynamic_cast<const C*>(material_constants::current());
+    if (constants == NULL) {
+        sptr_local = umat_init(props);
+        constants = static_cast<const C*>(sptr_local.get());
+    }
+    return constants;
+}
+
+//======================================
+class isotropic_constants : public material_constants
+//======================================
+{
+private:
+
+protected:
+
+public :
+
+    arma::mat L;        //Elastic stiffness tensor
+    arma::mat M;        //Elastic compliance tensor
+    arma::vec alpha;    //CTE tensor
+    arma::vec Ir05;     //Factors of the strain-like tensors in Voigt notation (1,1,1,0.5,0.5,0.5)
+
+    isotropic_constants(const double &, const double &, const double &);  //Constructor from E, nu and the isotropic CTE
+    virtual ~isotropic_constants();
+};
+
+//======================================
+class sma_constants : public material_constants
+//======================================
+{
+private:
+
+protected:
+
+public :
+
+    double K_A;         //Bulk modulus of Austenite
+    double mu_A;        //Shear modulus of Austenite
+    double K_M;         //Bulk modulus of Martensite
+    double mu_M;        //Shear modulus of Martensite
+    arma::mat M_A;      //Elastic compliance tensor of Austenite
+    arma::mat M_M;      //Elastic compliance tensor of Martensite
+    arma::mat DM;       //M_M - M_A
+    arma::vec Ith;      //Identity tensor in Voigt notation, for the CTE of the mixture
+    arma::vec Dalpha;   //Difference of the CTE tensors of Martensite and Austenite
+
+    sma_constants(const double &, const double &, const double &, const double &, const double &, const double &);  //Constructor from E_A, E_M, nu_A, nu_M, alphaA_iso, alphaM_iso
+    virtual ~sma_constants();
+};
+
+} //namespace smart
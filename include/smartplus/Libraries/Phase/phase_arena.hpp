@@ -0,0 +1,81 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file phase_arena.hpp
+///@brief Flattened, index-based view of a tree of phases
+///@version 1.0
+
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <armadillo>
+#include "phase_characteristics.hpp"
+
+namespace smart{
+
+//======================================
+class phase_arena
+//======================================
+{
+	private:
+
+	protected:
+
+	public :
+
+        std::vector<phase_characteristics*> phases;    //Phases in breadth-first order, phases[0] is the root
+        arma::Col<int> parent;          //Index of the parent phase, -1 for the root
+        arma::Col<int> first_child;     //Index of the first sub-phase, the sub-phases of a phase are contiguous
+        arma::Col<int> nchildren;       //Number of sub-phases
+        arma::Col<int> depth;           //Depth of the phase in the tree, 0 for the root
+
+        phase_arena();     //default constructor
+        phase_arena(phase_characteristics &);  //Constructor with parameters
+        phase_arena(const phase_arena &);  //Copy constructor
+        virtual ~phase_arena();
+
+        virtual void build(phase_characteristics &);
+        int size() const {return phases.size();}
+        phase_characteristics& operator()(const int &i) {return *phases[i];}
+
+        /// Calls f(phase, index) for each phase, parents before their sub-phases
+        template<typename F> void visit(F f) {
+            for (unsigned int i=0; i<phases.size(); i++)
+                f(*phases[i], i);
+        }
+
+        /// Calls f(phase, index) for each sub-phase of the phase i
+        template<typename F> void visit_children(const int &i, F f) {
+            for (int j=first_child(i); j<first_child(i)+nchildren(i); j++)
+                f(*phases[j], j);
+        }
+
+        /// Calls f(phase, index) for each phase that has no sub-phase
+        template<typename F> void visit_leaves(F f) {
+            for (unsigned int i=0; i<phases.size(); i++) {
+                if (nchildren(i) == 0)
+                    f(*phases[i], i);
+            }
+        }
+
+        virtual phase_arena& operator = (const phase_arena&);
+
+        friend std::ostream& operator << (std::ostream&, const phase_arena&);
+};
+
+} //namespace smart
@@ -56,6 +56,7 @@ class phase_characteristics
     
         std::vector<phase_characteristics> sub_phases;
         std::string sub_phases_file;
+        bool at_start;      //The current values equal the start values (set by set_start and to_start, reset by any call of a umat) : to_start has nothing to copy
     
 		phase_characteristics(); 	//default constructor
     
@@ -64,13 +65,19 @@ class phase_characteristics
 		phase_characteristics(const phase_characteristics&);	//Copy constructor
         virtual ~phase_characteristics();
     
+        //Statically typed access : the types are fixed by construct (shape_type and sv_type), so no RTTI lookup or reference count is needed
+        template<class S> S* sv_global() const {return static_cast<S*>(sptr_sv_global.get());}
+        template<class S> S* sv_local() const {return static_cast<S*>(sptr_sv_local.get());}
+        template<class G> G* shape() const {return static_cast<G*>(sptr_shape.get());}
+        template<class M> M* multi() const {return static_cast<M*>(sptr_multi.get());}
+
         virtual void construct(const int &, const int &);
         virtual void sub_phases_construct(const int &, const int &, const int &);
         virtual void to_start();
         virtual void set_start();
         virtual void local2global();
         virtual void global2local();
-        virtual void copy(const phase_characteristics&);   //Be warned that the ofstreams are NOT copied
+        virtual void copy(const phase_characteristics&, const bool & = true);   //Be warned that the ofstreams are NOT copied. The sub-phases are copied if the second argument is true
 
 		virtual phase_characteristics& operator = (const phase_characteristics&);
     
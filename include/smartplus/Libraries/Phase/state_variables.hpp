@@ -23,6 +23,7 @@
 
 #include <iostream>
 #include <armadillo>
+#include "../Maths/rotation.hpp"
 
 namespace smart{
 
@@ -67,7 +68,9 @@ class state_variables
         virtual void set_start(); //sigma_start goes to sigma
     
         virtual state_variables& rotate_l2g(const state_variables&, const double&, const double&, const double&);
+        virtual state_variables& rotate_l2g(const state_variables&, const euler_Q&);
         virtual state_variables& rotate_g2l(const state_variables&, const double&, const double&, const double&);
+        virtual state_variables& rotate_g2l(const state_variables&, const euler_Q&);
     
         friend std::ostream& operator << (std::ostream&, const state_variables&);
 };
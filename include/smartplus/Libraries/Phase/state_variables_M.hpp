@@ -63,8 +63,10 @@ class state_variables_M : public state_variables
     
         using state_variables::rotate_l2g;
         virtual state_variables_M& rotate_l2g(const state_variables_M&, const double&, const double&, const double&);
+        virtual state_variables_M& rotate_l2g(const state_variables_M&, const euler_Q&);
         using state_variables::rotate_g2l;
         virtual state_variables_M& rotate_g2l(const state_variables_M&, const double&, const double&, const double&);
+        virtual state_variables_M& rotate_g2l(const state_variables_M&, const euler_Q&);
     
         friend std::ostream& operator << (std::ostream&, const state_variables_M&);
 };
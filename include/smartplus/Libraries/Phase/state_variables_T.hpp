@@ -70,8 +70,10 @@ namespace smart{
     
         using state_variables::rotate_l2g;
         virtual state_variables_T& rotate_l2g(const state_variables_T&, const double&, const double&, const double&);
+        virtual state_variables_T& rotate_l2g(const state_variables_T&, const euler_Q&);
         using state_variables::rotate_g2l;
         virtual state_variables_T& rotate_g2l(const state_variables_T&, const double&, const double&, const double&);
+        virtual state_variables_T& rotate_g2l(const state_variables_T&, const euler_Q&);
     
         friend std::ostream& operator << (std::ostream&, const state_variables_T&);
 };
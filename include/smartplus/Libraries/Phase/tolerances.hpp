@@ -0,0 +1,61 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file tolerances.hpp
+///@brief Numerical tolerances and iteration limits of the constitutive models, set at runtime
+///@version 1.0
+
+#pragma once
+
+#include <iostream>
+
+namespace smart{
+
+//======================================
+class tolerances
+//======================================
+{
+private:
+
+protected:
+
+public :
+
+    int umat_maxiter;           //Maximal number of iterations of the return mapping of a UMAT (maxiter_umat)
+    double umat_precision;      //Precision of the return mapping of a UMAT (precision_umat)
+    int umat_substeps;          //Maximal number of sub-increments an increment of a UMAT may be split into locally, 1 : no sub-stepping (substeps_umat)
+    int micro_maxiter;          //Maximal number of iterations of the micromechanical schemes (maxiter_micro)
+    double micro_precision;     //Precision of the micromechanical schemes (precision_micro)
+    int micro_points;           //Maximal number of integration points of the Eshelby tensors in each direction, 0 : the ones of the props (points_micro)
+    double zero_limit;          //Threshold under which a quantity is considered null (limit)
+    double zero_iota;           //Smaller threshold, used for the internal variables (iota)
+
+    tolerances();   //default constructor : copy of the global defaults
+    tolerances(const int &, const double &, const int &, const int &, const double &, const int &, const double &, const double &);  //Constructor with parameters
+    tolerances(const tolerances &);     //Copy constructor
+    virtual ~tolerances();
+
+    static tolerances& defaults();                  //Global defaults of this thread, initialized with the values of parameter.hpp (the solver controls of a simulation set them)
+    static const tolerances& current();             //Tolerances of the material being computed in this thread, the global defaults otherwise
+    static const tolerances* set_current(const tolerances *);   //Sets the tolerances of the material being computed, returns the previous ones
+
+    virtual tolerances& operator = (const tolerances&);
+
+    friend std::ostream& operator << (std::ostream&, const tolerances&);
+};
+
+} //namespace smart
@@ -0,0 +1,91 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file checkpoint.hpp
+///@brief Save and restore of the full state of a RVE and of the solver counters
+///@version 1.0
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <armadillo>
+#include "../Phase/phase_characteristics.hpp"
+
+namespace smart{
+
+//======================================
+class phase_state
+//======================================
+{
+private:
+
+protected:
+
+    unsigned int pos;       //Position of the next value to read
+
+public :
+
+    std::vector<double> data;   //Fields of all the phases (depth-first order), each matrix preceded by its dimensions
+
+    phase_state(); 	//default constructor
+    phase_state(const phase_state &);	//Copy constructor
+    virtual ~phase_state();
+
+    virtual void save(const phase_characteristics &);   //Copies the state of a RVE, the memory is reused from one save to the next
+    virtual void restore(phase_characteristics &);     //Sets the state of a RVE with the same phases, bit for bit
+
+    virtual phase_state& operator = (const phase_state&);
+
+    friend  std::ostream& operator << (std::ostream&, const phase_state&);
+};
+
+//======================================
+class solver_checkpoint
+//======================================
+{
+private:
+
+protected:
+
+public :
+
+    int kblock;             //Block of the next cycle
+    int kcycle;             //Next cycle
+    double Time;
+    double tnew_dt;         //Fraction of the next increment
+    double Dtinc;           //Size of the last increment
+    double Dtinc_cur;
+    double error;           //Error of the last increment, with its residual
+    arma::vec residual;
+    int o_ncount;           //Number of increments since the last output
+    double o_tcount;        //Time since the last output
+
+    solver_checkpoint(); 	//default constructor
+    solver_checkpoint(const solver_checkpoint &);	//Copy constructor
+    virtual ~solver_checkpoint();
+
+    virtual void save(const std::string &, const phase_characteristics &) const;  //Writes the counters and the RVE in a binary file
+    virtual bool load(const std::string &, phase_characteristics &);             //Reads a file written by save : the RVE is built again with all its phases. false if there is no file
+
+    virtual solver_checkpoint& operator = (const solver_checkpoint&);
+
+    friend  std::ostream& operator << (std::ostream&, const solver_checkpoint&);
+};
+
+} //namespace smart
@@ -0,0 +1,63 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file cycle_control.hpp
+///@brief object that defines the treatment of the cycles of each block
+///@version 1.0
+
+#pragma once
+
+#include <iostream>
+#include <armadillo>
+
+namespace smart{
+
+//======================================
+class cycle_control
+//======================================
+{
+private:
+
+protected:
+
+public :
+
+    //cycle-jump
+    arma::Col<int> c_jump;          //1 : the slow variables are extrapolated over several cycles
+    arma::Col<int> c_ncompute;      //Number of cycles integrated between two jumps (at least 2)
+    arma::vec c_tolerance;          //Relative tolerance on the change and the extrapolation error of the statev over a jump
+    arma::Col<int> c_njump_min;     //Minimal number of cycles of a jump, smaller jumps are not performed
+    arma::Col<int> c_njump_max;     //Maximal number of cycles of a jump
+
+    //stabilized cycle
+    arma::Col<int> c_stab;          //Detection of a periodic response : 0 none, 1 the remaining cycles are skipped, 2 the stabilized cycle is copied in the output for the remaining cycles
+    arma::vec c_stab_tolerance;     //Relative tolerance on the difference between the trajectories of two successive cycles
+    arma::Col<int> c_stab_ncycles;  //Number of successive periodic cycles required
+
+    cycle_control(); 	//default constructor
+    cycle_control(const int&);	//Constructor with parameters
+    cycle_control(const cycle_control &);	//Copy constructor
+    ~cycle_control();
+
+    bool active() const;    //true if one of the blocks requires a specific treatment of its cycles
+
+    virtual cycle_control& operator = (const cycle_control&);
+
+    friend  std::ostream& operator << (std::ostream&, const cycle_control&);
+};
+
+} //namespace smart
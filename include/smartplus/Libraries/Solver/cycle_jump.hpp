@@ -0,0 +1,74 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file cycle_jump.hpp
+///@brief Extrapolation of the slowly evolving variables of a RVE over a large number of cycles
+///@version 1.0
+
+#pragma once
+
+#include <iostream>
+#include <armadillo>
+#include "../Phase/phase_characteristics.hpp"
+
+namespace smart{
+
+//======================================
+class cycle_jump
+//======================================
+{
+private:
+
+protected:
+
+public :
+
+    int ncompute;           //Number of cycles integrated between two jumps
+    double tolerance;       //Relative tolerance on the change and the extrapolation error of the statev over a jump
+    int njump_min;          //Minimal number of cycles of a jump
+    int njump_max;          //Maximal number of cycles of a jump
+
+    arma::mat history;      //Slow variables at the end of the last cycles integrated (one column per cycle, the latest one last)
+    arma::Col<int> is_statev;   //1 if the slow variable is a statev (controls the size of the jumps), 0 for the works
+    arma::vec times;        //Time at the end of the last cycles integrated
+    int nrecords;           //Number of cycles recorded since the beginning of the block or the last jump
+
+    int njumps;             //Number of jumps performed
+    int ncycles_jumped;     //Total number of cycles extrapolated
+
+    cycle_jump(); 	//default constructor
+    cycle_jump(const int &, const double &, const int &, const int &);	//Constructor with parameters
+    cycle_jump(const cycle_jump &);	//Copy constructor
+    virtual ~cycle_jump();
+
+    virtual void reset();   //Clears the recorded cycles
+    virtual void record(phase_characteristics &, const double &);   //Records the slow variables of the RVE at the end of a cycle
+    virtual int size(const int &) const;    //Number of cycles that can be extrapolated, 0 if no jump should be performed
+    virtual double jump(phase_characteristics &, const int &);      //Extrapolates the slow variables over a number of cycles, returns the time elapsed
+
+    virtual cycle_jump& operator = (const cycle_jump&);
+
+    friend  std::ostream& operator << (std::ostream&, const cycle_jump&);
+};
+
+///Gathers the slow variables (statev, Wm, Wt) of all the phases of a RVE in a vector. The second argument flags the statev
+void pack_slow_variables(phase_characteristics &, arma::vec &, arma::Col<int> &);
+
+///Sets the slow variables of all the phases of a RVE from a vector built by pack_slow_variables
+void unpack_slow_variables(phase_characteristics &, const arma::vec &);
+
+} //namespace smart
@@ -0,0 +1,78 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file cycle_stabilization.hpp
+///@brief Detection of a periodic response of a RVE over the cycles of a block
+///@version 1.0
+
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <armadillo>
+#include "output.hpp"
+#include "output_backend.hpp"
+#include "../Phase/phase_characteristics.hpp"
+
+namespace smart{
+
+//======================================
+class cycle_stabilization
+//======================================
+{
+private:
+
+protected:
+
+public :
+
+    double tolerance;       //Relative tolerance on the difference between the trajectories of two successive cycles
+    int ncycles;            //Number of successive periodic cycles required
+
+    std::vector<arma::vec> trajectory;          //sigma, Etot and the change of the statev since the beginning of the cycle, at the end of each increment of the current cycle
+    std::vector<arma::vec> trajectory_prev;     //Same for the previous cycle
+    arma::vec statev_cycle;     //statev at the beginning of the current cycle
+    arma::vec slow_cycle;       //Slow variables of all the phases (statev and works, see pack_slow_variables) at the beginning of the current cycle
+    double Time_cycle;          //Time at the beginning of the current cycle
+    double period;              //Duration of the last cycle
+
+    std::vector<arma::vec> records_global;      //Output records of the current cycle, to be copied once the response is periodic
+    std::vector<arma::vec> records_local;
+
+    arma::vec errors;       //Relative differences of sigma, Etot and statev between the last two cycles
+    int nperiodic;          //Number of successive periodic cycles
+    int ncompared;          //Number of cycles compared
+
+    cycle_stabilization(); 	//default constructor
+    cycle_stabilization(const double &, const int &);	//Constructor with parameters
+    cycle_stabilization(const cycle_stabilization &);	//Copy constructor
+    virtual ~cycle_stabilization();
+
+    virtual void reset();   //Forgets the previous cycles
+    virtual void begin(phase_characteristics &, const double &);        //Beginning of a cycle
+    virtual void sample(const phase_characteristics &);                 //End of a converged increment
+    virtual void store(const phase_characteristics &, const solver_output &, const output_backend &, const output_backend &, const int &, const int &, const int &, const int &, const double &);    //Output records of an increment
+    virtual bool end(const double &);       //End of a cycle : true if the response is periodic
+    virtual void replay(output_backend &, output_backend &, const int &) const;  //Writes the records of the last cycle for a number of following cycles
+    virtual void skip(phase_characteristics &, const int &) const;      //Advances the slow variables by their change over the last cycle, for a number of following cycles
+
+    virtual cycle_stabilization& operator = (const cycle_stabilization&);
+
+    friend  std::ostream& operator << (std::ostream&, const cycle_stabilization&);
+};
+
+} //namespace smart
@@ -49,6 +49,12 @@ public :
     arma::Col<int> o_nfreq;
     arma::vec o_tfreq;
     
+    //output backend
+    int o_format;   //0 : text files (one per phase), 1 : binary columnar file (all phases)
+    int o_chunk;    //Number of increments buffered before a chunk is written (binary), 0 : a single chunk at the end
+    int o_async;    //1 : the results are written by a background thread
+    int o_nbuffer;  //Number of increments that can be pending in the asynchronous output
+    
     solver_output(); 	//default constructor
     solver_output(const int&);	//Constructor with parameters
     solver_output(const solver_output &);	//Copy constructor
@@ -0,0 +1,212 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file output_backend.hpp
+///@brief Backends that write the results of a phase and its sub-phases
+///@version 1.0
+
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <armadillo>
+#include "output.hpp"
+#include "../Phase/phase_characteristics.hpp"
+
+namespace smart{
+
+//======================================
+class output_backend
+//======================================
+{
+private:
+
+protected:
+
+    arma::vec record;           //Record of the current increment
+
+    void define_columns(const phase_characteristics &, const solver_output &);
+
+public :
+
+    std::string coordsys;       //"global" or "local"
+    int nfields;                //Number of fields of a record (increment info + all phases)
+    std::vector<std::string> columns;
+    arma::Col<int> col_phases;  //Index of the phase (depth-first order) of each field, -1 for the increment info
+
+    output_backend(); 	//default constructor
+    virtual ~output_backend();
+
+    virtual void open(phase_characteristics &, const solver_output &, const std::string &, const std::string &, const std::string & = "global") = 0;
+    virtual void write(phase_characteristics &, const solver_output &, const int &, const int &, const int &, const int &, const double &);
+    virtual void write_record(const arma::vec &) = 0;     //Writes a record filled by output_record
+    virtual void close() = 0;
+};
+
+//======================================
+class output_text : public output_backend
+//======================================
+{
+private:
+
+protected:
+
+    std::vector<std::shared_ptr<std::ofstream> > files;  //Files of the phases (depth-first order)
+    arma::Col<int> n_first;     //Index of the first field of each phase
+    arma::Col<int> n_statev;    //Index of the first statev of each phase
+
+public :
+
+    output_text(); 	//default constructor
+    virtual ~output_text();
+
+    virtual void open(phase_characteristics &, const solver_output &, const std::string &, const std::string &, const std::string & = "global");
+    virtual void write(phase_characteristics &, const solver_output &, const int &, const int &, const int &, const int &, const double &);
+    virtual void write_record(const arma::vec &);
+    virtual void close();
+};
+
+//======================================
+class output_binary : public output_backend
+//======================================
+{
+private:
+
+protected:
+
+    std::ofstream of;
+    arma::mat chunk;            //Records of the current chunk, one column per increment
+
+    void flush();
+
+public :
+
+    int nrows;                  //Number of records in the current chunk
+    int chunk_size;             //Number of records per chunk, 0 for a single chunk
+
+    output_binary(); 	//default constructor
+    output_binary(const int &); 	//Constructor with parameters
+    virtual ~output_binary();
+
+    virtual void open(phase_characteristics &, const solver_output &, const std::string &, const std::string &, const std::string & = "global");
+    virtual void write_record(const arma::vec &);
+    virtual void close();
+};
+
+//======================================
+class output_async : public output_backend
+//======================================
+{
+private:
+
+protected:
+
+    arma::mat ring;             //Snapshots, one column per increment
+    long head;                  //Number of snapshots copied by the solver
+    long tail;                  //Number of snapshots written by the writer thread
+    bool done;
+    std::mutex mtx;
+    std::condition_variable cv_data;
+    std::condition_variable cv_space;
+    std::thread writer;
+
+    void run();
+
+public :
+
+    std::shared_ptr<output_backend> sptr_backend;  //The backend that formats and writes the snapshots
+    int capacity;               //Number of snapshots in the ring buffer
+
+    output_async(); 	//default constructor
+    output_async(const std::shared_ptr<output_backend> &, const int &); 	//Constructor with parameters
+    virtual ~output_async();
+
+    virtual void open(phase_characteristics &, const solver_output &, const std::string &, const std::string &, const std::string & = "global");
+    virtual void write(phase_characteristics &, const solver_output &, const int &, const int &, const int &, const int &, const double &);
+    virtual void write_record(const arma::vec &);
+    virtual void close();
+};
+
+//======================================
+class output_recorder : public output_backend
+//======================================
+{
+private:
+
+protected:
+
+public :
+
+    std::shared_ptr<output_backend> sptr_backend;  //The backend that writes the records
+    std::vector<arma::vec> records;     //Records written since the backend was opened
+
+    output_recorder(); 	//default constructor
+    output_recorder(const std::shared_ptr<output_backend> &); 	//Constructor with parameters
+    virtual ~output_recorder();
+
+    virtual void open(phase_characteristics &, const solver_output &, const std::string &, const std::string &, const std::string & = "global");
+    virtual void write(phase_characteristics &, const solver_output &, const int &, const int &, const int &, const int &, const double &);
+    virtual void write_record(const arma::vec &);
+    virtual void close();
+};
+
+//======================================
+class output_monitor : public output_backend
+//======================================
+{
+private:
+
+protected:
+
+public :
+
+    std::shared_ptr<output_backend> sptr_backend;  //The backend that writes the records
+    bool stopped;               //A record has been rejected by check : the solver stops at the end of the increment
+
+    output_monitor(); 	//default constructor
+    output_monitor(const std::shared_ptr<output_backend> &); 	//Constructor with parameters
+    virtual ~output_monitor();
+
+    virtual void open(phase_characteristics &, const solver_output &, const std::string &, const std::string &, const std::string & = "global");
+    virtual void write(phase_characteristics &, const solver_output &, const int &, const int &, const int &, const int &, const double &);
+    virtual void write_record(const arma::vec &);
+    virtual void close();
+    virtual bool check(const arma::vec &);     //Called with each record written, false to stop the simulation
+};
+
+/// Function that returns the output backend selected in solver_output (o_format, o_async)
+std::shared_ptr<output_backend> make_output_backend(const solver_output &);
+
+/// Function that lists the fields written for a phase and its sub-phases (depth-first), with the index of their phase
+void output_names(const phase_characteristics &, const solver_output &, std::vector<std::string> &, std::vector<int> &, int &);
+
+/// Function that fills the fields of a phase and its sub-phases, starting at the given index
+void output_fields(const phase_characteristics &, const solver_output &, arma::vec &, int &, const std::string & = "global");
+
+/// Function that fills a record: increment info (block, cycle, step, inc, Time) followed by the fields of all the phases
+void output_record(const phase_characteristics &, const solver_output &, const int &, const int &, const int &, const int &, const double &, arma::vec &, const std::string & = "global");
+
+/// Function that reads a binary output file: column names, phase of each column and records (one row per increment)
+void read_output_binary(std::vector<std::string> &, arma::Col<int> &, arma::mat &, const std::string & = "results", const std::string & = "results_job_global.bin");
+
+} //namespace smart
@@ -24,6 +24,8 @@
 #include <string>
 #include "block.hpp"
 #include "output.hpp"
+#include "cycle_control.hpp"
+#include "simulation_tree.hpp"
 
 namespace smart{
 
@@ -47,6 +49,15 @@ void read_matprops(std::string &, int &, arma::vec &, int &, double &, double &,
 /// Function that reads the output parameters
 void read_output(solver_output &, const int &, const int &, const std::string & = "data", const std::string & = "output.dat");
 
+/// Function that reads the treatment of the cycles of the blocks (optional file)
+void read_cycle_control(cycle_control &, const int &, const std::string & = "data", const std::string & = "cycle_control.inp");
+
+/// Function that reads the snapshots kept at the block boundaries (optional file, no snapshot without it)
+void read_simulation_tree(simulation_tree &, const std::string & = "data", const std::string & = "simul_tree.inp");
+
+/// Function that reads the checkpoints of the solver : number of cycles between two checkpoints and restart from the last one (optional file)
+void read_checkpoint_control(int &, int &, const std::string & = "data", const std::string & = "checkpoint.inp");
+
 /// Function that checks the coherency between the path and the step increments provided
 void check_path_output(const std::vector<block> &, const solver_output &);
     
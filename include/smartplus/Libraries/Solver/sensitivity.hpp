@@ -0,0 +1,85 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file sensitivity.hpp
+///@brief Forward sensitivities of the response of a RVE with respect to some of its props, integrated along with the solver increments
+///@version 1.0
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <armadillo>
+#include "output.hpp"
+#include "output_backend.hpp"
+#include "step_meca.hpp"
+#include "../Phase/phase_characteristics.hpp"
+
+namespace smart{
+
+//======================================
+class solver_sensitivity
+//======================================
+{
+private:
+
+protected:
+
+    phase_characteristics work;     //Copy of the RVE for the perturbed increments
+    phase_characteristics rve_d;    //Copy of the RVE that holds the derivatives of one parameter, to fill its records
+    arma::vec record;               //Record of the derivatives of one parameter
+
+    void perturb(const phase_characteristics &, const int &, const double &, const arma::vec &, const arma::mat &, const double &, const double &, const int &, const int &, const bool &, const int &);  //Increment of the work copy, along the derivatives of a parameter
+
+public :
+
+    arma::Col<int> props_index;     //Index in the props of the RVE of each parameter
+    double delta;                   //Relative perturbation of the props for the directional derivatives of an increment
+    bool active;                    //The derivatives are integrated (false if the simulation is not supported)
+
+    arma::mat dEtot;                //Derivatives of Etot, one column per parameter
+    arma::mat dsigma;               //Derivatives of sigma
+    arma::mat dWm;                  //Derivatives of Wm
+    arma::mat dstatev;              //Derivatives of statev
+    arma::mat dL;                   //Derivatives of L (36 values), which some models keep from the initialization
+    arma::cube dmecas;              //Derivatives of the increments of the current step (increments x 6 x parameters), they depend on the state at its start
+
+    solver_sensitivity(); 	//default constructor
+    solver_sensitivity(const arma::Col<int> &, const double & = 1.E-6);	//Constructor with parameters
+    solver_sensitivity(const solver_sensitivity &);	//Copy constructor
+    virtual ~solver_sensitivity();
+
+    int size() const {return props_index.n_elem;}   //Number of parameters
+
+    virtual bool supported(const phase_characteristics &) const;    //Mechanical RVE without sub-phases
+    virtual void begin(const phase_characteristics &, const arma::mat &, const double &, const int &, const int &, const int &);    //Initial state, after the first call of the model
+    virtual void generate(const step_meca &);     //Derivatives of the increments of a step, once it is generated
+    arma::mat prescribed(const int &, const double &) const;   //Derivatives of the prescribed values of a fraction of an increment of the current step
+    virtual void increment(const phase_characteristics &, const arma::Col<int> &, const arma::mat &, const arma::mat &, const double &, const double &, const int &, const int &, const int &);   //Converged increment, before the start values are set
+    virtual void open(std::vector<std::shared_ptr<output_backend> > &, const solver_output &, const std::string &, const std::string &);    //One backend per parameter, after begin
+    virtual void write(std::vector<std::shared_ptr<output_backend> > &, const solver_output &, const int &, const int &, const int &, const int &, const double &);
+
+    static std::string outputfile(const std::string &, const int &);    //Output file of the derivatives with respect to a parameter
+
+    virtual solver_sensitivity& operator = (const solver_sensitivity&);
+
+    friend  std::ostream& operator << (std::ostream&, const solver_sensitivity&);
+};
+
+} //namespace smart
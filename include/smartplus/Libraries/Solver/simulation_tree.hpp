@@ -0,0 +1,113 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file simulation_tree.hpp
+///@brief Snapshots of the solver at the block boundaries, shared by the simulations whose loading paths have a common prefix
+///@version 1.0
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <list>
+#include <armadillo>
+#include "block.hpp"
+#include "output.hpp"
+#include "cycle_control.hpp"
+#include "../Phase/phase_characteristics.hpp"
+
+namespace smart{
+
+//======================================
+class solver_snapshot
+//======================================
+{
+private:
+
+protected:
+
+public :
+
+    std::string key;        //Description of everything that determines the state of the solver after the prefix
+    int nblock;             //Number of blocks of the prefix
+
+    phase_characteristics rve;  //State of the RVE at the end of the prefix (deep copy, without the output streams)
+    double Time;
+    double tnew_dt;
+    int o_ncount;
+    double o_tcount;
+
+    std::vector<arma::vec> records_global;  //Output records of the prefix
+    std::vector<arma::vec> records_local;
+
+    int mp;                 //Integration points of the Eshelby tensors (static members of ellipsoid_multi), only built at the start of a simulation
+    int np;
+    arma::vec x;
+    arma::vec wx;
+    arma::vec y;
+    arma::vec wy;
+
+    solver_snapshot(); 	//default constructor
+    solver_snapshot(const std::string &, const int &, const phase_characteristics &, const double &, const double &, const int &, const double &, const std::vector<arma::vec> &, const std::vector<arma::vec> &);	//Constructor with parameters
+    solver_snapshot(const solver_snapshot &);	//Copy constructor
+    virtual ~solver_snapshot();
+
+    virtual void restore_points() const;    //Sets the integration points of the Eshelby tensors of the snapshot, before the simulation resumes
+
+    virtual solver_snapshot& operator = (const solver_snapshot&);
+
+    friend  std::ostream& operator << (std::ostream&, const solver_snapshot&);
+};
+
+//======================================
+class simulation_tree
+//======================================
+{
+private:
+
+protected:
+
+public :
+
+    int capacity;                   //Maximal number of snapshots kept, 0 disables the tree
+    arma::Col<int> props_block;     //First block (starting at 1) whose response depends on each prop, the props not given affect every block
+    std::list<solver_snapshot> snapshots;   //Snapshots, the most recently used first
+
+    int nhits;              //Number of simulations started from a snapshot
+    int nmisses;            //Number of simulations started from the beginning of the path
+    int nblocks_saved;      //Total number of blocks that were not simulated again
+
+    simulation_tree(); 	//default constructor
+    simulation_tree(const int &);	//Constructor with parameters
+    simulation_tree(const simulation_tree &);	//Copy constructor
+    virtual ~simulation_tree();
+
+    bool active() const;    //true if the snapshots are kept
+    virtual void clear();   //Discards all the snapshots
+    virtual const solver_snapshot* find(const std::string &);   //Snapshot of a prefix, NULL if none
+    virtual void insert(const solver_snapshot &);               //Keeps a snapshot, the least recently used one is discarded if the tree is full
+
+    virtual simulation_tree& operator = (const simulation_tree&);
+
+    friend  std::ostream& operator << (std::ostream&, const simulation_tree&);
+};
+
+/// Function that describes the prefixes of a loading path : the i-th key determines the state of the solver after the i first blocks (the first key is the one of the initial state)
+std::vector<std::string> prefix_keys(const std::string &, const arma::vec &, const int &, const double &, const double &, const double &, const arma::vec &, const double &, const std::vector<block> &, const solver_output &, const cycle_control &, const arma::Col<int> &, const std::string & = "data");
+
+} //namespace smart
@@ -22,6 +22,7 @@
 #pragma once
 
 #include <iostream>
+#include <memory>
 #include <armadillo>
 #include "output.hpp"
 #include "../Phase/state_variables.hpp"
@@ -50,12 +51,20 @@ protected:
     
     std::string file; //  It is used for input/output values of the loading path
     
+    bool compiled;                          //true once the tables of the increments are built, they are then reused at each cycle
+    arma::vec inc_coef;                     //Relative size of the increments (modes 1 and 2)
+    std::shared_ptr<const arma::mat> table; //Values of the incremental path file (mode 3), shared by the steps that read the same file
+    arma::mat table_inc;                    //Changes of the values of the file from one increment to the next, the first row holds the values of the first increment
+    int col_T;                              //Column of the thermal condition in table_inc, -1 if none
+    arma::Col<int> col_meca;                //Columns of the mechanical conditions in table_inc, -1 if none
+    
     step(); 	//default constructor
     step(const int &, const double &, const double &, const double &, const int &);	//Constructor with parameters
     step(const step &);	//Copy constructor
     virtual ~step();
    
     virtual void generate();
+    virtual void compile(const int &);     //Builds the tables of the increments, reading the incremental path file with the given number of columns (mode 3)
     virtual void compute_inc(double &, const int &, double &, double &, double &, const int &);
     virtual void assess_inc(const double &, double &, const double &, phase_characteristics &, double &, const double &);
     
@@ -64,4 +73,10 @@ protected:
     friend  std::ostream& operator << (std::ostream&, const step&);
 };
 
+/// Reads an incremental path file once per process : the table (one row per increment, without the first column) is shared by all the steps and runs that use the same file
+std::shared_ptr<const arma::mat> read_path_table(const std::string &, const int &);
+
+/// Maximal number of tables kept by read_path_table
+const int max_path_tables = 64;
+
 } //namespace smart
@@ -51,6 +51,8 @@ protected:
     step_meca(const step_meca&);	//Copy constructor
     virtual ~step_meca();
     
+    using step::compile;
+    virtual void compile();
     using step::generate;
     virtual void generate(const double&, const arma::vec&, const arma::vec&, const double&);
     
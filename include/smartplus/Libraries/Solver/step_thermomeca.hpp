@@ -50,6 +50,8 @@ protected:
     step_thermomeca(const step_thermomeca&);	//Copy constructor
     virtual ~step_thermomeca();
     
+    using step::compile;
+    virtual void compile();
     using step::generate;
     virtual void generate(const double&, const arma::vec&, const arma::vec&, const double&);
     
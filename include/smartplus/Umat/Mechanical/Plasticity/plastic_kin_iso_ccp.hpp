@@ -22,7 +22,9 @@
 ///@version 1.0
 
 #pragma once
+#include <memory>
 #include <armadillo>
+#include "../../../Libraries/Phase/material_constants.hpp"
 
 namespace smart {
 
@@ -45,6 +47,9 @@ namespace smart {
 ///@brief statev[6] : Plastic strain 13: EP(0,2)
 ///@brief statev[7] : Plastic strain 23: EP(1,2)
 
+///@brief Precomputation of the constants of the model from its props, once per material
+std::shared_ptr<material_constants> umat_plasticity_kin_iso_CCP_init(const arma::vec &);
+
 void umat_plasticity_kin_iso_CCP(const arma::vec &, const arma::vec &, arma::vec &, arma::mat &, arma::mat &, arma::vec &, const arma::mat &, const int &, const arma::vec &, const int &, arma::vec &, const double &, const double &,const double &,const double &, double &, double &, double &, double &, const int &, const int &, const bool &, const int &, double &);
                                 
 } //namespace smart
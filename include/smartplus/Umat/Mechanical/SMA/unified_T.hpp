@@ -21,7 +21,9 @@
 ///@brief Implemented in 1D-2D-3D
 
 #pragma once
+#include <memory>
 #include <armadillo>
+#include "../../../Libraries/Phase/material_constants.hpp"
 
 namespace smart {
 
@@ -75,6 +77,9 @@ namespace smart {
     ///@brief statev[15] : a3 : Equilibrium hardening parameter
     ///@brief statev[16] : Y0t : Initial transformation critical value
 
+///@brief Precomputation of the constants of the model from its props, once per material
+std::shared_ptr<material_constants> umat_sma_unified_T_init(const arma::vec &);
+
 void umat_sma_unified_T(const arma::vec &, const arma::vec &, arma::vec &, arma::mat &, const arma::mat &, const int &, const arma::vec &, const int &, arma::vec &, const double &, const double &,const double &,const double &, double &, double &, double &, double &, const int &, const int &, const bool &, double &);
     
 } //namespace smart
@@ -21,7 +21,9 @@
 
 #pragma once
 
+#include <memory>
 #include <armadillo>
+#include "../../../Libraries/Phase/material_constants.hpp"
 
 namespace smart{
     
@@ -32,6 +34,9 @@ namespace smart{
     
     ///@brief No statev is required for thermoelastic constitutive law
     
+    ///@brief Precomputation of the constants of the model from its props, once per material
+    std::shared_ptr<material_constants> umat_elasticity_iso_T_init(const arma::vec &);
+
     void umat_elasticity_iso_T(const arma::vec &, const arma::vec &, arma::vec &, double &, arma::mat &, arma::mat &, arma::mat &, arma::mat &, const arma::mat &, const int &, const arma::vec &, const int &, arma::vec &, const double &, const double &,const double &,const double &, double &, double &, double &, double &, double &, double &, double &, const int &, const int &, const bool &, double &);
     
 } //namespace smart
@@ -22,7 +22,9 @@
 ///@version 1.0
 
 #pragma once
+#include <memory>
 #include <armadillo>
+#include "../../../Libraries/Phase/material_constants.hpp"
 
 namespace smart {
 
@@ -54,6 +56,9 @@ namespace smart {
 ///@brief statev[12] : Backstress 11: X(0,2)
 ///@brief statev[13] : Backstress 11: X(1,2)
 
+///@brief Precomputation of the constants of the model from its props, once per material
+std::shared_ptr<material_constants> umat_plasticity_kin_iso_CCP_T_init(const arma::vec &);
+
 void umat_plasticity_kin_iso_CCP_T(const arma::vec &, const arma::vec &, arma::vec &, double &, arma::mat &, arma::mat &, arma::mat &, arma::mat &, const arma::mat &, const int &, const arma::vec &, const int &, arma::vec &, const double &, const double &,const double &,const double &, double &, double &, double &, double &, double &, double &, double &, const int &, const int &, const bool &, double &);
     
 } //namespace smart
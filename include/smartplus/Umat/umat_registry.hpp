@@ -0,0 +1,59 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file umat_registry.hpp
+///@brief Registry of the constitutive models: the name of a UMAT is resolved once into a function handle
+///@version 1.0
+
+#pragma once
+#include <string>
+#include <map>
+#include <armadillo>
+#include "../Libraries/Phase/material_constants.hpp"
+
+namespace smart{
+
+class phase_characteristics;
+
+///Signature shared by all the registered constitutive models : (rve, DR, Time, DTime, ndi, nshr, start, solver_type, tnew_dt)
+typedef void (*umat_function)(phase_characteristics &, const arma::mat &, const double &, const double &, const int &, const int &, const bool &, const int &, double &);
+
+///Entry of the registry
+struct umat_entry {
+    int id;                     //Number of the model (the micromechanical schemes use it as the homogenization method)
+    umat_function umat_M;       //Mechanical model, NULL if there is none
+    umat_function umat_T;       //Thermomechanical model, NULL if there is none
+    umat_init_function init_M;  //Precomputation of the constants of the mechanical model, NULL if there is none
+    umat_init_function init_T;  //Precomputation of the constants of the thermomechanical model, NULL if there is none
+};
+
+///Name of the symbol a plugin library has to export : extern "C" void smartplus_register_umat()
+#define SMARTPLUS_UMAT_PLUGIN_SYMBOL "smartplus_register_umat"
+
+///Returns the registry, the built-in models are registered at the first call
+std::map<std::string, umat_entry>& umat_library();
+
+///Registers (or replaces) a model, with the optional precomputation of its constants. If id is 0, a number above 1000 is attributed. Returns the number of the model
+int register_umat(const std::string &, const int &, umat_function, umat_function, umat_init_function = NULL, umat_init_function = NULL);
+
+///Returns the entry of a model, NULL if the name is not registered
+const umat_entry* find_umat(const std::string &);
+
+///Opens a shared library and calls its registration function smartplus_register_umat()
+void load_umat_plugin(const std::string &);
+
+} //namespace smart
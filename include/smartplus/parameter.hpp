@@ -57,6 +57,10 @@ namespace smart {
 #define mul_tnew_dt_umat 2
 #endif
 
+#ifndef substeps_umat
+#define substeps_umat 1
+#endif
+
 #ifndef maxiter_micro
 #define maxiter_micro 100
 #endif
@@ -65,4 +69,8 @@ namespace smart {
 #define precision_micro 1E-6
 #endif
 
+#ifndef points_micro
+#define points_micro 0
+#endif
+
 } //end of namespace smart
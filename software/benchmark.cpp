@@ -0,0 +1,149 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file benchmark.cpp
+///@brief benchmark: micro-benchmarks of the per-increment kernels
+///@brief usage : benchmark [nphases] [niter] [nstatev]
+///@version 1.0
+
+#include <iostream>
+#include <string>
+#include <memory>
+#include <chrono>
+#include <armadillo>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Geometry/ellipsoid.hpp>
+#include <smartplus/Libraries/Homogenization/ellipsoid_multi.hpp>
+#include <smartplus/Libraries/Phase/state_variables_M.hpp>
+#include <smartplus/Libraries/Phase/phase_characteristics.hpp>
+#include <smartplus/Libraries/Maths/rotation.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace smart;
+
+typedef std::chrono::high_resolution_clock bench_clock;
+
+double elapsed(const bench_clock::time_point &t0) {
+    return std::chrono::duration<double>(bench_clock::now() - t0).count();
+}
+
+void report(const string &name, const double &t, const int &niter, const int &nphases) {
+    cout << name << "\t" << t << " s\t" << 1.E9*t/(double(niter)*double(nphases)) << " ns/phase\n";
+}
+
+int main(int argc, char* argv[]) {
+
+    int nphases = (argc > 1) ? atoi(argv[1]) : 64;
+    int niter = (argc > 2) ? atoi(argv[2]) : 100000;
+    int nstatev = (argc > 3) ? atoi(argv[3]) : 10;
+    double T_init = 273.15;
+
+    phase_characteristics rve;
+    rve.construct(0,1);
+    rve.sub_phases_construct(nphases, 2, 1);
+    for (auto &r : rve.sub_phases) {
+        r.sptr_sv_global->update(zeros(6), zeros(6), zeros(6), zeros(6), eye(3,3), eye(3,3), T_init, 0., nstatev, zeros(nstatev), zeros(nstatev));
+        r.sptr_sv_local->update(zeros(6), zeros(6), zeros(6), zeros(6), eye(3,3), eye(3,3), T_init, 0., nstatev, zeros(nstatev), zeros(nstatev));
+        r.sptr_shape->concentration = 1./double(nphases);
+        r.sptr_multi->A = eye(6,6);
+    }
+
+    cout << "benchmark : " << nphases << " phases, " << niter << " iterations, " << nstatev << " statev\n";
+    double sum = 0.;
+    bench_clock::time_point t0;
+
+    ///1 - Access to the derived types of the sub-phases, as done in the schemes at each iteration
+    t0 = bench_clock::now();
+    for (int n=0; n<niter; n++) {
+        for (auto &r : rve.sub_phases) {
+            std::shared_ptr<ellipsoid_multi> elli_multi = std::dynamic_pointer_cast<ellipsoid_multi>(r.sptr_multi);
+            std::shared_ptr<ellipsoid> elli = std::dynamic_pointer_cast<ellipsoid>(r.sptr_shape);
+            std::shared_ptr<state_variables_M> sv_r = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
+            sum += elli->concentration + sv_r->T + elli_multi->A(0,0);
+        }
+    }
+    report("dynamic_pointer_cast", elapsed(t0), niter, nphases);
+
+    t0 = bench_clock::now();
+    for (int n=0; n<niter; n++) {
+        for (auto &r : rve.sub_phases) {
+            ellipsoid_multi *elli_multi = r.multi<ellipsoid_multi>();
+            ellipsoid *elli = r.shape<ellipsoid>();
+            state_variables_M *sv_r = r.sv_global<state_variables_M>();
+            sum += elli->concentration + sv_r->T + elli_multi->A(0,0);
+        }
+    }
+    report("static access\t", elapsed(t0), niter, nphases);
+
+    ///2 - Start values of the sub-phases, as done at each increment : a commit, then the rollback of the first Newton iteration
+    t0 = bench_clock::now();
+    for (int n=0; n<niter; n++) {
+        for (auto &r : rve.sub_phases) {
+            r.set_start();
+            r.at_start = false;     //As before at_start : every rollback copies the start values
+            r.to_start();
+        }
+    }
+    report("set_start/to_start (copy)", elapsed(t0), niter, nphases);
+
+    t0 = bench_clock::now();
+    for (int n=0; n<niter; n++) {
+        for (auto &r : rve.sub_phases) {
+            r.set_start();
+            r.to_start();
+        }
+    }
+    report("set_start/to_start", elapsed(t0), niter, nphases);
+
+    ///3 - Rotation of a stiffness tensor to the orientations of the phases, one call per phase against one batch
+    int niter_rot = (niter/100 > 1) ? niter/100 : 1;
+    vec psi = 2.*pi*randu(nphases);
+    vec theta = pi*randu(nphases);
+    vec phi = 2.*pi*randu(nphases);
+    mat L = eye(6,6) + 0.1*ones(6,6);
+    
+    t0 = bench_clock::now();
+    for (int n=0; n<niter_rot; n++) {
+        for (int i=0; i<nphases; i++) {
+            mat L_loc = rotate_g2l_L(L, psi(i), theta(i), phi(i));
+            sum += L_loc(0,0);
+        }
+    }
+    report("rotate_g2l_L\t", elapsed(t0), niter_rot, nphases);
+    
+    t0 = bench_clock::now();
+    for (int n=0; n<niter_rot; n++) {
+        rotation_batch rb(psi, theta, phi);
+        cube L_loc = rb.rotate_g2l_L(L);
+        sum += L_loc(0,0,0);
+    }
+    report("rotation_batch\t", elapsed(t0), niter_rot, nphases);
+    
+    rotation_batch rb(psi, theta, phi);
+    t0 = bench_clock::now();
+    for (int n=0; n<niter_rot; n++) {
+        cube L_loc = rb.rotate_g2l_L(L);
+        sum += L_loc(0,0,0);
+    }
+    report("rotation_batch (reused)", elapsed(t0), niter_rot, nphases);
+
+    //Prevent the loops from being removed by the compiler
+    cout << "checksum : " << sum << "\n";
+
+    return 0;
+}
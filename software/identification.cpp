@@ -59,6 +59,9 @@ int main() {
     double c;	///Lagrange penalty parameters
     double p0;
 	double lambdaLM;
+    string optimizer;
+    double cma_sigma;
+    int nthreads;
     //Read the identification control
     
     string path_data = "data";
@@ -74,7 +77,7 @@ int main() {
     string simul_type = "SOLVE";
 
     ident_essentials(n_param, n_consts, nfiles, path_data, file_essentials);
-    ident_control(ngen, aleaspace, apop, spop, ngboys, maxpop, station_nb, probaMut, pertu, c, p0, lambdaLM, path_data, file_control);
-    run_identification(simul_type,n_param, n_consts, nfiles, ngen, aleaspace, apop, spop, ngboys, maxpop, station_nb, path_data, path_keys, path_results, materialfile, outputfile, simulfile, probaMut, pertu, c, p0, lambdaLM);
+    ident_control(ngen, aleaspace, apop, spop, ngboys, maxpop, station_nb, probaMut, pertu, c, p0, lambdaLM, optimizer, cma_sigma, nthreads, path_data, file_control);
+    run_identification(simul_type,n_param, n_consts, nfiles, ngen, aleaspace, apop, spop, ngboys, maxpop, station_nb, path_data, path_keys, path_results, materialfile, outputfile, simulfile, probaMut, pertu, c, p0, lambdaLM, optimizer, cma_sigma, nthreads);
 
 }
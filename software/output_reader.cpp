@@ -0,0 +1,68 @@
+/* This file is part of SMART+.
+ 
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file output_reader.cpp
+///@brief output_reader: converts a binary output file of the solver into text files, one per phase
+///@version 1.0
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <armadillo>
+#include <smartplus/Libraries/Solver/output_backend.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace smart;
+
+int main(int argc, char *argv[]) {
+    
+    string path_results = "results";
+    string inputfile = "results_job_global.bin";
+    
+    if (argc > 1)
+        inputfile = argv[1];
+    if (argc > 2)
+        path_results = argv[2];
+    
+    std::vector<std::string> names;
+    Col<int> phases;
+    mat data;
+    read_output_binary(names, phases, data, path_results, inputfile);
+    
+    if (names.size() == 0)
+        return 1;
+    
+    //The increment info (phase = -1) is written in front of each phase file
+    uvec info = find(phases < 0);
+    string filename = inputfile.substr(0,inputfile.length()-4); //to remove the extension
+    for (int p=0; p<=phases.max(); p++) {
+        uvec cols = join_cols(info, find(phases == p));
+        
+        ofstream of(path_results + "/" + filename + "-" + to_string(p) + ".txt");
+        for (unsigned int k=0; k<cols.n_elem; k++) {
+            of << names[cols(k)] << ((k+1 < cols.n_elem) ? "\t" : "\n");
+        }
+        for (unsigned int i=0; i<data.n_rows; i++) {
+            for (unsigned int k=0; k<cols.n_elem; k++) {
+                of << data(i, cols(k)) << ((k+1 < cols.n_elem) ? "\t" : "\n");
+            }
+        }
+    }
+    
+	return 0;
+}
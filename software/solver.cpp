@@ -28,6 +28,7 @@
 #include <armadillo>
 #include <smartplus/parameter.hpp>
 #include <smartplus/Umat/umat_smart.hpp>
+#include <smartplus/Umat/umat_registry.hpp>
 #include <smartplus/Libraries/Solver/read.hpp>
 #include <smartplus/Libraries/Solver/block.hpp>
 #include <smartplus/Libraries/Solver/step.hpp>
@@ -39,7 +40,7 @@ using namespace std;
 using namespace arma;
 using namespace smart;
 
-int main() {
+int main(int argc, char* argv[]) {
 
     string path_data = "data";
     string path_results = "results";
@@ -68,6 +69,11 @@ int main() {
     double precision_solver = 0.;
     double lambda_solver = 0.;
     
+    //User constitutive models : each argument is a shared library that registers its umats
+    for (int i=1; i<argc; i++) {
+        load_umat_plugin(argv[i]);
+    }
+    
     solver_essentials(solver_type, path_data, sol_essentials);
     solver_control(div_tnew_dt_solver, mul_tnew_dt_solver, miniter_solver, maxiter_solver, inforce_solver, precision_solver, lambda_solver, path_data, sol_control);
     
@@ -96,6 +96,7 @@ ellipsoid::ellipsoid(const ellipsoid& sv) : geometry(sv)
     psi_geom = sv.psi_geom;
     theta_geom = sv.theta_geom;
     phi_geom = sv.phi_geom;
+    Q_geom = sv.Q_geom;
 }
 
 /*!
@@ -108,6 +109,18 @@ ellipsoid::ellipsoid(const ellipsoid& sv) : geometry(sv)
 ellipsoid::~ellipsoid() {}
 //-------------------------------------
 
+/*!
+  \brief Returns the composed rotation matrices of the geometric orientation (psi_geom, theta_geom, phi_geom), composed again only if the angles have changed
+*/
+
+//-------------------------------------------------------------
+const euler_Q& ellipsoid::rotation() const
+//-------------------------------------------------------------
+{
+    Q_geom.set(psi_geom, theta_geom, phi_geom);
+    return Q_geom;
+}
+
 /*!
   \brief Standard operator = for ellipsoid_characteristics
 */
@@ -128,6 +141,7 @@ ellipsoid& ellipsoid::operator = (const ellipsoid& sv)
     psi_geom = sv.psi_geom;
     theta_geom = sv.theta_geom;
     phi_geom = sv.phi_geom;
+    Q_geom = sv.Q_geom;
     
 	return *this;
 }
@@ -84,6 +84,7 @@ layer::layer(const layer& sv) : geometry(sv)
     psi_geom = sv.psi_geom;
     theta_geom = sv.theta_geom;
     phi_geom = sv.phi_geom;    
+    Q_geom = sv.Q_geom;
 }
 
 /*!
@@ -96,6 +97,18 @@ layer::layer(const layer& sv) : geometry(sv)
 layer::~layer() {}
 //-------------------------------------
 
+/*!
+  \brief Returns the composed rotation matrices of the geometric orientation (psi_geom, theta_geom, phi_geom), composed again only if the angles have changed
+*/
+
+//-------------------------------------------------------------
+const euler_Q& layer::rotation() const
+//-------------------------------------------------------------
+{
+    Q_geom.set(psi_geom, theta_geom, phi_geom);
+    return Q_geom;
+}
+
 /*!
   \brief Standard operator = for layer
 */
@@ -113,6 +126,7 @@ layer& layer::operator = (const layer& sv)
     psi_geom = sv.psi_geom;
     theta_geom = sv.theta_geom;
     phi_geom = sv.phi_geom;    
+    Q_geom = sv.Q_geom;
     
 	return *this;
 }
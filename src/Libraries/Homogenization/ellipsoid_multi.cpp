@@ -36,12 +36,12 @@ using namespace arma;
 namespace smart{
 
 //Definition of the static variables
-int ellipsoid_multi::mp;
-int ellipsoid_multi::np;
-vec ellipsoid_multi::x;
-vec ellipsoid_multi::wx;
-vec ellipsoid_multi::y;
-vec ellipsoid_multi::wy;
+thread_local int ellipsoid_multi::mp = 0;
+thread_local int ellipsoid_multi::np = 0;
+thread_local vec ellipsoid_multi::x;
+thread_local vec ellipsoid_multi::wx;
+thread_local vec ellipsoid_multi::y;
+thread_local vec ellipsoid_multi::wy;
     
     
 //=====Private methods for ellipsoid_multi===================================
@@ -103,6 +103,30 @@ ellipsoid_multi::ellipsoid_multi(const ellipsoid_multi& pc) : phase_multi(pc), S
 ellipsoid_multi::~ellipsoid_multi() {}
 //-------------------------------------
 
+/*!
+  \brief Builds the static integration points x, wx, y, wy of the Eshelby tensors
+  \param mmp : number of points in the first direction (props of the material)
+  \param mnp : number of points in the second direction (props of the material)
+  \param max_points : bound of the numbers of points in each direction, e.g. for a cheap evaluation (tolerances::micro_points, 0 : no bound)
+*/
+
+//-------------------------------------
+void ellipsoid_multi::set_points(const int &mmp, const int &mnp, const int &max_points)
+//-------------------------------------
+{
+    mp = mmp;
+    np = mnp;
+    if ((max_points > 0)&&(mp > max_points))
+        mp = max_points;
+    if ((max_points > 0)&&(np > max_points))
+        np = max_points;
+    x.set_size(mp);
+    wx.set_size(mp);
+    y.set_size(np);
+    wy.set_size(np);
+    points(x, wx, y, wy, mp, np);
+}
+
 /*!
   \brief Standard operator = for phase_multi
 */
@@ -111,7 +135,7 @@ ellipsoid_multi::~ellipsoid_multi() {}
 void ellipsoid_multi::fillS_loc(const mat& Lt_m, const ellipsoid &ell)
 //-------------------------------------
 {
-    mat Ltm_local_geom = rotate_g2l_L(Lt_m, ell.psi_geom, ell.theta_geom, ell.phi_geom);
+    mat Ltm_local_geom = rotate_g2l_L(Lt_m, ell.rotation());
     S_loc = Eshelby(Ltm_local_geom, ell.a1, ell.a2, ell.a3, x, wx, y, wy, mp, np);
 }
     
@@ -119,7 +143,7 @@ void ellipsoid_multi::fillS_loc(const mat& Lt_m, const ellipsoid &ell)
 void ellipsoid_multi::fillP_loc(const mat& Lt_m, const ellipsoid &ell)
 //-------------------------------------
 {
-    mat Ltm_local_geom = rotate_g2l_L(Lt_m, ell.psi_geom, ell.theta_geom, ell.phi_geom);
+    mat Ltm_local_geom = rotate_g2l_L(Lt_m, ell.rotation());
     P_loc = T_II(Ltm_local_geom, ell.a1, ell.a2, ell.a3, x, wx, y, wy, mp, np);
 }
     
@@ -129,13 +153,13 @@ void ellipsoid_multi::fillT(const mat& Lt_m, const mat& Lt, const ellipsoid &ell
 //This method correspond to the classical Eshelby method
 //-------------------------------------
 {
-    mat Lt_m_local_geom = rotate_g2l_L(Lt_m, ell.psi_geom, ell.theta_geom, ell.phi_geom);
+    mat Lt_m_local_geom = rotate_g2l_L(Lt_m, ell.rotation());
     S_loc = Eshelby(Lt_m_local_geom, ell.a1, ell.a2, ell.a3, x, wx, y, wy, mp, np);
-    mat Lt_local_geom = rotate_g2l_L(Lt, ell.psi_geom, ell.theta_geom, ell.phi_geom);
+    mat Lt_local_geom = rotate_g2l_L(Lt, ell.rotation());
     
     T_loc = inv(eye(6,6) + S_loc*inv(Lt_m_local_geom)*(Lt_local_geom - Lt_m_local_geom));
     
-    T = rotate_l2g_A(T_loc, ell.psi_geom, ell.theta_geom, ell.phi_geom);
+    T = rotate_l2g_A(T_loc, ell.rotation());
 }
 
 //-------------------------------------
@@ -145,11 +169,11 @@ void ellipsoid_multi::fillT_iso(const mat& Lt_m, const mat& Lt, const ellipsoid
 {
     mat Lt_m_iso = Isotropize(Lt_m);
     S_loc = Eshelby(Lt_m_iso, ell.a1, ell.a2, ell.a3, x, wx, y, wy, mp, np);
-    mat Lt_local_geom = rotate_g2l_L(Lt, ell.psi_geom, ell.theta_geom, ell.phi_geom);
+    mat Lt_local_geom = rotate_g2l_L(Lt, ell.rotation());
     
     T_loc = inv(eye(6,6) + S_loc*inv(Lt_m_iso)*(Lt_local_geom - Lt_m_iso));
     
-    T = rotate_l2g_A(T_loc, ell.psi_geom, ell.theta_geom, ell.phi_geom);
+    T = rotate_l2g_A(T_loc, ell.rotation());
 }
 
 //-------------------------------------
@@ -158,15 +182,15 @@ void ellipsoid_multi::fillT_mec_in(const mat& L_m, const mat& L, const ellipsoid
 //the interaction tensors T for the elastic and the inelastic part.
 //-------------------------------------
 {
-    mat L_m_local_geom = rotate_g2l_L(L_m, ell.psi_geom, ell.theta_geom, ell.phi_geom);
+    mat L_m_local_geom = rotate_g2l_L(L_m, ell.rotation());
     S_loc = Eshelby(L_m_local_geom, ell.a1, ell.a2, ell.a3, x, wx, y, wy, mp, np);
-    mat L_local_geom = rotate_g2l_L(L, ell.psi_geom, ell.theta_geom, ell.phi_geom);
+    mat L_local_geom = rotate_g2l_L(L, ell.rotation());
     
     T_loc = inv(eye(6,6) + S_loc*inv(L_m_local_geom)*(L_local_geom - L_m_local_geom));
-    T = rotate_l2g_A(T_loc, ell.psi_geom, ell.theta_geom, ell.phi_geom);
+    T = rotate_l2g_A(T_loc, ell.rotation());
     
     T_in_loc = (eye(6,6)-T_loc)*inv(L_m_local_geom - L_local_geom);
-    T_in = rotate_l2g_M(T_in_loc, ell.psi_geom, ell.theta_geom, ell.phi_geom);
+    T_in = rotate_l2g_M(T_in_loc, ell.rotation());
 }
     
 //----------------------------------------------------------------------
@@ -0,0 +1,333 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file cmaes.cpp
+///@brief Covariance matrix adaptation evolution strategy (CMA-ES), to sample the offsprings of a generation
+///@version 1.0
+
+#include <iostream>
+#include <assert.h>
+#include <math.h>
+#include <armadillo>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Maths/random.hpp>
+#include <smartplus/Libraries/Identification/parameters.hpp>
+#include <smartplus/Libraries/Identification/generation.hpp>
+#include <smartplus/Libraries/Identification/cmaes.hpp>
+
+using namespace std;
+using namespace arma;
+
+namespace smart{
+
+//Standard normal random number (Box-Muller), from the same generator as alead
+static double gaussian()
+{
+    double u1 = alead(0.,1.);
+    while (u1 <= 0.)
+        u1 = alead(0.,1.);
+    double u2 = alead(0.,1.);
+    return sqrt(-2.*log(u1))*cos(2.*pi*u2);
+}
+
+//=====Private methods for cmaes===================================
+
+//-------------------------------------------------------------
+void cmaes::decompose()
+//-------------------------------------------------------------
+{
+    C = symmatu(C);
+    vec eigval;
+    eig_sym(eigval, B, C);
+    D = zeros(n);
+    for (int i=0; i<n; i++) {
+        D(i) = (eigval(i) > 1.E-20) ? sqrt(eigval(i)) : 1.E-10;
+    }
+}
+
+//=====Public methods for cmaes============================================
+
+/*!
+  \brief default constructor
+  The parameters are normalized by their bounds : the distribution is sampled in [0,1]^n, and the individuals outside are sampled again
+  (nresample times at most) before they are projected on the bounds. The learning rates are the default ones of Hansen's tutorial
+*/
+
+//-------------------------------------------------------------
+cmaes::cmaes()
+//-------------------------------------------------------------
+{
+    n = 0;
+    lambda = 0;
+    mu = 0;
+    mueff = 0.;
+    cc = 0.;
+    cs = 0.;
+    c1 = 0.;
+    cmu = 0.;
+    damps = 0.;
+    chiN = 0.;
+    sigma0 = 0.3;
+    sigma = 0.3;
+    niter = 0;
+    nresample = 10;
+}
+
+/*!
+  \brief Constructor with parameters
+  \param params : the parameters, with their bounds
+  \param mlambda : number of individuals sampled (at least 2)
+  \param msigma0 : initial step size, relative to the bounds
+*/
+
+//-------------------------------------------------------------
+cmaes::cmaes(const std::vector<parameters> &params, const int &mlambda, const double &msigma0)
+//-------------------------------------------------------------
+{
+    assert(params.size() > 0);
+    assert(mlambda > 1);
+    assert(msigma0 > 0.);
+
+    n = params.size();
+    lambda = mlambda;
+    mu = lambda/2;
+    sigma0 = msigma0;
+    nresample = 10;
+
+    lower = zeros(n);
+    upper = zeros(n);
+    for (int i=0; i<n; i++) {
+        lower(i) = params[i].min_value;
+        upper(i) = params[i].max_value;
+    }
+
+    weights = zeros(mu);
+    for (int i=0; i<mu; i++) {
+        weights(i) = log(mu+0.5) - log(i+1.);
+    }
+    weights /= sum(weights);
+    mueff = 1./sum(weights%weights);
+
+    cc = (4.+mueff/n)/(n+4.+2.*mueff/n);
+    cs = (mueff+2.)/(n+mueff+5.);
+    c1 = 2./((n+1.3)*(n+1.3)+mueff);
+    cmu = 2.*(mueff-2.+1./mueff)/((n+2.)*(n+2.)+mueff);
+    if (cmu > 1.-c1)
+        cmu = 1.-c1;
+    damps = 1.+cs;
+    if (sqrt((mueff-1.)/(n+1.)) > 1.)
+        damps += 2.*(sqrt((mueff-1.)/(n+1.))-1.);
+    chiN = sqrt(double(n))*(1.-1./(4.*n)+1./(21.*n*n));
+
+    init(0.5*(lower+upper));
+}
+
+/*!
+  \brief Copy constructor
+  \param cma cmaes object to duplicate
+*/
+
+//------------------------------------------------------
+cmaes::cmaes(const cmaes& cma)
+//------------------------------------------------------
+{
+    lower = cma.lower;
+    upper = cma.upper;
+    X = cma.X;
+
+    n = cma.n;
+    lambda = cma.lambda;
+    mu = cma.mu;
+    weights = cma.weights;
+    mueff = cma.mueff;
+    cc = cma.cc;
+    cs = cma.cs;
+    c1 = cma.c1;
+    cmu = cma.cmu;
+    damps = cma.damps;
+    chiN = cma.chiN;
+
+    sigma0 = cma.sigma0;
+    mean = cma.mean;
+    sigma = cma.sigma;
+    C = cma.C;
+    B = cma.B;
+    D = cma.D;
+    pc = cma.pc;
+    ps = cma.ps;
+    niter = cma.niter;
+    nresample = cma.nresample;
+}
+
+/*!
+  \brief destructor
+*/
+cmaes::~cmaes() {}
+
+/*!
+  \brief Starts the distribution at a set of parameters (e.g. the best individual of the first generation), with the initial step size
+  \param p : values of the parameters
+*/
+
+//-------------------------------------------------------------
+void cmaes::init(const vec &p)
+//-------------------------------------------------------------
+{
+    assert(int(p.n_elem) == n);
+
+    mean = 0.5*ones(n);
+    for (int i=0; i<n; i++) {
+        if (upper(i) > lower(i))
+            mean(i) = (p(i)-lower(i))/(upper(i)-lower(i));
+    }
+    mean = clamp(mean, 0., 1.);
+    sigma = sigma0;
+    C = eye(n,n);
+    B = eye(n,n);
+    D = ones(n);
+    pc = zeros(n);
+    ps = zeros(n);
+    niter = 0;
+}
+
+/*!
+  \brief Samples the individuals of a generation, which get new ids
+  \param gensons : the generation, of lambda individuals
+  \param idnumber : the next id
+*/
+
+//-------------------------------------------------------------
+void cmaes::sample(generation &gensons, int &idnumber)
+//-------------------------------------------------------------
+{
+    assert(gensons.size() == lambda);
+
+    X = zeros(n, lambda);
+    vec z = zeros(n);
+    vec x = zeros(n);
+    gensons.newid(idnumber);
+    for (int i=0; i<lambda; i++) {
+        for (int k=0; k<nresample; k++) {
+            for (int j=0; j<n; j++)
+                z(j) = gaussian();
+            x = mean + sigma*(B*(D%z));
+            if ((x.min() >= 0.)&&(x.max() <= 1.))
+                break;
+        }
+        X.col(i) = clamp(x, 0., 1.);
+        gensons.pop[i].p = lower + X.col(i)%(upper-lower);
+    }
+}
+
+/*!
+  \brief Updates the mean, the evolution paths, the covariance matrix and the step size with the ranking of the generation sampled last
+  \param gensons : the generation sampled last, with the costs of its individuals (an individual without cost is ranked last)
+*/
+
+//-------------------------------------------------------------
+void cmaes::update(const generation &gensons)
+//-------------------------------------------------------------
+{
+    assert(gensons.size() == lambda);
+    assert(int(X.n_cols) == lambda);
+
+    vec costs = zeros(lambda);
+    for (int i=0; i<lambda; i++) {
+        costs(i) = (std::isnan(gensons.pop[i].cout)) ? datum::inf : gensons.pop[i].cout;
+    }
+    uvec order = sort_index(costs);
+
+    //Mean of the mu best individuals
+    vec mean_old = mean;
+    mean = zeros(n);
+    for (int i=0; i<mu; i++) {
+        mean += weights(i)*X.col(order(i));
+    }
+    vec y_w = (mean - mean_old)/sigma;
+
+    //Evolution paths
+    niter++;
+    mat invsqrtC = B*diagmat(1./D)*B.t();
+    ps = (1.-cs)*ps + sqrt(cs*(2.-cs)*mueff)*(invsqrtC*y_w);
+    double hsig = (norm(ps,2)/sqrt(1.-pow(1.-cs, 2.*niter))/chiN < 1.4+2./(n+1.)) ? 1. : 0.;
+    pc = (1.-cc)*pc + hsig*sqrt(cc*(2.-cc)*mueff)*y_w;
+
+    //Covariance matrix : rank-one and rank-mu updates
+    mat Y = zeros(n, mu);
+    for (int i=0; i<mu; i++) {
+        Y.col(i) = (X.col(order(i)) - mean_old)/sigma;
+    }
+    C = (1.-c1-cmu)*C + c1*(pc*pc.t() + (1.-hsig)*cc*(2.-cc)*C) + cmu*Y*diagmat(weights)*Y.t();
+
+    //Step size
+    sigma *= exp((cs/damps)*(norm(ps,2)/chiN - 1.));
+
+    decompose();
+}
+
+/*!
+  \brief Standard operator = for cmaes
+*/
+
+//----------------------------------------------------------------------
+cmaes& cmaes::operator = (const cmaes& cma)
+//----------------------------------------------------------------------
+{
+    lower = cma.lower;
+    upper = cma.upper;
+    X = cma.X;
+
+    n = cma.n;
+    lambda = cma.lambda;
+    mu = cma.mu;
+    weights = cma.weights;
+    mueff = cma.mueff;
+    cc = cma.cc;
+    cs = cma.cs;
+    c1 = cma.c1;
+    cmu = cma.cmu;
+    damps = cma.damps;
+    chiN = cma.chiN;
+
+    sigma0 = cma.sigma0;
+    mean = cma.mean;
+    sigma = cma.sigma;
+    C = cma.C;
+    B = cma.B;
+    D = cma.D;
+    pc = cma.pc;
+    ps = cma.ps;
+    niter = cma.niter;
+    nresample = cma.nresample;
+
+    return *this;
+}
+
+//--------------------------------------------------------------------------
+ostream& operator << (ostream& s, const cmaes& cma)
+//--------------------------------------------------------------------------
+{
+    s << "Display info on the CMA-ES:\n";
+    s << "n = " << cma.n << "\t lambda = " << cma.lambda << "\t mu = " << cma.mu << "\n";
+    s << "iterations = " << cma.niter << "\t sigma = " << cma.sigma << "\n";
+    s << "mean = " << cma.mean.t();
+    s << "\n";
+
+    return s;
+}
+
+} //namespace smart
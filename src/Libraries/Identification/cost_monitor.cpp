@@ -0,0 +1,126 @@
+/* This file is part of SMART+.
+ 
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file cost_monitor.cpp
+///@brief Cost function of an individual accumulated during its simulations, to stop the hopeless ones
+///@version 1.0
+
+#include <iostream>
+#include <assert.h>
+#include <math.h>
+#include <armadillo>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Identification/cost_monitor.hpp>
+
+using namespace std;
+using namespace arma;
+
+namespace smart{
+
+///@brief default constructor
+//-------------------------------------------------------------
+cost_monitor::cost_monitor() : output_monitor()
+//-------------------------------------------------------------
+{
+    nrecords = 0;
+    file = 0;
+    cost = 0.;
+    bound = 0.;
+}
+
+/*!
+  \brief Constructor with parameters
+  \param W : weights of the data (calcW), in the order of calcV
+  \param data_num : numerical data files, for the columns and the skipped lines
+  \param data_exp : experimental data files
+  \param nfiles : number of files
+  The rows of the numerical file i are the global records of the RVE written by the solver, so that the column c_data of the file is the field c_data of the record
+*/
+//-------------------------------------------------------------
+cost_monitor::cost_monitor(const vec &W, const std::vector<opti_data> &data_num, const std::vector<opti_data> &mdata_exp, const int &nfiles) : output_monitor()
+//-------------------------------------------------------------
+{
+    data_exp.resize(nfiles);
+    weights.resize(nfiles);
+    c_data.resize(nfiles);
+    skiplines = zeros<Col<int> >(nfiles);
+    
+    int z = 0;
+    for (int i=0; i<nfiles; i++) {
+        int ndata = mdata_exp[i].ndata;
+        int ninfo = mdata_exp[i].ninfo;
+        data_exp[i] = mdata_exp[i].data;
+        weights[i] = zeros(ndata, ninfo);
+        if (ndata*ninfo > 0)
+            weights[i] = reshape(W.subvec(z, z+ndata*ninfo-1), ndata, ninfo);
+        c_data[i] = data_num[i].c_data;
+        skiplines(i) = data_num[i].skiplines;
+        z += ndata*ninfo;
+    }
+    assert(z == int(W.n_elem));
+    
+    nrecords = 0;
+    file = 0;
+    cost = 0.;
+    bound = 0.;
+}
+
+//-------------------------------------
+cost_monitor::~cost_monitor() {}
+//-------------------------------------
+
+//-------------------------------------------------------------
+void cost_monitor::reset(const double &mbound)
+//-------------------------------------------------------------
+{
+    cost = 0.;
+    bound = mbound;
+    begin(0);
+}
+
+//-------------------------------------------------------------
+void cost_monitor::begin(const int &mfile)
+//-------------------------------------------------------------
+{
+    assert(mfile < int(data_exp.size()));
+    file = mfile;
+    nrecords = 0;
+    stopped = false;
+}
+
+/*!
+  \brief Adds the contribution of a record to the cost : the terms of calcC for the corresponding row of the experimental file.
+  The records beyond the experimental data are not accounted for
+*/
+//-------------------------------------------------------------
+bool cost_monitor::check(const vec &mrecord)
+//-------------------------------------------------------------
+{
+    int a = nrecords - skiplines(file);
+    nrecords++;
+    
+    if ((a >= 0)&&(a < int(data_exp[file].n_rows))) {
+        for (unsigned int l=0; l<data_exp[file].n_cols; l++) {
+            if ((weights[file](a,l) > iota)&&(c_data[file](l) < int(mrecord.n_elem))) {
+                cost += pow(data_exp[file](a,l) - mrecord(c_data[file](l)), 2.)*weights[file](a,l);
+            }
+        }
+    }
+    return ((bound <= 0.)||(cost <= bound));
+}
+    
+} //namespace smart
@@ -25,6 +25,8 @@
 #include <math.h>
 #include <armadillo>
 #include <algorithm>
+#include <thread>
+#include <atomic>
 
 #include <boost/filesystem.hpp>
 
@@ -40,13 +42,171 @@
 #include <smartplus/Libraries/Identification/doe.hpp>
 #include <smartplus/Libraries/Identification/read.hpp>
 #include <smartplus/Libraries/Identification/script.hpp>
+#include <smartplus/Libraries/Identification/cost_monitor.hpp>
+#include <smartplus/Libraries/Identification/cmaes.hpp>
+#include <smartplus/Libraries/Solver/simulation_tree.hpp>
 
 using namespace std;
 using namespace arma;
 
 namespace smart{
+
+//Bound of the cost of the offsprings : above the worst cost of the population, an offspring cannot be retained
+static double abort_bound(const generation &gen_cur, const int &worst, const double &bound)
+{
+    double bound_pop = 0.;
+    if (worst) {
+        for (int i=0; i<gen_cur.size(); i++) {
+            if (std::isnan(gen_cur.pop[i].cout))
+                return bound;   //An offspring with a cost replaces the individual without one
+            if (gen_cur.pop[i].cout > bound_pop)
+                bound_pop = gen_cur.pop[i].cout;
+        }
+    }
+    if ((bound_pop > 0.)&&((bound <= 0.)||(bound_pop < bound)))
+        return bound_pop;
+    return bound;
+}
+
+//Cost of an individual : the one of its simulations, at least the cost that stopped them
+static double monitored_cost(const vec &vexp, vec &vnum, const vec &W, const vector<opti_data> &data_num, const vector<opti_data> &data_exp, const int &nfiles, const int &sizev, const cost_monitor &monitor)
+{
+    double cost = calc_cost(vexp, vnum, W, data_num, data_exp, nfiles, sizev);
+    if ((monitor.stopped)&&(monitor.cost > cost))
+        cost = monitor.cost;
+    return cost;
+}
+
+//Scratch space of a thread that simulates individuals : its copy of path_data (where the keys are replaced), its folder of numerical data,
+//its parameters, its cost monitor and its simulation tree, so that the individuals of a population can be simulated at the same time
+struct ident_worker
+{
+    string path_data;
+    string folder;
+    vector<parameters> params;
+    vector<constants> consts;
+    vector<opti_data> data_num;
+    vec vnum;
+    std::shared_ptr<cost_monitor> monitor;
+    simulation_tree tree;
+    int nstopped;
+};
+
+//Copies the files of a folder, and of its subfolders, in another one
+static void copy_folder(const boost::filesystem::path &src, const boost::filesystem::path &dst)
+{
+    boost::filesystem::create_directories(dst);
+    for (boost::filesystem::directory_iterator end_dir_it, it(src); it!=end_dir_it; ++it) {
+        if (boost::filesystem::is_directory(it->path()))
+            copy_folder(it->path(), dst / it->path().filename());
+        else
+            boost::filesystem::copy_file(it->path(), dst / it->path().filename(), boost::filesystem::copy_option::overwrite_if_exists);
+    }
+}
+
+//Workers of the populations : a single one works in path_data and data_num_folder, as the other simulations of the identification.
+//Otherwise each one works in its own folder, data_num_folder_<w>, with a copy of path_data
+static void build_workers(vector<ident_worker> &workers, const int &nworkers, const vector<parameters> &params, const vector<constants> &consts, const vector<opti_data> &data_num, const int &sizev, const std::shared_ptr<cost_monitor> &monitor, const string &path_data, const string &data_num_folder)
+{
+    workers.resize(nworkers);
+    for (int w=0; w<nworkers; w++) {
+        if (nworkers == 1) {
+            workers[w].path_data = path_data;
+            workers[w].folder = data_num_folder;
+        }
+        else {
+            string root = data_num_folder + "_" + to_string(w);
+            workers[w].path_data = root + "/data";
+            workers[w].folder = root + "/num_data";
+            boost::filesystem::remove_all(root);
+            copy_folder(path_data, workers[w].path_data);
+            boost::filesystem::create_directories(workers[w].folder);
+        }
+        workers[w].params = params;
+        workers[w].consts = consts;
+        workers[w].data_num = data_num;
+        workers[w].vnum = zeros(sizev);
+        if (monitor)
+            workers[w].monitor = std::make_shared<cost_monitor>(*monitor);
+        workers[w].nstopped = 0;
+    }
+}
+
+//Simulations and costs of the individuals of a population, distributed over the workers (one thread each). The simulations of an individual
+//stop once its cost exceeds the bound (with a cost monitor)
+static void evaluate_population(generation &gen_cur, vector<ident_worker> &workers, const double &bound, const bool &screening, const std::string &simul_type, const int &nfiles, const vector<opti_data> &data_exp, const string &data_num_name, const string &path_keys, const string &materialfile, const string &controlfile, const vec &vexp, const vec &W, const int &sizev)
+{
+    std::atomic<int> next(0);
+    auto work = [&](ident_worker &wk) {
+        for (int i=next++; i<gen_cur.size(); i=next++) {
+            if (wk.monitor)
+                wk.monitor->reset(bound);
+            run_simulation(simul_type, gen_cur.pop[i], nfiles, wk.params, wk.consts, wk.data_num, wk.folder, data_num_name, wk.path_data, path_keys, materialfile, wk.monitor, controlfile, NULL, &wk.tree);
+            gen_cur.pop[i].screened = screening;
+            
+            //Calculation of the cost function
+            if (wk.monitor) {
+                gen_cur.pop[i].cout = monitored_cost(vexp, wk.vnum, W, wk.data_num, data_exp, nfiles, sizev, *wk.monitor);
+                wk.nstopped += (wk.monitor->stopped) ? 1 : 0;
+            }
+            else
+                gen_cur.pop[i].cout = calc_cost(vexp, wk.vnum, W, wk.data_num, data_exp, nfiles, sizev);
+        }
+    };
+    
+    if (workers.size() == 1) {
+        work(workers[0]);
+        return;
+    }
+    vector<std::thread> threads;
+    for (unsigned int w=0; w<workers.size(); w++)
+        threads.push_back(std::thread(work, std::ref(workers[w])));
+    for (unsigned int w=0; w<threads.size(); w++)
+        threads[w].join();
+}
+
+//Multi-fidelity : the screened individuals among the ntop first ones of a classified generation are evaluated again with the full solver controls,
+//until the ntop first ones all have a full cost. The screened and full costs are written in the fidelity file
+static void confirm_best(generation &gen_cur, const int &ntop, const int &g, const std::string &simul_type, const int &nfiles, vector<parameters> &params, vector<constants> &consts, vector<opti_data> &data_num, const vector<opti_data> &data_exp, const string &data_num_folder, const string &data_num_name, const string &path_data, const string &path_keys, const string &materialfile, const vec &vexp, vec &vnum, const vec &W, const int &sizev, const string &fidelityfile)
+{
+    int nconfirmed = 0;
+    double sum_discrepancy = 0.;
+    double max_discrepancy = 0.;
+    ofstream fidelity(fidelityfile, ios::out | ios::app);
+    
+    bool confirmed = true;
+    while (confirmed) {
+        confirmed = false;
+        for (int i=0; (i<ntop)&&(i<gen_cur.size()); i++) {
+            if (!gen_cur.pop[i].screened)
+                continue;
+            double cost_screen = gen_cur.pop[i].cout;
+            run_simulation(simul_type, gen_cur.pop[i], nfiles, params, consts, data_num, data_num_folder, data_num_name, path_data, path_keys, materialfile);
+            gen_cur.pop[i].cout = calc_cost(vexp, vnum, W, data_num, data_exp, nfiles, sizev);
+            gen_cur.pop[i].screened = false;
+            
+            double discrepancy = 0.;
+            if (fabs(gen_cur.pop[i].cout) > 0.)
+                discrepancy = fabs(gen_cur.pop[i].cout - cost_screen)/fabs(gen_cur.pop[i].cout);
+            if (!std::isnan(discrepancy)) {
+                nconfirmed++;
+                sum_discrepancy += discrepancy;
+                if (discrepancy > max_discrepancy)
+                    max_discrepancy = discrepancy;
+            }
+            fidelity << g << "\t" << gen_cur.pop[i].id << "\t" << cost_screen << "\t" << gen_cur.pop[i].cout << "\t" << discrepancy << "\n";
+            confirmed = true;
+        }
+        if (confirmed)
+            gen_cur.classify();
+    }
+    fidelity.close();
+    
+    if (nconfirmed > 0)
+        cout << "Screened costs confirmed : " << nconfirmed << ", relative discrepancy (mean, max) = " << sum_discrepancy/nconfirmed << ", " << max_discrepancy << "\n";
+}
         
-void run_identification(const std::string &simul_type, const int &n_param, const int &n_consts, const int &nfiles, const int &ngen, const int &aleaspace, int &apop, int &spop, const int &ngboys, const int &maxpop, const int &stationnarity_nb, const std::string &path_data, const std::string &path_keys, const std::string &path_results, const std::string &materialfile, const std::string &outputfile, const std::string &data_num_name, const double &probaMut, const double &pertu, const double &c, const double &p0, const double &lambdaLM) {
+void run_identification(const std::string &simul_type, const int &n_param, const int &n_consts, const int &nfiles, const int &ngen, const int &aleaspace, int &apop, int &spop, const int &ngboys, const int &maxpop, const int &stationnarity_nb, const std::string &path_data, const std::string &path_keys, const std::string &path_results, const std::string &materialfile, const std::string &outputfile, const std::string &data_num_name, const double &probaMut, const double &pertu, const double &c, const double &p0, const double &lambdaLM, const std::string &optimizer, const double &cma_sigma, const int &nthreads) {
 
     std::string data_num_ext = data_num_name.substr(data_num_name.length()-4,data_num_name.length());
     std::string data_num_name_root = data_num_name.substr(0,data_num_name.length()-4); //to remove the extension
@@ -136,6 +296,49 @@ void run_identification(const std::string &simul_type, const int &n_param, const
     read_data_num(nfiles, data_exp, data_num);
     vec vnum = zeros(sizev);   //num vector
     
+    //Early abort of the simulations (solver only) : the cost is accumulated during the simulations of an individual, which stop
+    //once it exceeds the worst cost of the population and/or a fixed bound (see ident_abort.inp)
+    int abort_worst = 0;
+    double abort_bound_fixed = 0.;
+    read_early_abort(abort_worst, abort_bound_fixed, path_data);
+    std::shared_ptr<cost_monitor> monitor;
+    if ((simul_type == "SOLVE")&&((abort_worst)||(abort_bound_fixed > 0.)))
+        monitor = std::make_shared<cost_monitor>(W, data_num, data_exp, nfiles);
+    
+    //Multi-fidelity evaluation : the individuals are screened with cheaper solver controls (see ident_fidelity.inp), and the best ones
+    //(at least the gboys) are evaluated again with the full ones. The discrepancy between both costs is written in fidelity.txt
+    string screenfile;
+    int screen_top = 0;
+    read_fidelity(screenfile, screen_top, path_data);
+    bool screening = ((simul_type == "SOLVE")&&(screenfile != ""));
+    string controlfile = (screening) ? screenfile : "solver_control.inp";
+    int ntop = std::max(std::max(screen_top, ngboys), 1);
+    string fidelityfile = path_results + "/fidelity.txt";
+    if (screening) {
+        ofstream fidelity(fidelityfile, ios::out);
+        fidelity << "g" << "\t" << "nindividual" << "\t" << "cost_screen" << "\t" << "cost" << "\t" << "discrepancy" << "\n";
+        fidelity.close();
+    }
+    
+    //Forward sensitivities of the gboys (solver only) : the derivatives with respect to the parameters that are props of the material
+    //are integrated along one simulation, instead of one simulation per parameter (see ident_sensi.inp)
+    int forward_sensi = 0;
+    double delta_sensi = 1.E-6;
+    read_forward_sensi(forward_sensi, delta_sensi, path_data);
+    
+    //Optimizer of the offsprings : the genetic algorithm, or the CMA-ES (see ident_control.inp), whose distribution starts at the best individual
+    //of the first generation and is updated with the ranking of each population it samples
+    bool cma = (optimizer == "cmaes");
+    if ((!cma)&&(optimizer != "genetic")) {
+        cout << "Error: The optimizer " << optimizer << " is unknown (genetic or cmaes)\n";
+        exit(0);
+    }
+    if ((cma)&&(maxpop < 2)) {
+        cout << "Error: The CMA-ES requires a population of at least 2 individuals\n";
+        exit(0);
+    }
+    cmaes cma_es;
+    
     //Data structure has been created. Next is the generation of structures to compute cost function and associated derivatives
     mat S(sizev,n_param);
     Col<int> pb_col;
@@ -171,20 +374,29 @@ void run_identification(const std::string &simul_type, const int &n_param, const
         boost::filesystem::create_directory(data_num_folder);
     }
         
+    //The individuals of a population are simulated at the same time, by nworkers threads (see ident_control.inp).
+    //hardware_concurrency() may return 0 if the number of hardware threads is not known : at least one worker is used
+    int nworkers = nthreads;
+    if (nworkers <= 0)
+        nworkers = std::thread::hardware_concurrency();
+    if (nworkers > std::max(geninit.size(), maxpop))
+        nworkers = std::max(geninit.size(), maxpop);
+    if (nworkers < 1)
+        nworkers = 1;
+    vector<ident_worker> workers;
+    build_workers(workers, nworkers, params, consts, data_num, sizev, monitor, path_data, data_num_folder);
+    
     /// Run the simulations corresponding to each individual
     /// The simulation input files should be ready!
-    for(int i=0; i<geninit.size(); i++) {
-        run_simulation(simul_type, geninit.pop[i], nfiles, params, consts, data_num, data_num_folder, data_num_name, path_data, path_keys, materialfile);
-        
-        //Calculation of the cost function
-        geninit.pop[i].cout = calc_cost(vexp, vnum, W, data_num, data_exp, nfiles, sizev);
-    }
+    evaluate_population(geninit, workers, abort_bound_fixed, screening, simul_type, nfiles, data_exp, data_num_name, path_keys, materialfile, controlfile, vexp, W, sizev);
     
     //Classification of bests
     for(int i=0; i<maxpop; i++) {
         gen[0].pop[i]=geninit.pop[i];
     }
     gen[0].classify();
+    if (screening)
+        confirm_best(gen[0], ntop, 0, simul_type, nfiles, params, consts, data_num, data_exp, data_num_folder, data_num_name, path_data, path_keys, materialfile, vexp, vnum, W, sizev, fidelityfile);
 
     result.open(outputfile,  ios::out | ios::app);
     for(int i=0; i<maxpop; i++) {
@@ -200,6 +412,11 @@ void run_identification(const std::string &simul_type, const int &n_param, const
     result.close();
 
     cout << "\nCost function (Best set of parameters)  = " << gen[0].pop[0].cout << "\n";
+    
+    if (cma) {
+        cma_es = cmaes(params, maxpop, cma_sigma);
+        cma_es.init(gen[0].pop[0].p);
+    }
 
     ///Next step : Classify the best one, and compute the next generation!
     // Here we can choose the type of optimizer we want
@@ -233,21 +450,22 @@ void run_identification(const std::string &simul_type, const int &n_param, const
         /// The simulation input files should be ready!
         if (maxpop > 1) {
             
-            genetic(gen[g], gensons, idnumber, probaMut, pertu, params);
+            if (cma)
+                cma_es.sample(gensons, idnumber);
+            else
+                genetic(gen[g], gensons, idnumber, probaMut, pertu, params);
             ///prepare the individuals to run
             
-            for(int i=0; i<gensons.size(); i++) {
-                run_simulation(simul_type, gensons.pop[i], nfiles, params, consts, data_num, data_num_folder, data_num_name, path_data, path_keys, materialfile);
-                //Calculation of the cost function
-                gensons.pop[i].cout = calc_cost(vexp, vnum, W, data_num, data_exp, nfiles, sizev);
-            }
-            
+            double bound_sons = abort_bound(gen[g], abort_worst, abort_bound_fixed);
+            evaluate_population(gensons, workers, bound_sons, screening, simul_type, nfiles, data_exp, data_num_name, path_keys, materialfile, controlfile, vexp, W, sizev);
+            if (cma)
+                cma_es.update(gensons);
         }
         for (int i=0; i<ngboys; i++) {
             
             cost_gb_cost_n[i] = gen[g].pop[i].cout;
             
-            S = calc_sensi(gboys[g].pop[i], n_gboys, simul_type, nfiles, n_param, params, consts, vnum, data_num, data_exp, data_num_folder, data_num_name, path_data, path_keys, sizev, Dp_gb_n[i], materialfile);
+            S = calc_sensi(gboys[g].pop[i], n_gboys, simul_type, nfiles, n_param, params, consts, vnum, data_num, data_exp, data_num_folder, data_num_name, path_data, path_keys, sizev, Dp_gb_n[i], materialfile, forward_sensi, delta_sensi);
             gboys[g].pop[i].cout = calcC(vexp, vnum, W);
             p = gboys[g].pop[i].p;
             ///Compute the parameters increment
@@ -279,6 +497,12 @@ void run_identification(const std::string &simul_type, const int &n_param, const
         ///Find the bests
         g++;
         find_best(gen[g], gboys[g], gen[g-1], gboys[g-1], gensons, maxpop, n_param, id0);
+        if (screening) {
+            confirm_best(gen[g], ntop, g, simul_type, nfiles, params, consts, data_num, data_exp, data_num_folder, data_num_name, path_data, path_keys, materialfile, vexp, vnum, W, sizev, fidelityfile);
+            for(int i=0; i<gboys[g].size(); i++) {
+                gboys[g].pop[i] = gen[g].pop[i];
+            }
+        }
         write_results(result, outputfile, gen[g], g, maxpop, n_param);
         
         if(fabs(costnm1 - gen[g].pop[0].cout) < stationnarity) {
@@ -288,6 +512,12 @@ void run_identification(const std::string &simul_type, const int &n_param, const
             compt_des = 0;
         
         cout << "Cost function (Best set of parameters) = " << gen[g].pop[0].cout << "\n";
+        if (monitor) {
+            int nstopped = 0;
+            for (unsigned int w=0; w<workers.size(); w++)
+                nstopped += workers[w].nstopped;
+            cout << "Simulations stopped early : " << nstopped << "\n";
+        }
         
         //Replace the parameters
         for (unsigned int k=0; k<params.size(); k++) {
@@ -307,6 +537,9 @@ void run_identification(const std::string &simul_type, const int &n_param, const
         apply_parameters(params, path_results);
     }
     
+    //Remove the folders of the workers
+    for (int w=0; (nworkers > 1)&&(w<nworkers); w++)
+        boost::filesystem::remove_all(data_num_folder + "_" + to_string(w));
 }
 
 } //namespace smart
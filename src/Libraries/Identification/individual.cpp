@@ -42,6 +42,7 @@ individual::individual()
 	id = 0;
 	rank=0;
 	lambda=0.;
+	screened=false;
 }
 
 /*!
@@ -64,6 +65,7 @@ individual::individual(const int &n, const int &idnumber, const double &nlambda)
         p = zeros(n);
     }
 	lambda=nlambda;
+	screened=false;
 }
 
 /*!
@@ -80,6 +82,7 @@ individual::individual(const individual& gp)
 	rank=gp.rank;
 	p=gp.p;
 	lambda=gp.lambda;
+	screened=gp.screened;
 }
 
 /*!
@@ -109,6 +112,7 @@ individual& individual::operator = (const individual& gp)
     rank=gp.rank;
     p=gp.p;
 	lambda=gp.lambda;
+	screened=gp.screened;
     
     return *this;
 }
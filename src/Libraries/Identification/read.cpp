@@ -294,7 +294,7 @@ void ident_essentials(int &n_param, int &n_consts, int &n_files, const string &p
     
 }
     
-void ident_control(int &ngen, int &aleaspace, int &apop, int &spop, int &ngboys, int &maxpop, int &station_nb, double &probaMut, double &pertu, double &c, double &p0, double &lambdaLM, const string &path, const string &filename) {
+void ident_control(int &ngen, int &aleaspace, int &apop, int &spop, int &ngboys, int &maxpop, int &station_nb, double &probaMut, double &pertu, double &c, double &p0, double &lambdaLM, string &optimizer, double &cma_sigma, int &nthreads, const string &path, const string &filename) {
     
     string pathfile = path + "/" + filename;
     ifstream param_control;
@@ -329,9 +329,105 @@ void ident_control(int &ngen, int &aleaspace, int &apop, int &spop, int &ngboys,
     param_control >> buffer >> c >> p0;
     param_control >> buffer >> lambdaLM;
     
+    ///Optional keys : the optimizer of the offsprings (genetic or cmaes), the initial step size of the CMA-ES, relative to the bounds,
+    ///and the number of individuals of a population simulated at the same time (1 by default, 0 : one per hardware thread)
+    optimizer = "genetic";
+    cma_sigma = 0.3;
+    nthreads = 1;
+    while (param_control >> buffer) {
+        if (buffer == "optimizer")
+            param_control >> optimizer;
+        else if (buffer == "sigma")
+            param_control >> cma_sigma;
+        else if (buffer == "threads")
+            param_control >> nthreads;
+        else {
+            cout << "Error: The key " << buffer << " in " << filename << " is unknown (optimizer, sigma or threads)\n";
+            exit(0);
+        }
+    }
+    
     param_control.close();
 }
     
+void read_early_abort(int &worst, double &bound, const string &path, const string &filename) {
+    
+    string pathfile = path + "/" + filename;
+    ifstream param_abort;
+    string buffer;
+    worst = 0;
+    bound = 0.;
+    
+    ///The file is optional : without it, every simulation runs to its end
+    param_abort.open(pathfile, ios::in);
+    if(!param_abort)
+        return;
+    
+    while (param_abort >> buffer) {
+        if (buffer == "population")
+            param_abort >> worst;
+        else if (buffer == "bound")
+            param_abort >> bound;
+        else {
+            cout << "Error: The key " << buffer << " in " << filename << " is unknown (population or bound)\n";
+            exit(0);
+        }
+    }
+    param_abort.close();
+}
+
+void read_fidelity(string &screenfile, int &top, const string &path, const string &filename) {
+    
+    string pathfile = path + "/" + filename;
+    ifstream param_fidelity;
+    string buffer;
+    screenfile = "";
+    top = 0;
+    
+    ///The file is optional : without it, every individual is evaluated with the full solver controls
+    param_fidelity.open(pathfile, ios::in);
+    if(!param_fidelity)
+        return;
+    
+    while (param_fidelity >> buffer) {
+        if (buffer == "screen")
+            param_fidelity >> screenfile;
+        else if (buffer == "top")
+            param_fidelity >> top;
+        else {
+            cout << "Error: The key " << buffer << " in " << filename << " is unknown (screen or top)\n";
+            exit(0);
+        }
+    }
+    param_fidelity.close();
+}
+
+void read_forward_sensi(int &forward, double &delta, const string &path, const string &filename) {
+    
+    string pathfile = path + "/" + filename;
+    ifstream param_sensi;
+    string buffer;
+    forward = 0;
+    delta = 1.E-6;
+    
+    ///The file is optional : without it, the sensitivities are computed by finite differences of whole simulations
+    param_sensi.open(pathfile, ios::in);
+    if(!param_sensi)
+        return;
+    
+    while (param_sensi >> buffer) {
+        if (buffer == "forward")
+            param_sensi >> forward;
+        else if (buffer == "delta")
+            param_sensi >> delta;
+        else {
+            cout << "Error: The key " << buffer << " in " << filename << " is unknown (forward or delta)\n";
+            exit(0);
+        }
+    }
+    param_sensi.close();
+}
+    
 void read_gen(int &apop, mat &samples, const int &n_param) {
     
     ifstream paraminit;
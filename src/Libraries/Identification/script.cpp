@@ -36,9 +36,13 @@
 #include <smartplus/Libraries/Identification/read.hpp>
 #include <smartplus/Libraries/Identification/optimize.hpp>
 #include <smartplus/Libraries/Identification/script.hpp>
+#include <smartplus/Libraries/Identification/cost_monitor.hpp>
 #include <smartplus/Libraries/Solver/read.hpp>
 #include <smartplus/Libraries/Solver/solver.hpp>
+#include <smartplus/Libraries/Solver/simulation_tree.hpp>
+#include <smartplus/Libraries/Solver/sensitivity.hpp>
 #include <smartplus/Libraries/Phase/phase_characteristics.hpp>
+#include <smartplus/Libraries/Phase/tolerances.hpp>
 #include <smartplus/Libraries/Phase/read.hpp>
 #include <smartplus/Libraries/Phase/write.hpp>
 #include <smartplus/Libraries/Material/ODF.hpp>
@@ -154,7 +158,7 @@ void apply_constants(const vector<constants> &consts, const string &dst_path) {
     
 }
     
-void launch_solver(const individual &ind, const int &nfiles, vector<parameters> &params, vector<constants> &consts, const string &path_results, const string &name, const string &path_data, const string &path_keys, const string &materialfile)
+void launch_solver(const individual &ind, const int &nfiles, vector<parameters> &params, vector<constants> &consts, const string &path_results, const string &name, const string &path_data, const string &path_keys, const string &materialfile, const std::shared_ptr<cost_monitor> &sptr_monitor, const string &controlfile, solver_sensitivity *sensi, simulation_tree *sim_tree)
 {
 	string outputfile;
     string simulfile;
@@ -163,6 +167,13 @@ void launch_solver(const individual &ind, const int &nfiles, vector<parameters>
     string name_ext = name.substr(name.length()-4,name.length());
     string name_root = name.substr(0,name.length()-4); //to remove the extension
     
+    //Snapshots of the solver kept from one individual (and one experiment) to the next : the prefixes of the loading paths
+    //that are not affected by the parameters are simulated once (see simul_tree.inp). The individuals simulated at the same time have their own tree
+    static simulation_tree tree_shared;
+    simulation_tree &tree = (sim_tree != NULL) ? *sim_tree : tree_shared;
+    read_simulation_tree(tree, path_data);
+    bool sensi_active = true;     //The forward sensitivities have been integrated for all the files
+    
 	//#pragma omp parallel for private(sstm, path)
     for (int i = 0; i<nfiles; i++) {
         ///Creating the right path & output filenames
@@ -204,20 +215,39 @@ void launch_solver(const individual &ind, const int &nfiles, vector<parameters>
         double precision_solver = 0.;
         double lambda_solver = 0.;
         
+        //The tolerances of the control file only apply to this simulation : the ones of a screening file do not leak into the next full simulation
+        tolerances tol_defaults = tolerances::defaults();
         solver_essentials(solver_type, path_data);
-        solver_control(div_tnew_dt_solver, mul_tnew_dt_solver, miniter_solver, maxiter_solver, inforce_solver, precision_solver, lambda_solver, path_data);
+        solver_control(div_tnew_dt_solver, mul_tnew_dt_solver, miniter_solver, maxiter_solver, inforce_solver, precision_solver, lambda_solver, path_data, controlfile);
         
         //Then read the material properties
         read_matprops(umat_name, nprops, props, nstatev, psi_rve, theta_rve, phi_rve, path_data, materialfile);
-        ///Launching the solver with relevant parameters
-        solver(umat_name, props, nstatev, psi_rve, theta_rve, phi_rve, solver_type, div_tnew_dt_solver, mul_tnew_dt_solver, miniter_solver, maxiter_solver, inforce_solver, precision_solver, lambda_solver, path_data, path_results, pathfile, outputfile);
+        ///Launching the solver with relevant parameters. With a monitor, the solver stops once the cost of the individual exceeds its bound
+        if (sptr_monitor)
+            sptr_monitor->begin(i);
+        solver(umat_name, props, nstatev, psi_rve, theta_rve, phi_rve, solver_type, div_tnew_dt_solver, mul_tnew_dt_solver, miniter_solver, maxiter_solver, inforce_solver, precision_solver, lambda_solver, path_data, path_results, pathfile, outputfile, &tree, sptr_monitor, sensi);
+        tolerances::defaults() = tol_defaults;
         
         //Get the simulation files according to the proper name
         outputfile = path_results + "/" + name_root + "_" + to_string(ind.id) + "_" + to_string(i+1) + "_global-0" + name_ext;
         simulfile = path_results + "/" + name_root + "_" + to_string(ind.id)  + "_" + to_string(i+1) + name_ext;
         
         boost::filesystem::copy_file(outputfile,simulfile,boost::filesystem::copy_option::overwrite_if_exists);
+        
+        //Same for the files of the derivatives
+        if (sensi != NULL) {
+            sensi_active = ((sensi_active)&&(sensi->active));
+            for (int p=0; (sensi->active)&&(p<sensi->size()); p++) {
+                string sensifile = solver_sensitivity::outputfile(name_root + "_" + to_string(ind.id) + "_" + to_string(i+1) + name_ext, p);
+                string sensi_root = sensifile.substr(0,sensifile.length()-4);
+                outputfile = path_results + "/" + sensi_root + "_global-0" + name_ext;
+                simulfile = path_results + "/" + sensifile;
+                boost::filesystem::copy_file(outputfile,simulfile,boost::filesystem::copy_option::overwrite_if_exists);
+            }
+        }
     }
+    if (sensi != NULL)
+        sensi->active = sensi_active;
 }
     
 void launch_odf(const individual &ind, vector<parameters> &params, const string &path_results, const string &name, const string &path_data, const string &path_keys, const string &materialfile)
@@ -473,7 +503,7 @@ void launch_func_N(const individual &ind, const int &nfiles, vector<parameters>
     }
 }
     
-void run_simulation(const string &simul_type, const individual &ind, const int &nfiles, vector<parameters> &params, vector<constants> &consts, vector<opti_data> &data_num, const string &folder, const string &name, const string &path_data, const string &path_keys, const string &inputdatafile) {
+void run_simulation(const string &simul_type, const individual &ind, const int &nfiles, vector<parameters> &params, vector<constants> &consts, vector<opti_data> &data_num, const string &folder, const string &name, const string &path_data, const string &path_keys, const string &inputdatafile, const std::shared_ptr<cost_monitor> &sptr_monitor, const string &controlfile, solver_sensitivity *sensi, simulation_tree *sim_tree) {
     
     //In the simulation run, make sure that we remove all the temporary files
     boost::filesystem::path path_to_remove(folder);
@@ -487,7 +517,7 @@ void run_simulation(const string &simul_type, const individual &ind, const int &
     switch (list_simul[simul_type]) {
             
         case 1: {
-            launch_solver(ind, nfiles, params, consts, folder, name, path_data, path_keys, inputdatafile);
+            launch_solver(ind, nfiles, params, consts, folder, name, path_data, path_keys, inputdatafile, sptr_monitor, controlfile, sensi, sim_tree);
             break;
         }
         case 2: {
@@ -524,23 +554,87 @@ void run_simulation(const string &simul_type, const individual &ind, const int &
     
 }
     
+Col<int> props_keys(const vector<parameters> &params, const string &path_keys, const string &materialfile) {
+    
+    Col<int> props_index(params.size());
+    props_index.fill(-1);
+    
+    //Same layout as read_matprops, the props being read as keys
+    string buffer;
+    string umat_name;
+    int nprops = 0;
+    int nstatev = 0;
+    ifstream propsmat;
+    propsmat.open(path_keys + "/" + materialfile, ios::in);
+    if(!propsmat)
+        return props_index;
+    propsmat >> buffer >> buffer >> umat_name >> buffer >> nprops >> buffer >> nstatev;
+    propsmat.close();
+    
+    vector<string> props_key(nprops);
+    propsmat.open(path_keys + "/" + materialfile, ios::in);
+    propsmat >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer >> buffer;
+    for(int i=0; i<nprops; i++)
+        propsmat >> buffer >> props_key[i];
+    propsmat.close();
+    
+    for (unsigned int j=0; j<params.size(); j++) {
+        if ((params[j].ninput_files != 1)||(params[j].input_files[0] != materialfile))
+            continue;
+        int nfound = 0;
+        for(int i=0; i<nprops; i++) {
+            if (props_key[i] == params[j].key) {
+                props_index(j) = i;
+                nfound++;
+            }
+        }
+        if (nfound > 1)
+            props_index(j) = -1;
+    }
+    return props_index;
+}
+    
 double calc_cost(const vec &vexp, vec &vnum, const vec &W, const vector<opti_data> &data_num, const vector<opti_data> &data_exp, const int &nfiles, const int &sizev) {
 
     vnum = calcV(data_num, data_exp, nfiles, sizev);    
     return calcC(vexp, vnum, W);
 }
      
-mat calc_sensi(const individual &gboy, generation &n_gboy, const string &simul_type, const int &nfiles, const int &n_param, vector<parameters> &params, vector<constants> &consts, vec &vnum0, vector<opti_data> &data_num, vector<opti_data> &data_exp, const string &folder, const string &name, const string &path_data, const string &path_keys, const int &sizev, const vec &Dp_n, const string &materialfile) {
+mat calc_sensi(const individual &gboy, generation &n_gboy, const string &simul_type, const int &nfiles, const int &n_param, vector<parameters> &params, vector<constants> &consts, vec &vnum0, vector<opti_data> &data_num, vector<opti_data> &data_exp, const string &folder, const string &name, const string &path_data, const string &path_keys, const int &sizev, const vec &Dp_n, const string &materialfile, const int &forward, const double &delta_forward) {
     
     //delta
     vec delta = 0.01*ones(n_param);
     
     mat S = zeros(sizev,n_param);
+    
+    //Forward sensitivities : the derivatives with respect to the parameters that are props of the material are integrated along the simulation
+    //of the gboy. The other ones (or all of them, if the solver could not integrate the derivatives) are computed by finite differences
+    Col<int> props_index(n_param);
+    props_index.fill(-1);
+    if ((forward)&&(simul_type == "SOLVE"))
+        props_index = props_keys(params, path_keys, materialfile);
+    uvec forward_params = find(props_index >= 0);
+    Col<int> forward_props = props_index.elem(forward_params);
+    solver_sensitivity sensi(forward_props, delta_forward);
+    
     //genrun part of the gradient
     
-    run_simulation(simul_type, gboy, nfiles, params, consts, data_num, folder, name, path_data, path_keys, materialfile);
+    run_simulation(simul_type, gboy, nfiles, params, consts, data_num, folder, name, path_data, path_keys, materialfile, std::shared_ptr<cost_monitor>(), "solver_control.inp", (forward_params.n_elem > 0) ? &sensi : NULL);
     vnum0 = calcV(data_num, data_exp, nfiles, sizev);
     
+    Col<int> forward_done = zeros<Col<int> >(n_param);
+    if ((forward_params.n_elem > 0)&&(sensi.active)) {
+        for(unsigned int q=0; q<forward_params.n_elem; q++) {
+            vector<opti_data> data_sensi = data_num;
+            for(int i=0; i<nfiles; i++) {
+                data_sensi[i].name = solver_sensitivity::outputfile(data_num[i].name, q);
+                data_sensi[i].import(folder);
+            }
+            S.col(forward_params(q)) = calcV(data_sensi, data_exp, nfiles, sizev);
+            forward_done(forward_params(q)) = 1;
+        }
+    }
+    
     for(int j=0; j<n_param; j++) {
         n_gboy.pop[j].p = gboy.p;
         if (fabs(Dp_n(j)) > 0.) {
@@ -555,6 +649,8 @@ mat calc_sensi(const individual &gboy, generation &n_gboy, const string &simul_t
     }
     
     for(int j=0; j<n_param; j++) {
+        if (forward_done(j))
+            continue;
         //run the simulation
         run_simulation(simul_type, n_gboy.pop[j], nfiles, params, consts, data_num, folder, name, path_data, path_keys, materialfile);
         vec vnum = calcV(data_num, data_exp, nfiles, sizev);
@@ -147,7 +147,19 @@ double ODF::density(const double &alpha)
 {
     double density = 0.;
     
-    for(auto p : peaks) {
+    for(auto &p : peaks) {
+        density += p.get_density_ODF(alpha);
+    }
+    return density;
+}
+
+//----------------------------------------------------------------------
+vec ODF::density(const vec &alpha)
+//----------------------------------------------------------------------
+{
+    vec density = zeros(alpha.n_elem);
+    
+    for(auto &p : peaks) {
         density += p.get_density_ODF(alpha);
     }
     return density;
@@ -184,7 +196,7 @@ ostream& operator << (ostream& s, const ODF& pc)
     s << "number of peaks:" << pc.peaks.size() << "\n";    
     s << "peaks:\n";
     
-    for(auto p : pc.peaks) {
+    for(auto &p : pc.peaks) {
         s << p << "\n";
     }
 //    s << "n_densities:\t" << pc.n_densities << "\n";
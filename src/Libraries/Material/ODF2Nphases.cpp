@@ -29,6 +29,7 @@
 #include <smartplus/parameter.hpp>
 #include <smartplus/Libraries/Phase/phase_characteristics.hpp>
 #include <smartplus/Libraries/Material/ODF.hpp>
+#include <smartplus/Libraries/Material/ODF3D.hpp>
 #include <smartplus/Libraries/Material/ODF2Nphases.hpp>
 #include <smartplus/Libraries/Material/read.hpp>
 #include <smartplus/Libraries/Phase/phase_characteristics.hpp>
@@ -143,39 +144,45 @@ void fill_angles(const double &alpha, phase_characteristics &phase, const ODF &o
 phase_characteristics discretize_ODF(const phase_characteristics &rve_init, ODF &odf_rve, const int &num_phase_disc, const int &nb_phases_disc, const int &angles_mat) {
     
     phase_characteristics rve;
-    rve.copy(rve_init);
+    rve.copy(rve_init, false);
     
     int number = 0;
-    odf_rve.norm = 0.;
     
     double angle_range = odf_rve.limits(1) - odf_rve.limits(0);
     assert(angle_range > 0.);
     
     double dalpha = angle_range/double(nb_phases_disc);
-    double alpha = odf_rve.limits(0);
     
-    rve.sub_phases.erase(rve.sub_phases.begin()+num_phase_disc);
+    //Bounds and middles of the slices, x(2i+1) being the angle of the slice i : the bounds are shared by the neighbouring slices
+    vec x = odf_rve.limits(0) - dalpha/2. + (dalpha/2.)*linspace(0., 2.*nb_phases_disc, 2*nb_phases_disc+1);
+    //The lower bound of the first slice is taken on the other side of the period
+    x(0) += pi;
+    vec densities_x = odf_rve.density(x);
+    
+    //Simpson integration over each slice
+    vec concentrations = zeros(nb_phases_disc);
     for (int i=0; i<nb_phases_disc; i++) {
-        
-        phase_characteristics temp;
-        temp.copy(rve_init.sub_phases[num_phase_disc]);
-        
-        fill_angles(alpha, temp, odf_rve, angles_mat);
-        
-        if(alpha - odf_rve.limits(0) < dalpha)
-            temp.sptr_shape->concentration = dalpha/6. * (odf_rve.density(pi+alpha-dalpha/2) + 4.*odf_rve.density(alpha) + odf_rve.density(alpha+dalpha/2));
-        else
-            temp.sptr_shape->concentration = dalpha/6. * (odf_rve.density(alpha-dalpha/2) + 4.*odf_rve.density(alpha) + odf_rve.density(alpha+dalpha/2));
-
-        odf_rve.norm += temp.sptr_shape->concentration;
-        
-        rve.sub_phases.insert(rve.sub_phases.begin()+i+num_phase_disc, temp);
-        alpha += dalpha;
+        concentrations(i) = dalpha/6. * (densities_x(2*i) + 4.*densities_x(2*i+1) + densities_x(2*i+2));
     }
+    odf_rve.norm = accu(concentrations);
     
     ///Normalization
-    for(int i=0; i<nb_phases_disc; i++) {
-        rve.sub_phases[i+num_phase_disc].sptr_shape->concentration *= (rve_init.sub_phases[num_phase_disc].sptr_shape->concentration / odf_rve.norm);
+    const phase_characteristics &phase_disc = rve_init.sub_phases[num_phase_disc];
+    concentrations *= (phase_disc.sptr_shape->concentration / odf_rve.norm);
+    
+    //The sub-phases are built in place : the other phases, then the slices in place of the discretized phase
+    rve.sub_phases.resize(rve_init.sub_phases.size() - 1 + nb_phases_disc);
+    for (int i=0; i<num_phase_disc; i++) {
+        rve.sub_phases[i].copy(rve_init.sub_phases[i]);
+    }
+    for (int i=0; i<nb_phases_disc; i++) {
+        phase_characteristics &temp = rve.sub_phases[i+num_phase_disc];
+        temp.copy(phase_disc);
+        fill_angles(x(2*i+1), temp, odf_rve, angles_mat);
+        temp.sptr_shape->concentration = concentrations(i);
+    }
+    for (unsigned int i=num_phase_disc+1; i<rve_init.sub_phases.size(); i++) {
+        rve.sub_phases[i-1+nb_phases_disc].copy(rve_init.sub_phases[i]);
     }
     
     for (unsigned int i=0; i<rve.sub_phases.size(); i++) {
@@ -183,12 +190,87 @@ phase_characteristics discretize_ODF(const phase_characteristics &rve_init, ODF
         number++;
     }
     
-//    cout << "rve = " << rve;
-    
     return rve;
     
 }
 
+    
+void fill_angles(const double &psi, const double &theta, const double &phi, phase_characteristics &phase, const int &angles_mat) {
+    
+    if (angles_mat) {
+        phase.sptr_matprops->psi_mat = psi;
+        phase.sptr_matprops->theta_mat = theta;
+        phase.sptr_matprops->phi_mat = phi;
+    }
+    
+    //Switch case for the geometry of the phase
+    switch (phase.shape_type) {
+        case 0: {
+            break;
+        }
+        case 1: {
+            std::shared_ptr<layer> lay = std::dynamic_pointer_cast<layer>(phase.sptr_shape);
+            lay->psi_geom = psi;
+            lay->theta_geom = theta;
+            lay->phi_geom = phi;
+            break;
+        }
+        case 2: {
+            std::shared_ptr<ellipsoid> elli = std::dynamic_pointer_cast<ellipsoid>(phase.sptr_shape);
+            elli->psi_geom = psi;
+            elli->theta_geom = theta;
+            elli->phi_geom = phi;
+            break;
+        }
+        case 3: {
+            std::shared_ptr<cylinder> cyl = std::dynamic_pointer_cast<cylinder>(phase.sptr_shape);
+            cyl->psi_geom = psi;
+            cyl->theta_geom = theta;
+            cyl->phi_geom = phi;
+            break;
+        }
+    }
+}
+    
+phase_characteristics discretize_ODF3D(const phase_characteristics &rve_init, ODF3D &odf_rve, const int &num_phase_disc, const int &nb_phases_disc, const int &method, const double &tol_merge, const int &angles_mat) {
+    
+    phase_characteristics rve;
+    rve.copy(rve_init, false);
+    
+    mat angles;
+    vec weights;
+    odf_rve.sample(angles, weights, nb_phases_disc, method);
+    reduce_orientations(angles, weights, tol_merge);
+    
+    int number = 0;
+    double weights_sum = accu(weights);
+    assert(weights_sum > 0.);
+    int nb_orientations = weights.n_elem;
+    
+    //The sub-phases are built in place : the other phases, then the orientations in place of the discretized phase
+    const phase_characteristics &phase_disc = rve_init.sub_phases[num_phase_disc];
+    rve.sub_phases.resize(rve_init.sub_phases.size() - 1 + nb_orientations);
+    for (int i=0; i<num_phase_disc; i++) {
+        rve.sub_phases[i].copy(rve_init.sub_phases[i]);
+    }
+    for (int i=0; i<nb_orientations; i++) {
+        phase_characteristics &temp = rve.sub_phases[i+num_phase_disc];
+        temp.copy(phase_disc);
+        fill_angles(angles(0,i), angles(1,i), angles(2,i), temp, angles_mat);
+        temp.sptr_shape->concentration = phase_disc.sptr_shape->concentration*weights(i)/weights_sum;
+    }
+    for (unsigned int i=num_phase_disc+1; i<rve_init.sub_phases.size(); i++) {
+        rve.sub_phases[i-1+nb_orientations].copy(rve_init.sub_phases[i]);
+    }
+    
+    for (unsigned int i=0; i<rve.sub_phases.size(); i++) {
+        rve.sub_phases[i].sptr_matprops->number = number;
+        number++;
+    }
+    
+    return rve;
+}
+
 
 /*double ODF(const double& theta, const int& method, const vec& param, const bool& radian, const double& dec){
 	
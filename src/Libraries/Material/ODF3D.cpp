@@ -0,0 +1,351 @@
+/* This file is part of SMART+.
+ 
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file ODF3D.cpp
+///@brief Orientation distribution function over the three Euler angles
+///@version 1.0
+
+#include <iostream>
+#include <assert.h>
+#include <math.h>
+#include <vector>
+#include <armadillo>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Material/peak.hpp>
+#include <smartplus/Libraries/Material/ODF3D.hpp>
+#include <smartplus/Libraries/Maths/rotation.hpp>
+
+using namespace std;
+using namespace arma;
+
+namespace smart{
+
+//Radical inverse of i in the given base : the i-th point of the Halton sequence
+static double radical_inverse(int i, const int &base) {
+    
+    double inv_base = 1./double(base);
+    double f = inv_base;
+    double h = 0.;
+    while (i > 0) {
+        h += f*double(i % base);
+        i /= base;
+        f *= inv_base;
+    }
+    return h;
+}
+
+//Misorientation angle between two rotation matrices
+static double misorientation(const mat &R1, const mat &R2) {
+    
+    double c = 0.5*(trace(trans(R1)*R2) - 1.);
+    if (c > 1.)
+        c = 1.;
+    if (c < -1.)
+        c = -1.;
+    return acos(c);
+}
+
+//=====Private methods for ODF3D===================================
+
+//=====Public methods for ODF3D============================================
+
+/*!
+ \brief default constructor
+ */
+
+//-------------------------------------------------------------
+ODF3D::ODF3D()
+//-------------------------------------------------------------
+{
+    n_psi = 0;
+    n_theta = 0;
+    n_phi = 0;
+    norm = 0.;
+}
+
+/*!
+ \brief Constructor with the size of the Euler grid
+ \param mn_psi : number of cells along psi
+ \param mn_theta : number of cells along theta
+ \param mn_phi : number of cells along phi
+ */
+
+//-------------------------------------------------------------
+ODF3D::ODF3D(const int &mn_psi, const int &mn_theta, const int &mn_phi)
+//-------------------------------------------------------------
+{
+    assert(mn_psi > 0);
+    assert(mn_theta > 0);
+    assert(mn_phi > 0);
+    
+    n_psi = mn_psi;
+    n_theta = mn_theta;
+    n_phi = mn_phi;
+    norm = 0.;
+}
+
+/*!
+ \brief Copy constructor
+ \param odf ODF3D object to duplicate
+ */
+
+//------------------------------------------------------
+ODF3D::ODF3D(const ODF3D& odf)
+//------------------------------------------------------
+{
+    peaks = odf.peaks;
+    orientations = odf.orientations;
+    n_psi = odf.n_psi;
+    n_theta = odf.n_theta;
+    n_phi = odf.n_phi;
+    densities = odf.densities;
+    volumes = odf.volumes;
+    norm = odf.norm;
+}
+
+/*!
+ \brief Destructor
+ */
+
+//-------------------------------------
+ODF3D::~ODF3D() {}
+//-------------------------------------
+
+//-------------------------------------------------------------
+void ODF3D::add_component(const peak &p, const double &psi, const double &theta, const double &phi)
+//-------------------------------------------------------------
+{
+    peaks.push_back(p);
+    vec g = {psi, theta, phi};
+    orientations.insert_cols(orientations.n_cols, g);
+}
+
+//-------------------------------------------------------------
+double ODF3D::density(const double &psi, const double &theta, const double &phi)
+//-------------------------------------------------------------
+{
+    mat R = fillR(psi, theta, phi);
+    double density = 0.;
+    for (unsigned int i=0; i<peaks.size(); i++) {
+        mat R_i = fillR(orientations(0,i), orientations(1,i), orientations(2,i));
+        //The non-periodic densities of the PDF : the misorientation angle is in [0,pi]
+        density += peaks[i].get_density_PDF(misorientation(R, R_i));
+    }
+    return density;
+}
+
+/*!
+ \brief Evaluates the densities at the centers of the cells of the Euler grid, the volumes of the cells and the integral of the density
+ */
+
+//-------------------------------------------------------------
+void ODF3D::construct()
+//-------------------------------------------------------------
+{
+    assert(n_psi > 0);
+    assert(n_theta > 0);
+    assert(n_phi > 0);
+    
+    double dpsi = 2.*pi/double(n_psi);
+    double dtheta = pi/double(n_theta);
+    double dphi = 2.*pi/double(n_phi);
+    
+    densities.set_size(n_psi, n_theta, n_phi);
+    volumes.set_size(n_psi, n_theta, n_phi);
+    norm = 0.;
+    for (int k=0; k<n_phi; k++) {
+        for (int j=0; j<n_theta; j++) {
+            //Exact integral of sin(theta) over the cell
+            double volume = dpsi*dphi*(cos(j*dtheta) - cos((j+1)*dtheta));
+            for (int i=0; i<n_psi; i++) {
+                densities(i,j,k) = density((i+0.5)*dpsi, (j+0.5)*dtheta, (k+0.5)*dphi);
+                volumes(i,j,k) = volume;
+                norm += densities(i,j,k)*volume;
+            }
+        }
+    }
+}
+
+/*!
+ \brief Representative orientations of the ODF
+ \param angles : (3,N) orientations psi, theta, phi
+ \param weights : (N) weights of the orientations, their sum is 1
+ \param N : number of orientations
+ \param method : 0 : equal weights, the orientations are the cells met by N strata of equal mass of the grid (several strata may fall in the same cell, see reduce_orientations) \n
+ 1 : N quasi-Monte-Carlo (Halton) orientations, uniform over the orientations, weighted by the density
+ */
+
+//-------------------------------------------------------------
+void ODF3D::sample(mat &angles, vec &weights, const int &N, const int &method)
+//-------------------------------------------------------------
+{
+    assert(N > 0);
+    angles = zeros(3,N);
+    weights = zeros(N);
+    
+    switch (method) {
+        case 0: {
+            if (densities.n_elem == 0)
+                construct();
+            assert(norm > 0.);
+            
+            double dpsi = 2.*pi/double(n_psi);
+            double dtheta = pi/double(n_theta);
+            double dphi = 2.*pi/double(n_phi);
+            
+            //Systematic sampling of the cumulated mass : the n-th stratum is at (n+1/2)/N of it
+            double cumul = 0.;
+            int n = 0;
+            for (int k=0; k<n_phi && n<N; k++) {
+                for (int j=0; j<n_theta && n<N; j++) {
+                    for (int i=0; i<n_psi && n<N; i++) {
+                        cumul += densities(i,j,k)*volumes(i,j,k)/norm;
+                        while ((n < N)&&((n+0.5)/double(N) <= cumul)) {
+                            angles(0,n) = (i+0.5)*dpsi;
+                            angles(1,n) = (j+0.5)*dtheta;
+                            angles(2,n) = (k+0.5)*dphi;
+                            weights(n) = 1./double(N);
+                            n++;
+                        }
+                    }
+                }
+            }
+            //Round-off of the cumulated mass : the last strata go to the last cell
+            while (n < N) {
+                angles.col(n) = angles.col(n-1);
+                weights(n) = 1./double(N);
+                n++;
+            }
+            break;
+        }
+        case 1: {
+            //Uniform orientations : psi and phi are uniform, cos(theta) is uniform
+            for (int n=0; n<N; n++) {
+                angles(0,n) = 2.*pi*radical_inverse(n+1, 2);
+                angles(1,n) = acos(1. - 2.*radical_inverse(n+1, 3));
+                angles(2,n) = 2.*pi*radical_inverse(n+1, 5);
+                weights(n) = density(angles(0,n), angles(1,n), angles(2,n));
+            }
+            assert(accu(weights) > 0.);
+            weights /= accu(weights);
+            break;
+        }
+        default: {
+            cout << "error: The sampling method of the ODF does not exist (0 for equal weights, 1 for quasi-Monte-Carlo)\n";
+            exit(0);
+            break;
+        }
+    }
+}
+
+/*!
+ \brief Standard operator = for ODF3D
+ */
+
+//----------------------------------------------------------------------
+ODF3D& ODF3D::operator = (const ODF3D& odf)
+//----------------------------------------------------------------------
+{
+    peaks = odf.peaks;
+    orientations = odf.orientations;
+    n_psi = odf.n_psi;
+    n_theta = odf.n_theta;
+    n_phi = odf.n_phi;
+    densities = odf.densities;
+    volumes = odf.volumes;
+    norm = odf.norm;
+    
+    return *this;
+}
+
+//--------------------------------------------------------------------------
+ostream& operator << (ostream& s, const ODF3D& odf)
+//--------------------------------------------------------------------------
+{
+    s << "Display info on the 3D ODF\n";
+    s << "Euler grid: " << odf.n_psi << " x " << odf.n_theta << " x " << odf.n_phi << "\n";
+    s << "Number of components: " << odf.peaks.size() << "\n";
+    for (unsigned int i=0; i<odf.peaks.size(); i++) {
+        s << "Component " << i+1 << ": orientation = " << odf.orientations(0,i) << "\t" << odf.orientations(1,i) << "\t" << odf.orientations(2,i) << "\n";
+        s << odf.peaks[i];
+    }
+    s << "norm = " << odf.norm << "\n";
+    s << "\n";
+    
+    return s;
+}
+
+//-------------------------------------------------------------
+double misorientation(const double &psi1, const double &theta1, const double &phi1, const double &psi2, const double &theta2, const double &phi2)
+//-------------------------------------------------------------
+{
+    return misorientation(fillR(psi1, theta1, phi1), fillR(psi2, theta2, phi2));
+}
+
+//-------------------------------------------------------------
+void reduce_orientations(mat &angles, vec &weights, const double &tol)
+//-------------------------------------------------------------
+{
+    assert(angles.n_rows == 3);
+    assert(angles.n_cols == weights.n_elem);
+    
+    double sum = accu(weights);
+    
+    //The heaviest orientations are the representatives of the groups
+    uvec order = sort_index(weights, "descend");
+    std::vector<mat> R_groups;
+    std::vector<int> first;
+    std::vector<double> weight_groups;
+    for (unsigned int n=0; n<order.n_elem; n++) {
+        int i = order(n);
+        mat R = fillR(angles(0,i), angles(1,i), angles(2,i));
+        bool merged = false;
+        for (unsigned int g=0; g<R_groups.size(); g++) {
+            if (misorientation(R, R_groups[g]) <= tol) {
+                weight_groups[g] += weights(i);
+                merged = true;
+                break;
+            }
+        }
+        if (!merged) {
+            R_groups.push_back(R);
+            first.push_back(i);
+            weight_groups.push_back(weights(i));
+        }
+    }
+    
+    int nkept = 0;
+    for (unsigned int g=0; g<R_groups.size(); g++) {
+        if (weight_groups[g] > limit*sum)
+            nkept++;
+    }
+    
+    mat angles_r = zeros(3,nkept);
+    vec weights_r = zeros(nkept);
+    int m = 0;
+    for (unsigned int g=0; g<R_groups.size(); g++) {
+        if (weight_groups[g] > limit*sum) {
+            angles_r.col(m) = angles.col(first[g]);
+            weights_r(m) = weight_groups[g];
+            m++;
+        }
+    }
+    angles = angles_r;
+    weights = weights_r;
+}
+
+} //namespace smart
@@ -139,7 +139,19 @@ double PDF::density(const double &alpha)
 {
     double density = 0.;
     
-    for(auto p : peaks) {
+    for(auto &p : peaks) {
+        density += p.get_density_PDF(alpha);
+    }
+    return density;
+}
+
+//----------------------------------------------------------------------
+vec PDF::density(const vec &alpha)
+//----------------------------------------------------------------------
+{
+    vec density = zeros(alpha.n_elem);
+    
+    for(auto &p : peaks) {
         density += p.get_density_PDF(alpha);
     }
     return density;
@@ -174,7 +186,7 @@ ostream& operator << (ostream& s, const PDF& pc)
     s << "number of peaks:" << pc.peaks.size() << "\n";    
     s << "peaks:\n";
     
-    for(auto p : pc.peaks) {
+    for(auto &p : pc.peaks) {
         s << p << "\n";
     }
 //    s << "n_densities:\t" << pc.n_densities << "\n";
@@ -60,47 +60,50 @@ vec get_densities_PDF(const vec &x, const string &path_data, const string &input
 void fill_parameters(const double &alpha, phase_characteristics &phase, const PDF &pdf_rve) {
     
     phase.sptr_matprops->props(pdf_rve.Parameter) = alpha;
+    phase.sptr_matprops->reset_constants();
     
 }
     
 phase_characteristics discretize_PDF(const phase_characteristics &rve_init, PDF &pdf_rve, const int &num_phase_disc, const int &nb_phases_disc) {
     
     phase_characteristics rve;
-    rve.copy(rve_init);
+    rve.copy(rve_init, false);
     
     int number = 0;
-    pdf_rve.norm = 0.;
     
     double parameter_range = pdf_rve.limits(1) - pdf_rve.limits(0);
     assert(parameter_range > 0.);
     
     double dalpha = parameter_range/double(nb_phases_disc);
-    double alpha = pdf_rve.limits(0);
     
-    rve.sub_phases.erase(rve.sub_phases.begin()+num_phase_disc);
+    //Bounds and middles of the slices, x(2i+1) being the parameter of the slice i : the bounds are shared by the neighbouring slices
+    vec x = pdf_rve.limits(0) - dalpha/2. + (dalpha/2.)*linspace(0., 2.*nb_phases_disc, 2*nb_phases_disc+1);
+    vec densities_x = pdf_rve.density(x);
+    
+    //Simpson integration over each slice
+    vec concentrations = zeros(nb_phases_disc);
     for (int i=0; i<nb_phases_disc; i++) {
-        
-        phase_characteristics temp;
-        temp.copy(rve_init.sub_phases[num_phase_disc]);
-        
-        fill_parameters(alpha, temp, pdf_rve);
-        
-        // if(alpha - pdf_rve.limits(0) < dalpha)
-            // temp.sptr_shape->concentration = dalpha/6. * (pdf_rve.density(pi+alpha-dalpha/2) + 4.*pdf_rve.density(alpha) + pdf_rve.density(alpha+dalpha/2));
-        // else
-            // temp.sptr_shape->concentration = dalpha/6. * (pdf_rve.density(alpha-dalpha/2) + 4.*pdf_rve.density(alpha) + pdf_rve.density(alpha+dalpha/2));
-            
-        temp.sptr_shape->concentration = dalpha/6. * (pdf_rve.density(alpha-dalpha/2) + 4.*pdf_rve.density(alpha) + pdf_rve.density(alpha+dalpha/2));
-
-        pdf_rve.norm += temp.sptr_shape->concentration;
-        
-        rve.sub_phases.insert(rve.sub_phases.begin()+i+num_phase_disc, temp);
-        alpha += dalpha;
+        concentrations(i) = dalpha/6. * (densities_x(2*i) + 4.*densities_x(2*i+1) + densities_x(2*i+2));
     }
+    pdf_rve.norm = accu(concentrations);
     
     ///Normalization
-    for(int i=0; i<nb_phases_disc; i++) {
-        rve.sub_phases[i+num_phase_disc].sptr_shape->concentration *= (rve_init.sub_phases[num_phase_disc].sptr_shape->concentration / pdf_rve.norm);
+    const phase_characteristics &phase_disc = rve_init.sub_phases[num_phase_disc];
+    concentrations *= (phase_disc.sptr_shape->concentration / pdf_rve.norm);
+    
+    //The sub-phases are built in place : the other phases, then the slices in place of the discretized phase
+    rve.sub_phases.resize(rve_init.sub_phases.size() - 1 + nb_phases_disc);
+    for (int i=0; i<num_phase_disc; i++) {
+        rve.sub_phases[i].copy(rve_init.sub_phases[i]);
+    }
+    for (int i=0; i<nb_phases_disc; i++) {
+        phase_characteristics &temp = rve.sub_phases[i+num_phase_disc];
+        temp.copy(phase_disc);
+        fill_parameters(x(2*i+1), temp, pdf_rve);
+        temp.sptr_shape->concentration = concentrations(i);
+    }
+    for (unsigned int i=num_phase_disc+1; i<rve_init.sub_phases.size(); i++) {
+        rve.sub_phases[i-1+nb_phases_disc].copy(rve_init.sub_phases[i]);
     }
     
     for (unsigned int i=0; i<rve.sub_phases.size(); i++) {
@@ -108,8 +111,6 @@ phase_characteristics discretize_PDF(const phase_characteristics &rve_init, PDF
         number++;
     }
     
-//    cout << "rve = " << rve;
-    
     return rve;
     
 }
@@ -33,6 +33,18 @@ using namespace std;
 using namespace arma;
 
 namespace smart{
+
+//Gaussian of stats.hpp, evaluated at all the points at once
+static vec Gaussian(const vec &X, const double &mean, const double &std_dev, const double &ampl) {
+    assert(std_dev>0);
+    return (ampl/(std_dev*sqrt(2.*pi)))*exp(-0.5*square((X - mean)/std_dev));
+}
+
+//Lorentzian of stats.hpp, evaluated at all the points at once
+static vec Lorentzian(const vec &X, const double &mean, const double &width, const double &ampl) {
+    assert(width>0);
+    return (ampl*width/(2.*pi))/(square(X - mean) + pow(width/2., 2.));
+}
     
 //=====Private methods for peak===================================
 
@@ -194,6 +206,62 @@ double peak::get_density_PDF(const double &theta)
     }
 }
     
+/*!
+ \brief Densities of the ODF at all the points : the type of peak is resolved once, the Gaussian and Lorentzian peaks are evaluated on the whole vector
+ */
+
+//-------------------------------------------------------------
+vec peak::get_density_ODF(const vec &theta)
+//-------------------------------------------------------------
+{
+    switch (method) {
+        case 3: {
+            return Gaussian(theta, mean, s_dev, ampl) + Gaussian(theta - pi, mean, s_dev, ampl) + Gaussian(theta + pi, mean, s_dev, ampl);
+        }
+        case 4: {
+            return Lorentzian(theta, mean, width, ampl) + Lorentzian(theta - pi, mean, width, ampl) + Lorentzian(theta + pi, mean, width, ampl);
+        }
+        case 7: {
+            return ones(theta.n_elem);
+        }
+        default : {
+            vec density = zeros(theta.n_elem);
+            for (unsigned int i=0; i<theta.n_elem; i++) {
+                density(i) = get_density_ODF(theta(i));
+            }
+            return density;
+        }
+    }
+}
+
+/*!
+ \brief Densities of the PDF at all the points : the type of peak is resolved once, the Gaussian and Lorentzian peaks are evaluated on the whole vector
+ */
+
+//-------------------------------------------------------------
+vec peak::get_density_PDF(const vec &theta)
+//-------------------------------------------------------------
+{
+    switch (method) {
+        case 3: {
+            return Gaussian(theta, mean, s_dev, ampl);
+        }
+        case 4: {
+            return Lorentzian(theta, mean, width, ampl);
+        }
+        case 7: {
+            return ones(theta.n_elem);
+        }
+        default : {
+            vec density = zeros(theta.n_elem);
+            for (unsigned int i=0; i<theta.n_elem; i++) {
+                density(i) = get_density_PDF(theta(i));
+            }
+            return density;
+        }
+    }
+}
+    
 //----------------------------------------------------------------------
 peak& peak::operator = (const peak& pc)
 //----------------------------------------------------------------------
@@ -16,9 +16,12 @@
 ///@date 10/23/2014
 
 #include <iostream>
+#include <functional>
 #include <assert.h>
 #include <armadillo>
 #include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Phase/tolerances.hpp>
+#include <smartplus/Libraries/Maths/num_solve.hpp>
 
 using namespace std;
 using namespace arma;
@@ -29,6 +32,59 @@ using namespace arma;
 
 namespace smart{
 
+bool lu_solve(const mat &A, const vec &b, vec &x)
+{
+    int n=b.n_elem;
+    assert((int(A.n_rows) == n)&&(int(A.n_cols) == n));
+    
+    mat LU = A;
+    x = b;
+    
+    //The rows are equilibrated first : the pivots are compared with the null threshold whatever the magnitude of the rows
+    //(e.g. the large diagonal terms set by the Fischer-Burmeister systems for the mechanisms with Phi = Dp = 0)
+    double zero_limit = tolerances::current().zero_limit;
+    for (int i=0; i<n; i++) {
+        double scale = abs(LU.row(i)).max();
+        if (scale <= 0.) {
+            return false;
+        }
+        LU.row(i) /= scale;
+        x(i) /= scale;
+    }
+    
+    //Gaussian elimination with partial pivoting, the permutations are applied to x along the way
+    for (int k=0; k<n; k++) {
+        int piv = k;
+        for (int i=k+1; i<n; i++) {
+            if (fabs(LU(i,k)) > fabs(LU(piv,k)))
+                piv = i;
+        }
+        if (fabs(LU(piv,k)) <= zero_limit) {
+            return false;
+        }
+        if (piv != k) {
+            LU.swap_rows(k, piv);
+            std::swap(x(k), x(piv));
+        }
+        for (int i=k+1; i<n; i++) {
+            double factor = LU(i,k)/LU(k,k);
+            for (int j=k+1; j<n; j++) {
+                LU(i,j) -= factor*LU(k,j);
+            }
+            x(i) -= factor*x(k);
+        }
+    }
+    
+    //Back substitution
+    for (int i=n-1; i>=0; i--) {
+        for (int j=i+1; j<n; j++) {
+            x(i) -= LU(i,j)*x(j);
+        }
+        x(i) /= LU(i,i);
+    }
+    return true;
+}
+
 void Newton_Raphon(const vec &Phi, const vec &Y_crit, const mat &denom, vec &Dp, vec &dp, double &error)
 {
     int n=Phi.n_elem;
@@ -37,8 +93,8 @@ void Newton_Raphon(const vec &Phi, const vec &Y_crit, const mat &denom, vec &Dp,
         assert(fabs(Y_crit(i)) > 0.);
     }
     
-    if (fabs(det(denom)) > limit) {
-        dp = -1.*solve(denom,Phi);
+    if (lu_solve(denom, Phi, dp)) {
+        dp = -1.*dp;
     }
     else {
         dp = zeros(n);
@@ -100,8 +156,8 @@ void Fischer_Burmeister(const vec &Phi, const vec &Y_crit, const mat &denom, vec
         
     }
     
-    if (fabs(det(denomFB)) > limit) {
-        dp = -1.*solve(denomFB,FB);
+    if (lu_solve(denomFB, FB, dp)) {
+        dp = -1.*dp;
     }
     else {
         dp = zeros(n);
@@ -218,8 +274,8 @@ void Fischer_Burmeister_limits(const vec &Phi_p, const vec &Phi_l, const vec &Y_
         }
     }
     
-    if (fabs(det(denomFB)) > limit) {
-        dp = -1.*solve(denomFB,FB);
+    if (lu_solve(denomFB, FB, dp)) {
+        dp = -1.*dp;
     }
     else {
         dp = zeros(n);
@@ -234,16 +290,12 @@ void Fischer_Burmeister_limits(const vec &Phi_p, const vec &Phi_l, const vec &Y_
     
 }
     
-void Fischer_Burmeister_m(const vec &Phi, const vec &Y_crit, const mat &denom, vec &Dp, vec &dp, double &error)
+void Fischer_Burmeister_m_system(const vec &Phi, const mat &denom, const vec &Dp, vec &FB, mat &denomFB)
 {
     int n=Phi.n_elem;
-        
-    for (int i=0; i<n; i++) {
-        assert(fabs(Y_crit(i)) > 0);
-    }
     
-    vec FB = zeros(n);
-    mat denomFB = zeros(n,n);
+    FB = zeros(n);
+    denomFB = zeros(n,n);
     mat delta = eye(n,n);
     
     //Determine the eigenvalues of denom
@@ -291,8 +343,22 @@ void Fischer_Burmeister_m(const vec &Phi, const vec &Y_crit, const mat &denom, v
         
     }
     
-    if (fabs(det(denomFB)) > limit) {
-        dp = -1.*solve(denomFB, FB);
+}
+    
+void Fischer_Burmeister_m(const vec &Phi, const vec &Y_crit, const mat &denom, vec &Dp, vec &dp, double &error)
+{
+    int n=Phi.n_elem;
+        
+    for (int i=0; i<n; i++) {
+        assert(fabs(Y_crit(i)) > 0);
+    }
+    
+    vec FB;
+    mat denomFB;
+    Fischer_Burmeister_m_system(Phi, denom, Dp, FB, denomFB);
+    
+    if (lu_solve(denomFB, FB, dp)) {
+        dp = -1.*dp;
     }
     else {
         dp = zeros(n);
@@ -421,8 +487,8 @@ void Fischer_Burmeister_m_limits(const vec &Phi_p, const vec &Phi_l, const vec &
         }
     }
     
-    if (fabs(det(denomFB)) > limit) {
-        dp = -1.*solve(denomFB, FB);
+    if (lu_solve(denomFB, FB, dp)) {
+        dp = -1.*dp;
     }
     else {
         dp = zeros(n);
@@ -440,45 +506,78 @@ void Fischer_Burmeister_m_limits(const vec &Phi_p, const vec &Phi_l, const vec &
     
 mat denom_FB_m(const vec &Phi, const mat &denom, const vec &Dp)
 {
+    vec FB;
+    mat denomFB;
+    Fischer_Burmeister_m_system(Phi, denom, Dp, FB, denomFB);
+    return denomFB;
+}
     
-    int n=Phi.n_elem;
-    
-    vec FB = zeros(n);
-    mat denomFB = zeros(n,n);
-    mat delta = eye(n,n);
+complementarity_stats complementarity_solve(const std::function<void(const vec &, vec &, mat &)> &residual, const vec &Y_crit, vec &Dp, const int &maxiter, const double &precision)
+{
+    int n=Dp.n_elem;
     
-    //Determine the eigenvalues of denom
-    vec factor_denom = zeros(n);
     for (int i=0; i<n; i++) {
-        factor_denom(i) = fabs(denom(i,i));
+        assert(fabs(Y_crit(i)) > 0.);
     }
     
-    vec Dpstar = Dp%factor_denom;
-    vec dDpstar = factor_denom;
+    complementarity_stats stats;
+    stats.niter = 0;
+    stats.nbacktrack = 0;
+    stats.converged = false;
     
-    //Normalized Fischer-Burmeister set of equations
-    for (int i=0; i<n; i++) {
+    //Parameters of the Armijo backtracking line search
+    double c_armijo = 1.E-4;
+    double alpha_min = 1.E-4;
+    
+    vec Phi;
+    mat denom;
+    vec FB;
+    mat denomFB;
+    vec dp;
+    
+    //Dp is the starting point : zeros, or the multipliers of the previous increment for a warm start
+    residual(Dp, Phi, denom);
+    Fischer_Burmeister_m_system(Phi, denom, Dp, FB, denomFB);
+    double merit = 0.5*dot(FB, FB);
+    stats.error = sum(abs(FB)/abs(Y_crit));
+    
+    for (stats.niter = 0; ((stats.niter < maxiter) && (stats.error > precision)); stats.niter++) {
         
-        for (int j=0; j<n; j++) {
-            if ((fabs(Phi(i)) > 0.)&&(fabs(Dpstar(i)) > 0.)) {
-                denomFB(i,j) = (Phi(i)/(sqrt(pow(Phi(i),2.) + pow(Dpstar(i),2.)))+1.)*denom(i,j) + delta(i,j)*dDpstar(i)*(Dpstar(i)/(sqrt(pow(Phi(i),2.) + pow(Dpstar(i),2.))) - 1.);
-            }
-            else if(fabs(Phi(i)) > 0.) {
-                denomFB(i,j) = (Phi(i)/(sqrt(pow(Phi(i),2.)))+1.)*denom(i,j) - delta(i,j)*dDpstar(i);
-            }
-            else if(fabs(Dpstar(i)) > 0.) {
-                denomFB(i,j) = denom(i,j) + delta(i,j)*dDpstar(i)*(Dpstar(i)/(sqrt(pow(Dpstar(i),2.))) - 1.);
-            }
-            else {
-                if (i==j)
-                    denomFB(i,j) = 1.E12;
-                else
-                    denomFB(i,j) = 0.;
-            }
+        if (lu_solve(denomFB, FB, dp)) {
+            dp = -1.*dp;
+        }
+        else {
+            break;
+        }
+        
+        //The Newton direction decreases the merit function 0.5*||FB||^2 with a slope -||FB||^2
+        double alpha = 1.;
+        vec Dp_trial = Dp + dp;
+        residual(Dp_trial, Phi, denom);
+        Fischer_Burmeister_m_system(Phi, denom, Dp_trial, FB, denomFB);
+        double merit_trial = 0.5*dot(FB, FB);
+        while ((merit_trial > (1. - 2.*c_armijo*alpha)*merit) && (alpha > alpha_min)) {
+            alpha *= 0.5;
+            stats.nbacktrack++;
+            Dp_trial = Dp + alpha*dp;
+            residual(Dp_trial, Phi, denom);
+            Fischer_Burmeister_m_system(Phi, denom, Dp_trial, FB, denomFB);
+            merit_trial = 0.5*dot(FB, FB);
         }
         
+        Dp = Dp_trial;
+        merit = merit_trial;
+        stats.error = sum(abs(FB)/abs(Y_crit));
     }
-    return denomFB;
+    
+    stats.converged = (stats.error <= precision);
+    return stats;
+}
+
+complementarity_stats complementarity_solve(const std::function<void(const vec &, vec &, mat &)> &residual, const vec &Y_crit, vec &Dp)
+{
+    const tolerances &tol = tolerances::current();
+    return complementarity_solve(residual, Y_crit, Dp, tol.umat_maxiter, tol.umat_precision);
 }
     
 } //namespace smart
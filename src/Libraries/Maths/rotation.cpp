@@ -19,6 +19,10 @@
 ///@version 1.0
 
 #include <math.h>
+#include <assert.h>
+#include <vector>
+#include <thread>
+#include <functional>
 #include <armadillo>
 #include <smartplus/parameter.hpp>
 #include <smartplus/Libraries/Maths/rotation.hpp>
@@ -845,5 +849,660 @@ mat rotate_g2l_B(const mat &B, const double &psi, const double &theta, const dou
     
 	return B_temp;
 }
+
+//Minimal number of orientations per thread of the batch rotations
+static const int batch_chunk = 256;
+
+//out = op(Q)*V, with op(Q) = Q or trans(Q), for a column-major (6,6) array and a Voigt vector (6). out may be V
+static void rotate_6(double *out, const double *q, const bool &tq, const double *v) {
+    
+    double q_op[36];
+    if (tq) {
+        for (int j=0; j<6; j++)
+            for (int i=0; i<6; i++)
+                q_op[i+6*j] = q[j+6*i];
+        q = q_op;
+    }
+    
+    double tmp[6] = {0.,0.,0.,0.,0.,0.};
+    for (int k=0; k<6; k++) {
+        for (int i=0; i<6; i++) {
+            tmp[i] += q[i+6*k]*v[k];
+        }
+    }
+    for (int i=0; i<6; i++) {
+        out[i] = tmp[i];
+    }
+}
+
+//out = op(Q)*A*trans(op(P)), with op(X) = X or trans(X), for column-major (6,6) arrays. out may be A
+static void rotate_66(double *out, const double *q, const bool &tq, const double *a, const double *p, const bool &tp) {
+    
+    double q_op[36];
+    if (tq) {
+        for (int j=0; j<6; j++)
+            for (int i=0; i<6; i++)
+                q_op[i+6*j] = q[j+6*i];
+        q = q_op;
+    }
+    double p_op[36];
+    if (tp) {
+        for (int j=0; j<6; j++)
+            for (int i=0; i<6; i++)
+                p_op[i+6*j] = p[j+6*i];
+        p = p_op;
+    }
+    
+    //tmp = A*trans(P), the inner loops run along the columns
+    double tmp[36];
+    for (int j=0; j<6; j++) {
+        for (int i=0; i<6; i++)
+            tmp[i+6*j] = 0.;
+        for (int k=0; k<6; k++) {
+            double p_jk = p[j+6*k];
+            for (int i=0; i<6; i++) {
+                tmp[i+6*j] += a[i+6*k]*p_jk;
+            }
+        }
+    }
+    
+    //out = Q*tmp : A is no longer read
+    for (int j=0; j<6; j++) {
+        double col[6] = {0.,0.,0.,0.,0.,0.};
+        for (int k=0; k<6; k++) {
+            double t_kj = tmp[k+6*j];
+            for (int i=0; i<6; i++) {
+                col[i] += q[i+6*k]*t_kj;
+            }
+        }
+        for (int i=0; i<6; i++) {
+            out[i+6*j] = col[i];
+        }
+    }
+}
+
+//Runs f(begin, end) on the orientations [0,N), split between threads for the large batches
+static void batch_for(const int &N, const std::function<void(const int &, const int &)> &f) {
+    
+    int nthreads = int(std::thread::hardware_concurrency());
+    if (nthreads > N/batch_chunk)
+        nthreads = N/batch_chunk;
+    if (nthreads <= 1) {
+        f(0, N);
+        return;
+    }
+    
+    int chunk = (N + nthreads - 1)/nthreads;
+    std::vector<std::thread> workers;
+    for (int t=0; t<nthreads; t++) {
+        int begin = t*chunk;
+        int end = (begin + chunk < N) ? begin + chunk : N;
+        if (begin >= end)
+            break;
+        workers.push_back(std::thread(f, begin, end));
+    }
+    for (auto &w : workers) {
+        w.join();
+    }
+}
+
+//To rotate a Voigt vector (6, stored as a column or a row) with a composed rotation matrix, without temporaries : out = Q*V
+void rotate_voigt(mat &out, const mat &Q, const mat &V) {
+    
+    assert(Q.n_rows == 6);
+    assert(Q.n_cols == 6);
+    assert(V.n_elem == 6);
+    
+    out.set_size(V.n_rows, V.n_cols);
+    rotate_6(out.memptr(), Q.memptr(), false, V.memptr());
+}
+    
+//To rotate a (6,6) matrix with composed rotation matrices, without temporaries : out = Q*A*trans(P)
+void rotate_voigt(mat &out, const mat &Q, const mat &A, const mat &P) {
+    
+    assert(Q.n_rows == 6);
+    assert(Q.n_cols == 6);
+    assert(P.n_rows == 6);
+    assert(P.n_cols == 6);
+    assert(A.n_rows == 6);
+    assert(A.n_cols == 6);
+    
+    out.set_size(6,6);
+    rotate_66(out.memptr(), Q.memptr(), false, A.memptr(), P.memptr(), false);
+}
+
+//To rotate from local to global a strain tensor (6) with composed matrices
+vec rotate_l2g_strain(const vec &E, const euler_Q &Q) {
+    if (Q.identity)
+        return E;
+    vec E_temp;
+    rotate_voigt(E_temp, Q.QE_l2g, E);
+    return E_temp;
+}
+
+//To rotate from global to local a strain tensor (6) with composed matrices
+vec rotate_g2l_strain(const vec &E, const euler_Q &Q) {
+    if (Q.identity)
+        return E;
+    vec E_temp;
+    rotate_voigt(E_temp, Q.QE_g2l, E);
+    return E_temp;
+}
+
+//To rotate from local to global a stress tensor (6) with composed matrices
+vec rotate_l2g_stress(const vec &S, const euler_Q &Q) {
+    if (Q.identity)
+        return S;
+    vec S_temp;
+    rotate_voigt(S_temp, Q.QS_l2g, S);
+    return S_temp;
+}
+
+//To rotate from global to local a stress tensor (6) with composed matrices
+vec rotate_g2l_stress(const vec &S, const euler_Q &Q) {
+    if (Q.identity)
+        return S;
+    vec S_temp;
+    rotate_voigt(S_temp, Q.QS_g2l, S);
+    return S_temp;
+}
+
+//To rotate from local to global a stiffness matrix (6,6) with composed matrices
+mat rotate_l2g_L(const mat &Lt, const euler_Q &Q) {
+    if (Q.identity)
+        return Lt;
+    mat Lt_temp;
+    rotate_voigt(Lt_temp, Q.QS_l2g, Lt, Q.QS_l2g);
+    return Lt_temp;
+}
+
+//To rotate from global to local a stiffness matrix (6,6) with composed matrices
+mat rotate_g2l_L(const mat &Lt, const euler_Q &Q) {
+    if (Q.identity)
+        return Lt;
+    mat Lt_temp;
+    rotate_voigt(Lt_temp, Q.QS_g2l, Lt, Q.QS_g2l);
+    return Lt_temp;
+}
+
+//To rotate from local to global a compliance matrix (6,6) with composed matrices
+mat rotate_l2g_M(const mat &M, const euler_Q &Q) {
+    if (Q.identity)
+        return M;
+    mat M_temp;
+    rotate_voigt(M_temp, Q.QE_l2g, M, Q.QE_l2g);
+    return M_temp;
+}
+
+//To rotate from global to local a compliance matrix (6,6) with composed matrices
+mat rotate_g2l_M(const mat &M, const euler_Q &Q) {
+    if (Q.identity)
+        return M;
+    mat M_temp;
+    rotate_voigt(M_temp, Q.QE_g2l, M, Q.QE_g2l);
+    return M_temp;
+}
+
+//To rotate from local to global a strain localisation matrix (6,6) with composed matrices
+mat rotate_l2g_A(const mat &A, const euler_Q &Q) {
+    if (Q.identity)
+        return A;
+    mat A_temp;
+    rotate_voigt(A_temp, Q.QE_l2g, A, Q.QS_l2g);
+    return A_temp;
+}
+
+//To rotate from global to local a strain localisation matrix (6,6) with composed matrices
+mat rotate_g2l_A(const mat &A, const euler_Q &Q) {
+    if (Q.identity)
+        return A;
+    mat A_temp;
+    rotate_voigt(A_temp, Q.QE_g2l, A, Q.QS_g2l);
+    return A_temp;
+}
+
+//To rotate from local to global a stress localisation matrix (6,6) with composed matrices
+mat rotate_l2g_B(const mat &B, const euler_Q &Q) {
+    if (Q.identity)
+        return B;
+    mat B_temp;
+    rotate_voigt(B_temp, Q.QS_l2g, B, Q.QE_l2g);
+    return B_temp;
+}
+
+//To rotate from global to local a stress localisation matrix (6,6) with composed matrices
+mat rotate_g2l_B(const mat &B, const euler_Q &Q) {
+    if (Q.identity)
+        return B;
+    mat B_temp;
+    rotate_voigt(B_temp, Q.QS_g2l, B, Q.QE_g2l);
+    return B_temp;
+}
+
+//=====Private methods for euler_Q===================================
+
+//-------------------------------------------------------------
+void euler_Q::compose()
+//-------------------------------------------------------------
+{
+    QS_g2l.eye();
+    QE_g2l.eye();
+    QS_l2g.eye();
+    QE_l2g.eye();
+    R_g2l.eye();
+    R_l2g.eye();
+    identity = true;
+    
+    //Same sequence as rotate_g2l_* (psi, theta, phi) and rotate_l2g_* (-phi, -theta, -psi)
+    double angles[3] = {psi, theta, phi};
+    int axis[3] = {axis_psi, axis_theta, axis_phi};
+    for (int n=0; n<3; n++) {
+        if(fabs(angles[n]) > iota) {
+            QS_g2l = fillQS(angles[n], axis[n], active)*QS_g2l;
+            QE_g2l = fillQE(angles[n], axis[n], active)*QE_g2l;
+            QS_l2g = QS_l2g*fillQS(-angles[n], axis[n], active);
+            QE_l2g = QE_l2g*fillQE(-angles[n], axis[n], active);
+            R_g2l = R_g2l*fillR(angles[n], axis[n]);
+            R_l2g = fillR(-angles[n], axis[n])*R_l2g;
+            identity = false;
+        }
+    }
+}
+
+//=====Public methods for euler_Q============================================
+
+/*!
+  \brief default constructor, null angles : the matrices are the identity
+  \param mactive : convention of the single-axis rotations
+*/
+
+//-------------------------------------------------------------
+euler_Q::euler_Q(const bool &mactive)
+//-------------------------------------------------------------
+{
+    psi = 0.;
+    theta = 0.;
+    phi = 0.;
+    active = mactive;
+    compose();
+}
+
+/*!
+  \brief Constructor with parameters
+  \param mpsi : first Euler angle (axis_psi)
+  \param mtheta : second Euler angle (axis_theta)
+  \param mphi : third Euler angle (axis_phi)
+  \param mactive : convention of the single-axis rotations
+*/
+
+//-------------------------------------------------------------
+euler_Q::euler_Q(const double &mpsi, const double &mtheta, const double &mphi, const bool &mactive)
+//-------------------------------------------------------------
+{
+    psi = mpsi;
+    theta = mtheta;
+    phi = mphi;
+    active = mactive;
+    compose();
+}
+
+/*!
+  \brief Copy constructor
+  \param Q euler_Q object to duplicate
+*/
+
+//------------------------------------------------------
+euler_Q::euler_Q(const euler_Q& Q)
+//------------------------------------------------------
+{
+    *this = Q;
+}
+
+/*!
+  \brief Destructor
+*/
+
+//-------------------------------------
+euler_Q::~euler_Q() {}
+//-------------------------------------
+
+//-------------------------------------------------------------
+void euler_Q::set(const double &mpsi, const double &mtheta, const double &mphi)
+//-------------------------------------------------------------
+{
+    if ((mpsi == psi)&&(mtheta == theta)&&(mphi == phi))
+        return;
+    
+    psi = mpsi;
+    theta = mtheta;
+    phi = mphi;
+    compose();
+}
+
+/*!
+  \brief Standard operator = for euler_Q
+*/
+
+//----------------------------------------------------------------------
+euler_Q& euler_Q::operator = (const euler_Q& Q)
+//----------------------------------------------------------------------
+{
+    psi = Q.psi;
+    theta = Q.theta;
+    phi = Q.phi;
+    active = Q.active;
+    identity = Q.identity;
+    QS_g2l = Q.QS_g2l;
+    QE_g2l = Q.QE_g2l;
+    QS_l2g = Q.QS_l2g;
+    QE_l2g = Q.QE_l2g;
+    R_g2l = Q.R_g2l;
+    R_l2g = Q.R_l2g;
+    
+    return *this;
+}
+
+//--------------------------------------------------------------------------
+ostream& operator << (ostream& s, const euler_Q& Q)
+//--------------------------------------------------------------------------
+{
+    s << "Display euler_Q:\n";
+    s << "psi = " << Q.psi << "\t theta = " << Q.theta << "\t phi = " << Q.phi << "\t active = " << Q.active << "\n";
+    s << "QS_g2l: \n" << Q.QS_g2l << "\n";
+    s << "QE_g2l: \n" << Q.QE_g2l << "\n";
+    s << "\n";
+    
+    return s;
+}
+
+//Rotates one (6,6) tensor per orientation, or the same one for all of them if nA is 1 : out_n = op(Q_n)*A_n*trans(op(P_n))
+static cube rotate_batch_66(const int &N, const cube &Q, const bool &tq, const double *A, const int &nA, const cube &P, const bool &tp) {
+    
+    cube out(6,6,N);
+    double *o = out.memptr();
+    const double *q = Q.memptr();
+    const double *p = P.memptr();
+    batch_for(N, [&](const int &begin, const int &end) {
+        for (int n=begin; n<end; n++) {
+            const double *a = (nA == 1) ? A : A + 36*n;
+            rotate_66(o + 36*n, q + 36*n, tq, a, p + 36*n, tp);
+        }
+    });
+    return out;
+}
+
+//Rotates one Voigt vector per orientation, or the same one for all of them if nV is 1 : out_n = op(Q_n)*V_n
+static mat rotate_batch_6(const int &N, const cube &Q, const bool &tq, const double *V, const int &nV) {
+    
+    mat out(6,N);
+    double *o = out.memptr();
+    const double *q = Q.memptr();
+    batch_for(N, [&](const int &begin, const int &end) {
+        for (int n=begin; n<end; n++) {
+            const double *v = (nV == 1) ? V : V + 6*n;
+            rotate_6(o + 6*n, q + 36*n, tq, v);
+        }
+    });
+    return out;
+}
+
+//=====Private methods for rotation_batch===================================
+
+//-------------------------------------------------------------
+void rotation_batch::fill(const int &n, const mat &R)
+//-------------------------------------------------------------
+{
+    //Same matrices as fillQS(R) and fillQE(R), written in place in the slices
+    double a = R(0,0);
+    double b = R(0,1);
+    double c = R(0,2);
+    double d = R(1,0);
+    double e = R(1,1);
+    double f = R(1,2);
+    double g = R(2,0);
+    double h = R(2,1);
+    double i = R(2,2);
+    
+    //Rows 0-2 and columns 0-2 of QS and QE only differ by a factor 2 in the shear blocks
+    double *qs = QS_g2l.memptr() + 36*n;
+    double *qe = QE_g2l.memptr() + 36*n;
+    
+    double normal[3][3] = {{a*a, b*b, c*c}, {d*d, e*e, f*f}, {g*g, h*h, i*i}};
+    double normal_shear[3][3] = {{a*b, a*c, b*c}, {d*e, d*f, e*f}, {g*h, g*i, h*i}};
+    double shear_normal[3][3] = {{a*d, b*e, c*f}, {a*g, b*h, c*i}, {d*g, e*h, f*i}};
+    double shear[3][3] = {{d*b+a*e, d*c+a*f, e*c+b*f}, {g*b+a*h, g*c+a*i, h*c+b*i}, {g*e+d*h, g*f+d*i, h*f+e*i}};
+    
+    for (int k=0; k<3; k++) {
+        for (int l=0; l<3; l++) {
+            qs[k+6*l] = normal[k][l];
+            qe[k+6*l] = normal[k][l];
+            qs[k+6*(l+3)] = 2.*normal_shear[k][l];
+            qe[k+6*(l+3)] = normal_shear[k][l];
+            qs[k+3+6*l] = shear_normal[k][l];
+            qe[k+3+6*l] = 2.*shear_normal[k][l];
+            qs[k+3+6*(l+3)] = shear[k][l];
+            qe[k+3+6*(l+3)] = shear[k][l];
+        }
+    }
+}
+
+//=====Public methods for rotation_batch============================================
+
+/*!
+  \brief default constructor, no orientation
+*/
+
+//-------------------------------------------------------------
+rotation_batch::rotation_batch()
+//-------------------------------------------------------------
+{
+    N = 0;
+    active = false;
+}
+
+/*!
+  \brief Constructor with the Euler angles of the orientations
+  \param psi : first Euler angle (axis_psi) of each orientation
+  \param theta : second Euler angle (axis_theta) of each orientation
+  \param phi : third Euler angle (axis_phi) of each orientation
+  \param mactive : convention of the single-axis rotations. With false, the rotations are the ones of rotate_g2l_* and rotate_l2g_*
+*/
+
+//-------------------------------------------------------------
+rotation_batch::rotation_batch(const vec &psi, const vec &theta, const vec &phi, const bool &mactive)
+//-------------------------------------------------------------
+{
+    assert(psi.n_elem == theta.n_elem);
+    assert(psi.n_elem == phi.n_elem);
+    
+    N = psi.n_elem;
+    active = mactive;
+    QS_g2l.set_size(6,6,N);
+    QE_g2l.set_size(6,6,N);
+    
+    //The stress and strain rotations of the composed 3x3 rotation are the products of the single-axis ones
+    batch_for(N, [&](const int &begin, const int &end) {
+        for (int n=begin; n<end; n++) {
+            mat R = fillR(psi(n), theta(n), phi(n), active);
+            fill(n, R);
+        }
+    });
+}
+
+/*!
+  \brief Constructor with the unit quaternions of the orientations
+  \param q : (4,N) quaternions (w,x,y,z), one per column. The rotations from global to local are the ones of rotate_stress(V, R(q)) and rotate_strain(V, R(q))
+*/
+
+//-------------------------------------------------------------
+rotation_batch::rotation_batch(const mat &q)
+//-------------------------------------------------------------
+{
+    assert(q.n_rows == 4);
+    
+    N = q.n_cols;
+    active = true;
+    QS_g2l.set_size(6,6,N);
+    QE_g2l.set_size(6,6,N);
+    
+    batch_for(N, [&](const int &begin, const int &end) {
+        for (int n=begin; n<end; n++) {
+            double norm_q = sqrt(q(0,n)*q(0,n) + q(1,n)*q(1,n) + q(2,n)*q(2,n) + q(3,n)*q(3,n));
+            assert(norm_q > 0.);
+            double w = q(0,n)/norm_q;
+            double x = q(1,n)/norm_q;
+            double y = q(2,n)/norm_q;
+            double z = q(3,n)/norm_q;
+            mat R = { {1.-2.*(y*y+z*z), 2.*(x*y-w*z), 2.*(x*z+w*y)}, {2.*(x*y+w*z), 1.-2.*(x*x+z*z), 2.*(y*z-w*x)}, {2.*(x*z-w*y), 2.*(y*z+w*x), 1.-2.*(x*x+y*y)} };
+            fill(n, R);
+        }
+    });
+}
+
+/*!
+  \brief Copy constructor
+  \param rb rotation_batch object to duplicate
+*/
+
+//------------------------------------------------------
+rotation_batch::rotation_batch(const rotation_batch& rb)
+//------------------------------------------------------
+{
+    N = rb.N;
+    active = rb.active;
+    QS_g2l = rb.QS_g2l;
+    QE_g2l = rb.QE_g2l;
+}
+
+/*!
+  \brief Destructor
+*/
+
+//-------------------------------------
+rotation_batch::~rotation_batch() {}
+//-------------------------------------
+
+//-------------------------------------------------------------
+cube rotation_batch::rotate_g2l_L(const mat &L) const
+//-------------------------------------------------------------
+{
+    assert((L.n_rows == 6)&&(L.n_cols == 6));
+    return rotate_batch_66(N, QS_g2l, false, L.memptr(), 1, QS_g2l, false);
+}
+
+//-------------------------------------------------------------
+cube rotation_batch::rotate_g2l_L(const cube &L) const
+//-------------------------------------------------------------
+{
+    assert((L.n_rows == 6)&&(L.n_cols == 6)&&(int(L.n_slices) == N));
+    return rotate_batch_66(N, QS_g2l, false, L.memptr(), N, QS_g2l, false);
+}
+
+//-------------------------------------------------------------
+cube rotation_batch::rotate_l2g_L(const mat &L) const
+//-------------------------------------------------------------
+{
+    assert((L.n_rows == 6)&&(L.n_cols == 6));
+    return rotate_batch_66(N, QE_g2l, true, L.memptr(), 1, QE_g2l, true);
+}
+
+//-------------------------------------------------------------
+cube rotation_batch::rotate_l2g_L(const cube &L) const
+//-------------------------------------------------------------
+{
+    assert((L.n_rows == 6)&&(L.n_cols == 6)&&(int(L.n_slices) == N));
+    return rotate_batch_66(N, QE_g2l, true, L.memptr(), N, QE_g2l, true);
+}
+
+//-------------------------------------------------------------
+cube rotation_batch::rotate_g2l_M(const mat &M) const
+//-------------------------------------------------------------
+{
+    assert((M.n_rows == 6)&&(M.n_cols == 6));
+    return rotate_batch_66(N, QE_g2l, false, M.memptr(), 1, QE_g2l, false);
+}
+
+//-------------------------------------------------------------
+cube rotation_batch::rotate_g2l_M(const cube &M) const
+//-------------------------------------------------------------
+{
+    assert((M.n_rows == 6)&&(M.n_cols == 6)&&(int(M.n_slices) == N));
+    return rotate_batch_66(N, QE_g2l, false, M.memptr(), N, QE_g2l, false);
+}
+
+//-------------------------------------------------------------
+cube rotation_batch::rotate_l2g_M(const mat &M) const
+//-------------------------------------------------------------
+{
+    assert((M.n_rows == 6)&&(M.n_cols == 6));
+    return rotate_batch_66(N, QS_g2l, true, M.memptr(), 1, QS_g2l, true);
+}
+
+//-------------------------------------------------------------
+cube rotation_batch::rotate_l2g_M(const cube &M) const
+//-------------------------------------------------------------
+{
+    assert((M.n_rows == 6)&&(M.n_cols == 6)&&(int(M.n_slices) == N));
+    return rotate_batch_66(N, QS_g2l, true, M.memptr(), N, QS_g2l, true);
+}
+
+//-------------------------------------------------------------
+mat rotation_batch::rotate_g2l_stress(const mat &S) const
+//-------------------------------------------------------------
+{
+    assert((S.n_rows == 6)&&((S.n_cols == 1)||(int(S.n_cols) == N)));
+    return rotate_batch_6(N, QS_g2l, false, S.memptr(), S.n_cols);
+}
+
+//-------------------------------------------------------------
+mat rotation_batch::rotate_l2g_stress(const mat &S) const
+//-------------------------------------------------------------
+{
+    assert((S.n_rows == 6)&&((S.n_cols == 1)||(int(S.n_cols) == N)));
+    return rotate_batch_6(N, QE_g2l, true, S.memptr(), S.n_cols);
+}
+
+//-------------------------------------------------------------
+mat rotation_batch::rotate_g2l_strain(const mat &E) const
+//-------------------------------------------------------------
+{
+    assert((E.n_rows == 6)&&((E.n_cols == 1)||(int(E.n_cols) == N)));
+    return rotate_batch_6(N, QE_g2l, false, E.memptr(), E.n_cols);
+}
+
+//-------------------------------------------------------------
+mat rotation_batch::rotate_l2g_strain(const mat &E) const
+//-------------------------------------------------------------
+{
+    assert((E.n_rows == 6)&&((E.n_cols == 1)||(int(E.n_cols) == N)));
+    return rotate_batch_6(N, QS_g2l, true, E.memptr(), E.n_cols);
+}
+
+/*!
+  \brief Standard operator = for rotation_batch
+*/
+
+//----------------------------------------------------------------------
+rotation_batch& rotation_batch::operator = (const rotation_batch& rb)
+//----------------------------------------------------------------------
+{
+    N = rb.N;
+    active = rb.active;
+    QS_g2l = rb.QS_g2l;
+    QE_g2l = rb.QE_g2l;
+    
+    return *this;
+}
+
+//--------------------------------------------------------------------------
+ostream& operator << (ostream& s, const rotation_batch& rb)
+//--------------------------------------------------------------------------
+{
+    s << "Display rotation_batch:\n";
+    s << "Number of orientations = " << rb.N << "\t active = " << rb.active << "\n";
+    s << "\n";
+    
+    return s;
+}
     
 } //namespace smart
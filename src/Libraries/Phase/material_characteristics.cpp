@@ -40,7 +40,7 @@ namespace smart{
 */
 
 //-------------------------------------------------------------
-material_characteristics::material_characteristics()
+material_characteristics::material_characteristics() : Q_mat(true)
 //-------------------------------------------------------------
 {
 	number=-1;
@@ -51,6 +51,13 @@ material_characteristics::material_characteristics()
 	phi_mat=0.;
 	
 	nprops=0;
+    
+    umat_id = 0;
+    umat_M = NULL;
+    umat_T = NULL;
+    init_M = NULL;
+    init_T = NULL;
+    path_data = "data";
 }
 
 /*!
@@ -63,7 +70,7 @@ material_characteristics::material_characteristics()
 */
 
 //-------------------------------------------------------------
-material_characteristics::material_characteristics(const int &n, const bool &init, const double &value)
+material_characteristics::material_characteristics(const int &n, const bool &init, const double &value) : Q_mat(true)
 //-------------------------------------------------------------
 {
 
@@ -83,6 +90,13 @@ material_characteristics::material_characteristics(const int &n, const bool &ini
     else{
         props = zeros(n);
     }
+    
+    umat_id = 0;
+    umat_M = NULL;
+    umat_T = NULL;
+    init_M = NULL;
+    init_T = NULL;
+    path_data = "data";
 }
 
 /*!
@@ -94,7 +108,7 @@ material_characteristics::material_characteristics(const int &n, const bool &ini
 */
 
 //-------------------------------------------------------------
-material_characteristics::material_characteristics(const int &mnumber, const string &mumat_name, const int &msave, const double &mpsi_mat, const double &mtheta_mat, const double &mphi_mat, const int &mnprops, const vec &mprops)
+material_characteristics::material_characteristics(const int &mnumber, const string &mumat_name, const int &msave, const double &mpsi_mat, const double &mtheta_mat, const double &mphi_mat, const int &mnprops, const vec &mprops) : Q_mat(true)
 //-------------------------------------------------------------
 {	
 	assert(mnprops);
@@ -109,6 +123,9 @@ material_characteristics::material_characteristics(const int &mnumber, const str
     
 	nprops = mnprops;
 	props = mprops;
+    path_data = "data";
+    
+    resolve_umat();
 }
 
 /*!
@@ -130,6 +147,17 @@ material_characteristics::material_characteristics(const material_characteristic
     
 	nprops = sv.nprops;
 	props = sv.props;
+    
+    umat_id = sv.umat_id;
+    umat_M = sv.umat_M;
+    umat_T = sv.umat_T;
+    init_M = sv.init_M;
+    init_T = sv.init_T;
+    sptr_constants_M = sv.sptr_constants_M;
+    sptr_constants_T = sv.sptr_constants_T;
+    tol = sv.tol;
+    Q_mat = sv.Q_mat;
+    path_data = sv.path_data;
 }
 
 /*!
@@ -148,6 +176,7 @@ void material_characteristics::resize()
 {
     assert(nprops > 0);
     props = zeros(nprops);
+    reset_constants();
 }
     
 //-------------------------------------------------------------
@@ -163,6 +192,7 @@ void material_characteristics::resize(const int &n, const bool &init, const doub
     else{
         props = zeros(n);
     }
+    reset_constants();
 }
 
 /*!
@@ -185,6 +215,59 @@ void material_characteristics::update(const int &mnumber, const string &mumat_na
     
     nprops = mnprops;
     props = mprops;
+    
+    resolve_umat();
+}
+    
+/*!
+  \brief Resolves umat_name into the handles of the umat registry, once for all the increments
+  If the name is not registered, umat_id is set to -1 and the handles to NULL : the error is raised when the model is called
+*/
+
+//-------------------------------------------------------------
+void material_characteristics::resolve_umat()
+//-------------------------------------------------------------
+{
+    const umat_entry *entry = find_umat(umat_name);
+    if (entry == NULL) {
+        umat_id = -1;
+        umat_M = NULL;
+        umat_T = NULL;
+        init_M = NULL;
+        init_T = NULL;
+    }
+    else {
+        umat_id = entry->id;
+        umat_M = entry->umat_M;
+        umat_T = entry->umat_T;
+        init_M = entry->init_M;
+        init_T = entry->init_T;
+    }
+    reset_constants();
+}
+
+/*!
+  \brief Discards the constants derived from the props : they are built again by the next call of the model
+*/
+
+//-------------------------------------------------------------
+void material_characteristics::reset_constants()
+//-------------------------------------------------------------
+{
+    sptr_constants_M.reset();
+    sptr_constants_T.reset();
+}
+
+/*!
+  \brief Returns the composed rotation matrices of the orientation of the material (psi_mat, theta_mat, phi_mat), composed again only if the angles have changed
+*/
+
+//-------------------------------------------------------------
+const euler_Q& material_characteristics::rotation() const
+//-------------------------------------------------------------
+{
+    Q_mat.set(psi_mat, theta_mat, phi_mat);
+    return Q_mat;
 }
     
 //----------------------------------------------------------------------
@@ -204,6 +287,17 @@ material_characteristics& material_characteristics::operator = (const material_c
 	nprops = sv.nprops;
 	props = sv.props;
     
+    umat_id = sv.umat_id;
+    umat_M = sv.umat_M;
+    umat_T = sv.umat_T;
+    init_M = sv.init_M;
+    init_T = sv.init_T;
+    sptr_constants_M = sv.sptr_constants_M;
+    sptr_constants_T = sv.sptr_constants_T;
+    tol = sv.tol;
+    Q_mat = sv.Q_mat;
+    path_data = sv.path_data;
+    
 	return *this;
 }
 
@@ -0,0 +1,136 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file material_constants.cpp
+///@brief Constants derived from the props of a material, computed once and used by the constitutive models at each call
+///@version 1.0
+
+#include <iostream>
+#include <assert.h>
+#include <armadillo>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Phase/material_constants.hpp>
+#include <smartplus/Libraries/Continuum_Mechanics/constitutive.hpp>
+
+using namespace std;
+using namespace arma;
+
+namespace smart{
+
+//Constants of the material being computed, per thread
+static thread_local const material_constants *current_constants_ptr = NULL;
+
+//=====Private methods for material_constants===================================
+
+//=====Public methods for material_constants============================================
+
+/*!
+  \brief default constructor
+*/
+
+//-------------------------------------------------------------
+material_constants::material_constants()
+//-------------------------------------------------------------
+{
+}
+
+/*!
+  \brief Destructor
+*/
+
+//-------------------------------------
+material_constants::~material_constants() {}
+//-------------------------------------
+
+//-------------------------------------------------------------
+const material_constants* material_constants::current()
+//-------------------------------------------------------------
+{
+    return current_constants_ptr;
+}
+
+//-------------------------------------------------------------
+const material_constants* material_constants::set_current(const material_constants *constants)
+//-------------------------------------------------------------
+{
+    const material_constants *previous = current_constants_ptr;
+    current_constants_ptr = constants;
+    return previous;
+}
+
+/*!
+  \brief Constructor of the constants of an isotropic material
+  \param E : Young modulus
+  \param nu : Poisson ratio
+  \param alpha_iso : isotropic coefficient of thermal expansion
+*/
+
+//-------------------------------------------------------------
+isotropic_constants::isotropic_constants(const double &E, const double &nu, const double &alpha_iso)
+//-------------------------------------------------------------
+{
+    L = L_iso(E, nu, "Enu");
+    M = M_iso(E, nu, "Enu");
+    alpha = alpha_iso*Ith();
+    Ir05 = smart::Ir05();
+}
+
+/*!
+  \brief Destructor
+*/
+
+//-------------------------------------
+isotropic_constants::~isotropic_constants() {}
+//-------------------------------------
+
+/*!
+  \brief Constructor of the constants of a shape memory alloy, mixture of Austenite and Martensite
+  \param E_A : Young modulus of Austenite
+  \param E_M : Young modulus of Martensite
+  \param nu_A : Poisson ratio of Austenite
+  \param nu_M : Poisson ratio of Martensite
+  \param alphaA_iso : CTE of Austenite
+  \param alphaM_iso : CTE of Martensite
+*/
+
+//-------------------------------------------------------------
+sma_constants::sma_constants(const double &E_A, const double &E_M, const double &nu_A, const double &nu_M, const double &alphaA_iso, const double &alphaM_iso)
+//-------------------------------------------------------------
+{
+    K_A = E_A/(3.*(1.-2*nu_A));
+    mu_A = E_A/(2.*(1.+nu_A));
+
+    K_M = E_M/(3.*(1.-2*nu_M));
+    mu_M = E_M/(2.*(1.+nu_M));
+
+    M_A = M_iso(K_A, mu_A, "Kmu");
+    M_M = M_iso(K_M, mu_M, "Kmu");
+    DM = M_M - M_A;
+
+    Ith = smart::Ith();
+    Dalpha = (alphaM_iso - alphaA_iso)*Ith;
+}
+
+/*!
+  \brief Destructor
+*/
+
+//-------------------------------------
+sma_constants::~sma_constants() {}
+//-------------------------------------
+
+} //namespace smart
@@ -0,0 +1,157 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file phase_arena.cpp
+///@brief Flattened, index-based view of a tree of phases
+///@version 1.0
+
+#include <iostream>
+#include <vector>
+#include <assert.h>
+#include <armadillo>
+#include <smartplus/Libraries/Phase/phase_characteristics.hpp>
+#include <smartplus/Libraries/Phase/phase_arena.hpp>
+
+using namespace std;
+using namespace arma;
+
+namespace smart{
+
+//=====Private methods for phase_arena===================================
+
+//=====Public methods for phase_arena============================================
+
+/*!
+  \brief default constructor
+*/
+
+//-------------------------------------------------------------
+phase_arena::phase_arena()
+//-------------------------------------------------------------
+{
+
+}
+
+/*!
+  \brief Constructor with parameters
+  \param rve : root of the tree of phases
+  The arena stores pointers to the phases: it has to be built again if a vector of sub_phases is resized
+*/
+
+//-------------------------------------------------------------
+phase_arena::phase_arena(phase_characteristics &rve)
+//-------------------------------------------------------------
+{
+    build(rve);
+}
+
+/*!
+  \brief Copy constructor
+  \param pa phase_arena object to duplicate (the phases are not copied)
+*/
+
+//------------------------------------------------------
+phase_arena::phase_arena(const phase_arena& pa)
+//------------------------------------------------------
+{
+    phases = pa.phases;
+    parent = pa.parent;
+    first_child = pa.first_child;
+    nchildren = pa.nchildren;
+    depth = pa.depth;
+}
+
+/*!
+  \brief Destructor
+*/
+
+//-------------------------------------
+phase_arena::~phase_arena() {}
+//-------------------------------------
+
+//-------------------------------------------------------------
+void phase_arena::build(phase_characteristics &rve)
+//-------------------------------------------------------------
+{
+    //Count the phases to allocate the arrays only once
+    unsigned int nphases = 0;
+    std::vector<phase_characteristics*> stack = {&rve};
+    while (stack.size() > 0) {
+        phase_characteristics *pc = stack.back();
+        stack.pop_back();
+        nphases++;
+        for (auto &r : pc->sub_phases) {
+            stack.push_back(&r);
+        }
+    }
+
+    phases.resize(nphases);
+    parent.set_size(nphases);
+    first_child.set_size(nphases);
+    nchildren.set_size(nphases);
+    depth.set_size(nphases);
+
+    //Breadth-first traversal : the sub-phases of a phase get contiguous indices
+    phases[0] = &rve;
+    parent(0) = -1;
+    depth(0) = 0;
+    unsigned int next = 1;
+    for (unsigned int i=0; i<nphases; i++) {
+        first_child(i) = next;
+        nchildren(i) = phases[i]->sub_phases.size();
+        for (auto &r : phases[i]->sub_phases) {
+            phases[next] = &r;
+            parent(next) = i;
+            depth(next) = depth(i) + 1;
+            next++;
+        }
+    }
+    assert(next == nphases);
+}
+
+/*!
+  \brief Standard operator = for phase_arena
+*/
+
+//----------------------------------------------------------------------
+phase_arena& phase_arena::operator = (const phase_arena& pa)
+//----------------------------------------------------------------------
+{
+    phases = pa.phases;
+    parent = pa.parent;
+    first_child = pa.first_child;
+    nchildren = pa.nchildren;
+    depth = pa.depth;
+
+    return *this;
+}
+
+//--------------------------------------------------------------------------
+ostream& operator << (ostream& s, const phase_arena& pa)
+//--------------------------------------------------------------------------
+{
+    s << "Display phase arena:\n";
+    s << "index\t number\t parent\t depth\t nchildren\n";
+    for (unsigned int i=0; i<pa.phases.size(); i++) {
+        s << i << "\t" << pa.phases[i]->sptr_matprops->number << "\t" << pa.parent(i) << "\t" << pa.depth(i) << "\t" << pa.nchildren(i) << "\n";
+    }
+    s << "\n";
+
+    return s;
+}
+
+} //namespace smart
@@ -63,6 +63,7 @@ phase_characteristics::phase_characteristics()
     shape_type = 0;
     sv_type = 0;
     sptr_matprops = std::make_shared<material_characteristics>();
+    at_start = false;
     
     //Note : the construction of sptr_shape = std::make_shared.. and sptr_sv = std::make_shared.. is made in construct(int, int)
    
@@ -87,6 +88,7 @@ phase_characteristics::phase_characteristics(const int &mshape_type, const int &
     sptr_out_global = msptr_out_global;
     sptr_out_local = msptr_out_local;
     sub_phases_file = msub_phases_file;
+    at_start = false;
 }
 
 /*!
@@ -110,6 +112,7 @@ phase_characteristics::phase_characteristics(const phase_characteristics& pc)
     
     sub_phases = pc.sub_phases;
     sub_phases_file = pc.sub_phases_file;
+    at_start = false;   //The state variables are shared : nothing is known of the writes made through the other object
 }
     
 
@@ -136,6 +139,7 @@ void phase_characteristics::construct(const int &mshape_type, const int &msv_typ
     
     shape_type = mshape_type;
     sv_type = msv_type;
+    at_start = false;
     
     //Switch case for the geometry of the phase
     switch (shape_type) {
@@ -205,24 +209,32 @@ void phase_characteristics::sub_phases_construct(const int &nphases, const int &
     for (int i=0; i<nphases; i++) {
         sub_phases[i].construct(mshape_type, msv_type);
     }
+    at_start = false;
 }
     
+/*!
+  \brief Rollback : the current values of all the phases go back to their start values
+  Nothing is copied if the phase has not been written since the last set_start or to_start (at_start is true). Otherwise the copy covers all the sub-phases, whatever their own flag.
+*/
+
 //----------------------------------------------------------------------
 void phase_characteristics::to_start()
 //----------------------------------------------------------------------
 {
+    if (at_start)
+        return;
     
     switch (sv_type) {
         case 1: {
-            auto sv_M_g = std::dynamic_pointer_cast<state_variables_M>(sptr_sv_global);
-            auto sv_M_l = std::dynamic_pointer_cast<state_variables_M>(sptr_sv_local);
+            auto sv_M_g = sv_global<state_variables_M>();
+            auto sv_M_l = sv_local<state_variables_M>();
             sv_M_g->to_start();
             sv_M_l->to_start();
             break;
         }
         case 2: {
-            auto sv_T_g = std::dynamic_pointer_cast<state_variables_T>(sptr_sv_global);
-            auto sv_T_l = std::dynamic_pointer_cast<state_variables_T>(sptr_sv_local);
+            auto sv_T_g = sv_global<state_variables_T>();
+            auto sv_T_l = sv_local<state_variables_T>();
             sv_T_g->to_start();
             sv_T_l->to_start();
             break;
@@ -234,10 +246,11 @@ void phase_characteristics::to_start()
         }
     }
     sptr_multi->to_start();
-    for(auto r : sub_phases) {
+    for(auto &r : sub_phases) {
+        r.at_start = false;
         r.to_start();
     }
-    
+    at_start = true;
 }
     
 //----------------------------------------------------------------------
@@ -246,15 +259,15 @@ void phase_characteristics::set_start()
 {
     switch (sv_type) {
         case 1: {
-            auto sv_M_g = std::dynamic_pointer_cast<state_variables_M>(sptr_sv_global);
-            auto sv_M_l = std::dynamic_pointer_cast<state_variables_M>(sptr_sv_local);
+            auto sv_M_g = sv_global<state_variables_M>();
+            auto sv_M_l = sv_local<state_variables_M>();
             sv_M_g->set_start();
             sv_M_l->set_start();
             break;
         }
         case 2: {
-            auto sv_T_g = std::dynamic_pointer_cast<state_variables_T>(sptr_sv_global);
-            auto sv_T_l = std::dynamic_pointer_cast<state_variables_T>(sptr_sv_local);
+            auto sv_T_g = sv_global<state_variables_T>();
+            auto sv_T_l = sv_local<state_variables_T>();
             sv_T_g->set_start();
             sv_T_l->set_start();
             break;
@@ -266,9 +279,10 @@ void phase_characteristics::set_start()
         }
     }
     sptr_multi->set_start();
-    for(auto r : sub_phases) {
+    for(auto &r : sub_phases) {
         r.set_start();
     }
+    at_start = true;
 }
 
 //-------------------------------------------------------------
@@ -278,15 +292,15 @@ void phase_characteristics::local2global()
     //Switch case for the state_variables type of the phase
     switch (sv_type) {
         case 1: {
-            auto sv_M_g = std::dynamic_pointer_cast<state_variables_M>(sptr_sv_global);
-            auto sv_M_l = std::dynamic_pointer_cast<state_variables_M>(sptr_sv_local);
-            sv_M_g->rotate_l2g(*sv_M_l, sptr_matprops->psi_mat, sptr_matprops->theta_mat, sptr_matprops->phi_mat);
+            auto sv_M_g = sv_global<state_variables_M>();
+            auto sv_M_l = sv_local<state_variables_M>();
+            sv_M_g->rotate_l2g(*sv_M_l, sptr_matprops->rotation());
             break;
         }
         case 2: {
-            auto sv_T_g = std::dynamic_pointer_cast<state_variables_T>(sptr_sv_global);
-            auto sv_T_l = std::dynamic_pointer_cast<state_variables_T>(sptr_sv_local);
-            sv_T_g->rotate_l2g(*sv_T_l, sptr_matprops->psi_mat, sptr_matprops->theta_mat, sptr_matprops->phi_mat);
+            auto sv_T_g = sv_global<state_variables_T>();
+            auto sv_T_l = sv_local<state_variables_T>();
+            sv_T_g->rotate_l2g(*sv_T_l, sptr_matprops->rotation());
             break;
         }
         default: {
@@ -305,15 +319,15 @@ void phase_characteristics::global2local()
     //Switch case for the state_variables type of the phase
     switch (sv_type) {
         case 1: {
-            auto sv_M_g = std::dynamic_pointer_cast<state_variables_M>(sptr_sv_global);
-            auto sv_M_l = std::dynamic_pointer_cast<state_variables_M>(sptr_sv_local);
-            sv_M_l->rotate_g2l(*sv_M_g, sptr_matprops->psi_mat, sptr_matprops->theta_mat, sptr_matprops->phi_mat);
+            auto sv_M_g = sv_global<state_variables_M>();
+            auto sv_M_l = sv_local<state_variables_M>();
+            sv_M_l->rotate_g2l(*sv_M_g, sptr_matprops->rotation());
             break;
         }
         case 2: {
-            auto sv_T_g = std::dynamic_pointer_cast<state_variables_T>(sptr_sv_global);
-            auto sv_T_l = std::dynamic_pointer_cast<state_variables_T>(sptr_sv_local);
-            sv_T_l->rotate_g2l(*sv_T_g, sptr_matprops->psi_mat, sptr_matprops->theta_mat, sptr_matprops->phi_mat);
+            auto sv_T_g = sv_global<state_variables_T>();
+            auto sv_T_l = sv_local<state_variables_T>();
+            sv_T_l->rotate_g2l(*sv_T_g, sptr_matprops->rotation());
             break;
         }
         default: {
@@ -339,6 +353,7 @@ phase_characteristics& phase_characteristics::operator = (const phase_characteri
     
     sub_phases = pc.sub_phases;
     sub_phases_file = pc.sub_phases_file;
+    at_start = false;
     
     return *this;
 }
@@ -394,7 +409,7 @@ void phase_characteristics::output(const solver_output &so, const int &kblock, c
                 }
                 case 2: {
                     //We need to cast sv
-                    std::shared_ptr<state_variables_T> sv_T = std::dynamic_pointer_cast<state_variables_T>(sptr_sv_global);
+                    state_variables_T *sv_T = sv_global<state_variables_T>();
                     *sptr_out_global << sv_T->T  << "\t";
                     *sptr_out_global << sv_T->Q << "\t";                //This is for the flux
                     *sptr_out_global << sv_T->r << "\t";                //This is for the r
@@ -420,7 +435,7 @@ void phase_characteristics::output(const solver_output &so, const int &kblock, c
 
         switch (sv_type) {
             case 1: {
-                std::shared_ptr<state_variables_M> sv_M = std::dynamic_pointer_cast<state_variables_M>(sptr_sv_global);
+                state_variables_M *sv_M = sv_global<state_variables_M>();
                 *sptr_out_global << sv_M->Wm(0)  << "\t";
                 *sptr_out_global << sv_M->Wm(1)  << "\t";
                 *sptr_out_global << sv_M->Wm(2)  << "\t";
@@ -429,7 +444,7 @@ void phase_characteristics::output(const solver_output &so, const int &kblock, c
             }
             case 2: {
                 //We need to cast sv
-                std::shared_ptr<state_variables_T> sv_T = std::dynamic_pointer_cast<state_variables_T>(sptr_sv_global);
+                state_variables_T *sv_T = sv_global<state_variables_T>();
                 *sptr_out_global << sv_T->Wm(0)  << "\t";
                 *sptr_out_global << sv_T->Wm(1)  << "\t";
                 *sptr_out_global << sv_T->Wm(2)  << "\t";
@@ -460,9 +475,9 @@ void phase_characteristics::output(const solver_output &so, const int &kblock, c
                 }
             }
         }
-        *sptr_out_global << endl;
+        *sptr_out_global << "\n";
         
-        for(auto r : sub_phases) {
+        for(auto &r : sub_phases) {
             r.output(so, kblock, kcycle, kstep, kinc, Time, "global");
         }
     }
@@ -486,7 +501,7 @@ void phase_characteristics::output(const solver_output &so, const int &kblock, c
                     }
                     case 2: {
                         //We need to cast sv
-                        std::shared_ptr<state_variables_T> sv_T = std::dynamic_pointer_cast<state_variables_T>(sptr_sv_local);
+                        state_variables_T *sv_T = sv_local<state_variables_T>();
                         *sptr_out_local << sv_T->T  << "\t";
                         *sptr_out_local << sv_T->Q << "\t";                //This is for the flux
                         *sptr_out_local << sv_T->r << "\t";                //This is for the r
@@ -512,7 +527,7 @@ void phase_characteristics::output(const solver_output &so, const int &kblock, c
         
         switch (sv_type) {
             case 1: {
-                std::shared_ptr<state_variables_M> sv_M = std::dynamic_pointer_cast<state_variables_M>(sptr_sv_global);
+                state_variables_M *sv_M = sv_local<state_variables_M>();
                 *sptr_out_local << sv_M->Wm(0)  << "\t";
                 *sptr_out_local << sv_M->Wm(1)  << "\t";
                 *sptr_out_local << sv_M->Wm(2)  << "\t";
@@ -521,7 +536,7 @@ void phase_characteristics::output(const solver_output &so, const int &kblock, c
             }
             case 2: {
                 //We need to cast sv
-                std::shared_ptr<state_variables_T> sv_T = std::dynamic_pointer_cast<state_variables_T>(sptr_sv_global);
+                state_variables_T *sv_T = sv_local<state_variables_T>();
                 *sptr_out_local << sv_T->Wm(0)  << "\t";
                 *sptr_out_local << sv_T->Wm(1)  << "\t";
                 *sptr_out_local << sv_T->Wm(2)  << "\t";
@@ -552,9 +567,9 @@ void phase_characteristics::output(const solver_output &so, const int &kblock, c
                 }
             }
         }
-        *sptr_out_local << endl;
+        *sptr_out_local << "\n";
         
-        for(auto r : sub_phases) {
+        for(auto &r : sub_phases) {
             r.output(so, kblock, kcycle, kstep, kinc, Time, "local");
         }
         
@@ -579,7 +594,7 @@ ostream& operator << (ostream& s, const phase_characteristics& pc)
     s << "Display local state variables:\n";
     s << *pc.sptr_sv_local;
     
-    for(auto r : pc.sub_phases) {
+    for(auto &r : pc.sub_phases) {
         s << r;
     }
     
@@ -589,7 +604,7 @@ ostream& operator << (ostream& s, const phase_characteristics& pc)
 }
     
 //----------------------------------------------------------------------
-void phase_characteristics::copy(const phase_characteristics& pc)
+void phase_characteristics::copy(const phase_characteristics& pc, const bool &copy_sub_phases)
 //----------------------------------------------------------------------
 {
     shape_type =  pc.shape_type;
@@ -660,12 +675,14 @@ void phase_characteristics::copy(const phase_characteristics& pc)
     }
 
     sub_phases.clear();
-    for (unsigned int i=0; i<pc.sub_phases.size(); i++) {
-        phase_characteristics temp;
-        temp.copy(pc.sub_phases[i]);
-        sub_phases.push_back(temp);
+    if (copy_sub_phases) {
+        sub_phases.resize(pc.sub_phases.size());
+        for (unsigned int i=0; i<pc.sub_phases.size(); i++) {
+            sub_phases[i].copy(pc.sub_phases[i]);
+        }
     }
     sub_phases_file = pc.sub_phases_file;
+    at_start = false;
 }
 
 } //namespace smart
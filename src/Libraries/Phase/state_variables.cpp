@@ -271,6 +271,13 @@ void state_variables::set_start()
 //----------------------------------------------------------------------
 state_variables& state_variables::rotate_l2g(const state_variables& sv, const double &psi, const double &theta, const double &phi)
 //----------------------------------------------------------------------
+{
+    return state_variables::rotate_l2g(sv, euler_Q(psi, theta, phi, true));
+}
+
+//----------------------------------------------------------------------
+state_variables& state_variables::rotate_l2g(const state_variables& sv, const euler_Q &rot)
+//----------------------------------------------------------------------
 {
     
 	Etot = sv.Etot;
@@ -286,32 +293,14 @@ state_variables& state_variables::rotate_l2g(const state_variables& sv, const do
     statev = sv.statev;
     statev_start = sv.statev_start;
     
-    mat R = zeros(3,3);
-    
-  	if(fabs(phi) > iota) {
-		Etot = rotate_strain(Etot, -phi, axis_phi);
-		DEtot = rotate_strain(DEtot, -phi, axis_phi);
-		sigma = rotate_stress(sigma, -phi, axis_phi);
-		sigma_start = rotate_stress(sigma_start, -phi, axis_phi);
-        F0 = rotate_mat(F0, -phi, axis_phi);
-        F1 = rotate_mat(F1, -phi, axis_phi);
-	}
-  	if(fabs(theta) > iota) {
-		Etot = rotate_strain(Etot, -theta, axis_theta);
-		DEtot = rotate_strain(DEtot, -theta, axis_theta);
-		sigma = rotate_stress(sigma, -theta, axis_theta);
-		sigma_start = rotate_stress(sigma_start, -theta, axis_theta);
-        F0 = rotate_mat(F0, -theta, axis_theta);
-        F1 = rotate_mat(F1, -theta, axis_theta);
-	}
-	if(fabs(psi) > iota) {
-		Etot = rotate_strain(Etot, -psi, axis_psi);
-		DEtot = rotate_strain(DEtot, -psi, axis_psi);
-		sigma = rotate_stress(sigma, -psi, axis_psi);
-		sigma_start = rotate_stress(sigma_start, -psi, axis_psi);
-        F0 = rotate_mat(F0, -psi, axis_psi);
-        F1 = rotate_mat(F1, -psi, axis_psi);
-	}
+    if(!rot.identity) {
+        rotate_voigt(Etot, rot.QE_l2g, Etot);
+        rotate_voigt(DEtot, rot.QE_l2g, DEtot);
+        rotate_voigt(sigma, rot.QS_l2g, sigma);
+        rotate_voigt(sigma_start, rot.QS_l2g, sigma_start);
+        F0 = rotate_mat(F0, rot.R_l2g);
+        F1 = rotate_mat(F1, rot.R_l2g);
+    }
     
 	return *this;
 }
@@ -320,11 +309,18 @@ state_variables& state_variables::rotate_l2g(const state_variables& sv, const do
 state_variables& state_variables::rotate_g2l(const state_variables& sv, const double &psi, const double &theta, const double &phi)
 //----------------------------------------------------------------------
 {
+    return state_variables::rotate_g2l(sv, euler_Q(psi, theta, phi, true));
+}
 
-    Etot = sv.Etot;
-    DEtot = sv.DEtot;
-    sigma = sv.sigma;
-    sigma_start = sv.sigma_start;
+//----------------------------------------------------------------------
+state_variables& state_variables::rotate_g2l(const state_variables& sv, const euler_Q &rot)
+//----------------------------------------------------------------------
+{
+    
+	Etot = sv.Etot;
+	DEtot = sv.DEtot;
+	sigma = sv.sigma;
+	sigma_start = sv.sigma_start;
     F0 = sv.F0;
     F1 = sv.F1;
     T = sv.T;
@@ -332,31 +328,15 @@ state_variables& state_variables::rotate_g2l(const state_variables& sv, const do
     
     nstatev = sv.nstatev;
     statev = sv.statev;
-    statev_start = sv.statev_start;    
+    statev_start = sv.statev_start;
     
-  	if(fabs(psi) > iota) {
-		Etot = rotate_strain(Etot, psi, axis_psi);
-		DEtot = rotate_strain(DEtot, psi, axis_psi);
-		sigma = rotate_stress(sigma, psi, axis_psi);
-		sigma_start = rotate_stress(sigma_start, psi, axis_psi);
-        F0 = rotate_mat(F0, psi, axis_psi);
-        F1 = rotate_mat(F1, psi, axis_psi);
-	}
-	if(fabs(theta) > iota) {
-		Etot = rotate_strain(Etot, theta, axis_theta);
-		DEtot = rotate_strain(DEtot, theta, axis_theta);
-		sigma = rotate_stress(sigma, theta, axis_theta);
-		sigma_start = rotate_stress(sigma_start, theta, axis_theta);
-        F0 = rotate_mat(F0, theta, axis_theta);
-        F1 = rotate_mat(F1, theta, axis_theta);
-	}
-	if(fabs(phi) > iota) {
-		Etot = rotate_strain(Etot, phi, axis_phi);
-		DEtot = rotate_strain(DEtot, phi, axis_phi);
-		sigma = rotate_stress(sigma, phi, axis_phi);
-		sigma_start = rotate_stress(sigma_start, phi, axis_phi);
-        F0 = rotate_mat(F0, phi, axis_phi);
-        F1 = rotate_mat(F1, phi, axis_phi);
+    if(!rot.identity) {
+        rotate_voigt(Etot, rot.QE_g2l, Etot);
+        rotate_voigt(DEtot, rot.QE_g2l, DEtot);
+        rotate_voigt(sigma, rot.QS_g2l, sigma);
+        rotate_voigt(sigma_start, rot.QS_g2l, sigma_start);
+        F0 = rotate_mat(F0, rot.R_g2l);
+        F1 = rotate_mat(F1, rot.R_g2l);
     }
     
 	return *this;
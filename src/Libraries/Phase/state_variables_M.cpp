@@ -221,9 +221,16 @@ void state_variables_M::set_start()
 //----------------------------------------------------------------------
 state_variables_M& state_variables_M::rotate_l2g(const state_variables_M& sv, const double &psi, const double &theta, const double &phi)
 //----------------------------------------------------------------------
+{
+    return rotate_l2g(sv, euler_Q(psi, theta, phi, true));
+}
+
+//----------------------------------------------------------------------
+state_variables_M& state_variables_M::rotate_l2g(const state_variables_M& sv, const euler_Q &rot)
+//----------------------------------------------------------------------
 {
     
-    state_variables::rotate_l2g(sv, psi, theta, phi);
+    state_variables::rotate_l2g(sv, rot);
     
     sigma_in = sv.sigma_in;
     sigma_in_start = sv.sigma_in_start;
@@ -234,24 +241,12 @@ state_variables_M& state_variables_M::rotate_l2g(const state_variables_M& sv, co
 	L = sv.L;
 	Lt = sv.Lt;
     
-  	if(fabs(phi) > iota) {
-        sigma_in = rotate_stress(sigma_in, -phi, axis_phi);
-        sigma_in_start = rotate_stress(sigma_in_start, -phi, axis_phi);
-		L = rotateL(L, -phi, axis_phi);
-		Lt = rotateL(Lt, -phi, axis_phi);
-	}
-  	if(fabs(theta) > iota) {
-        sigma_in = rotate_stress(sigma_in, -theta, axis_theta);
-        sigma_in_start = rotate_stress(sigma_in_start, -theta, axis_theta);
-		Lt = rotateL(Lt, -theta, axis_theta);
-		L = rotateL(L, -theta, axis_theta);
-	}
-	if(fabs(psi) > iota) {
-        sigma_in = rotate_stress(sigma_in, -psi, axis_psi);
-        sigma_in_start = rotate_stress(sigma_in_start, -psi, axis_psi);
-		Lt = rotateL(Lt, -psi, axis_psi);
-		L = rotateL(L, -psi, axis_psi);        
-	}
+    if(!rot.identity) {
+        rotate_voigt(sigma_in, rot.QS_l2g, sigma_in);
+        rotate_voigt(sigma_in_start, rot.QS_l2g, sigma_in_start);
+        rotate_voigt(L, rot.QS_l2g, L, rot.QS_l2g);
+        rotate_voigt(Lt, rot.QS_l2g, Lt, rot.QS_l2g);
+    }
     
 	return *this;
 }
@@ -260,35 +255,30 @@ state_variables_M& state_variables_M::rotate_l2g(const state_variables_M& sv, co
 state_variables_M& state_variables_M::rotate_g2l(const state_variables_M& sv, const double &psi, const double &theta, const double &phi)
 //----------------------------------------------------------------------
 {
+    return rotate_g2l(sv, euler_Q(psi, theta, phi, true));
+}
 
-    state_variables::rotate_g2l(sv, psi, theta, phi);
+//----------------------------------------------------------------------
+state_variables_M& state_variables_M::rotate_g2l(const state_variables_M& sv, const euler_Q &rot)
+//----------------------------------------------------------------------
+{
+    
+    state_variables::rotate_g2l(sv, rot);
     
     sigma_in = sv.sigma_in;
     sigma_in_start = sv.sigma_in_start;
     
     Wm = sv.Wm;
     Wm_start = sv.Wm_start;
-
-    L = sv.L;
-    Lt = sv.Lt;
     
-  	if(fabs(psi) > iota) {
-        sigma_in = rotate_stress(sigma_in, psi, axis_psi);
-        sigma_in_start = rotate_stress(sigma_in_start, psi, axis_psi);
-		L = rotateL(L, psi, axis_psi);
-		Lt = rotateL(Lt, psi, axis_psi);
-	}			
-	if(fabs(theta) > iota) {
-        sigma_in = rotate_stress(sigma_in, theta, axis_theta);
-        sigma_in_start = rotate_stress(sigma_in_start, theta, axis_theta);
-		L = rotateL(L, theta, axis_theta);
-		Lt = rotateL(Lt, theta, axis_theta);
-	}
-	if(fabs(phi) > iota) {
-        sigma_in = rotate_stress(sigma_in, phi, axis_phi);
-        sigma_in_start = rotate_stress(sigma_in_start, phi, axis_phi);
-		L = rotateL(L, phi, axis_phi);
-		Lt = rotateL(Lt, phi, axis_phi);
+	L = sv.L;
+	Lt = sv.Lt;
+    
+    if(!rot.identity) {
+        rotate_voigt(sigma_in, rot.QS_g2l, sigma_in);
+        rotate_voigt(sigma_in_start, rot.QS_g2l, sigma_in_start);
+        rotate_voigt(L, rot.QS_g2l, L, rot.QS_g2l);
+        rotate_voigt(Lt, rot.QS_g2l, Lt, rot.QS_g2l);
     }
     
 	return *this;
@@ -288,8 +288,15 @@ void state_variables_T::set_start()
 state_variables_T& state_variables_T::rotate_l2g(const state_variables_T& sv, const double &psi, const double &theta, const double &phi)
 //----------------------------------------------------------------------
 {
+    return rotate_l2g(sv, euler_Q(psi, theta, phi, true));
+}
 
-    state_variables::rotate_l2g(sv, psi, theta, phi);
+//----------------------------------------------------------------------
+state_variables_T& state_variables_T::rotate_l2g(const state_variables_T& sv, const euler_Q &rot)
+//----------------------------------------------------------------------
+{
+
+    state_variables::rotate_l2g(sv, rot);
 
     dSdE = sv.dSdE;
     dSdEt = sv.dSdEt;
@@ -306,30 +313,14 @@ state_variables_T& state_variables_T::rotate_l2g(const state_variables_T& sv, co
     Wm_start = sv.Wm_start;
     Wt_start = sv.Wt_start;
     
-  	if(fabs(phi) > iota) {
-        sigma_in = rotate_stress(sigma_in, -phi, axis_phi);
-        sigma_in_start = rotate_stress(sigma_in_start, -phi, axis_phi);
-		dSdE = rotateL(dSdE, -phi, axis_phi);
-		dSdEt = rotateL(dSdEt, -phi, axis_phi);
-        dSdT = rotate_stress(dSdT, -phi, axis_phi);
-		drdE = rotate_strain(drdE, -phi, axis_phi);
-	}
-  	if(fabs(theta) > iota) {
-        sigma_in = rotate_stress(sigma_in, -theta, axis_theta);
-        sigma_in_start = rotate_stress(sigma_in_start, -theta, axis_theta);
-		dSdE = rotateL(dSdE, -theta, axis_theta);
-		dSdEt = rotateL(dSdEt, -theta, axis_theta);
-        dSdT = rotate_stress(dSdT, -theta, axis_theta);
-		drdE = rotate_strain(drdE, -theta, axis_theta);
-	}
-	if(fabs(psi) > iota) {
-        sigma_in = rotate_stress(sigma_in, -psi, axis_psi);
-        sigma_in_start = rotate_stress(sigma_in_start, -psi, axis_psi);
-		dSdE = rotateL(dSdE, -psi, axis_psi);
-		dSdEt = rotateL(dSdEt, -psi, axis_psi);
-        dSdT = rotate_stress(dSdT, -psi, axis_psi);
-		drdE = rotate_strain(drdE, -psi, axis_psi);
-	}
+    if(!rot.identity) {
+        rotate_voigt(sigma_in, rot.QS_l2g, sigma_in);
+        rotate_voigt(sigma_in_start, rot.QS_l2g, sigma_in_start);
+        rotate_voigt(dSdE, rot.QS_l2g, dSdE, rot.QS_l2g);
+        rotate_voigt(dSdEt, rot.QS_l2g, dSdEt, rot.QS_l2g);
+        rotate_voigt(dSdT, rot.QS_l2g, dSdT);
+        rotate_voigt(drdE, rot.QE_l2g, drdE);
+    }
     
 	return *this;
 }
@@ -338,9 +329,16 @@ state_variables_T& state_variables_T::rotate_l2g(const state_variables_T& sv, co
 state_variables_T& state_variables_T::rotate_g2l(const state_variables_T& sv, const double &psi, const double &theta, const double &phi)
 //----------------------------------------------------------------------
 {
+    return rotate_g2l(sv, euler_Q(psi, theta, phi, true));
+}
+
+//----------------------------------------------------------------------
+state_variables_T& state_variables_T::rotate_g2l(const state_variables_T& sv, const euler_Q &rot)
+//----------------------------------------------------------------------
+{
+
+    state_variables::rotate_g2l(sv, rot);
 
-    state_variables::rotate_g2l(sv, psi, theta, phi);
-    
     sigma_in = sv.sigma_in;
     sigma_in_start = sv.sigma_in_start;
     
@@ -356,30 +354,13 @@ state_variables_T& state_variables_T::rotate_g2l(const state_variables_T& sv, co
     Wm_start = sv.Wm_start;
     Wt_start = sv.Wt_start;
     
-  	if(fabs(psi) > iota) {
-        sigma_in = rotate_stress(sigma_in, psi, axis_psi);
-        sigma_in_start = rotate_stress(sigma_in_start, psi, axis_psi);
-		dSdE = rotateL(dSdE, psi, axis_psi);
-		dSdEt = rotateL(dSdEt, psi, axis_psi);
-        dSdT = rotate_stress(dSdT, psi, axis_psi);
-        drdE = rotate_strain(drdE, psi, axis_psi);
-        
-	}			
-	if(fabs(theta) > iota) {
-        sigma_in = rotate_stress(sigma_in, theta, axis_theta);
-        sigma_in_start = rotate_stress(sigma_in_start, theta, axis_theta);
-		dSdE = rotateL(dSdE, theta, axis_theta);
-		dSdEt = rotateL(dSdEt, theta, axis_theta);
-        dSdT = rotate_stress(dSdT, theta, axis_theta);
-        drdE = rotate_strain(drdE, theta, axis_theta);
-	}
-	if(fabs(phi) > iota) {
-        sigma_in = rotate_stress(sigma_in, phi, axis_phi);
-        sigma_in_start = rotate_stress(sigma_in_start, phi, axis_phi);
-		dSdE = rotateL(dSdE, phi, axis_phi);
-		dSdEt = rotateL(dSdEt, phi, axis_phi);
-        dSdT = rotate_stress(dSdT, phi, axis_phi);
-        drdE = rotate_strain(drdE, phi, axis_phi);
+    if(!rot.identity) {
+        rotate_voigt(sigma_in, rot.QS_g2l, sigma_in);
+        rotate_voigt(sigma_in_start, rot.QS_g2l, sigma_in_start);
+        rotate_voigt(dSdE, rot.QS_g2l, dSdE, rot.QS_g2l);
+        rotate_voigt(dSdEt, rot.QS_g2l, dSdEt, rot.QS_g2l);
+        rotate_voigt(dSdT, rot.QS_g2l, dSdT);
+        rotate_voigt(drdE, rot.QE_g2l, drdE);
     }
     
 	return *this;
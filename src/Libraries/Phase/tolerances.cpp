@@ -0,0 +1,166 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file tolerances.cpp
+///@brief Numerical tolerances and iteration limits of the constitutive models, set at runtime
+///@version 1.0
+
+#include <iostream>
+#include <assert.h>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Phase/tolerances.hpp>
+
+using namespace std;
+
+namespace smart{
+
+//Tolerances of the material being computed, per thread
+static thread_local const tolerances *current_tolerances = NULL;
+
+//=====Private methods for tolerances===================================
+
+//=====Public methods for tolerances============================================
+
+/*!
+  \brief default constructor, the values are the global defaults
+*/
+
+//-------------------------------------------------------------
+tolerances::tolerances()
+//-------------------------------------------------------------
+{
+    *this = defaults();
+}
+
+/*!
+  \brief Constructor with parameters
+  \param mumat_maxiter : maximal number of iterations of the return mapping of a UMAT
+  \param mumat_precision : precision of the return mapping of a UMAT
+  \param mumat_substeps : maximal number of sub-increments of a UMAT increment (1 : no sub-stepping)
+  \param mmicro_maxiter : maximal number of iterations of the micromechanical schemes
+  \param mmicro_precision : precision of the micromechanical schemes
+  \param mmicro_points : maximal number of integration points of the Eshelby tensors in each direction (0 : the ones of the props)
+  \param mzero_limit : threshold under which a quantity is considered null
+  \param mzero_iota : threshold for the internal variables
+*/
+
+//-------------------------------------------------------------
+tolerances::tolerances(const int &mumat_maxiter, const double &mumat_precision, const int &mumat_substeps, const int &mmicro_maxiter, const double &mmicro_precision, const int &mmicro_points, const double &mzero_limit, const double &mzero_iota)
+//-------------------------------------------------------------
+{
+    assert(mumat_maxiter > 0);
+    assert(mumat_substeps > 0);
+    assert(mmicro_maxiter > 0);
+    assert(mmicro_points >= 0);
+
+    umat_maxiter = mumat_maxiter;
+    umat_precision = mumat_precision;
+    umat_substeps = mumat_substeps;
+    micro_maxiter = mmicro_maxiter;
+    micro_precision = mmicro_precision;
+    micro_points = mmicro_points;
+    zero_limit = mzero_limit;
+    zero_iota = mzero_iota;
+}
+
+/*!
+  \brief Copy constructor
+  \param tol tolerances object to duplicate
+*/
+
+//------------------------------------------------------
+tolerances::tolerances(const tolerances& tol)
+//------------------------------------------------------
+{
+    umat_maxiter = tol.umat_maxiter;
+    umat_precision = tol.umat_precision;
+    umat_substeps = tol.umat_substeps;
+    micro_maxiter = tol.micro_maxiter;
+    micro_precision = tol.micro_precision;
+    micro_points = tol.micro_points;
+    zero_limit = tol.zero_limit;
+    zero_iota = tol.zero_iota;
+}
+
+/*!
+  \brief Destructor
+*/
+
+//-------------------------------------
+tolerances::~tolerances() {}
+//-------------------------------------
+
+//-------------------------------------------------------------
+tolerances& tolerances::defaults()
+//-------------------------------------------------------------
+{
+    static thread_local tolerances tol_default(maxiter_umat, precision_umat, substeps_umat, maxiter_micro, precision_micro, points_micro, limit, iota);
+    return tol_default;
+}
+
+//-------------------------------------------------------------
+const tolerances& tolerances::current()
+//-------------------------------------------------------------
+{
+    if (current_tolerances == NULL)
+        return defaults();
+    return *current_tolerances;
+}
+
+//-------------------------------------------------------------
+const tolerances* tolerances::set_current(const tolerances *tol)
+//-------------------------------------------------------------
+{
+    const tolerances *previous = current_tolerances;
+    current_tolerances = tol;
+    return previous;
+}
+
+/*!
+  \brief Standard operator = for tolerances
+*/
+
+//----------------------------------------------------------------------
+tolerances& tolerances::operator = (const tolerances& tol)
+//----------------------------------------------------------------------
+{
+    umat_maxiter = tol.umat_maxiter;
+    umat_precision = tol.umat_precision;
+    umat_substeps = tol.umat_substeps;
+    micro_maxiter = tol.micro_maxiter;
+    micro_precision = tol.micro_precision;
+    micro_points = tol.micro_points;
+    zero_limit = tol.zero_limit;
+    zero_iota = tol.zero_iota;
+
+    return *this;
+}
+
+//--------------------------------------------------------------------------
+ostream& operator << (ostream& s, const tolerances& tol)
+//--------------------------------------------------------------------------
+{
+    s << "Display tolerances:\n";
+    s << "umat : maxiter = " << tol.umat_maxiter << "\t precision = " << tol.umat_precision << "\t substeps = " << tol.umat_substeps << "\n";
+    s << "micro : maxiter = " << tol.micro_maxiter << "\t precision = " << tol.micro_precision << "\t points = " << tol.micro_points << "\n";
+    s << "limit = " << tol.zero_limit << "\t iota = " << tol.zero_iota << "\n";
+    s << "\n";
+
+    return s;
+}
+
+} //namespace smart
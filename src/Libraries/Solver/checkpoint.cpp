@@ -0,0 +1,743 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file checkpoint.cpp
+///@brief Save and restore of the full state of a RVE and of the solver counters
+///@version 1.0
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <string.h>
+#include <assert.h>
+#include <boost/filesystem.hpp>
+#include <armadillo>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Phase/phase_characteristics.hpp>
+#include <smartplus/Libraries/Phase/material_characteristics.hpp>
+#include <smartplus/Libraries/Phase/state_variables.hpp>
+#include <smartplus/Libraries/Phase/state_variables_M.hpp>
+#include <smartplus/Libraries/Phase/state_variables_T.hpp>
+#include <smartplus/Libraries/Geometry/geometry.hpp>
+#include <smartplus/Libraries/Geometry/layer.hpp>
+#include <smartplus/Libraries/Geometry/ellipsoid.hpp>
+#include <smartplus/Libraries/Geometry/cylinder.hpp>
+#include <smartplus/Libraries/Homogenization/phase_multi.hpp>
+#include <smartplus/Libraries/Homogenization/layer_multi.hpp>
+#include <smartplus/Libraries/Homogenization/ellipsoid_multi.hpp>
+#include <smartplus/Libraries/Homogenization/cylinder_multi.hpp>
+#include <smartplus/Libraries/Solver/checkpoint.hpp>
+
+using namespace std;
+using namespace arma;
+
+namespace smart{
+
+//The state is packed in a vector of doubles : the scalars as they are, the matrices (and vectors) preceded by their dimensions
+
+static void pack(std::vector<double> &d, const double &value)
+{
+    d.push_back(value);
+}
+
+static void pack(std::vector<double> &d, const int &value)
+{
+    d.push_back(value);
+}
+
+static void pack(std::vector<double> &d, const mat &m)
+{
+    d.push_back(m.n_rows);
+    d.push_back(m.n_cols);
+    d.insert(d.end(), m.memptr(), m.memptr() + m.n_elem);
+}
+
+static void unpack(const std::vector<double> &d, unsigned int &pos, double &value)
+{
+    assert(pos < d.size());
+    value = d[pos++];
+}
+
+static void unpack(const std::vector<double> &d, unsigned int &pos, int &value)
+{
+    assert(pos < d.size());
+    value = int(d[pos++]);
+}
+
+template<class M> static void unpack(const std::vector<double> &d, unsigned int &pos, M &m)
+{
+    assert(pos+2 <= d.size());
+    int n_rows = int(d[pos]);
+    int n_cols = int(d[pos+1]);
+    pos += 2;
+    m.set_size(n_rows, n_cols);
+    assert(pos + m.n_elem <= d.size());
+    if (m.n_elem > 0)
+        memcpy(m.memptr(), &d[pos], sizeof(double)*m.n_elem);
+    pos += m.n_elem;
+}
+
+//Fields of the state variables, with those of the mechanical or thermomechanical ones
+static void pack_sv(std::vector<double> &d, const state_variables &sv, const int &sv_type)
+{
+    pack(d, sv.Etot);
+    pack(d, sv.DEtot);
+    pack(d, sv.sigma);
+    pack(d, sv.sigma_start);
+    pack(d, sv.F0);
+    pack(d, sv.F1);
+    pack(d, sv.T);
+    pack(d, sv.DT);
+    pack(d, sv.statev);
+    pack(d, sv.statev_start);
+
+    if (sv_type == 1) {
+        const state_variables_M &sv_M = static_cast<const state_variables_M&>(sv);
+        pack(d, sv_M.sigma_in);
+        pack(d, sv_M.sigma_in_start);
+        pack(d, sv_M.Wm);
+        pack(d, sv_M.Wm_start);
+        pack(d, sv_M.L);
+        pack(d, sv_M.Lt);
+    }
+    else if (sv_type == 2) {
+        const state_variables_T &sv_T = static_cast<const state_variables_T&>(sv);
+        pack(d, sv_T.sigma_in);
+        pack(d, sv_T.sigma_in_start);
+        pack(d, sv_T.Wm);
+        pack(d, sv_T.Wt);
+        pack(d, sv_T.Wm_start);
+        pack(d, sv_T.Wt_start);
+        pack(d, sv_T.dSdE);
+        pack(d, sv_T.dSdEt);
+        pack(d, sv_T.dSdT);
+        pack(d, sv_T.Q);
+        pack(d, sv_T.r);
+        pack(d, sv_T.r_in);
+        pack(d, sv_T.drdE);
+        pack(d, sv_T.drdT);
+    }
+}
+
+static void unpack_sv(const std::vector<double> &d, unsigned int &pos, state_variables &sv, const int &sv_type)
+{
+    unpack(d, pos, sv.Etot);
+    unpack(d, pos, sv.DEtot);
+    unpack(d, pos, sv.sigma);
+    unpack(d, pos, sv.sigma_start);
+    unpack(d, pos, sv.F0);
+    unpack(d, pos, sv.F1);
+    unpack(d, pos, sv.T);
+    unpack(d, pos, sv.DT);
+    unpack(d, pos, sv.statev);
+    unpack(d, pos, sv.statev_start);
+    sv.nstatev = sv.statev.n_elem;
+
+    if (sv_type == 1) {
+        state_variables_M &sv_M = static_cast<state_variables_M&>(sv);
+        unpack(d, pos, sv_M.sigma_in);
+        unpack(d, pos, sv_M.sigma_in_start);
+        unpack(d, pos, sv_M.Wm);
+        unpack(d, pos, sv_M.Wm_start);
+        unpack(d, pos, sv_M.L);
+        unpack(d, pos, sv_M.Lt);
+    }
+    else if (sv_type == 2) {
+        state_variables_T &sv_T = static_cast<state_variables_T&>(sv);
+        unpack(d, pos, sv_T.sigma_in);
+        unpack(d, pos, sv_T.sigma_in_start);
+        unpack(d, pos, sv_T.Wm);
+        unpack(d, pos, sv_T.Wt);
+        unpack(d, pos, sv_T.Wm_start);
+        unpack(d, pos, sv_T.Wt_start);
+        unpack(d, pos, sv_T.dSdE);
+        unpack(d, pos, sv_T.dSdEt);
+        unpack(d, pos, sv_T.dSdT);
+        unpack(d, pos, sv_T.Q);
+        unpack(d, pos, sv_T.r);
+        unpack(d, pos, sv_T.r_in);
+        unpack(d, pos, sv_T.drdE);
+        unpack(d, pos, sv_T.drdT);
+    }
+}
+
+//Geometry and concentration tensors of a phase
+static void pack_shape(std::vector<double> &d, const phase_characteristics &pc)
+{
+    pack(d, pc.sptr_shape->concentration);
+    pack(d, pc.sptr_multi->A);
+    pack(d, pc.sptr_multi->A_start);
+    pack(d, pc.sptr_multi->B);
+    pack(d, pc.sptr_multi->B_start);
+    pack(d, pc.sptr_multi->A_in);
+
+    switch (pc.shape_type) {
+        case 1: {
+            const layer *lay = pc.shape<layer>();
+            const layer_multi *lay_multi = pc.multi<layer_multi>();
+            pack(d, lay->layerup);
+            pack(d, lay->layerdown);
+            pack(d, lay->psi_geom);
+            pack(d, lay->theta_geom);
+            pack(d, lay->phi_geom);
+            pack(d, lay_multi->Dnn);
+            pack(d, lay_multi->Dnt);
+            pack(d, lay_multi->dXn);
+            pack(d, lay_multi->dXt);
+            pack(d, lay_multi->sigma_hat);
+            pack(d, lay_multi->dzdx1);
+            break;
+        }
+        case 2: {
+            const ellipsoid *elli = pc.shape<ellipsoid>();
+            const ellipsoid_multi *elli_multi = pc.multi<ellipsoid_multi>();
+            pack(d, elli->coatingof);
+            pack(d, elli->coatedby);
+            pack(d, elli->a1);
+            pack(d, elli->a2);
+            pack(d, elli->a3);
+            pack(d, elli->psi_geom);
+            pack(d, elli->theta_geom);
+            pack(d, elli->phi_geom);
+            pack(d, elli_multi->S_loc);
+            pack(d, elli_multi->P_loc);
+            pack(d, elli_multi->T_loc);
+            pack(d, elli_multi->T);
+            pack(d, elli_multi->T_in_loc);
+            pack(d, elli_multi->T_in);
+            break;
+        }
+        case 3: {
+            const cylinder *cyl = pc.shape<cylinder>();
+            const cylinder_multi *cyl_multi = pc.multi<cylinder_multi>();
+            pack(d, cyl->coatingof);
+            pack(d, cyl->coatedby);
+            pack(d, cyl->L);
+            pack(d, cyl->R);
+            pack(d, cyl->psi_geom);
+            pack(d, cyl->theta_geom);
+            pack(d, cyl->phi_geom);
+            pack(d, cyl_multi->T_loc);
+            pack(d, cyl_multi->T);
+            pack(d, cyl_multi->A_loc);
+            pack(d, cyl_multi->B_loc);
+            break;
+        }
+    }
+}
+
+static void unpack_shape(const std::vector<double> &d, unsigned int &pos, phase_characteristics &pc)
+{
+    unpack(d, pos, pc.sptr_shape->concentration);
+    unpack(d, pos, pc.sptr_multi->A);
+    unpack(d, pos, pc.sptr_multi->A_start);
+    unpack(d, pos, pc.sptr_multi->B);
+    unpack(d, pos, pc.sptr_multi->B_start);
+    unpack(d, pos, pc.sptr_multi->A_in);
+
+    switch (pc.shape_type) {
+        case 1: {
+            layer *lay = pc.shape<layer>();
+            layer_multi *lay_multi = pc.multi<layer_multi>();
+            unpack(d, pos, lay->layerup);
+            unpack(d, pos, lay->layerdown);
+            unpack(d, pos, lay->psi_geom);
+            unpack(d, pos, lay->theta_geom);
+            unpack(d, pos, lay->phi_geom);
+            unpack(d, pos, lay_multi->Dnn);
+            unpack(d, pos, lay_multi->Dnt);
+            unpack(d, pos, lay_multi->dXn);
+            unpack(d, pos, lay_multi->dXt);
+            unpack(d, pos, lay_multi->sigma_hat);
+            unpack(d, pos, lay_multi->dzdx1);
+            break;
+        }
+        case 2: {
+            ellipsoid *elli = pc.shape<ellipsoid>();
+            ellipsoid_multi *elli_multi = pc.multi<ellipsoid_multi>();
+            unpack(d, pos, elli->coatingof);
+            unpack(d, pos, elli->coatedby);
+            unpack(d, pos, elli->a1);
+            unpack(d, pos, elli->a2);
+            unpack(d, pos, elli->a3);
+            unpack(d, pos, elli->psi_geom);
+            unpack(d, pos, elli->theta_geom);
+            unpack(d, pos, elli->phi_geom);
+            unpack(d, pos, elli_multi->S_loc);
+            unpack(d, pos, elli_multi->P_loc);
+            unpack(d, pos, elli_multi->T_loc);
+            unpack(d, pos, elli_multi->T);
+            unpack(d, pos, elli_multi->T_in_loc);
+            unpack(d, pos, elli_multi->T_in);
+            break;
+        }
+        case 3: {
+            cylinder *cyl = pc.shape<cylinder>();
+            cylinder_multi *cyl_multi = pc.multi<cylinder_multi>();
+            unpack(d, pos, cyl->coatingof);
+            unpack(d, pos, cyl->coatedby);
+            unpack(d, pos, cyl->L);
+            unpack(d, pos, cyl->R);
+            unpack(d, pos, cyl->psi_geom);
+            unpack(d, pos, cyl->theta_geom);
+            unpack(d, pos, cyl->phi_geom);
+            unpack(d, pos, cyl_multi->T_loc);
+            unpack(d, pos, cyl_multi->T);
+            unpack(d, pos, cyl_multi->A_loc);
+            unpack(d, pos, cyl_multi->B_loc);
+            break;
+        }
+    }
+}
+
+//A phase and its sub-phases, depth-first. The types and the number of sub-phases are packed to check the structure when the state is restored
+static void pack_phase(std::vector<double> &d, const phase_characteristics &pc)
+{
+    pack(d, pc.shape_type);
+    pack(d, pc.sv_type);
+    pack(d, int(pc.sub_phases.size()));
+    pack_sv(d, *pc.sptr_sv_global, pc.sv_type);
+    pack_sv(d, *pc.sptr_sv_local, pc.sv_type);
+    pack_shape(d, pc);
+    for (auto &r : pc.sub_phases) {
+        pack_phase(d, r);
+    }
+}
+
+static void unpack_phase(const std::vector<double> &d, unsigned int &pos, phase_characteristics &pc)
+{
+    int shape_type = 0;
+    int sv_type = 0;
+    int nsub = 0;
+    unpack(d, pos, shape_type);
+    unpack(d, pos, sv_type);
+    unpack(d, pos, nsub);
+    if ((shape_type != pc.shape_type)||(sv_type != pc.sv_type)||(nsub != int(pc.sub_phases.size()))) {
+        cout << "error: The state does not correspond to the phases of the RVE\n";
+        exit(0);
+    }
+    unpack_sv(d, pos, *pc.sptr_sv_global, pc.sv_type);
+    unpack_sv(d, pos, *pc.sptr_sv_local, pc.sv_type);
+    unpack_shape(d, pos, pc);
+    for (auto &r : pc.sub_phases) {
+        unpack_phase(d, pos, r);
+    }
+}
+
+//Binary i/o of the checkpoint files
+
+template<class S> static void write_value(ofstream &of, const S &value)
+{
+    of.write(reinterpret_cast<const char*>(&value), sizeof(S));
+}
+
+template<class S> static void read_value(ifstream &in, S &value)
+{
+    in.read(reinterpret_cast<char*>(&value), sizeof(S));
+}
+
+static void write_string(ofstream &of, const string &s)
+{
+    int length = s.length();
+    write_value(of, length);
+    of.write(s.c_str(), length);
+}
+
+static void read_string(ifstream &in, string &s)
+{
+    int length = 0;
+    read_value(in, length);
+    s.assign(length, ' ');
+    if (length > 0)
+        in.read(&s[0], length);
+}
+
+static void write_vec(ofstream &of, const vec &v)
+{
+    int n = v.n_elem;
+    write_value(of, n);
+    of.write(reinterpret_cast<const char*>(v.memptr()), sizeof(double)*n);
+}
+
+static void read_vec(ifstream &in, vec &v)
+{
+    int n = 0;
+    read_value(in, n);
+    v.set_size(n);
+    in.read(reinterpret_cast<char*>(v.memptr()), sizeof(double)*n);
+}
+
+//Structure of the phases and their material : the RVE is built again from it before its state is restored
+static void write_structure(ofstream &of, const phase_characteristics &pc)
+{
+    const material_characteristics &mat = *pc.sptr_matprops;
+    write_value(of, pc.shape_type);
+    write_value(of, pc.sv_type);
+    write_string(of, pc.sub_phases_file);
+
+    write_value(of, mat.number);
+    write_string(of, mat.umat_name);
+    write_value(of, mat.save);
+    write_value(of, mat.psi_mat);
+    write_value(of, mat.theta_mat);
+    write_value(of, mat.phi_mat);
+    write_vec(of, mat.props);
+    write_value(of, mat.tol.umat_maxiter);
+    write_value(of, mat.tol.umat_precision);
+    write_value(of, mat.tol.umat_substeps);
+    write_value(of, mat.tol.micro_maxiter);
+    write_value(of, mat.tol.micro_precision);
+    write_value(of, mat.tol.micro_points);
+    write_value(of, mat.tol.zero_limit);
+    write_value(of, mat.tol.zero_iota);
+
+    int nsub = pc.sub_phases.size();
+    write_value(of, nsub);
+    for (auto &r : pc.sub_phases) {
+        write_structure(of, r);
+    }
+}
+
+static void read_structure(ifstream &in, phase_characteristics &pc)
+{
+    int shape_type = 0;
+    int sv_type = 0;
+    read_value(in, shape_type);
+    read_value(in, sv_type);
+    if ((!in)||(sv_type < 1)||(sv_type > 2)) {
+        cout << "error: The checkpoint file is corrupted\n";
+        exit(0);
+    }
+    pc.construct(shape_type, sv_type);
+    read_string(in, pc.sub_phases_file);
+
+    material_characteristics &mat = *pc.sptr_matprops;
+    read_value(in, mat.number);
+    read_string(in, mat.umat_name);
+    read_value(in, mat.save);
+    read_value(in, mat.psi_mat);
+    read_value(in, mat.theta_mat);
+    read_value(in, mat.phi_mat);
+    read_vec(in, mat.props);
+    mat.nprops = mat.props.n_elem;
+    read_value(in, mat.tol.umat_maxiter);
+    read_value(in, mat.tol.umat_precision);
+    read_value(in, mat.tol.umat_substeps);
+    read_value(in, mat.tol.micro_maxiter);
+    read_value(in, mat.tol.micro_precision);
+    read_value(in, mat.tol.micro_points);
+    read_value(in, mat.tol.zero_limit);
+    read_value(in, mat.tol.zero_iota);
+    mat.resolve_umat();
+
+    int nsub = 0;
+    read_value(in, nsub);
+    pc.sub_phases.resize(nsub);
+    for (auto &r : pc.sub_phases) {
+        read_structure(in, r);
+    }
+}
+
+//=====Private methods for phase_state===================================
+
+//=====Public methods for phase_state============================================
+
+/*!
+  \brief default constructor
+  A phase_state is a copy of all the fields of the phases of a RVE in a single contiguous buffer : the state variables
+  (global and local), the geometry and the concentration tensors. It is used to roll a RVE back to a previous state exactly,
+  and to write the checkpoint files
+*/
+
+//-------------------------------------------------------------
+phase_state::phase_state()
+//-------------------------------------------------------------
+{
+    pos = 0;
+}
+
+/*!
+  \brief Copy constructor
+  \param ps phase_state object to duplicate
+*/
+
+//------------------------------------------------------
+phase_state::phase_state(const phase_state& ps)
+//------------------------------------------------------
+{
+    pos = 0;
+    data = ps.data;
+}
+
+/*!
+  \brief Destructor
+*/
+
+//-------------------------------------
+phase_state::~phase_state() {}
+//-------------------------------------
+
+/*!
+  \brief Copies the state of a RVE. The buffer keeps its memory, so that saving the same RVE again does not allocate
+  \param rve : RVE
+*/
+
+//-------------------------------------------------------------
+void phase_state::save(const phase_characteristics &rve)
+//-------------------------------------------------------------
+{
+    data.clear();
+    pack_phase(data, rve);
+    pos = 0;
+}
+
+/*!
+  \brief Sets the state of a RVE, which must have the phases of the saved one (same types and sub-phases)
+  \param rve : RVE
+*/
+
+//-------------------------------------------------------------
+void phase_state::restore(phase_characteristics &rve)
+//-------------------------------------------------------------
+{
+    pos = 0;
+    unpack_phase(data, pos, rve);
+    assert(pos == data.size());
+    rve.at_start = false;
+}
+
+/*!
+  \brief Standard operator = for phase_state
+*/
+
+//----------------------------------------------------------------------
+phase_state& phase_state::operator = (const phase_state& ps)
+//----------------------------------------------------------------------
+{
+    pos = 0;
+    data = ps.data;
+
+    return *this;
+}
+
+//--------------------------------------------------------------------------
+ostream& operator << (ostream& s, const phase_state& ps)
+//--------------------------------------------------------------------------
+{
+    s << "Display info on the phase state:\n";
+    s << "Number of values = " << ps.data.size() << "\n";
+    s << "\n";
+
+    return s;
+}
+
+//=====Private methods for solver_checkpoint===================================
+
+//=====Public methods for solver_checkpoint============================================
+
+//@brief default constructor
+//-------------------------------------------------------------
+solver_checkpoint::solver_checkpoint()
+//-------------------------------------------------------------
+{
+    kblock = 0;
+    kcycle = 0;
+    Time = 0.;
+    tnew_dt = 1.;
+    Dtinc = 0.;
+    Dtinc_cur = 0.;
+    error = 0.;
+    o_ncount = 0;
+    o_tcount = 0.;
+}
+
+/*!
+  \brief Copy constructor
+  \param sc solver_checkpoint object to duplicate
+*/
+
+//------------------------------------------------------
+solver_checkpoint::solver_checkpoint(const solver_checkpoint& sc)
+//------------------------------------------------------
+{
+    kblock = sc.kblock;
+    kcycle = sc.kcycle;
+    Time = sc.Time;
+    tnew_dt = sc.tnew_dt;
+    Dtinc = sc.Dtinc;
+    Dtinc_cur = sc.Dtinc_cur;
+    error = sc.error;
+    residual = sc.residual;
+    o_ncount = sc.o_ncount;
+    o_tcount = sc.o_tcount;
+}
+
+/*!
+  \brief Destructor
+*/
+
+//-------------------------------------
+solver_checkpoint::~solver_checkpoint() {}
+//-------------------------------------
+
+/*!
+  \brief Writes the counters, the structure of the RVE (phases and materials) and its state in a binary file.
+  The file is written under a temporary name first, so that a crash while writing leaves the previous checkpoint intact.
+  \n
+  "SMARTCHK" | version | counters | quadrature of the ellipsoids | structure of the phases (depth-first) | state (see phase_state)
+  \param file : path of the file
+  \param rve : RVE
+*/
+
+//-------------------------------------------------------------
+void solver_checkpoint::save(const string &file, const phase_characteristics &rve) const
+//-------------------------------------------------------------
+{
+    string file_tmp = file + ".tmp";
+    ofstream of(file_tmp, ios::out | ios::binary | ios::trunc);
+    if(!of) {
+        cout << "error: the checkpoint file " << file_tmp << " could not be opened\n";
+        exit(0);
+    }
+
+    const char magic[8] = {'S','M','A','R','T','C','H','K'};
+    int version = 2;
+    of.write(magic, 8);
+    write_value(of, version);
+
+    write_value(of, kblock);
+    write_value(of, kcycle);
+    write_value(of, Time);
+    write_value(of, tnew_dt);
+    write_value(of, Dtinc);
+    write_value(of, Dtinc_cur);
+    write_value(of, error);
+    write_vec(of, residual);
+    write_value(of, o_ncount);
+    write_value(of, o_tcount);
+
+    //Quadrature of the Eshelby tensors, defined by the multiphase models at their first call
+    write_value(of, ellipsoid_multi::mp);
+    write_value(of, ellipsoid_multi::np);
+    write_vec(of, ellipsoid_multi::x);
+    write_vec(of, ellipsoid_multi::wx);
+    write_vec(of, ellipsoid_multi::y);
+    write_vec(of, ellipsoid_multi::wy);
+
+    write_structure(of, rve);
+
+    phase_state ps;
+    ps.save(rve);
+    vec state(ps.data.data(), ps.data.size(), false, true);
+    write_vec(of, state);
+    of.close();
+
+    boost::filesystem::rename(file_tmp, file);
+}
+
+/*!
+  \brief Reads a checkpoint file : the RVE is built again with its phases and materials, and its state is set bit for bit
+  \param file : path of the file
+  \param rve : RVE
+  \return false if the file does not exist
+*/
+
+//-------------------------------------------------------------
+bool solver_checkpoint::load(const string &file, phase_characteristics &rve)
+//-------------------------------------------------------------
+{
+    ifstream in(file, ios::in | ios::binary);
+    if(!in)
+        return false;
+
+    char magic[8];
+    int version = 0;
+    in.read(magic, 8);
+    read_value(in, version);
+    if((!in)||(strncmp(magic, "SMARTCHK", 8) != 0)||(version != 2)) {
+        cout << "error: " << file << " is not a checkpoint file\n";
+        exit(0);
+    }
+
+    read_value(in, kblock);
+    read_value(in, kcycle);
+    read_value(in, Time);
+    read_value(in, tnew_dt);
+    read_value(in, Dtinc);
+    read_value(in, Dtinc_cur);
+    read_value(in, error);
+    read_vec(in, residual);
+    read_value(in, o_ncount);
+    read_value(in, o_tcount);
+
+    read_value(in, ellipsoid_multi::mp);
+    read_value(in, ellipsoid_multi::np);
+    read_vec(in, ellipsoid_multi::x);
+    read_vec(in, ellipsoid_multi::wx);
+    read_vec(in, ellipsoid_multi::y);
+    read_vec(in, ellipsoid_multi::wy);
+
+    rve = phase_characteristics();
+    read_structure(in, rve);
+
+    vec state;
+    read_vec(in, state);
+    if(!in) {
+        cout << "error: The checkpoint file " << file << " is corrupted\n";
+        exit(0);
+    }
+    phase_state ps;
+    ps.data.assign(state.begin(), state.end());
+    ps.restore(rve);
+
+    return true;
+}
+
+/*!
+  \brief Standard operator = for solver_checkpoint
+*/
+
+//----------------------------------------------------------------------
+solver_checkpoint& solver_checkpoint::operator = (const solver_checkpoint& sc)
+//----------------------------------------------------------------------
+{
+    kblock = sc.kblock;
+    kcycle = sc.kcycle;
+    Time = sc.Time;
+    tnew_dt = sc.tnew_dt;
+    Dtinc = sc.Dtinc;
+    Dtinc_cur = sc.Dtinc_cur;
+    error = sc.error;
+    residual = sc.residual;
+    o_ncount = sc.o_ncount;
+    o_tcount = sc.o_tcount;
+
+    return *this;
+}
+
+//--------------------------------------------------------------------------
+ostream& operator << (ostream& s, const solver_checkpoint& sc)
+//--------------------------------------------------------------------------
+{
+    s << "Display info on the solver checkpoint:\n";
+    s << "Next block = " << sc.kblock+1 << "\t next cycle = " << sc.kcycle+1 << "\t Time = " << sc.Time << "\n";
+    s << "\n";
+
+    return s;
+}
+
+} //namespace smart
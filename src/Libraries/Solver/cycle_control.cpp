@@ -0,0 +1,133 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file cycle_control.cpp
+///@brief object that defines the treatment of the cycles of each block
+///@version 1.0
+
+#include <iostream>
+#include <assert.h>
+#include <armadillo>
+#include <smartplus/Libraries/Solver/cycle_control.hpp>
+
+using namespace std;
+using namespace arma;
+
+namespace smart{
+
+//=====Private methods for cycle_control===================================
+
+//=====Public methods for cycle_control============================================
+
+//@brief default constructor
+//-------------------------------------------------------------
+cycle_control::cycle_control()
+//-------------------------------------------------------------
+{
+
+}
+
+/*!
+ \brief Constructor with parameters : every cycle of every block is integrated
+ \param nblock : number of blocks
+ */
+
+//-------------------------------------------------------------
+cycle_control::cycle_control(const int &nblock)
+//-------------------------------------------------------------
+{
+    assert(nblock >= 0);
+
+    c_jump.zeros(nblock);
+    c_ncompute = 3*ones<Col<int> >(nblock);
+    c_tolerance = 5.E-2*ones(nblock);
+    c_njump_min = 5*ones<Col<int> >(nblock);
+    c_njump_max = 10000*ones<Col<int> >(nblock);
+
+    c_stab.zeros(nblock);
+    c_stab_tolerance = 1.E-3*ones(nblock);
+    c_stab_ncycles = 2*ones<Col<int> >(nblock);
+}
+
+/*!
+ \brief Copy constructor
+ \param cc cycle_control object to duplicate
+ */
+
+//------------------------------------------------------
+cycle_control::cycle_control(const cycle_control& cc)
+//------------------------------------------------------
+{
+    c_jump = cc.c_jump;
+    c_ncompute = cc.c_ncompute;
+    c_tolerance = cc.c_tolerance;
+    c_njump_min = cc.c_njump_min;
+    c_njump_max = cc.c_njump_max;
+    c_stab = cc.c_stab;
+    c_stab_tolerance = cc.c_stab_tolerance;
+    c_stab_ncycles = cc.c_stab_ncycles;
+}
+
+/*!
+ \brief destructor
+ */
+
+cycle_control::~cycle_control() {}
+
+//-------------------------------------------------------------
+bool cycle_control::active() const
+//-------------------------------------------------------------
+{
+    return ((accu(c_jump) > 0)||(accu(c_stab) > 0));
+}
+
+/*!
+ \brief Standard operator = for cycle_control objects
+ */
+
+//----------------------------------------------------------------------
+cycle_control& cycle_control::operator = (const cycle_control& cc)
+//----------------------------------------------------------------------
+{
+    c_jump = cc.c_jump;
+    c_ncompute = cc.c_ncompute;
+    c_tolerance = cc.c_tolerance;
+    c_njump_min = cc.c_njump_min;
+    c_njump_max = cc.c_njump_max;
+    c_stab = cc.c_stab;
+    c_stab_tolerance = cc.c_stab_tolerance;
+    c_stab_ncycles = cc.c_stab_ncycles;
+
+	return *this;
+}
+
+//--------------------------------------------------------------------------
+ostream& operator << (ostream& s, const cycle_control& cc)
+//--------------------------------------------------------------------------
+{
+	s << "Display info on the cycle control:\n";
+    s << "block\t jump\t ncompute\t tolerance\t njump_min\t njump_max\t stabilization\t tolerance\t ncycles\n";
+    for (unsigned int i=0; i<cc.c_jump.n_elem; i++) {
+        s << i+1 << "\t" << cc.c_jump(i) << "\t" << cc.c_ncompute(i) << "\t" << cc.c_tolerance(i) << "\t" << cc.c_njump_min(i) << "\t" << cc.c_njump_max(i);
+        s << "\t" << cc.c_stab(i) << "\t" << cc.c_stab_tolerance(i) << "\t" << cc.c_stab_ncycles(i) << "\n";
+    }
+    s << "\n";
+
+	return s;
+}
+
+} //namespace smart
@@ -0,0 +1,362 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file cycle_jump.cpp
+///@brief Extrapolation of the slowly evolving variables of a RVE over a large number of cycles
+///@version 1.0
+
+#include <iostream>
+#include <assert.h>
+#include <math.h>
+#include <armadillo>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Phase/phase_characteristics.hpp>
+#include <smartplus/Libraries/Phase/phase_arena.hpp>
+#include <smartplus/Libraries/Phase/state_variables_M.hpp>
+#include <smartplus/Libraries/Phase/state_variables_T.hpp>
+#include <smartplus/Libraries/Solver/cycle_jump.hpp>
+
+using namespace std;
+using namespace arma;
+
+namespace smart{
+
+//Number of values of the slow variables of a state_variables object
+static int nb_slow(const state_variables &sv, const int &sv_type)
+{
+    switch (sv_type) {
+        case 1: {
+            const state_variables_M &sv_M = static_cast<const state_variables_M&>(sv);
+            return sv_M.nstatev + sv_M.Wm.n_elem;
+        }
+        case 2: {
+            const state_variables_T &sv_T = static_cast<const state_variables_T&>(sv);
+            return sv_T.nstatev + sv_T.Wm.n_elem + sv_T.Wt.n_elem;
+        }
+        default: {
+            return sv.nstatev;
+        }
+    }
+}
+
+//Copies the slow variables of sv at the position pos of y (pack = true) or the reverse, in which case the start values are set as well
+static void copy_slow(state_variables &sv, const int &sv_type, vec &y, Col<int> &flags, int &pos, const bool &pack)
+{
+    auto copy = [&](vec &x, vec &x_start, const int &flag) {
+        if (x.n_elem == 0)
+            return;
+        if (pack) {
+            y.subvec(pos, pos+x.n_elem-1) = x;
+            flags.subvec(pos, pos+x.n_elem-1).fill(flag);
+        }
+        else {
+            x = y.subvec(pos, pos+x.n_elem-1);
+            x_start = x;
+        }
+        pos += x.n_elem;
+    };
+
+    copy(sv.statev, sv.statev_start, 1);
+    switch (sv_type) {
+        case 1: {
+            state_variables_M &sv_M = static_cast<state_variables_M&>(sv);
+            copy(sv_M.Wm, sv_M.Wm_start, 0);
+            break;
+        }
+        case 2: {
+            state_variables_T &sv_T = static_cast<state_variables_T&>(sv);
+            copy(sv_T.Wm, sv_T.Wm_start, 0);
+            copy(sv_T.Wt, sv_T.Wt_start, 0);
+            break;
+        }
+        default: {
+            break;
+        }
+    }
+}
+
+/*!
+  \brief Gathers the slow variables of all the phases of a RVE : the statev, then the works Wm (and Wt) of the global and the local state variables of each phase
+  \param rve : RVE
+  \param y : slow variables (output)
+  \param flags : 1 for the statev, 0 for the works (output)
+*/
+
+//-------------------------------------------------------------
+void pack_slow_variables(phase_characteristics &rve, vec &y, Col<int> &flags)
+//-------------------------------------------------------------
+{
+    phase_arena pa(rve);
+
+    int n = 0;
+    pa.visit([&](phase_characteristics &pc, const int &) {
+        n += nb_slow(*pc.sptr_sv_global, pc.sv_type) + nb_slow(*pc.sptr_sv_local, pc.sv_type);
+    });
+    y.zeros(n);
+    flags.zeros(n);
+
+    int pos = 0;
+    pa.visit([&](phase_characteristics &pc, const int &) {
+        copy_slow(*pc.sptr_sv_global, pc.sv_type, y, flags, pos, true);
+        copy_slow(*pc.sptr_sv_local, pc.sv_type, y, flags, pos, true);
+    });
+}
+
+/*!
+  \brief Sets the slow variables of all the phases of a RVE, and their start values
+  \param rve : RVE, with the same phases as when y was built
+  \param y : slow variables, built by pack_slow_variables
+*/
+
+//-------------------------------------------------------------
+void unpack_slow_variables(phase_characteristics &rve, const vec &y)
+//-------------------------------------------------------------
+{
+    phase_arena pa(rve);
+
+    vec x = y;
+    Col<int> flags;
+    int pos = 0;
+    pa.visit([&](phase_characteristics &pc, const int &) {
+        copy_slow(*pc.sptr_sv_global, pc.sv_type, x, flags, pos, false);
+        copy_slow(*pc.sptr_sv_local, pc.sv_type, x, flags, pos, false);
+    });
+    assert(pos == int(y.n_elem));
+}
+
+//=====Private methods for cycle_jump===================================
+
+//=====Public methods for cycle_jump============================================
+
+//@brief default constructor
+//-------------------------------------------------------------
+cycle_jump::cycle_jump()
+//-------------------------------------------------------------
+{
+    ncompute = 3;
+    tolerance = 5.E-2;
+    njump_min = 5;
+    njump_max = 10000;
+
+    nrecords = 0;
+    njumps = 0;
+    ncycles_jumped = 0;
+}
+
+/*!
+  \brief Constructor with parameters
+  \param mncompute : number of cycles integrated between two jumps (at least 2, to estimate the error of the extrapolation)
+  \param mtolerance : relative tolerance on the change and the extrapolation error of the statev over a jump
+  \param mnjump_min : minimal number of cycles of a jump
+  \param mnjump_max : maximal number of cycles of a jump
+*/
+
+//-------------------------------------------------------------
+cycle_jump::cycle_jump(const int &mncompute, const double &mtolerance, const int &mnjump_min, const int &mnjump_max)
+//-------------------------------------------------------------
+{
+    assert(mncompute >= 2);
+    assert(mtolerance > 0.);
+    assert(mnjump_min >= 1);
+    assert(mnjump_max >= mnjump_min);
+
+    ncompute = mncompute;
+    tolerance = mtolerance;
+    njump_min = mnjump_min;
+    njump_max = mnjump_max;
+
+    nrecords = 0;
+    njumps = 0;
+    ncycles_jumped = 0;
+}
+
+/*!
+  \brief Copy constructor
+  \param cj cycle_jump object to duplicate
+*/
+
+//------------------------------------------------------
+cycle_jump::cycle_jump(const cycle_jump& cj)
+//------------------------------------------------------
+{
+    ncompute = cj.ncompute;
+    tolerance = cj.tolerance;
+    njump_min = cj.njump_min;
+    njump_max = cj.njump_max;
+
+    history = cj.history;
+    is_statev = cj.is_statev;
+    times = cj.times;
+    nrecords = cj.nrecords;
+
+    njumps = cj.njumps;
+    ncycles_jumped = cj.ncycles_jumped;
+}
+
+/*!
+  \brief Destructor
+*/
+
+//-------------------------------------
+cycle_jump::~cycle_jump() {}
+//-------------------------------------
+
+//-------------------------------------------------------------
+void cycle_jump::reset()
+//-------------------------------------------------------------
+{
+    nrecords = 0;
+}
+
+/*!
+  \brief Records the slow variables of the RVE at the end of a cycle (or at the beginning of the block). Only the last three cycles are kept
+  \param rve : RVE, at a converged state
+  \param Time : current time
+*/
+
+//-------------------------------------------------------------
+void cycle_jump::record(phase_characteristics &rve, const double &Time)
+//-------------------------------------------------------------
+{
+    vec y;
+    pack_slow_variables(rve, y, is_statev);
+
+    if ((nrecords == 0)||(history.n_rows != y.n_elem)) {
+        history.zeros(y.n_elem, 3);
+        times.zeros(3);
+        nrecords = 0;
+    }
+
+    history.col(0) = history.col(1);
+    history.col(1) = history.col(2);
+    history.col(2) = y;
+    times(0) = times(1);
+    times(1) = times(2);
+    times(2) = Time;
+    nrecords++;
+}
+
+/*!
+  \brief Number of cycles over which the slow variables can be extrapolated linearly.
+  For each statev y that evolves, with r its change over the last cycle and c the change of r, the jump DN is bounded so that DN*|r| < tolerance*|y| (change over the jump) and DN^2*|c|/2 < tolerance*DN*|r| (error of the extrapolation)
+  \param nremaining : number of cycles remaining in the block
+  \return number of cycles of the jump, 0 if the history is too short or if the jump would be lower than njump_min
+*/
+
+//-------------------------------------------------------------
+int cycle_jump::size(const int &nremaining) const
+//-------------------------------------------------------------
+{
+    if ((nrecords < ncompute+1)||(nrecords < 3)||(nremaining < njump_min))
+        return 0;
+
+    vec r = history.col(2) - history.col(1);
+    vec c = r - (history.col(1) - history.col(0));
+
+    double njump = njump_max;
+    if (nremaining < njump)
+        njump = nremaining;
+
+    for (unsigned int i=0; i<r.n_elem; i++) {
+        if (is_statev(i) == 0)
+            continue;
+
+        double y_i = fabs(history(i,2));
+        double r_i = fabs(r(i));
+        double c_i = fabs(c(i));
+        if (r_i <= limit*(1. + y_i))
+            continue;
+
+        double njump_change = tolerance*y_i/r_i;
+        if (njump_change < njump)
+            njump = njump_change;
+
+        if (c_i > limit*(1. + y_i)) {
+            double njump_error = 2.*tolerance*r_i/c_i;
+            if (njump_error < njump)
+                njump = njump_error;
+        }
+    }
+
+    int n = int(floor(njump));
+    if (n < njump_min)
+        return 0;
+    return n;
+}
+
+/*!
+  \brief Extrapolates linearly the slow variables of the RVE over a number of cycles, from their change over the last cycle recorded. The mechanical state (strains, stresses, temperature) is the one at the end of the last cycle. The recorded cycles are cleared
+  \param rve : RVE, at the end of the last cycle recorded
+  \param njump : number of cycles extrapolated
+  \return time elapsed during the cycles extrapolated
+*/
+
+//-------------------------------------------------------------
+double cycle_jump::jump(phase_characteristics &rve, const int &njump)
+//-------------------------------------------------------------
+{
+    assert(nrecords >= 2);
+    assert(njump > 0);
+
+    unpack_slow_variables(rve, history.col(2) + njump*(history.col(2) - history.col(1)));
+
+    double DTime = njump*(times(2) - times(1));
+
+    njumps++;
+    ncycles_jumped += njump;
+    reset();
+    return DTime;
+}
+
+/*!
+  \brief Standard operator = for cycle_jump
+*/
+
+//----------------------------------------------------------------------
+cycle_jump& cycle_jump::operator = (const cycle_jump& cj)
+//----------------------------------------------------------------------
+{
+    ncompute = cj.ncompute;
+    tolerance = cj.tolerance;
+    njump_min = cj.njump_min;
+    njump_max = cj.njump_max;
+
+    history = cj.history;
+    is_statev = cj.is_statev;
+    times = cj.times;
+    nrecords = cj.nrecords;
+
+    njumps = cj.njumps;
+    ncycles_jumped = cj.ncycles_jumped;
+
+    return *this;
+}
+
+//--------------------------------------------------------------------------
+ostream& operator << (ostream& s, const cycle_jump& cj)
+//--------------------------------------------------------------------------
+{
+    s << "Display info on the cycle jump:\n";
+    s << "ncompute = " << cj.ncompute << "\t tolerance = " << cj.tolerance << "\t njump_min = " << cj.njump_min << "\t njump_max = " << cj.njump_max << "\n";
+    s << "Number of slow variables = " << cj.history.n_rows << "\t cycles recorded = " << cj.nrecords << "\n";
+    s << "Number of jumps = " << cj.njumps << "\t cycles extrapolated = " << cj.ncycles_jumped << "\n";
+    s << "\n";
+
+    return s;
+}
+
+} //namespace smart
@@ -0,0 +1,316 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file cycle_stabilization.cpp
+///@brief Detection of a periodic response of a RVE over the cycles of a block
+///@version 1.0
+
+#include <iostream>
+#include <assert.h>
+#include <math.h>
+#include <armadillo>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Phase/phase_characteristics.hpp>
+#include <smartplus/Libraries/Solver/output.hpp>
+#include <smartplus/Libraries/Solver/output_backend.hpp>
+#include <smartplus/Libraries/Solver/cycle_jump.hpp>
+#include <smartplus/Libraries/Solver/cycle_stabilization.hpp>
+
+using namespace std;
+using namespace arma;
+
+namespace smart{
+
+//=====Private methods for cycle_stabilization===================================
+
+//=====Public methods for cycle_stabilization============================================
+
+//@brief default constructor
+//-------------------------------------------------------------
+cycle_stabilization::cycle_stabilization()
+//-------------------------------------------------------------
+{
+    tolerance = 1.E-3;
+    ncycles = 2;
+
+    Time_cycle = 0.;
+    period = 0.;
+    errors = zeros(3);
+    nperiodic = 0;
+    ncompared = 0;
+}
+
+/*!
+  \brief Constructor with parameters
+  \param mtolerance : relative tolerance on the difference between the trajectories of two successive cycles
+  \param mncycles : number of successive periodic cycles required
+*/
+
+//-------------------------------------------------------------
+cycle_stabilization::cycle_stabilization(const double &mtolerance, const int &mncycles)
+//-------------------------------------------------------------
+{
+    assert(mtolerance > 0.);
+    assert(mncycles > 0);
+
+    tolerance = mtolerance;
+    ncycles = mncycles;
+
+    Time_cycle = 0.;
+    period = 0.;
+    errors = zeros(3);
+    nperiodic = 0;
+    ncompared = 0;
+}
+
+/*!
+  \brief Copy constructor
+  \param cs cycle_stabilization object to duplicate
+*/
+
+//------------------------------------------------------
+cycle_stabilization::cycle_stabilization(const cycle_stabilization& cs)
+//------------------------------------------------------
+{
+    tolerance = cs.tolerance;
+    ncycles = cs.ncycles;
+
+    trajectory = cs.trajectory;
+    trajectory_prev = cs.trajectory_prev;
+    statev_cycle = cs.statev_cycle;
+    slow_cycle = cs.slow_cycle;
+    Time_cycle = cs.Time_cycle;
+    period = cs.period;
+
+    records_global = cs.records_global;
+    records_local = cs.records_local;
+
+    errors = cs.errors;
+    nperiodic = cs.nperiodic;
+    ncompared = cs.ncompared;
+}
+
+/*!
+  \brief Destructor
+*/
+
+//-------------------------------------
+cycle_stabilization::~cycle_stabilization() {}
+//-------------------------------------
+
+//-------------------------------------------------------------
+void cycle_stabilization::reset()
+//-------------------------------------------------------------
+{
+    trajectory_prev.clear();
+    nperiodic = 0;
+}
+
+/*!
+  \brief Beginning of a cycle : the statev are compared relative to their values at this point, so that the accumulated ones (e.g. the cumulative plastic strain) can be periodic.
+  The slow variables of all the phases are kept to advance them over the skipped cycles
+  \param rve : RVE
+  \param Time : current time
+*/
+
+//-------------------------------------------------------------
+void cycle_stabilization::begin(phase_characteristics &rve, const double &Time)
+//-------------------------------------------------------------
+{
+    trajectory.clear();
+    records_global.clear();
+    records_local.clear();
+    statev_cycle = rve.sptr_sv_global->statev;
+    Col<int> flags;
+    pack_slow_variables(rve, slow_cycle, flags);
+    Time_cycle = Time;
+}
+
+/*!
+  \brief Samples the global response of the RVE at the end of a converged increment
+  \param rve : RVE
+*/
+
+//-------------------------------------------------------------
+void cycle_stabilization::sample(const phase_characteristics &rve)
+//-------------------------------------------------------------
+{
+    const state_variables &sv = *rve.sptr_sv_global;
+    vec y = zeros(12 + sv.nstatev);
+    y.subvec(0, 5) = sv.sigma;
+    y.subvec(6, 11) = sv.Etot;
+    if ((sv.nstatev > 0)&&(statev_cycle.n_elem == sv.statev.n_elem))
+        y.subvec(12, 11+sv.nstatev) = sv.statev - statev_cycle;
+    trajectory.push_back(y);
+}
+
+/*!
+  \brief Keeps the output records of an increment, to copy them once the response is periodic
+*/
+
+//-------------------------------------------------------------
+void cycle_stabilization::store(const phase_characteristics &rve, const solver_output &so, const output_backend &out_global, const output_backend &out_local, const int &kblock, const int &kcycle, const int &kstep, const int &kinc, const double &Time)
+//-------------------------------------------------------------
+{
+    vec record_global = zeros(out_global.nfields);
+    vec record_local = zeros(out_local.nfields);
+    output_record(rve, so, kblock, kcycle, kstep, kinc, Time, record_global, out_global.coordsys);
+    output_record(rve, so, kblock, kcycle, kstep, kinc, Time, record_local, out_local.coordsys);
+    records_global.push_back(record_global);
+    records_local.push_back(record_local);
+}
+
+/*!
+  \brief End of a cycle : its trajectory is compared with the one of the previous cycle, increment by increment.
+  The errors of sigma, Etot and of the change of the statev are the maximal differences divided by the maximal absolute values over the cycle
+  \param Time : current time
+  \return true if the last ncycles cycles were periodic within the tolerance
+*/
+
+//-------------------------------------------------------------
+bool cycle_stabilization::end(const double &Time)
+//-------------------------------------------------------------
+{
+    period = Time - Time_cycle;
+
+    bool comparable = ((trajectory.size() > 0)&&(trajectory.size() == trajectory_prev.size()));
+    for (unsigned int k=0; (comparable)&&(k<trajectory.size()); k++) {
+        comparable = (trajectory[k].n_elem == trajectory_prev[k].n_elem);
+    }
+
+    if (comparable) {
+        vec diff = zeros(3);
+        vec scale = zeros(3);
+        for (unsigned int k=0; k<trajectory.size(); k++) {
+            const vec &y = trajectory[k];
+            const vec &y_prev = trajectory_prev[k];
+            for (int g=0; g<3; g++) {
+                int first = 6*g;
+                int last = (g < 2) ? 6*g+5 : int(y.n_elem)-1;
+                if (last < first)
+                    continue;
+                double d = max(abs(y.subvec(first, last) - y_prev.subvec(first, last)));
+                double sc = max(abs(y.subvec(first, last)));
+                if (d > diff(g))
+                    diff(g) = d;
+                if (sc > scale(g))
+                    scale(g) = sc;
+            }
+        }
+        for (int g=0; g<3; g++) {
+            errors(g) = (scale(g) > limit) ? diff(g)/scale(g) : 0.;
+        }
+        ncompared++;
+
+        if (errors.max() <= tolerance)
+            nperiodic++;
+        else
+            nperiodic = 0;
+    }
+    else
+        nperiodic = 0;
+
+    trajectory_prev.swap(trajectory);
+    return (nperiodic >= ncycles);
+}
+
+/*!
+  \brief Writes the output records of the last cycle for the following cycles, with their cycle number and time shifted
+  \param out_global : output backend of the global fields
+  \param out_local : output backend of the local fields
+  \param ncopies : number of cycles
+*/
+
+//-------------------------------------------------------------
+void cycle_stabilization::replay(output_backend &out_global, output_backend &out_local, const int &ncopies) const
+//-------------------------------------------------------------
+{
+    for (int k=1; k<=ncopies; k++) {
+        for (unsigned int r=0; r<records_global.size(); r++) {
+            vec record_global = records_global[r];
+            vec record_local = records_local[r];
+            record_global(1) += k;
+            record_global(4) += k*period;
+            record_local(1) += k;
+            record_local(4) += k*period;
+            out_global.write_record(record_global);
+            out_local.write_record(record_local);
+        }
+    }
+}
+
+/*!
+  \brief Advances the slow variables of all the phases (the accumulated statev and the works) over the cycles that follow a periodic response :
+  each cycle changes them as much as the last one. The other variables are periodic and keep their values
+  \param rve : RVE, at the end of the last cycle
+  \param ncycles : number of cycles skipped
+*/
+
+//-------------------------------------------------------------
+void cycle_stabilization::skip(phase_characteristics &rve, const int &ncycles) const
+//-------------------------------------------------------------
+{
+    vec y;
+    Col<int> flags;
+    pack_slow_variables(rve, y, flags);
+    if ((ncycles <= 0)||(y.n_elem != slow_cycle.n_elem))
+        return;
+    unpack_slow_variables(rve, y + ncycles*(y - slow_cycle));
+}
+
+/*!
+  \brief Standard operator = for cycle_stabilization
+*/
+
+//----------------------------------------------------------------------
+cycle_stabilization& cycle_stabilization::operator = (const cycle_stabilization& cs)
+//----------------------------------------------------------------------
+{
+    tolerance = cs.tolerance;
+    ncycles = cs.ncycles;
+
+    trajectory = cs.trajectory;
+    trajectory_prev = cs.trajectory_prev;
+    statev_cycle = cs.statev_cycle;
+    slow_cycle = cs.slow_cycle;
+    Time_cycle = cs.Time_cycle;
+    period = cs.period;
+
+    records_global = cs.records_global;
+    records_local = cs.records_local;
+
+    errors = cs.errors;
+    nperiodic = cs.nperiodic;
+    ncompared = cs.ncompared;
+
+    return *this;
+}
+
+//--------------------------------------------------------------------------
+ostream& operator << (ostream& s, const cycle_stabilization& cs)
+//--------------------------------------------------------------------------
+{
+    s << "Display info on the cycle stabilization:\n";
+    s << "tolerance = " << cs.tolerance << "\t ncycles = " << cs.ncycles << "\n";
+    s << "Cycles compared = " << cs.ncompared << "\t successive periodic cycles = " << cs.nperiodic << "\n";
+    s << "Errors : sigma = " << cs.errors(0) << "\t Etot = " << cs.errors(1) << "\t statev = " << cs.errors(2) << "\n";
+    s << "\n";
+
+    return s;
+}
+
+} //namespace smart
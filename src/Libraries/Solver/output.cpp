@@ -44,6 +44,11 @@ solver_output::solver_output()
     o_nb_meca = 0;
     o_nb_T = 0;
     o_nw_statev = 0;
+    
+    o_format = 0;
+    o_chunk = 256;
+    o_async = 0;
+    o_nbuffer = 64;
 }
 
 /*!
@@ -59,6 +64,11 @@ solver_output::solver_output(const int &nblock)
     o_nb_T = 0;
     o_nw_statev = 0;
     
+    o_format = 0;
+    o_chunk = 256;
+    o_async = 0;
+    o_nbuffer = 64;
+    
     o_type.zeros(nblock);
     o_nfreq.zeros(nblock);
     o_tfreq.zeros(nblock);
@@ -83,6 +93,10 @@ solver_output::solver_output(const solver_output& so)
     o_type = so.o_type;
     o_nfreq = so.o_nfreq;
     o_tfreq = so.o_tfreq;
+    o_format = so.o_format;
+    o_chunk = so.o_chunk;
+    o_async = so.o_async;
+    o_nbuffer = so.o_nbuffer;
 }
 
 /*!
@@ -109,6 +123,10 @@ solver_output& solver_output::operator = (const solver_output& so)
     o_type = so.o_type;
     o_nfreq = so.o_nfreq;
     o_tfreq = so.o_tfreq;
+    o_format = so.o_format;
+    o_chunk = so.o_chunk;
+    o_async = so.o_async;
+    o_nbuffer = so.o_nbuffer;
     
 	return *this;
 }
@@ -139,6 +157,8 @@ ostream& operator << (ostream& s, const solver_output& so)
         
     }
     
+    s << "format = " << so.o_format << "\t chunk = " << so.o_chunk << "\t async = " << so.o_async << "\t buffer = " << so.o_nbuffer << "\n";
+    
 	return s;
 }
 
@@ -0,0 +1,809 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file output_backend.cpp
+///@brief Backends that write the results of a phase and its sub-phases
+///@version 1.0
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <assert.h>
+#include <memory>
+#include <thread>
+#include <armadillo>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Phase/phase_characteristics.hpp>
+#include <smartplus/Libraries/Phase/state_variables.hpp>
+#include <smartplus/Libraries/Phase/state_variables_M.hpp>
+#include <smartplus/Libraries/Phase/state_variables_T.hpp>
+#include <smartplus/Libraries/Solver/output.hpp>
+#include <smartplus/Libraries/Solver/output_backend.hpp>
+
+using namespace std;
+using namespace arma;
+
+namespace smart{
+
+//=====Public methods for output_backend============================================
+
+//-------------------------------------------------------------
+output_backend::output_backend()
+//-------------------------------------------------------------
+{
+    coordsys = "global";
+    nfields = 0;
+}
+
+//-------------------------------------
+output_backend::~output_backend() {}
+//-------------------------------------
+
+//-------------------------------------------------------------
+void output_backend::define_columns(const phase_characteristics &rve, const solver_output &so)
+//-------------------------------------------------------------
+{
+    columns = {"block", "cycle", "step", "inc", "Time"};
+    std::vector<int> phases(columns.size(), -1);
+    int nphase = 0;
+    output_names(rve, so, columns, phases, nphase);
+
+    nfields = columns.size();
+    col_phases = conv_to<Col<int> >::from(phases);
+    record.zeros(nfields);
+}
+
+//-------------------------------------------------------------
+void output_backend::write(phase_characteristics &rve, const solver_output &so, const int &kblock, const int &kcycle, const int &kstep, const int &kinc, const double &Time)
+//-------------------------------------------------------------
+{
+    output_record(rve, so, kblock, kcycle, kstep, kinc, Time, record, coordsys);
+    write_record(record);
+}
+
+//=====Public methods for output_text============================================
+
+/*!
+  \brief default constructor
+  The text backend writes one file per phase, using phase_characteristics::define_output and phase_characteristics::output
+*/
+
+//-------------------------------------------------------------
+output_text::output_text() : output_backend()
+//-------------------------------------------------------------
+{
+
+}
+
+//-------------------------------------
+output_text::~output_text() {}
+//-------------------------------------
+
+//-------------------------------------------------------------
+void output_text::open(phase_characteristics &rve, const solver_output &so, const std::string &path, const std::string &outputfile, const std::string &mcoordsys)
+//-------------------------------------------------------------
+{
+    coordsys = mcoordsys;
+    rve.define_output(path, outputfile, coordsys);
+    define_columns(rve, so);
+
+    //Files of the phases, in the order of the fields of the records
+    files.clear();
+    std::vector<phase_characteristics*> stack = {&rve};
+    while (stack.size() > 0) {
+        phase_characteristics *pc = stack.back();
+        stack.pop_back();
+        files.push_back((coordsys == "local") ? pc->sptr_out_local : pc->sptr_out_global);
+        for (auto r = pc->sub_phases.rbegin(); r != pc->sub_phases.rend(); ++r) {
+            stack.push_back(&(*r));
+        }
+    }
+
+    n_first.zeros(files.size()+1);
+    n_statev.zeros(files.size());
+    n_first(files.size()) = nfields;
+    for (int i=nfields-1; i>=0; i--) {
+        if (col_phases(i) < 0)
+            continue;
+        n_first(col_phases(i)) = i;
+        if (columns[i].compare(0, 7, "statev_") != 0) {
+            if (n_statev(col_phases(i)) == 0)
+                n_statev(col_phases(i)) = i+1;
+        }
+    }
+}
+
+//-------------------------------------------------------------
+void output_text::write(phase_characteristics &rve, const solver_output &so, const int &kblock, const int &kcycle, const int &kstep, const int &kinc, const double &Time)
+//-------------------------------------------------------------
+{
+    rve.output(so, kblock, kcycle, kstep, kinc, Time, coordsys);
+}
+
+/*!
+  \brief Writes a record, with the same layout as phase_characteristics::output
+*/
+
+//-------------------------------------------------------------
+void output_text::write_record(const vec &mrecord)
+//-------------------------------------------------------------
+{
+    for (unsigned int p=0; p<files.size(); p++) {
+        std::ofstream &of = *files[p];
+        for (int i=0; i<4; i++) {
+            of << int(mrecord(i)) << "\t";
+        }
+        of << mrecord(4) << "\t\t";
+        for (int i=n_first(p); i<n_statev(p); i++) {
+            of << mrecord(i) << "\t";
+        }
+        of << "\t";
+        for (int i=n_statev(p); i<n_first(p+1); i++) {
+            of << mrecord(i) << "\t";
+        }
+        of << "\n";
+    }
+}
+
+//-------------------------------------------------------------
+void output_text::close()
+//-------------------------------------------------------------
+{
+    for (auto &f : files) {
+        f->close();
+    }
+    files.clear();
+}
+
+//=====Public methods for output_binary============================================
+
+/*!
+  \brief default constructor
+  The binary backend writes all the phases in a single file: a schema header, followed by chunks.
+  Each chunk stores the number of records, then the records field by field (columnar layout):
+  \n
+  "SMARTBIN" | version | nfields | (phase, length, name) x nfields | chunk_size | (nrows, nrows x nfields doubles) x nchunks
+*/
+
+//-------------------------------------------------------------
+output_binary::output_binary() : output_backend()
+//-------------------------------------------------------------
+{
+    nrows = 0;
+    chunk_size = 256;
+}
+
+/*!
+  \brief Constructor with parameters
+  \param mchunk_size : number of records per chunk (0 keeps all the records in memory and writes a single chunk when closed)
+*/
+
+//-------------------------------------------------------------
+output_binary::output_binary(const int &mchunk_size) : output_backend()
+//-------------------------------------------------------------
+{
+    assert(mchunk_size >= 0);
+
+    nrows = 0;
+    chunk_size = mchunk_size;
+}
+
+/*!
+  \brief Destructor
+  Writes the remaining records, so that the file is complete even if the solver returns early
+*/
+
+//-------------------------------------
+output_binary::~output_binary()
+//-------------------------------------
+{
+    close();
+}
+
+//-------------------------------------------------------------
+void output_binary::open(phase_characteristics &rve, const solver_output &so, const std::string &path, const std::string &outputfile, const std::string &mcoordsys)
+//-------------------------------------------------------------
+{
+    coordsys = mcoordsys;
+
+    std::string filename = outputfile.substr(0,outputfile.length()-4); //to remove the extension
+    std::string path_filename = path + "/" + filename + ".bin";
+
+    define_columns(rve, so);
+
+    of.open(path_filename, ios::out | ios::binary | ios::trunc);
+    if(!of) {
+        cout << "error: the output file " << path_filename << " could not be opened\n";
+        exit(0);
+    }
+
+    const char magic[8] = {'S','M','A','R','T','B','I','N'};
+    int version = 1;
+    of.write(magic, 8);
+    of.write(reinterpret_cast<const char*>(&version), sizeof(int));
+    of.write(reinterpret_cast<const char*>(&nfields), sizeof(int));
+    for (int i=0; i<nfields; i++) {
+        int length = columns[i].length();
+        of.write(reinterpret_cast<const char*>(&col_phases(i)), sizeof(int));
+        of.write(reinterpret_cast<const char*>(&length), sizeof(int));
+        of.write(columns[i].c_str(), length);
+    }
+    of.write(reinterpret_cast<const char*>(&chunk_size), sizeof(int));
+
+    nrows = 0;
+    chunk.set_size(nfields, (chunk_size > 0) ? chunk_size : 64);
+}
+
+//-------------------------------------------------------------
+void output_binary::write_record(const vec &mrecord)
+//-------------------------------------------------------------
+{
+    assert(of.is_open());
+
+    if(nrows == int(chunk.n_cols))
+        chunk.resize(nfields, 2*chunk.n_cols);
+
+    chunk.col(nrows) = mrecord;
+    nrows++;
+
+    if((chunk_size > 0)&&(nrows == chunk_size))
+        flush();
+}
+
+//-------------------------------------------------------------
+void output_binary::close()
+//-------------------------------------------------------------
+{
+    if(!of.is_open())
+        return;
+
+    flush();
+    of.close();
+}
+
+//-------------------------------------------------------------
+void output_binary::flush()
+//-------------------------------------------------------------
+{
+    if(nrows == 0)
+        return;
+
+    //Columnar layout : each field of the chunk is contiguous
+    mat columnar = chunk.cols(0, nrows-1).t();
+    of.write(reinterpret_cast<const char*>(&nrows), sizeof(int));
+    of.write(reinterpret_cast<const char*>(columnar.memptr()), sizeof(double)*columnar.n_elem);
+    nrows = 0;
+}
+
+//=====Public methods for output_async============================================
+
+/*!
+  \brief default constructor
+  The asynchronous backend copies a snapshot of the record of each increment in a ring buffer.
+  A writer thread hands the snapshots to another backend, so the solver never waits on the disk,
+  unless the ring buffer is full (back-pressure).
+*/
+
+//-------------------------------------------------------------
+output_async::output_async() : output_backend()
+//-------------------------------------------------------------
+{
+    head = 0;
+    tail = 0;
+    done = false;
+    capacity = 64;
+    sptr_backend = std::make_shared<output_text>();
+}
+
+/*!
+  \brief Constructor with parameters
+  \param msptr_backend : the backend that formats and writes the snapshots
+  \param mcapacity : number of snapshots in the ring buffer
+*/
+
+//-------------------------------------------------------------
+output_async::output_async(const std::shared_ptr<output_backend> &msptr_backend, const int &mcapacity) : output_backend()
+//-------------------------------------------------------------
+{
+    assert(mcapacity > 0);
+
+    head = 0;
+    tail = 0;
+    done = false;
+    capacity = mcapacity;
+    sptr_backend = msptr_backend;
+}
+
+/*!
+  \brief Destructor
+  Waits for all the snapshots to be written (flush-on-exit)
+*/
+
+//-------------------------------------
+output_async::~output_async()
+//-------------------------------------
+{
+    close();
+}
+
+//-------------------------------------------------------------
+void output_async::open(phase_characteristics &rve, const solver_output &so, const std::string &path, const std::string &outputfile, const std::string &mcoordsys)
+//-------------------------------------------------------------
+{
+    coordsys = mcoordsys;
+    sptr_backend->open(rve, so, path, outputfile, coordsys);
+    define_columns(rve, so);
+
+    ring.zeros(nfields, capacity);
+    head = 0;
+    tail = 0;
+    done = false;
+    writer = std::thread(&output_async::run, this);
+}
+
+//-------------------------------------------------------------
+void output_async::write(phase_characteristics &rve, const solver_output &so, const int &kblock, const int &kcycle, const int &kstep, const int &kinc, const double &Time)
+//-------------------------------------------------------------
+{
+    assert(writer.joinable());
+
+    //Back-pressure: wait for a free slot
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv_space.wait(lock, [this]{ return head - tail < capacity; });
+    }
+
+    //The slot is not read by the writer thread until head is incremented
+    vec snapshot(ring.colptr(head%capacity), nfields, false, true);
+    output_record(rve, so, kblock, kcycle, kstep, kinc, Time, snapshot, coordsys);
+
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        head++;
+    }
+    cv_data.notify_one();
+}
+
+//-------------------------------------------------------------
+void output_async::write_record(const vec &mrecord)
+//-------------------------------------------------------------
+{
+    assert(writer.joinable());
+
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv_space.wait(lock, [this]{ return head - tail < capacity; });
+    }
+    ring.col(head%capacity) = mrecord;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        head++;
+    }
+    cv_data.notify_one();
+}
+
+//-------------------------------------------------------------
+void output_async::close()
+//-------------------------------------------------------------
+{
+    if(!writer.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        done = true;
+    }
+    cv_data.notify_one();
+    writer.join();
+    sptr_backend->close();
+}
+
+//-------------------------------------------------------------
+void output_async::run()
+//-------------------------------------------------------------
+{
+    long first = 0;
+    long last = 0;
+    bool finished = false;
+
+    while (!finished) {
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            cv_data.wait(lock, [this]{ return (head > tail)||(done); });
+            first = tail;
+            last = head;
+            finished = done;
+        }
+
+        //All the available snapshots are written at once, without holding the lock
+        for (long k=first; k<last; k++) {
+            vec snapshot(ring.colptr(k%capacity), nfields, false, true);
+            sptr_backend->write_record(snapshot);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            tail = last;
+            finished = (finished)&&(tail == head);
+        }
+        cv_space.notify_one();
+    }
+}
+
+//=====Public methods for output_recorder============================================
+
+/*!
+  \brief default constructor
+  The recorder keeps a copy of the records written by another backend, so that they can be written again
+  by a later simulation that starts from the same state (see simulation_tree)
+*/
+
+//-------------------------------------------------------------
+output_recorder::output_recorder() : output_backend()
+//-------------------------------------------------------------
+{
+    sptr_backend = std::make_shared<output_text>();
+}
+
+/*!
+  \brief Constructor with parameters
+  \param msptr_backend : the backend that writes the records
+*/
+
+//-------------------------------------------------------------
+output_recorder::output_recorder(const std::shared_ptr<output_backend> &msptr_backend) : output_backend()
+//-------------------------------------------------------------
+{
+    sptr_backend = msptr_backend;
+}
+
+//-------------------------------------
+output_recorder::~output_recorder() {}
+//-------------------------------------
+
+//-------------------------------------------------------------
+void output_recorder::open(phase_characteristics &rve, const solver_output &so, const std::string &path, const std::string &outputfile, const std::string &mcoordsys)
+//-------------------------------------------------------------
+{
+    coordsys = mcoordsys;
+    sptr_backend->open(rve, so, path, outputfile, coordsys);
+    define_columns(rve, so);
+    records.clear();
+}
+
+//-------------------------------------------------------------
+void output_recorder::write(phase_characteristics &rve, const solver_output &so, const int &kblock, const int &kcycle, const int &kstep, const int &kinc, const double &Time)
+//-------------------------------------------------------------
+{
+    output_record(rve, so, kblock, kcycle, kstep, kinc, Time, record, coordsys);
+    records.push_back(record);
+    sptr_backend->write(rve, so, kblock, kcycle, kstep, kinc, Time);
+}
+
+//-------------------------------------------------------------
+void output_recorder::write_record(const vec &mrecord)
+//-------------------------------------------------------------
+{
+    records.push_back(mrecord);
+    sptr_backend->write_record(mrecord);
+}
+
+//-------------------------------------------------------------
+void output_recorder::close()
+//-------------------------------------------------------------
+{
+    sptr_backend->close();
+}
+
+//=====Public methods for output_monitor============================================
+
+/*!
+  \brief default constructor
+  The monitor passes each record written by another backend to check, and asks the solver to stop when a record is rejected
+  (e.g. the cost of an identification that exceeds a bound)
+*/
+
+//-------------------------------------------------------------
+output_monitor::output_monitor() : output_backend()
+//-------------------------------------------------------------
+{
+    sptr_backend = std::make_shared<output_text>();
+    stopped = false;
+}
+
+/*!
+  \brief Constructor with parameters
+  \param msptr_backend : the backend that writes the records
+*/
+
+//-------------------------------------------------------------
+output_monitor::output_monitor(const std::shared_ptr<output_backend> &msptr_backend) : output_backend()
+//-------------------------------------------------------------
+{
+    sptr_backend = msptr_backend;
+    stopped = false;
+}
+
+//-------------------------------------
+output_monitor::~output_monitor() {}
+//-------------------------------------
+
+//-------------------------------------------------------------
+void output_monitor::open(phase_characteristics &rve, const solver_output &so, const std::string &path, const std::string &outputfile, const std::string &mcoordsys)
+//-------------------------------------------------------------
+{
+    coordsys = mcoordsys;
+    sptr_backend->open(rve, so, path, outputfile, coordsys);
+    define_columns(rve, so);
+    stopped = false;
+}
+
+//-------------------------------------------------------------
+void output_monitor::write(phase_characteristics &rve, const solver_output &so, const int &kblock, const int &kcycle, const int &kstep, const int &kinc, const double &Time)
+//-------------------------------------------------------------
+{
+    output_record(rve, so, kblock, kcycle, kstep, kinc, Time, record, coordsys);
+    sptr_backend->write(rve, so, kblock, kcycle, kstep, kinc, Time);
+    if (!check(record))
+        stopped = true;
+}
+
+//-------------------------------------------------------------
+void output_monitor::write_record(const vec &mrecord)
+//-------------------------------------------------------------
+{
+    sptr_backend->write_record(mrecord);
+    if (!check(mrecord))
+        stopped = true;
+}
+
+//-------------------------------------------------------------
+void output_monitor::close()
+//-------------------------------------------------------------
+{
+    //The monitor may outlive the simulation (e.g. the cost monitor of an identification) : the backend is released with its files
+    if (!sptr_backend)
+        return;
+    sptr_backend->close();
+    sptr_backend.reset();
+}
+
+/*!
+  \brief Test of a record : true to proceed with the simulation. Every record is accepted by the base monitor
+*/
+
+//-------------------------------------------------------------
+bool output_monitor::check(const vec &)
+//-------------------------------------------------------------
+{
+    return true;
+}
+
+//=====Functions============================================
+
+//-------------------------------------------------------------
+std::shared_ptr<output_backend> make_output_backend(const solver_output &so)
+//-------------------------------------------------------------
+{
+    std::shared_ptr<output_backend> sptr_backend;
+    switch (so.o_format) {
+        case 0: {
+            sptr_backend = std::make_shared<output_text>();
+            break;
+        }
+        case 1: {
+            sptr_backend = std::make_shared<output_binary>(so.o_chunk);
+            break;
+        }
+        default: {
+            cout << "error: The output format does not correspond (0 for text, 1 for binary)\n";
+            exit(0);
+        }
+    }
+
+    if (so.o_async > 0)
+        return std::make_shared<output_async>(sptr_backend, so.o_nbuffer);
+    else
+        return sptr_backend;
+}
+
+//-------------------------------------------------------------
+void output_names(const phase_characteristics &rve, const solver_output &so, std::vector<std::string> &names, std::vector<int> &phases, int &nphase)
+//-------------------------------------------------------------
+{
+    int number = nphase;
+
+    if (so.o_nb_T) {
+        names.push_back("T");
+        names.push_back("Q");
+        names.push_back("r");
+    }
+    for (int z=0; z<so.o_nb_meca; z++) {
+        names.push_back("Etot_" + to_string(so.o_meca(z)));
+    }
+    for (int z=0; z<so.o_nb_meca; z++) {
+        names.push_back("sigma_" + to_string(so.o_meca(z)));
+    }
+    for (int z=0; z<4; z++) {
+        names.push_back("Wm_" + to_string(z));
+    }
+    if (rve.sv_type == 2) {
+        for (int z=0; z<3; z++) {
+            names.push_back("Wt_" + to_string(z));
+        }
+    }
+    if(so.o_nw_statev != 0){
+        if (so.o_wanted_statev(0) < 0) {
+            for(int k = 0 ; k < rve.sptr_sv_global->nstatev ; k++)
+                names.push_back("statev_" + to_string(k));
+        }
+        else{
+            for(int k = 0 ; k < so.o_nw_statev ; k++){
+                for (int l = so.o_wanted_statev(k); l < (so.o_range_statev(k)+1); l++){
+                    names.push_back("statev_" + to_string(l));
+                }
+            }
+        }
+    }
+    phases.resize(names.size(), number);
+
+    nphase++;
+    for(auto &r : rve.sub_phases) {
+        output_names(r, so, names, phases, nphase);
+    }
+}
+
+//-------------------------------------------------------------
+void output_fields(const phase_characteristics &rve, const solver_output &so, vec &record, int &index, const std::string &coordsys)
+//-------------------------------------------------------------
+{
+    state_variables *sv = (coordsys == "local") ? rve.sptr_sv_local.get() : rve.sptr_sv_global.get();
+    state_variables_T *sv_T = NULL;
+    state_variables_M *sv_M = NULL;
+
+    switch (rve.sv_type) {
+        case 1: {
+            sv_M = static_cast<state_variables_M*>(sv);
+            break;
+        }
+        case 2: {
+            sv_T = static_cast<state_variables_T*>(sv);
+            break;
+        }
+        default: {
+            cout << "error: The state_variable type does not correspond (1 for Mechanical, 2 for Thermomechanical)\n";
+            exit(0);
+            break;
+        }
+    }
+
+    if (so.o_nb_T) {
+        record(index++) = sv->T;
+        record(index++) = (rve.sv_type == 2) ? sv_T->Q : 0.;
+        record(index++) = (rve.sv_type == 2) ? sv_T->r : 0.;
+    }
+    for (int z=0; z<so.o_nb_meca; z++) {
+        record(index++) = sv->Etot(so.o_meca(z));
+    }
+    for (int z=0; z<so.o_nb_meca; z++) {
+        record(index++) = sv->sigma(so.o_meca(z));
+    }
+    if (rve.sv_type == 2) {
+        for (int z=0; z<4; z++)
+            record(index++) = sv_T->Wm(z);
+        for (int z=0; z<3; z++)
+            record(index++) = sv_T->Wt(z);
+    }
+    else {
+        for (int z=0; z<4; z++)
+            record(index++) = sv_M->Wm(z);
+    }
+    if(so.o_nw_statev != 0){
+        if (so.o_wanted_statev(0) < 0) {
+            for(int k = 0 ; k < sv->nstatev ; k++)
+                record(index++) = sv->statev(k);
+        }
+        else{
+            for(int k = 0 ; k < so.o_nw_statev ; k++){
+                for (int l = so.o_wanted_statev(k); l < (so.o_range_statev(k)+1); l++){
+                    record(index++) = sv->statev(l);
+                }
+            }
+        }
+    }
+
+    for(auto &r : rve.sub_phases) {
+        output_fields(r, so, record, index, coordsys);
+    }
+}
+
+//-------------------------------------------------------------
+void output_record(const phase_characteristics &rve, const solver_output &so, const int &kblock, const int &kcycle, const int &kstep, const int &kinc, const double &Time, vec &mrecord, const std::string &coordsys)
+//-------------------------------------------------------------
+{
+    mrecord(0) = kblock+1;
+    mrecord(1) = kcycle+1;
+    mrecord(2) = kstep+1;
+    mrecord(3) = kinc+1;
+    mrecord(4) = Time;
+    int index = 5;
+    output_fields(rve, so, mrecord, index, coordsys);
+}
+
+//-------------------------------------------------------------
+void read_output_binary(std::vector<std::string> &names, Col<int> &phases, mat &data, const std::string &path, const std::string &inputfile)
+//-------------------------------------------------------------
+{
+    std::string path_inputfile = path + "/" + inputfile;
+    ifstream ifs(path_inputfile, ios::in | ios::binary);
+    if(!ifs) {
+        cout << "error: the binary output file " << path_inputfile << " is not present\n";
+        return;
+    }
+
+    char magic[8];
+    int version = 0;
+    int nfields = 0;
+    int chunk_size = 0;
+    ifs.read(magic, 8);
+    if((!ifs)||(std::string(magic, 8) != "SMARTBIN")) {
+        cout << "error: the file " << path_inputfile << " is not a binary output file\n";
+        return;
+    }
+    ifs.read(reinterpret_cast<char*>(&version), sizeof(int));
+    ifs.read(reinterpret_cast<char*>(&nfields), sizeof(int));
+
+    names.resize(nfields);
+    phases.zeros(nfields);
+    for (int i=0; i<nfields; i++) {
+        int length = 0;
+        ifs.read(reinterpret_cast<char*>(&phases(i)), sizeof(int));
+        ifs.read(reinterpret_cast<char*>(&length), sizeof(int));
+        names[i].resize(length);
+        ifs.read(&names[i][0], length);
+    }
+    ifs.read(reinterpret_cast<char*>(&chunk_size), sizeof(int));
+
+    //First pass over the chunk sizes to allocate the records only once
+    std::streampos start_chunks = ifs.tellg();
+    int nrows_total = 0;
+    int nrows = 0;
+    while(ifs.read(reinterpret_cast<char*>(&nrows), sizeof(int))) {
+        nrows_total += nrows;
+        ifs.seekg(sizeof(double)*nrows*nfields, ios::cur);
+    }
+    ifs.clear();
+    ifs.seekg(start_chunks);
+
+    data.set_size(nrows_total, nfields);
+    int row = 0;
+    while(ifs.read(reinterpret_cast<char*>(&nrows), sizeof(int))) {
+        if(nrows == 0)
+            continue;
+        mat chunk(nrows, nfields);
+        ifs.read(reinterpret_cast<char*>(chunk.memptr()), sizeof(double)*chunk.n_elem);
+        if(!ifs) {
+            cout << "error: the file " << path_inputfile << " is truncated\n";
+            data.resize(row, nfields);
+            return;
+        }
+        data.rows(row, row+nrows-1) = chunk;
+        row += nrows;
+    }
+}
+
+} //namespace smart
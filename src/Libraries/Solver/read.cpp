@@ -26,6 +26,9 @@
 #include <smartplus/Libraries/Solver/step_meca.hpp>
 #include <smartplus/Libraries/Solver/step_thermomeca.hpp>
 #include <smartplus/Libraries/Solver/output.hpp>
+#include <smartplus/Libraries/Solver/cycle_control.hpp>
+#include <smartplus/Libraries/Solver/simulation_tree.hpp>
+#include <smartplus/Libraries/Phase/tolerances.hpp>
 
 using namespace std;
 using namespace arma;
@@ -119,6 +122,31 @@ void solver_control(double &div_tnew_dt_solver, double &mul_tnew_dt_solver, int
     solver_control >> buffer >> inforce_solver;
     solver_control >> buffer >> precision_solver;
     solver_control >> buffer >> lambda_solver;
+    
+    ///Optional : global default tolerances of the constitutive models, given as "key value" lines
+    tolerances &tol = tolerances::defaults();
+    while (solver_control >> buffer) {
+        if (buffer == "maxiter_umat")
+            solver_control >> tol.umat_maxiter;
+        else if (buffer == "precision_umat")
+            solver_control >> tol.umat_precision;
+        else if (buffer == "substeps_umat")
+            solver_control >> tol.umat_substeps;
+        else if (buffer == "maxiter_micro")
+            solver_control >> tol.micro_maxiter;
+        else if (buffer == "precision_micro")
+            solver_control >> tol.micro_precision;
+        else if (buffer == "points_micro")
+            solver_control >> tol.micro_points;
+        else if (buffer == "limit")
+            solver_control >> tol.zero_limit;
+        else if (buffer == "iota")
+            solver_control >> tol.zero_iota;
+        else {
+            cout << "error: The tolerance " << buffer << " in " << filename << " is unknown (maxiter_umat, precision_umat, substeps_umat, maxiter_micro, precision_micro, points_micro, limit or iota)\n";
+            exit(0);
+        }
+    }
     solver_control.close();
 
 }
@@ -228,6 +256,28 @@ void read_output(solver_output &so, const int &nblock, const int &nstatev, const
             else
                 cyclic_output >> buffer;
         }
+
+        ///Optional selection of the output backend, e.g. "Format binary", "Chunk 256", "Async 1", "Buffer 64"
+        while (cyclic_output >> buffer) {
+            if ((buffer == "Format") || (buffer == "format") || (buffer == "FORMAT")) {
+                cyclic_output >> buffer;
+                if ((buffer == "binary") || (buffer == "Binary") || (buffer == "BINARY"))
+                    so.o_format = 1;
+                else
+                    so.o_format = 0;
+            }
+            else if ((buffer == "Chunk") || (buffer == "chunk") || (buffer == "CHUNK")) {
+                cyclic_output >> so.o_chunk;
+            }
+            else if ((buffer == "Async") || (buffer == "async") || (buffer == "ASYNC")) {
+                cyclic_output >> so.o_async;
+            }
+            else if ((buffer == "Buffer") || (buffer == "buffer") || (buffer == "BUFFER")) {
+                cyclic_output >> so.o_nbuffer;
+                if (so.o_nbuffer < 1)
+                    so.o_nbuffer = 1;
+            }
+        }
         cyclic_output.close();
     }
     else {
@@ -246,6 +296,145 @@ void read_output(solver_output &so, const int &nblock, const int &nstatev, const
     
 }
 
+void read_cycle_control(cycle_control &cc, const int &nblock, const string &path_data, const string &cyclefile) {
+    
+    string buffer;
+    string path_cyclefile = path_data + "/" + cyclefile;
+    cc = cycle_control(nblock);
+    
+    ///The file is optional : without it, every cycle of every block is integrated
+    ifstream cycles;
+    cycles.open(path_cyclefile, ios::in);
+    if(!cycles)
+        return;
+    
+    ///"key value" lines, that apply to the last block given by a "Block" line
+    int b = -1;
+    while (cycles >> buffer) {
+        if ((buffer == "Block") || (buffer == "block") || (buffer == "BLOCK")) {
+            cycles >> b;
+            b--;
+            if ((b < 0)||(b >= nblock)) {
+                cout << "error: The block " << b+1 << " in " << cyclefile << " does not exist\n";
+                exit(0);
+            }
+        }
+        else if (b < 0) {
+            cout << "error: The block must be given before the cycle controls in " << cyclefile << "\n";
+            exit(0);
+        }
+        else if (buffer == "jump")
+            cycles >> cc.c_jump(b);
+        else if (buffer == "jump_ncompute")
+            cycles >> cc.c_ncompute(b);
+        else if (buffer == "jump_tolerance")
+            cycles >> cc.c_tolerance(b);
+        else if (buffer == "jump_min")
+            cycles >> cc.c_njump_min(b);
+        else if (buffer == "jump_max")
+            cycles >> cc.c_njump_max(b);
+        else if (buffer == "stabilization")
+            cycles >> cc.c_stab(b);
+        else if (buffer == "stabilization_tolerance")
+            cycles >> cc.c_stab_tolerance(b);
+        else if (buffer == "stabilization_ncycles")
+            cycles >> cc.c_stab_ncycles(b);
+        else {
+            cout << "error: The cycle control " << buffer << " in " << cyclefile << " is unknown (jump, jump_ncompute, jump_tolerance, jump_min, jump_max, stabilization, stabilization_tolerance or stabilization_ncycles)\n";
+            exit(0);
+        }
+    }
+    cycles.close();
+    
+    for (int i=0; i<nblock; i++) {
+        if (cc.c_ncompute(i) < 2)
+            cc.c_ncompute(i) = 2;
+        if (cc.c_njump_min(i) < 1)
+            cc.c_njump_min(i) = 1;
+        if (cc.c_njump_max(i) < cc.c_njump_min(i))
+            cc.c_njump_max(i) = cc.c_njump_min(i);
+        if (cc.c_stab_ncycles(i) < 1)
+            cc.c_stab_ncycles(i) = 1;
+    }
+}
+
+void read_simulation_tree(simulation_tree &st, const string &path_data, const string &treefile) {
+    
+    string buffer;
+    string path_treefile = path_data + "/" + treefile;
+    
+    ///The file is optional : without it, no snapshot is kept
+    ifstream tree;
+    tree.open(path_treefile, ios::in);
+    if(!tree) {
+        st.capacity = 0;
+        st.clear();
+        return;
+    }
+    
+    ///"key value" lines. A "prop k b" line states that the prop k (starting at 0) only affects the blocks from the block b on
+    st.props_block.reset();
+    while (tree >> buffer) {
+        if (buffer == "capacity")
+            tree >> st.capacity;
+        else if (buffer == "prop") {
+            int k = 0;
+            int b = 1;
+            tree >> k >> b;
+            if ((k < 0)||(b < 1)) {
+                cout << "error: The prop " << k << " or the block " << b << " in " << treefile << " is not valid\n";
+                exit(0);
+            }
+            if (k >= int(st.props_block.n_elem)) {
+                int n = st.props_block.n_elem;
+                st.props_block.resize(k+1);
+                st.props_block.subvec(n, k).ones();
+            }
+            st.props_block(k) = b;
+        }
+        else {
+            cout << "error: The key " << buffer << " in " << treefile << " is unknown (capacity or prop)\n";
+            exit(0);
+        }
+    }
+    tree.close();
+    
+    if (st.capacity < 0)
+        st.capacity = 0;
+    while (int(st.snapshots.size()) > st.capacity) {
+        st.snapshots.pop_back();
+    }
+}
+
+void read_checkpoint_control(int &every, int &restart, const string &path_data, const string &checkpointfile) {
+    
+    string buffer;
+    string path_checkpointfile = path_data + "/" + checkpointfile;
+    every = 0;
+    restart = 0;
+    
+    ///The file is optional : without it, no checkpoint is written
+    ifstream checkpoint;
+    checkpoint.open(path_checkpointfile, ios::in);
+    if(!checkpoint)
+        return;
+    
+    while (checkpoint >> buffer) {
+        if (buffer == "every")
+            checkpoint >> every;
+        else if (buffer == "restart")
+            checkpoint >> restart;
+        else {
+            cout << "error: The key " << buffer << " in " << checkpointfile << " is unknown (every or restart)\n";
+            exit(0);
+        }
+    }
+    checkpoint.close();
+    
+    if (every < 0)
+        every = 0;
+}
+
 void check_path_output(const std::vector<block> &blocks, const solver_output &so) {
 
     /// Reading blocks
@@ -0,0 +1,386 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file sensitivity.cpp
+///@brief Forward sensitivities of the response of a RVE with respect to some of its props, integrated along with the solver increments
+///@version 1.0
+
+#include <iostream>
+#include <assert.h>
+#include <math.h>
+#include <armadillo>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Phase/phase_characteristics.hpp>
+#include <smartplus/Libraries/Phase/state_variables_M.hpp>
+#include <smartplus/Libraries/Solver/output.hpp>
+#include <smartplus/Libraries/Solver/output_backend.hpp>
+#include <smartplus/Libraries/Solver/step_meca.hpp>
+#include <smartplus/Libraries/Solver/sensitivity.hpp>
+#include <smartplus/Umat/umat_smart.hpp>
+
+using namespace std;
+using namespace arma;
+
+namespace smart{
+
+//=====Private methods for solver_sensitivity===================================
+
+/*!
+  \brief Runs the model of the RVE on its work copy, over the increment of the RVE, with the start values and the props moved along the derivatives of a parameter
+  \param rve : the RVE at the end of a converged increment, before its start values are set
+  \param p : number of the parameter
+  \param h : perturbation of the prop of the parameter
+  \param dDEtot : derivative of the strain increment
+  \param start : the model is initialized (see begin)
+*/
+
+//-------------------------------------------------------------
+void solver_sensitivity::perturb(const phase_characteristics &rve, const int &p, const double &h, const vec &dDEtot, const mat &DR, const double &Time, const double &DTime, const int &ndi, const int &nshr, const bool &start, const int &solver_type)
+//-------------------------------------------------------------
+{
+    work.copy(rve);
+    work.sptr_matprops->props(props_index(p)) += h;
+    work.sptr_matprops->reset_constants();
+
+    state_variables_M *sv_w = work.sv_global<state_variables_M>();
+    sv_w->Etot += h*dEtot.col(p);
+    sv_w->DEtot += h*dDEtot;
+    sv_w->sigma_start += h*dsigma.col(p);
+    sv_w->Wm_start += h*dWm.col(p);
+    sv_w->statev_start += h*dstatev.col(p);
+    sv_w->L += h*reshape(dL.col(p), 6, 6);
+    work.to_start();
+
+    double tnew_dt = 1.;
+    select_umat_M(work, DR, Time, DTime, ndi, nshr, start, solver_type, tnew_dt);
+}
+
+//=====Public methods for solver_sensitivity============================================
+
+/*!
+  \brief default constructor
+  The derivatives of the state of the RVE (Etot, sigma, Wm, statev and L) with respect to the parameters are carried from one increment to the next.
+  The increments of a step are generated from the state at its start (see step_meca::generate) : their derivatives are stored when the step is generated.
+  Over a converged increment, the derivative of the strain increment is the solution of the mixed problem linearized with the converged tangent Lt,
+  and the derivatives of the state at the end of the increment are the directional derivatives of the model, with respect to the prop of the parameter
+  and to the state at the beginning of the increment, along their derivatives (one or two calls of the model per parameter and per increment)
+*/
+
+//-------------------------------------------------------------
+solver_sensitivity::solver_sensitivity()
+//-------------------------------------------------------------
+{
+    delta = 1.E-6;
+    active = false;
+}
+
+/*!
+  \brief Constructor with parameters
+  \param mprops_index : index in the props of the RVE of each parameter
+  \param mdelta : relative perturbation of the props for the directional derivatives of an increment
+*/
+
+//-------------------------------------------------------------
+solver_sensitivity::solver_sensitivity(const Col<int> &mprops_index, const double &mdelta)
+//-------------------------------------------------------------
+{
+    assert(mdelta > 0.);
+
+    props_index = mprops_index;
+    delta = mdelta;
+    active = false;
+}
+
+/*!
+  \brief Copy constructor
+  \param ss solver_sensitivity object to duplicate
+*/
+
+//------------------------------------------------------
+solver_sensitivity::solver_sensitivity(const solver_sensitivity& ss)
+//------------------------------------------------------
+{
+    props_index = ss.props_index;
+    delta = ss.delta;
+    active = ss.active;
+
+    dEtot = ss.dEtot;
+    dsigma = ss.dsigma;
+    dWm = ss.dWm;
+    dstatev = ss.dstatev;
+    dL = ss.dL;
+    dmecas = ss.dmecas;
+}
+
+/*!
+  \brief Destructor
+*/
+
+//-------------------------------------
+solver_sensitivity::~solver_sensitivity() {}
+//-------------------------------------
+
+/*!
+  \brief The forward sensitivities are integrated for a mechanical RVE without sub-phases : the state of the sub-phases is not carried
+*/
+
+//-------------------------------------------------------------
+bool solver_sensitivity::supported(const phase_characteristics &rve) const
+//-------------------------------------------------------------
+{
+    return ((rve.sv_type == 1)&&(rve.sub_phases.size() == 0));
+}
+
+/*!
+  \brief Initial derivatives : the ones of the initialization of the model (the first call of a block, with start = true and no increment)
+  \param rve : the RVE after the first call of the model
+*/
+
+//-------------------------------------------------------------
+void solver_sensitivity::begin(const phase_characteristics &rve, const mat &DR, const double &Time, const int &ndi, const int &nshr, const int &solver_type)
+//-------------------------------------------------------------
+{
+    active = supported(rve);
+    if (!active)
+        return;
+
+    for (int p=0; p<size(); p++) {
+        if ((props_index(p) < 0)||(props_index(p) >= rve.sptr_matprops->nprops)) {
+            cout << "error: The sensitivity with respect to the prop " << props_index(p) << " is required, the material has " << rve.sptr_matprops->nprops << " props\n";
+            exit(0);
+        }
+    }
+
+    dEtot = zeros(6, size());
+    dsigma = zeros(6, size());
+    dWm = zeros(4, size());
+    dstatev = zeros(rve.sptr_sv_global->nstatev, size());
+    dL = zeros(36, size());
+    rve_d.copy(rve);
+
+    state_variables_M *sv = rve.sv_global<state_variables_M>();
+    for (int p=0; p<size(); p++) {
+        double h = delta*fabs(rve.sptr_matprops->props(props_index(p)));
+        if (h == 0.)
+            h = delta;
+
+        perturb(rve, p, h, zeros(6), DR, Time, 0., ndi, nshr, true, solver_type);
+        state_variables_M *sv_w = work.sv_global<state_variables_M>();
+        dsigma.col(p) = (sv_w->sigma - sv->sigma)/h;
+        dWm.col(p) = (sv_w->Wm - sv->Wm)/h;
+        dstatev.col(p) = (sv_w->statev - sv->statev)/h;
+        dL.col(p) = vectorise(sv_w->L - sv->L)/h;
+    }
+}
+
+/*!
+  \brief Derivatives of the increments of a step, from the derivatives of the state at its start : an increment of a component is a fraction of
+  the difference between the target and the start value (modes 1 and 2), only the first one depends on the start value for an incremental path file (mode 3)
+  \param sm : the step, just generated
+*/
+
+//-------------------------------------------------------------
+void solver_sensitivity::generate(const step_meca &sm)
+//-------------------------------------------------------------
+{
+    dmecas = zeros(sm.ninc, 6, size());
+    if (sm.ninc == 0)
+        return;
+
+    for (int p=0; p<size(); p++) {
+        for (int k=0; k<6; k++) {
+            double dstart = 0.;
+            if (sm.cBC_meca(k) == 1)
+                dstart = dsigma(k,p);
+            else if (sm.cBC_meca(k) == 0)
+                dstart = dEtot(k,p);
+
+            if (sm.mode < 3) {
+                for (int i=0; i<sm.ninc; i++)
+                    dmecas(i,k,p) = -sm.inc_coef(i)*dstart/sm.ninc;
+            }
+            else if (sm.col_meca(k) >= 0) {
+                dmecas(0,k,p) = -dstart;
+            }
+        }
+    }
+}
+
+/*!
+  \brief Derivatives of the prescribed values of an increment of the current step (strain increment or stress change, depending on the control), one column per parameter
+  \param inc : number of the increment
+  \param Dtinc : fraction of the increment
+*/
+
+//-------------------------------------------------------------
+mat solver_sensitivity::prescribed(const int &inc, const double &Dtinc) const
+//-------------------------------------------------------------
+{
+    mat dprescribed = zeros(6, size());
+    if (inc < int(dmecas.n_rows)) {
+        for (int p=0; p<size(); p++)
+            dprescribed.col(p) = Dtinc*dmecas.slice(p).row(inc).t();
+    }
+    return dprescribed;
+}
+
+/*!
+  \brief Integrates the derivatives over a converged increment, before the start values of the RVE are set
+  \param rve : the RVE at the end of the increment
+  \param cBC_meca : the control of the increment (1 for the prescribed stress components)
+  \param dprescribed : derivatives of the prescribed values of the increment (see prescribed)
+*/
+
+//-------------------------------------------------------------
+void solver_sensitivity::increment(const phase_characteristics &rve, const Col<int> &cBC_meca, const mat &dprescribed, const mat &DR, const double &Time, const double &DTime, const int &ndi, const int &nshr, const int &solver_type)
+//-------------------------------------------------------------
+{
+    state_variables_M *sv = rve.sv_global<state_variables_M>();
+
+    //The derivative of a prescribed strain component is the one of its increment, the derivative of a prescribed stress component is the one
+    //of its start value plus the one of its change over the increment
+    mat A = eye(6,6);
+    int nK = 0;
+    for (int k=0; k<6; k++) {
+        if (cBC_meca(k)) {
+            A.row(k) = sv->Lt.row(k);
+            nK++;
+        }
+    }
+
+    for (int p=0; p<size(); p++) {
+        double h = delta*fabs(rve.sptr_matprops->props(props_index(p)));
+        if (h == 0.)
+            h = delta;
+
+        vec dDEtot = zeros(6);
+        for (int k=0; k<6; k++) {
+            if (!cBC_meca(k))
+                dDEtot(k) = dprescribed(k,p);
+        }
+        perturb(rve, p, h, dDEtot, DR, Time, DTime, ndi, nshr, false, solver_type);
+        if (nK > 0) {
+            vec residual = zeros(6);
+            for (int k=0; k<6; k++) {
+                if (cBC_meca(k))
+                    residual(k) = dsigma(k,p) + dprescribed(k,p) - (work.sv_global<state_variables_M>()->sigma(k) - sv->sigma(k))/h;
+            }
+            dDEtot += solve(A, residual);
+            perturb(rve, p, h, dDEtot, DR, Time, DTime, ndi, nshr, false, solver_type);
+        }
+
+        state_variables_M *sv_w = work.sv_global<state_variables_M>();
+
+        dEtot.col(p) += dDEtot;
+        dsigma.col(p) = (sv_w->sigma - sv->sigma)/h;
+        dWm.col(p) = (sv_w->Wm - sv->Wm)/h;
+        dstatev.col(p) = (sv_w->statev - sv->statev)/h;
+        dL.col(p) = vectorise(sv_w->L - sv->L)/h;
+    }
+}
+
+/*!
+  \brief Opens the backends of the derivatives with respect to each parameter, of the same type as the ones of the simulation (see make_output_backend)
+  \param outputfile : the output file of the simulation : the ones of the derivatives are given by outputfile(outputfile, p)
+*/
+
+//-------------------------------------------------------------
+void solver_sensitivity::open(std::vector<std::shared_ptr<output_backend> > &outputs, const solver_output &so, const std::string &path, const std::string &outputfile)
+//-------------------------------------------------------------
+{
+    outputs.resize(size());
+    for (int p=0; p<size(); p++) {
+        std::string outputfile_p = solver_sensitivity::outputfile(outputfile, p);
+        std::string ext_filename = outputfile_p.substr(outputfile_p.length()-4,outputfile_p.length());
+        std::string filename = outputfile_p.substr(0,outputfile_p.length()-4);
+        outputs[p] = make_output_backend(so);
+        outputs[p]->open(rve_d, so, path, filename + "_global" + ext_filename, "global");
+    }
+    //The files are only held by the backends : they are closed with them
+    rve_d.sptr_out_global.reset();
+}
+
+/*!
+  \brief Writes the derivatives of the global record of the increment with respect to each parameter. The increment info is the one of the simulation
+*/
+
+//-------------------------------------------------------------
+void solver_sensitivity::write(std::vector<std::shared_ptr<output_backend> > &outputs, const solver_output &so, const int &kblock, const int &kcycle, const int &kstep, const int &kinc, const double &Time)
+//-------------------------------------------------------------
+{
+    state_variables_M *sv_d = rve_d.sv_global<state_variables_M>();
+    for (int p=0; p<size(); p++) {
+        sv_d->Etot = dEtot.col(p);
+        sv_d->sigma = dsigma.col(p);
+        sv_d->Wm = dWm.col(p);
+        sv_d->statev = dstatev.col(p);
+        sv_d->T = 0.;
+
+        record.zeros(outputs[p]->nfields);
+        output_record(rve_d, so, kblock, kcycle, kstep, kinc, Time, record, "global");
+        outputs[p]->write_record(record);
+    }
+}
+
+/*!
+  \brief Name of the output file of the derivatives with respect to the parameter p : "_dp" followed by the number of the parameter (from 1) is added to the name of the output file
+*/
+
+//-------------------------------------------------------------
+std::string solver_sensitivity::outputfile(const std::string &outputfile, const int &p)
+//-------------------------------------------------------------
+{
+    std::string ext_filename = outputfile.substr(outputfile.length()-4,outputfile.length());
+    std::string filename = outputfile.substr(0,outputfile.length()-4);
+    return filename + "_dp" + std::to_string(p+1) + ext_filename;
+}
+
+/*!
+  \brief Standard operator = for solver_sensitivity
+*/
+
+//----------------------------------------------------------------------
+solver_sensitivity& solver_sensitivity::operator = (const solver_sensitivity& ss)
+//----------------------------------------------------------------------
+{
+    props_index = ss.props_index;
+    delta = ss.delta;
+    active = ss.active;
+
+    dEtot = ss.dEtot;
+    dsigma = ss.dsigma;
+    dWm = ss.dWm;
+    dstatev = ss.dstatev;
+    dL = ss.dL;
+    dmecas = ss.dmecas;
+
+    return *this;
+}
+
+//--------------------------------------------------------------------------
+ostream& operator << (ostream& s, const solver_sensitivity& ss)
+//--------------------------------------------------------------------------
+{
+    s << "Display info on the forward sensitivities:\n";
+    s << "props = " << ss.props_index.t();
+    s << "delta = " << ss.delta << "\t active = " << ss.active << "\n";
+    s << "\n";
+
+    return s;
+}
+
+} //namespace smart
@@ -0,0 +1,425 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file simulation_tree.cpp
+///@brief Snapshots of the solver at the block boundaries, shared by the simulations whose loading paths have a common prefix
+///@version 1.0
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <functional>
+#include <assert.h>
+#include <armadillo>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Solver/step.hpp>
+#include <smartplus/Libraries/Solver/step_meca.hpp>
+#include <smartplus/Libraries/Solver/step_thermomeca.hpp>
+#include <smartplus/Libraries/Homogenization/ellipsoid_multi.hpp>
+#include <smartplus/Libraries/Solver/simulation_tree.hpp>
+
+using namespace std;
+using namespace arma;
+
+namespace smart{
+
+//Size and hash of the content of a file, "none" if it does not exist
+static string file_digest(const string &path)
+{
+    ifstream f(path, ios::in | ios::binary);
+    if(!f)
+        return "none";
+    stringstream content;
+    content << f.rdbuf();
+    string s = content.str();
+    return to_string(s.size()) + ":" + to_string(std::hash<string>()(s));
+}
+
+//Loading conditions of a step. For an incremental path file, its content is described rather than its name
+template<class S> static void describe_step(ostream &s, const S &st)
+{
+    s << "step\t" << st.mode << "\t" << st.Dn_init << "\t" << st.Dn_mini << "\t" << st.Dn_inc << "\t" << st.ninc << "\t" << st.BC_Time << "\n";
+    s << st.cBC_meca.t() << st.BC_meca.t();
+    s << st.cBC_T << "\t" << st.BC_T << "\n";
+    if (st.mode == 3)
+        s << "file\t" << file_digest(st.file) << "\n";
+}
+
+//=====Private methods for solver_snapshot===================================
+
+//=====Public methods for solver_snapshot============================================
+
+//@brief default constructor
+//-------------------------------------------------------------
+solver_snapshot::solver_snapshot()
+//-------------------------------------------------------------
+{
+    key = "";
+    nblock = 0;
+    Time = 0.;
+    tnew_dt = 1.;
+    o_ncount = 0;
+    o_tcount = 0.;
+    mp = 0;
+    np = 0;
+}
+
+/*!
+  \brief Constructor with parameters. The RVE is copied with its sub-phases, so that the snapshot does not change when the simulation goes on.
+  The integration points of the Eshelby tensors are the current ones
+  \param mkey : key of the prefix
+  \param mnblock : number of blocks of the prefix
+  \param mrve : RVE at the end of the prefix
+  \param mTime : time at the end of the prefix
+  \param mtnew_dt : fraction of the next increment
+  \param mo_ncount : number of increments since the last output
+  \param mo_tcount : time since the last output
+  \param mrecords_global : output records of the prefix (global coordinates)
+  \param mrecords_local : output records of the prefix (local coordinates)
+*/
+
+//-------------------------------------------------------------
+solver_snapshot::solver_snapshot(const string &mkey, const int &mnblock, const phase_characteristics &mrve, const double &mTime, const double &mtnew_dt, const int &mo_ncount, const double &mo_tcount, const std::vector<vec> &mrecords_global, const std::vector<vec> &mrecords_local)
+//-------------------------------------------------------------
+{
+    assert(mnblock > 0);
+
+    key = mkey;
+    nblock = mnblock;
+    rve.copy(mrve);
+    Time = mTime;
+    tnew_dt = mtnew_dt;
+    o_ncount = mo_ncount;
+    o_tcount = mo_tcount;
+    records_global = mrecords_global;
+    records_local = mrecords_local;
+    mp = ellipsoid_multi::mp;
+    np = ellipsoid_multi::np;
+    x = ellipsoid_multi::x;
+    wx = ellipsoid_multi::wx;
+    y = ellipsoid_multi::y;
+    wy = ellipsoid_multi::wy;
+}
+
+/*!
+  \brief Copy constructor
+  \param ss solver_snapshot object to duplicate
+*/
+
+//------------------------------------------------------
+solver_snapshot::solver_snapshot(const solver_snapshot& ss)
+//------------------------------------------------------
+{
+    key = ss.key;
+    nblock = ss.nblock;
+    if (ss.rve.sptr_sv_global)
+        rve.copy(ss.rve);
+    Time = ss.Time;
+    tnew_dt = ss.tnew_dt;
+    o_ncount = ss.o_ncount;
+    o_tcount = ss.o_tcount;
+    records_global = ss.records_global;
+    records_local = ss.records_local;
+    mp = ss.mp;
+    np = ss.np;
+    x = ss.x;
+    wx = ss.wx;
+    y = ss.y;
+    wy = ss.wy;
+}
+
+/*!
+  \brief Destructor
+*/
+
+//-------------------------------------
+solver_snapshot::~solver_snapshot() {}
+//-------------------------------------
+
+/*!
+  \brief The simulation resumes without calling the models with start = true : the integration points left by the previous simulation may differ
+  (e.g. with other tolerances), the ones of the snapshot are set back
+*/
+
+//-------------------------------------------------------------
+void solver_snapshot::restore_points() const
+//-------------------------------------------------------------
+{
+    ellipsoid_multi::mp = mp;
+    ellipsoid_multi::np = np;
+    ellipsoid_multi::x = x;
+    ellipsoid_multi::wx = wx;
+    ellipsoid_multi::y = y;
+    ellipsoid_multi::wy = wy;
+}
+
+/*!
+  \brief Standard operator = for solver_snapshot
+*/
+
+//----------------------------------------------------------------------
+solver_snapshot& solver_snapshot::operator = (const solver_snapshot& ss)
+//----------------------------------------------------------------------
+{
+    key = ss.key;
+    nblock = ss.nblock;
+    if (ss.rve.sptr_sv_global)
+        rve.copy(ss.rve);
+    Time = ss.Time;
+    tnew_dt = ss.tnew_dt;
+    o_ncount = ss.o_ncount;
+    o_tcount = ss.o_tcount;
+    records_global = ss.records_global;
+    records_local = ss.records_local;
+    mp = ss.mp;
+    np = ss.np;
+    x = ss.x;
+    wx = ss.wx;
+    y = ss.y;
+    wy = ss.wy;
+
+    return *this;
+}
+
+//--------------------------------------------------------------------------
+ostream& operator << (ostream& s, const solver_snapshot& ss)
+//--------------------------------------------------------------------------
+{
+    s << "Display info on the solver snapshot:\n";
+    s << "Blocks of the prefix = " << ss.nblock << "\t Time = " << ss.Time << "\t output records = " << ss.records_global.size() << "\n";
+    s << "\n";
+
+    return s;
+}
+
+//=====Private methods for simulation_tree===================================
+
+//=====Public methods for simulation_tree============================================
+
+//@brief default constructor
+//-------------------------------------------------------------
+simulation_tree::simulation_tree()
+//-------------------------------------------------------------
+{
+    capacity = 0;
+    nhits = 0;
+    nmisses = 0;
+    nblocks_saved = 0;
+}
+
+/*!
+  \brief Constructor with parameters
+  \param mcapacity : maximal number of snapshots kept
+*/
+
+//-------------------------------------------------------------
+simulation_tree::simulation_tree(const int &mcapacity)
+//-------------------------------------------------------------
+{
+    assert(mcapacity >= 0);
+
+    capacity = mcapacity;
+    nhits = 0;
+    nmisses = 0;
+    nblocks_saved = 0;
+}
+
+/*!
+  \brief Copy constructor
+  \param st simulation_tree object to duplicate
+*/
+
+//------------------------------------------------------
+simulation_tree::simulation_tree(const simulation_tree& st)
+//------------------------------------------------------
+{
+    capacity = st.capacity;
+    props_block = st.props_block;
+    snapshots = st.snapshots;
+    nhits = st.nhits;
+    nmisses = st.nmisses;
+    nblocks_saved = st.nblocks_saved;
+}
+
+/*!
+  \brief Destructor
+*/
+
+//-------------------------------------
+simulation_tree::~simulation_tree() {}
+//-------------------------------------
+
+//-------------------------------------------------------------
+bool simulation_tree::active() const
+//-------------------------------------------------------------
+{
+    return (capacity > 0);
+}
+
+//-------------------------------------------------------------
+void simulation_tree::clear()
+//-------------------------------------------------------------
+{
+    snapshots.clear();
+}
+
+/*!
+  \brief Looks for the snapshot of a prefix. A snapshot found becomes the most recently used one
+  \param key : key of the prefix, from prefix_keys
+  \return the snapshot, NULL if there is none for this key
+*/
+
+//-------------------------------------------------------------
+const solver_snapshot* simulation_tree::find(const string &key)
+//-------------------------------------------------------------
+{
+    for (auto it = snapshots.begin(); it != snapshots.end(); ++it) {
+        if (it->key == key) {
+            snapshots.splice(snapshots.begin(), snapshots, it);
+            return &snapshots.front();
+        }
+    }
+    return NULL;
+}
+
+/*!
+  \brief Keeps a snapshot. A snapshot with the same key is replaced, and the least recently used snapshots are discarded beyond the capacity
+  \param ss : snapshot
+*/
+
+//-------------------------------------------------------------
+void simulation_tree::insert(const solver_snapshot &ss)
+//-------------------------------------------------------------
+{
+    if (capacity <= 0)
+        return;
+
+    for (auto it = snapshots.begin(); it != snapshots.end(); ++it) {
+        if (it->key == ss.key) {
+            snapshots.erase(it);
+            break;
+        }
+    }
+    snapshots.push_front(ss);
+    while (int(snapshots.size()) > capacity) {
+        snapshots.pop_back();
+    }
+}
+
+/*!
+  \brief Standard operator = for simulation_tree
+*/
+
+//----------------------------------------------------------------------
+simulation_tree& simulation_tree::operator = (const simulation_tree& st)
+//----------------------------------------------------------------------
+{
+    capacity = st.capacity;
+    props_block = st.props_block;
+    snapshots = st.snapshots;
+    nhits = st.nhits;
+    nmisses = st.nmisses;
+    nblocks_saved = st.nblocks_saved;
+
+    return *this;
+}
+
+//--------------------------------------------------------------------------
+ostream& operator << (ostream& s, const simulation_tree& st)
+//--------------------------------------------------------------------------
+{
+    s << "Display info on the simulation tree:\n";
+    s << "capacity = " << st.capacity << "\t snapshots = " << st.snapshots.size() << "\n";
+    s << "Simulations started from a snapshot = " << st.nhits << "\t from the beginning = " << st.nmisses << "\t blocks not simulated again = " << st.nblocks_saved << "\n";
+    s << "\n";
+
+    return s;
+}
+
+/*!
+  \brief Describes the prefixes of a loading path. Two simulations reach the same state after i blocks if the i-th keys are equal :
+  the keys gather the model, the props that affect the first i blocks, the orientation, the solver controls, the initial temperature,
+  the output and cycle controls and the loading conditions of the first i blocks (the content of the incremental path files), and the content of the files
+  of the phases read by the multiphase models at their first call.
+  \param umat_name : name of the constitutive model
+  \param props : props of the model
+  \param nstatev : number of internal variables
+  \param psi_rve, theta_rve, phi_rve : orientation of the RVE
+  \param controls : solver type, solver controls and tolerances of the models
+  \param T_init : initial temperature
+  \param blocks : loading path
+  \param so : output controls
+  \param cc : treatment of the cycles
+  \param props_block : first block (starting at 1) whose response depends on each prop, the props beyond its size affect every block
+  \param path_data : folder of the data files, from which the multiphase models read their phases
+  \return the keys of the prefixes of 0 to blocks.size() blocks
+*/
+
+//-------------------------------------------------------------
+std::vector<std::string> prefix_keys(const string &umat_name, const vec &props, const int &nstatev, const double &psi_rve, const double &theta_rve, const double &phi_rve, const vec &controls, const double &T_init, const std::vector<block> &blocks, const solver_output &so, const cycle_control &cc, const Col<int> &props_block, const string &path_data)
+//-------------------------------------------------------------
+{
+    std::vector<std::string> keys(blocks.size()+1);
+
+    ostringstream base;
+    base.precision(17);
+    base << "umat\t" << umat_name << "\t" << nstatev << "\n";
+    base << "orientation\t" << psi_rve << "\t" << theta_rve << "\t" << phi_rve << "\n";
+    base << "solver\t" << controls.t();
+    base << "T_init\t" << T_init << "\n";
+    base << "output\t" << so.o_nb_meca << "\t" << so.o_nb_T << "\t" << so.o_nw_statev << "\n" << so.o_meca.t() << so.o_wanted_statev.t() << so.o_range_statev.t();
+    if (props.n_elem > 1) {
+        std::vector<std::string> microstructures = {"Nphases", "Nellipsoids", "Nlayers", "Ncylinders"};
+        for (auto &m : microstructures) {
+            string path_file = path_data + "/" + m + to_string(int(props(1))) + ".dat";
+            base << m << "\t" << file_digest(path_file) << "\n";
+        }
+    }
+    keys[0] = base.str();
+
+    ostringstream path;
+    path.precision(17);
+    for (unsigned int i=0; i<blocks.size(); i++) {
+        path << "block\t" << blocks[i].type << "\t" << blocks[i].nstep << "\t" << blocks[i].ncycle << "\n";
+        for (int j=0; j<blocks[i].nstep; j++) {
+            if (blocks[i].type == 1)
+                describe_step(path, *std::dynamic_pointer_cast<step_meca>(blocks[i].steps[j]));
+            else if (blocks[i].type == 2)
+                describe_step(path, *std::dynamic_pointer_cast<step_thermomeca>(blocks[i].steps[j]));
+        }
+        path << "output\t" << so.o_type(i) << "\t" << so.o_nfreq(i) << "\t" << so.o_tfreq(i) << "\n";
+        path << "cycles\t" << cc.c_jump(i) << "\t" << cc.c_ncompute(i) << "\t" << cc.c_tolerance(i) << "\t" << cc.c_njump_min(i) << "\t" << cc.c_njump_max(i);
+        path << "\t" << cc.c_stab(i) << "\t" << cc.c_stab_tolerance(i) << "\t" << cc.c_stab_ncycles(i) << "\n";
+
+        //The props that affect the first i+1 blocks
+        ostringstream p;
+        p.precision(17);
+        p << "props";
+        for (unsigned int k=0; k<props.n_elem; k++) {
+            if ((k >= props_block.n_elem)||(props_block(k) <= int(i)+1))
+                p << "\t" << k << ":" << props(k);
+        }
+        p << "\n";
+
+        keys[i+1] = keys[0] + p.str() + path.str();
+    }
+
+    return keys;
+}
+
+} //namespace smart
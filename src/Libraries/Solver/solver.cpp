@@ -39,13 +39,105 @@
 #include <smartplus/Libraries/Solver/step.hpp>
 #include <smartplus/Libraries/Solver/step_meca.hpp>
 #include <smartplus/Libraries/Solver/step_thermomeca.hpp>
+#include <smartplus/Libraries/Solver/output_backend.hpp>
+#include <smartplus/Libraries/Solver/cycle_control.hpp>
+#include <smartplus/Libraries/Solver/cycle_jump.hpp>
+#include <smartplus/Libraries/Solver/cycle_stabilization.hpp>
+#include <smartplus/Libraries/Solver/simulation_tree.hpp>
+#include <smartplus/Libraries/Solver/checkpoint.hpp>
 
 using namespace std;
 using namespace arma;
 
 namespace smart{
 
-void solver(const string &umat_name, const vec &props, const double &nstatev, const double &psi_rve, const double &theta_rve, const double &phi_rve, const int &solver_type, const double &div_tnew_dt_solver, const double &mul_tnew_dt_solver, const int &miniter_solver, const int &maxiter_solver, const int &inforce_solver, const double &precision_solver, const double &lambda_solver, const std::string &path_data, const std::string &path_results, const std::string &pathfile, const std::string &outputfile) {
+//Closes the output backends of the solver on every exit path : the files are complete once it returns, even if a backend is kept by the caller (e.g. a monitor)
+struct output_closer
+{
+    std::shared_ptr<output_backend> &out_global;
+    std::shared_ptr<output_backend> &out_local;
+    std::vector<std::shared_ptr<output_backend> > &out_sensi;
+    
+    output_closer(std::shared_ptr<output_backend> &mout_global, std::shared_ptr<output_backend> &mout_local, std::vector<std::shared_ptr<output_backend> > &mout_sensi) : out_global(mout_global), out_local(mout_local), out_sensi(mout_sensi) {}
+    
+    ~output_closer()
+    {
+        if (out_global)
+            out_global->close();
+        if (out_local)
+            out_local->close();
+        for (unsigned int p=0; p<out_sensi.size(); p++) {
+            if (out_sensi[p])
+                out_sensi[p]->close();
+        }
+    }
+};
+
+//Treatment of the end of the cycle n of the block ib : detection of a periodic response, then cycle-jump.
+//n is moved to the last cycle treated, Time and the slow variables to the end of this cycle, the ranges of cycles are listed in out_cycles
+static void end_cycle(phase_characteristics &rve, const block &bl, const int &ib, int &n, int &n_computed, double &Time, const cycle_control &cc, cycle_jump &cj, cycle_stabilization &cs, output_backend &out_global, output_backend &out_local, std::ofstream &out_cycles)
+{
+    if (cc.c_stab(ib)) {
+        if (cs.end(Time)) {
+            int nremaining = bl.ncycle - n - 1;
+            out_cycles << "#Block " << bl.number << " : periodic response at cycle " << n+1 << " after " << cs.ncompared << " comparisons, errors sigma = " << cs.errors(0) << " Etot = " << cs.errors(1) << " statev = " << cs.errors(2) << "\n";
+            out_cycles << bl.number << "\t" << n_computed+1 << "\t" << n+1 << "\tcomputed\n";
+            if (nremaining > 0) {
+                if (cc.c_stab(ib) == 2) {
+                    cs.replay(out_global, out_local, nremaining);
+                    out_cycles << bl.number << "\t" << n+2 << "\t" << bl.ncycle << "\tcopied\n";
+                }
+                else {
+                    out_cycles << bl.number << "\t" << n+2 << "\t" << bl.ncycle << "\tskipped\n";
+                }
+                cs.skip(rve, nremaining);
+                Time += nremaining*cs.period;
+            }
+            n = bl.ncycle;
+            n_computed = bl.ncycle;
+            return;
+        }
+        else if (n == bl.ncycle - 1) {
+            out_cycles << "#Block " << bl.number << " : no periodic response after " << cs.ncompared << " comparisons, errors sigma = " << cs.errors(0) << " Etot = " << cs.errors(1) << " statev = " << cs.errors(2) << "\n";
+        }
+    }
+    
+    if (cc.c_jump(ib)) {
+        cj.record(rve, Time);
+        int njump = cj.size(bl.ncycle - n - 1);
+        if (njump > 0) {
+            Time += cj.jump(rve, njump);
+            cj.record(rve, Time);
+            out_cycles << bl.number << "\t" << n_computed+1 << "\t" << n+1 << "\tcomputed\n";
+            out_cycles << bl.number << "\t" << n+2 << "\t" << n+1+njump << "\textrapolated\n";
+            n += njump;
+            n_computed = n+1;
+            //The cycle before the jump cannot be compared with the next one
+            cs.reset();
+        }
+    }
+    
+    if (cc.c_stab(ib))
+        cs.begin(rve, Time);
+}
+
+//Checkpoint at the end of the cycle n of the block ib : the simulation can be restarted from the next cycle
+static void checkpoint_cycle(solver_checkpoint &sc, const std::string &checkpoint_file, const phase_characteristics &rve, const block &bl, const int &ib, const int &n, const double &Time, const double &tnew_dt, const double &Dtinc, const double &Dtinc_cur, const double &error, const vec &residual, const int &o_ncount, const double &o_tcount)
+{
+    sc.kblock = (n+1 < bl.ncycle) ? ib : ib+1;
+    sc.kcycle = (n+1 < bl.ncycle) ? n+1 : 0;
+    sc.Time = Time;
+    sc.tnew_dt = tnew_dt;
+    sc.Dtinc = Dtinc;
+    sc.Dtinc_cur = Dtinc_cur;
+    sc.error = error;
+    sc.residual = residual;
+    sc.o_ncount = o_ncount;
+    sc.o_tcount = o_tcount;
+    sc.save(checkpoint_file, rve);
+}
+
+void solver(const string &umat_name, const vec &props, const double &nstatev, const double &psi_rve, const double &theta_rve, const double &phi_rve, const int &solver_type, const double &div_tnew_dt_solver, const double &mul_tnew_dt_solver, const int &miniter_solver, const int &maxiter_solver, const int &inforce_solver, const double &precision_solver, const double &lambda_solver, const std::string &path_data, const std::string &path_results, const std::string &pathfile, const std::string &outputfile, simulation_tree *tree, const std::shared_ptr<output_monitor> &sptr_monitor, solver_sensitivity *sensi) {
 
     //Check if the required directories exist:
     if(!boost::filesystem::is_directory(path_data)) {
@@ -64,6 +156,8 @@ void solver(const string &umat_name, const vec &props, const double &nstatev, co
     std::string outputfile_local = filename + "_local" + ext_filename;
     
     std::string output_info_file = "output.dat";
+    std::string cycle_info_file = "cycle_control.inp";
+    std::string checkpoint_info_file = "checkpoint.inp";
     
 	///Usefull UMAT variables
 	int ndi = 3;
@@ -96,6 +190,7 @@ void solver(const string &umat_name, const vec &props, const double &nstatev, co
     
     ///Material properties reading, use "material.dat" to specify parameters values
     rve.sptr_matprops->update(0, umat_name, 1, psi_rve, theta_rve, phi_rve, props.n_elem, props);
+    rve.sptr_matprops->path_data = path_data;
     
     //Output
     int o_ncount = 0;
@@ -106,6 +201,92 @@ void solver(const string &umat_name, const vec &props, const double &nstatev, co
     //Check output and step files
     check_path_output(blocks, so);
     
+    //Output backends, closed (and flushed) when the solver returns
+    std::shared_ptr<output_backend> out_global = make_output_backend(so);
+    std::shared_ptr<output_backend> out_local = make_output_backend(so);
+    
+    //The global records are checked by the monitor, which can stop the simulation (e.g. an identification with early abort)
+    if (sptr_monitor) {
+        sptr_monitor->sptr_backend = out_global;
+        out_global = sptr_monitor;
+    }
+    
+    //Treatment of the cycles of the blocks. When it is active, the cycles integrated and extrapolated are listed in a file
+    cycle_control cc(blocks.size());
+    read_cycle_control(cc, blocks.size(), path_data, cycle_info_file);
+    std::ofstream out_cycles;
+    if (cc.active()) {
+        out_cycles.open(path_results + "/" + filename + "_cycles" + ext_filename);
+        out_cycles << "#Block\tFirst_cycle\tLast_cycle\tStatus\n";
+    }
+    
+    //Checkpoints of the solver, written at the end of the cycles
+    int checkpoint_every = 0;
+    int checkpoint_restart = 0;
+    read_checkpoint_control(checkpoint_every, checkpoint_restart, path_data, checkpoint_info_file);
+    std::string checkpoint_file = path_results + "/" + filename + "_checkpoint.bin";
+    
+    //Forward sensitivities with respect to some props, written in their own files. They are not integrated over the cycles extrapolated or replayed,
+    //nor from the state of a previous simulation or of a checkpoint
+    std::vector<std::shared_ptr<output_backend> > out_sensi;
+    output_closer closer(out_global, out_local, out_sensi);
+    if (sensi != NULL) {
+        sensi->active = ((!cc.active())&&(checkpoint_restart == 0));
+    }
+    
+    //Prefixes of the loading path shared with the previous simulations : the solver starts from the snapshot of the longest one.
+    //The records written are kept, so that the output of the prefix can be written again by the next simulations
+    std::vector<std::string> keys;
+    std::shared_ptr<output_recorder> rec_global;
+    std::shared_ptr<output_recorder> rec_local;
+    unsigned int i_start = 0;
+    if ((tree != NULL)&&(tree->active())&&(checkpoint_restart == 0)&&((sensi == NULL)||(!sensi->active))) {
+        //The tolerances of the models are part of the controls : a prefix is not shared by simulations of different accuracies
+        const tolerances &tol = rve.sptr_matprops->tol;
+        vec controls = {double(solver_type), div_tnew_dt_solver, mul_tnew_dt_solver, double(miniter_solver), double(maxiter_solver), double(inforce_solver), precision_solver, lambda_solver, double(tol.umat_maxiter), tol.umat_precision, double(tol.umat_substeps), double(tol.micro_maxiter), tol.micro_precision, double(tol.micro_points), tol.zero_limit, tol.zero_iota};
+        keys = prefix_keys(umat_name, props, nstatev, psi_rve, theta_rve, phi_rve, controls, T_init, blocks, so, cc, tree->props_block, path_data);
+        rec_global = std::make_shared<output_recorder>(out_global);
+        rec_local = std::make_shared<output_recorder>(out_local);
+        out_global = rec_global;
+        out_local = rec_local;
+        
+        for (unsigned int nb = blocks.size(); nb > 0; nb--) {
+            const solver_snapshot *ss = tree->find(keys[nb]);
+            if (ss == NULL)
+                continue;
+            
+            //The props that do not affect the prefix may differ from the ones of the snapshot
+            rve.copy(ss->rve);
+            rve.sptr_matprops->update(0, umat_name, 1, psi_rve, theta_rve, phi_rve, props.n_elem, props);
+            rve.sptr_matprops->path_data = path_data;
+            Time = ss->Time;
+            tnew_dt = ss->tnew_dt;
+            o_ncount = ss->o_ncount;
+            o_tcount = ss->o_tcount;
+            ss->restore_points();
+            
+            out_global->open(rve, so, path_results, outputfile_global, "global");
+            out_local->open(rve, so, path_results, outputfile_local, "local");
+            for (unsigned int r=0; r<ss->records_global.size(); r++) {
+                out_global->write_record(ss->records_global[r]);
+                out_local->write_record(ss->records_local[r]);
+            }
+            if (cc.active()) {
+                out_cycles << "#Blocks 1 to " << nb << " : started from the state of a previous simulation\n";
+            }
+            
+            start = false;
+            i_start = nb;
+            break;
+        }
+        if (i_start > 0) {
+            tree->nhits++;
+            tree->nblocks_saved += i_start;
+        }
+        else
+            tree->nmisses++;
+    }
+    
     double error = 0.;
     vec residual;
     vec Delta;
@@ -120,8 +301,35 @@ void solver(const string &umat_name, const vec &props, const double &nstatev, co
     double Dtinc_cur=0.;
     double q_conv = 0.;        //q_conv parameter for 0D convexion, Q_conv = qconv (T-T_init), with q_conv = rho*c_p\tau, tau being a time constant for convexion thermal mechanical conditions
     
+    //Restart from the last checkpoint. The results are written in new files, so that the ones written before the checkpoint are kept
+    solver_checkpoint sc;
+    phase_state ps_restart;         //State of the checkpoint, set back after the initialization of its block
+    int n_start = 0;                //First cycle of the block i_start
+    int ncycles_checkpoint = 0;     //Number of cycles since the last checkpoint
+    if ((checkpoint_restart)&&(sc.load(checkpoint_file, rve))) {
+        rve.sptr_matprops->path_data = path_data;
+        ps_restart.save(rve);
+        Time = sc.Time;
+        tnew_dt = sc.tnew_dt;
+        Dtinc = sc.Dtinc;
+        Dtinc_cur = sc.Dtinc_cur;
+        error = sc.error;
+        o_ncount = sc.o_ncount;
+        o_tcount = sc.o_tcount;
+        
+        out_global->open(rve, so, path_results, filename + "_restart_global" + ext_filename, "global");
+        out_local->open(rve, so, path_results, filename + "_restart_local" + ext_filename, "local");
+        if (cc.active()) {
+            out_cycles << "#Restart at block " << sc.kblock+1 << ", cycle " << sc.kcycle+1 << "\n";
+        }
+        
+        start = false;
+        i_start = sc.kblock;
+        n_start = sc.kcycle;
+    }
+    
     /// Block loop
-    for(unsigned int i = 0 ; i < blocks.size() ; i++){
+    for(unsigned int i = i_start ; i < blocks.size() ; i++){
 
         switch(blocks[i].type) {
             case 1: { //Mechanical
@@ -176,8 +384,13 @@ void solver(const string &umat_name, const vec &props, const double &nstatev, co
                 
                 if(start) {
                     //Use the number of phases saved to define the files
-                    rve.define_output(path_results, outputfile_global, "global");
-                    rve.define_output(path_results, outputfile_local, "local");
+                    out_global->open(rve, so, path_results, outputfile_global, "global");
+                    out_local->open(rve, so, path_results, outputfile_local, "local");
+                    if ((sensi != NULL)&&(sensi->active)) {
+                        sensi->begin(rve, DR, Time, ndi, nshr, solver_type);
+                        if (sensi->active)
+                            sensi->open(out_sensi, so, path_results, outputfile);
+                    }
                     //Write the initial results
 //                    rve.output(so, -1, -1, -1, -1, Time, "global");
 //                    rve.output(so, -1, -1, -1, -1, Time, "local");
@@ -186,14 +399,32 @@ void solver(const string &umat_name, const vec &props, const double &nstatev, co
                 rve.set_start(); //DEtot = 0 and DT = 0 so we can use it safely here
                 start = false;
                 
+                //Restart in the middle of the block : the state of the checkpoint is set back after the initialization of the block
+                if (n_start > 0) {
+                    ps_restart.restore(rve);
+                    residual = sc.residual;
+                    tnew_dt = sc.tnew_dt;
+                }
+                
+                //Cycle-jump and detection of a periodic response : the state is recorded from the beginning of the block
+                cycle_jump cj(cc.c_ncompute(i), cc.c_tolerance(i), cc.c_njump_min(i), cc.c_njump_max(i));
+                cycle_stabilization cs(cc.c_stab_tolerance(i), cc.c_stab_ncycles(i));
+                int n_computed = n_start;     //First cycle integrated since the last jump
+                if (cc.c_jump(i))
+                    cj.record(rve, Time);
+                if (cc.c_stab(i))
+                    cs.begin(rve, Time);
+                
                 /// Cycle loop
-                for(int n = 0; n < blocks[i].ncycle; n++){
+                for(int n = n_start; n < blocks[i].ncycle; n++){
                     
                     /// Step loop
                     for(int j = 0; j < blocks[i].nstep; j++){
                     
                         sptr_meca = std::dynamic_pointer_cast<step_meca>(blocks[i].steps[j]);
                         sptr_meca->generate(Time, sv_M->Etot, sv_M->sigma, sv_M->T);
+                        if ((sensi != NULL)&&(sensi->active))
+                            sensi->generate(*sptr_meca);
                         
                         nK = sum(sptr_meca->cBC_meca);
                         
@@ -342,6 +573,11 @@ void solver(const string &umat_name, const vec &props, const double &nstatev, co
                                 }
                                 compteur = 0;
                                 
+                                //Forward sensitivities over the converged increment
+                                if ((sensi != NULL)&&(sensi->active)&&(tnew_dt >= 1.)) {
+                                    sensi->increment(rve, sptr_meca->cBC_meca, sensi->prescribed(inc, Dtinc), DR, Time, DTime, ndi, nshr, solver_type);
+                                }
+                                
                                 sptr_meca->assess_inc(tnew_dt, tinc, Dtinc, rve ,Time, DTime);
                                 //start variables ready for the next increment
                                 
@@ -358,8 +594,12 @@ void solver(const string &umat_name, const vec &props, const double &nstatev, co
                             //Write the results
                             if (((so.o_type(i) == 1)&&(o_ncount == so.o_nfreq(i)))||(((so.o_type(i) == 2)&&(fabs(o_tcount - so.o_tfreq(i)) < 1.E-12)))) {
                                 
-                                rve.output(so, i, n, j, inc, Time, "global");
-                                rve.output(so, i, n, j, inc, Time, "local");
+                                out_global->write(rve, so, i, n, j, inc, Time);
+                                out_local->write(rve, so, i, n, j, inc, Time);
+                                if ((sensi != NULL)&&(sensi->active))
+                                    sensi->write(out_sensi, so, i, n, j, inc, Time);
+                                if (cc.c_stab(i) == 2)
+                                    cs.store(rve, so, *out_global, *out_local, i, n, j, inc, Time);
                                 
                                 if (so.o_type(i) == 1) {
                                     o_ncount = 0;
@@ -369,17 +609,49 @@ void solver(const string &umat_name, const vec &props, const double &nstatev, co
                                 }
                             }
                             
+                            if (cc.c_stab(i))
+                                cs.sample(rve);
+                            
+                            //The simulation has been stopped by the monitor of the records
+                            if ((sptr_monitor)&&(sptr_monitor->stopped))
+                                return;
+                            
                             tinc = 0.;
                             inc++;
                          }
                                                 
                     }
+
+                    //Detection of a periodic response and cycle-jump
+                    if ((cc.c_jump(i))||(cc.c_stab(i))) {
+                        end_cycle(rve, blocks[i], i, n, n_computed, Time, cc, cj, cs, *out_global, *out_local, out_cycles);
+                    }
+                    if ((sptr_monitor)&&(sptr_monitor->stopped))
+                        return;
+                    
+                    //Checkpoint of the solver
+                    if (checkpoint_every > 0) {
+                        ncycles_checkpoint++;
+                        if (ncycles_checkpoint >= checkpoint_every) {
+                            checkpoint_cycle(sc, checkpoint_file, rve, blocks[i], i, n, Time, tnew_dt, Dtinc, Dtinc_cur, error, residual, o_ncount, o_tcount);
+                            ncycles_checkpoint = 0;
+                        }
+                    }
                         
                 }
+
+                if (((cc.c_jump(i))||(cc.c_stab(i)))&&(n_computed < blocks[i].ncycle)) {
+                    out_cycles << blocks[i].number << "\t" << n_computed+1 << "\t" << blocks[i].ncycle << "\tcomputed\n";
+                }
+                n_start = 0;
                 break;
             }
             case 2: { //Thermomechanical
                 
+                //The forward sensitivities are integrated for mechanical blocks only
+                if (sensi != NULL)
+                    sensi->active = false;
+                
                 /// resize the problem to solve
                 residual = zeros(7);
                 Delta = zeros(7);
@@ -436,8 +708,8 @@ void solver(const string &umat_name, const vec &props, const double &nstatev, co
                 
                 if(start) {
                     //Use the number of phases saved to define the files
-                    rve.define_output(path_results, outputfile_global, "global");
-                    rve.define_output(path_results, outputfile_local, "local");
+                    out_global->open(rve, so, path_results, outputfile_global, "global");
+                    out_local->open(rve, so, path_results, outputfile_local, "local");
                     //Write the initial results
 //                    rve.output(so, -1, -1, -1, -1, Time, "global");
 //                    rve.output(so, -1, -1, -1, -1, Time, "local");
@@ -446,8 +718,24 @@ void solver(const string &umat_name, const vec &props, const double &nstatev, co
                 rve.set_start(); //DEtot = 0 and DT = 0 so we can use it safely here
                 start = false;
                 
+                //Restart in the middle of the block : the state of the checkpoint is set back after the initialization of the block
+                if (n_start > 0) {
+                    ps_restart.restore(rve);
+                    residual = sc.residual;
+                    tnew_dt = sc.tnew_dt;
+                }
+                
+                //Cycle-jump and detection of a periodic response : the state is recorded from the beginning of the block
+                cycle_jump cj(cc.c_ncompute(i), cc.c_tolerance(i), cc.c_njump_min(i), cc.c_njump_max(i));
+                cycle_stabilization cs(cc.c_stab_tolerance(i), cc.c_stab_ncycles(i));
+                int n_computed = n_start;     //First cycle integrated since the last jump
+                if (cc.c_jump(i))
+                    cj.record(rve, Time);
+                if (cc.c_stab(i))
+                    cs.begin(rve, Time);
+                
                 /// Cycle loop
-                for(int n = 0; n < blocks[i].ncycle; n++){
+                for(int n = n_start; n < blocks[i].ncycle; n++){
                     
                     /// Step loop
                     for(int j = 0; j < blocks[i].nstep; j++){
@@ -688,8 +976,10 @@ void solver(const string &umat_name, const vec &props, const double &nstatev, co
                             //Write the results
                             if (((so.o_type(i) == 1)&&(o_ncount == so.o_nfreq(i)))||(((so.o_type(i) == 2)&&(fabs(o_tcount - so.o_tfreq(i)) < 1.E-12)))) {
                     
-                                rve.output(so, i, n, j, inc, Time, "global");
-                                rve.output(so, i, n, j, inc, Time, "local");
+                                out_global->write(rve, so, i, n, j, inc, Time);
+                                out_local->write(rve, so, i, n, j, inc, Time);
+                                if (cc.c_stab(i) == 2)
+                                    cs.store(rve, so, *out_global, *out_local, i, n, j, inc, Time);
                                 if (so.o_type(i) == 1) {
                                     o_ncount = 0;
                                 }
@@ -698,13 +988,41 @@ void solver(const string &umat_name, const vec &props, const double &nstatev, co
                                 }
                             }
                             
+                            if (cc.c_stab(i))
+                                cs.sample(rve);
+                            
+                            //The simulation has been stopped by the monitor of the records
+                            if ((sptr_monitor)&&(sptr_monitor->stopped))
+                                return;
+                            
                             tinc = 0.;
                             inc++;
                         }
                         
                     }
+
+                    //Detection of a periodic response and cycle-jump
+                    if ((cc.c_jump(i))||(cc.c_stab(i))) {
+                        end_cycle(rve, blocks[i], i, n, n_computed, Time, cc, cj, cs, *out_global, *out_local, out_cycles);
+                    }
+                    if ((sptr_monitor)&&(sptr_monitor->stopped))
+                        return;
+                    
+                    //Checkpoint of the solver
+                    if (checkpoint_every > 0) {
+                        ncycles_checkpoint++;
+                        if (ncycles_checkpoint >= checkpoint_every) {
+                            checkpoint_cycle(sc, checkpoint_file, rve, blocks[i], i, n, Time, tnew_dt, Dtinc, Dtinc_cur, error, residual, o_ncount, o_tcount);
+                            ncycles_checkpoint = 0;
+                        }
+                    }
                     
                 }
+
+                if (((cc.c_jump(i))||(cc.c_stab(i)))&&(n_computed < blocks[i].ncycle)) {
+                    out_cycles << blocks[i].number << "\t" << n_computed+1 << "\t" << blocks[i].ncycle << "\tcomputed\n";
+                }
+                n_start = 0;
                 break;
             }
             default: {
@@ -712,6 +1030,11 @@ void solver(const string &umat_name, const vec &props, const double &nstatev, co
                 break;
             }
         }
+        
+        //Snapshot of the state after the first i+1 blocks, for the next simulations that share this prefix
+        if (keys.size() > 0) {
+            tree->insert(solver_snapshot(keys[i+1], i+1, rve, Time, tnew_dt, o_ncount, o_tcount, rec_global->records, rec_local->records));
+        }
         //end of blocks loops
     }
     
@@ -24,6 +24,9 @@
 #include <fstream>
 #include <assert.h>
 #include <math.h>
+#include <map>
+#include <mutex>
+#include <functional>
 #include <armadillo>
 #include <smartplus/parameter.hpp>
 #include <smartplus/Libraries/Solver/step.hpp>
@@ -36,6 +39,90 @@ using namespace arma;
 
 namespace smart{
 
+//Table of an incremental path file in the cache of read_path_table
+struct path_table_entry
+{
+    std::size_t size;                   //Size of the content of the file
+    std::size_t hash;                   //Hash of the content of the file
+    unsigned long last_use;             //Number of the last lookup of the table
+    std::shared_ptr<const mat> table;
+};
+
+/*!
+ \brief Reads an incremental path file : each non-empty line is an increment, whose first entry is skipped. The tables are kept per process, and parsed again if the
+ content of the file has changed (its modification time is not precise enough for the files rewritten by an identification). At most max_path_tables tables are kept,
+ the least recently used one is dropped first
+ \param file : path of the file
+ \param ncols : number of values read after the first entry of each line
+ */
+
+//-------------------------------------------------------------
+std::shared_ptr<const mat> read_path_table(const std::string &file, const int &ncols)
+//-------------------------------------------------------------
+{
+    static std::mutex tables_mutex;
+    static std::map<std::string, path_table_entry> tables;
+    static unsigned long nlookups = 0;
+    
+    ifstream pathfile(file, ios::in | ios::binary);
+    if(!pathfile) {
+        cout << "Error: cannot open the file " << file << "\n Please check if the file is correct and is you have added the extension\n";
+        return std::make_shared<const mat>(0, ncols);
+    }
+    stringstream content;
+    content << pathfile.rdbuf();
+    pathfile.close();
+    std::string text = content.str();
+    std::size_t size = text.size();
+    std::size_t hash = std::hash<std::string>()(text);
+    std::string key = file + "#" + to_string(ncols);
+    
+    std::lock_guard<std::mutex> lock(tables_mutex);
+    nlookups++;
+    auto it = tables.find(key);
+    if ((it != tables.end())&&(it->second.size == size)&&(it->second.hash == hash)) {
+        it->second.last_use = nlookups;
+        return it->second.table;
+    }
+    
+    //read the content to get the number of increments
+    string buffer;
+    istringstream pathinc(text);
+    int ninc = 0;
+    while (getline(pathinc,buffer))
+    {
+        if (buffer != "") {
+            ninc++;
+        }
+    }
+    
+    std::shared_ptr<mat> mtable = std::make_shared<mat>(ninc, ncols);
+    pathinc.clear();
+    pathinc.str(text);
+    for (int i=0; i<ninc; i++) {
+        pathinc >> buffer;
+        for (int j=0; j<ncols; j++) {
+            pathinc >> (*mtable)(i,j);
+        }
+    }
+    
+    //The steps that use a dropped table keep it alive until they are destroyed
+    if ((it == tables.end())&&(int(tables.size()) >= max_path_tables)) {
+        auto oldest = tables.begin();
+        for (auto jt = tables.begin(); jt != tables.end(); ++jt) {
+            if (jt->second.last_use < oldest->second.last_use)
+                oldest = jt;
+        }
+        tables.erase(oldest);
+    }
+    path_table_entry &entry = tables[key];
+    entry.size = size;
+    entry.hash = hash;
+    entry.last_use = nlookups;
+    entry.table = mtable;
+    return mtable;
+}
+
 //=====Private methods for ellipsoid_characteristics===================================
 
 //=====Public methods for ellipsoid_characteristics============================================
@@ -55,6 +142,8 @@ step::step()
     BC_Time = 0.;
     
     file = "";
+    compiled = false;
+    col_T = -1;
 }
 
 /*!
@@ -86,6 +175,8 @@ step::step(const int &mnumber, const double &mDn_init, const double &mDn_mini, c
     BC_Time = 0.;
     
     file = "";
+    compiled = false;
+    col_T = -1;
 }
 
 /*!
@@ -108,6 +199,13 @@ step::step(const step& st)
     BC_Time = st.BC_Time;
     
     file = st.file;
+    
+    compiled = st.compiled;
+    inc_coef = st.inc_coef;
+    table = st.table;
+    table_inc = st.table_inc;
+    col_T = st.col_T;
+    col_meca = st.col_meca;
 }
 
 /*!
@@ -134,6 +232,38 @@ void step::generate()
     times = zeros(ninc);
 }
 
+/*!
+ \brief Builds the tables of the increments, once : the number of increments and the relative size of the increments (modes 1 and 2), the changes of the values of the incremental path file (mode 3).
+ The columns col_T and col_meca have to be set by the derived steps before
+ \param ncols : number of values of each line of the incremental path file
+ */
+
+//-------------------------------------------------------------
+void step::compile(const int &ncols)
+//-------------------------------------------------------------
+{
+    if(mode == 3) {
+        table = read_path_table(file, ncols);
+        ninc = table->n_rows;
+        table_inc = *table;
+        if (ninc > 1)
+            table_inc.rows(1, ninc-1) -= table->rows(0, ninc-2);
+    }
+    
+    step::generate();
+    
+    inc_coef = ones(ninc);          //If the mode is equal to 2, this is a sinuasoidal load control mode
+    if (mode == 2) {
+        double sum_ = 0.;
+        for(int k = 0 ; k < ninc ; k++){
+            inc_coef(k) =  cos(pi + (k+1)*2.*pi/(ninc+1))+1.;
+            sum_ += inc_coef(k);
+        }
+        inc_coef = inc_coef*ninc/sum_;
+    }
+    compiled = true;
+}
+
 //----------------------------------------------------------------------
 void step::compute_inc(double &tnew_dt, const int &inc, double &tinc, double &Dtinc, double &Dtinc_cur, const int &inforce_solver) {
 //----------------------------------------------------------------------
@@ -192,6 +322,13 @@ step& step::operator = (const step& st)
     BC_Time = st.BC_Time;
     
     file = st.file;
+    
+    compiled = st.compiled;
+    inc_coef = st.inc_coef;
+    table = st.table;
+    table_inc = st.table_inc;
+    col_T = st.col_T;
+    col_meca = st.col_meca;
         
 	return *this;
 }
@@ -96,46 +96,72 @@ step_thermomeca::step_thermomeca(const step_thermomeca& stm) : step(stm)
 
 step_thermomeca::~step_thermomeca() {}
 
+/*!
+ \brief Builds the tables of the increments once, at the first generation of the step. For mode 3, the incremental path file is read here only
+ */
+
 //-------------------------------------------------------------
-void step_thermomeca::generate(const double &mTime, const vec &mEtot, const vec &msigma, const double &mT)
+void step_thermomeca::compile()
 //-------------------------------------------------------------
 {
-    
-    //This in for the case of an incremental path file, to get the number of increments
-    string buffer;
-    ifstream pathinc;
-    if(mode == 3){
-        ninc = 0;
-        pathinc.open(file, ios::in);
-        if(!pathinc)
-        {
-            cout << "Error: cannot open the file << " << file << "\n Please check if the file is correct and is you have added the extension\n";
+    //Look at how many cBc are present to know the size of the file (1 for time + 6 for each meca + 1 for temperature):
+    int size_BC = 8;
+    for(int k = 0 ; k < 6 ; k++) {
+        if (cBC_meca(k) == 2){
+            size_BC--;
         }
-        //read the file to get the number of increments
-        while (!pathinc.eof())
-        {
-            getline (pathinc,buffer);
-            if (buffer != "") {
-                ninc++;
-            }
+    }
+    if (cBC_T > 2 ) {
+        size_BC--;
+    }
+    
+    //Columns of the conditions in the file
+    col_T = -1;
+    col_meca = -1*ones<Col<int> >(6);
+    int kT = 0;
+    if ((cBC_T == 0)||(cBC_T == 1)) {
+        col_T = kT+1;
+        kT++;
+    }
+    for(int k = 0 ; k < 6 ; k++) {
+        if (cBC_meca(k) < 2){
+            col_meca(k) = kT+1;
+            kT++;
         }
-        pathinc.close();
     }
     
-    step::generate();
+    step::compile(size_BC);
     
     Ts = zeros(ninc);
     mecas = zeros(ninc, 6);
     
-    vec inc_coef = ones(ninc);
-    if (mode == 2) {
-        double sum_ = 0.;
-        for(int k = 0 ; k < ninc ; k++){
-            inc_coef(k) =  cos(pi + (k+1)*2.*pi/(ninc+1))+1.;
-            sum_ += inc_coef(k);
+    if (mode == 3) {
+        //The heat flux is a direct quantity, it does not depend on any previous condition
+        if ((cBC_T == 1)&&(ninc > 0)) {
+            table_inc.col(col_T) = table->col(col_T);
+        }
+        //At the end, everything static becomes a stress-controlled with zeros
+        for(int k = 0 ; k < 6 ; k++) {
+            if (cBC_meca(k) == 2)
+                cBC_meca(k) = 1;
+        }
+        //And everything thermally static is an isothermal path
+        if (cBC_T == 2) {
+            cBC_T = 0;
         }
-        inc_coef = inc_coef*ninc/sum_;
     }
+}
+
+/*!
+ \brief Fills the increments of the step from the current state : the tables are built at the first call and only refilled at the next ones (e.g. at each cycle)
+ */
+
+//-------------------------------------------------------------
+void step_thermomeca::generate(const double &mTime, const vec &mEtot, const vec &msigma, const double &mT)
+//-------------------------------------------------------------
+{
+    if (!compiled)
+        compile();
     
     if (mode < 3) {
         for (int i=0; i<ninc; i++) {
@@ -156,92 +182,38 @@ void step_thermomeca::generate(const double &mTime, const vec &mEtot, const vec
             else if(cBC_T == 0) {
                 Ts(i) = inc_coef(i)*(BC_T - mT)/ninc;
             }
+            else {
+                Ts(i) = 0.;
+            }
             
         }
     }
-    else if (mode ==3){ ///Incremental loading
+    else if (mode ==3){ ///Incremental loading, the first increment starts from the current state
         
-        //Look at how many cBc are present to know the size of the file (1 for time + 6 for each meca + 1 for temperature):
-        int size_BC = 8;
-        for(int k = 0 ; k < 6 ; k++) {
-            if (cBC_meca(k) == 2){
-                size_BC--;
-            }
-        }
-        if (cBC_T > 2 ) {
-            size_BC--;
-        }
+        if (ninc == 0)
+            return;
         
-        vec BC_file_n = zeros(size_BC); //vector that temporarly stores the previous values
-        vec BC_file = zeros(size_BC); //vector that temporarly stores the values
+        times = table_inc.col(0);
+        times(0) -= mTime;
         
-        BC_file_n(0) = mTime;
-        int kT = 0;
-        if (cBC_T == 0) {
-            BC_file_n(kT+1) = mT;
-            kT++;
-        }
-        else if (cBC_T == 1) {
-            BC_file_n(kT+1) = 0.;    //Heat flux does not depend on any previous condition
-            kT++;
+        if (col_T >= 0) {
+            Ts = table_inc.col(col_T);
+            if (cBC_T == 0)
+                Ts(0) -= mT;
         }
-        
-        for (int k=0; k<6; k++) {
-            if (cBC_meca(k) == 0) {
-                BC_file_n(kT+1) = mEtot(k);
-                kT++;
-            }
-            if (cBC_meca(k) == 1) {
-                BC_file_n(kT+1) = msigma(k);
-                kT++;
-            }
+        else {
+            Ts.zeros();
         }
-                
-        //Read all the informations and fill the meca accordingly
-        pathinc.open(file, ios::in);
         
-        for (int i=0; i<ninc; i++) {
-            
-            pathinc >> buffer;
-            for (int j=0; j<size_BC; j++) {
-                pathinc >> BC_file(j);
-            }
-            
-            times(i) = (BC_file(0) - BC_file_n(0));
-            kT = 0;
-            if (cBC_T == 0) {
-                Ts(i) = BC_file(kT+1) - BC_file_n(kT+1);
-                kT++;
-            }
-            else if (cBC_T == 1) {
-                Ts(i) = BC_file(kT+1);  //Case of Heat, direct quantity
-                kT++;
-            }
-            else if(cBC_T == 2) {
-                Ts(i) = 0.;
+        for(int k = 0 ; k < 6 ; k++) {
+            if (col_meca(k) >= 0) {
+                mecas.col(k) = table_inc.col(col_meca(k));
+                mecas(0,k) -= (cBC_meca(k) == 0) ? mEtot(k) : msigma(k);
             }
-            
-            for(int k = 0 ; k < 6 ; k++) {
-                if (cBC_meca(k) < 2){
-                    mecas(i,k) = BC_file(kT+1) - BC_file_n(kT+1);
-                    kT++;
-                }
-                else if (cBC_meca(k) == 2){
-                    mecas(i,k) = 0.;
-                }
+            else {
+                mecas.col(k).zeros();
             }
-            BC_file_n = BC_file;
-        }
-        //At the end, everything static becomes a stress-controlled with zeros
-        for(int k = 0 ; k < 6 ; k++) {
-            if (cBC_meca(k) == 2)
-                cBC_meca(k) = 1;
-        }
-        //And everything thermally static is an isothermal path
-        if (cBC_T == 2) {
-            cBC_T = 0;
         }
-                
 	}
 	else {
 		cout << "\nError: The mode of the step number " << number << " does not correspond to an existing loading mode.\n";
@@ -53,11 +53,11 @@ void umat_multi(phase_characteristics &phase, const mat &DR, const double &Time,
 {
 
     int nphases = phase.sptr_matprops->props(0); // Number of phases
-    string path_data = "data";
+    string path_data = phase.sptr_matprops->path_data;  //The phases are read from the data folder of the simulation
     string inputfile; //file # that stores the microstructure properties
     
-    shared_ptr<state_variables_M> umat_phase_M = std::dynamic_pointer_cast<state_variables_M>(phase.sptr_sv_local); //shared_ptr on state variables of the rve
-    shared_ptr<state_variables_M> umat_sub_phases_M; //shared_ptr on state variables
+    state_variables_M *umat_phase_M = phase.sv_local<state_variables_M>(); //pointer on state variables of the rve
+    state_variables_M *umat_sub_phases_M; //pointer on state variables
     
     //1 - We need to figure out the type of geometry and read the phase
     if(start) {
@@ -65,13 +65,7 @@ void umat_multi(phase_characteristics &phase, const mat &DR, const double &Time,
                 
             case 100: case 101: case 102: case 103: {
                 //Definition of the static vectors x,wx,y,wy
-                ellipsoid_multi::mp = phase.sptr_matprops->props(2);
-                ellipsoid_multi::np = phase.sptr_matprops->props(3);
-                ellipsoid_multi::x.set_size(ellipsoid_multi::mp);
-                ellipsoid_multi::wx.set_size(ellipsoid_multi::mp);
-                ellipsoid_multi::y.set_size(ellipsoid_multi::np);
-                ellipsoid_multi::wy.set_size(ellipsoid_multi::np);
-                points(ellipsoid_multi::x, ellipsoid_multi::wx, ellipsoid_multi::y, ellipsoid_multi::wy,ellipsoid_multi::mp, ellipsoid_multi::np);
+                ellipsoid_multi::set_points(phase.sptr_matprops->props(2), phase.sptr_matprops->props(3), phase.sptr_matprops->tol.micro_points);
                 
                 inputfile = "Nellipsoids" + to_string(int(phase.sptr_matprops->props(1))) + ".dat";
                 read_ellipsoid(phase, path_data, inputfile);
@@ -101,7 +95,7 @@ void umat_multi(phase_characteristics &phase, const mat &DR, const double &Time,
     std::vector<vec> DEtot_N(nphases); //Table that stores all the previous increments of strain
     
 	//Convergence loop, localization
-	while ((error > precision_micro)&&(nbiter <= maxiter_micro)) {
+	while ((error > phase.sptr_matprops->tol.micro_precision)&&(nbiter <= phase.sptr_matprops->tol.micro_maxiter)) {
 	  
         for(int i=0; i<nphases; i++) {
             DEtot_N[i] = phase.sub_phases[i].sptr_sv_global->DEtot;
@@ -137,7 +131,7 @@ void umat_multi(phase_characteristics &phase, const mat &DR, const double &Time,
         
         }
     
-        for (auto r : phase.sub_phases) {
+        for (auto &r : phase.sub_phases) {
             r.sptr_sv_global->to_start();
             
             //Theta method for the tangent modulus
@@ -145,7 +139,7 @@ void umat_multi(phase_characteristics &phase, const mat &DR, const double &Time,
             select_umat_M(r, DR, Time, DTime, ndi, nshr, start, 0, tnew_dt);
 
             //Theta method for the tangent modulus
-            //umat_sub_phases_M = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
+            //umat_sub_phases_M = r.sv_global<state_variables_M>();
             //Lt* = (1 - (2./3.))*Lt_start + 2./3.*Lt;
         }
         
@@ -190,14 +184,14 @@ void umat_multi(phase_characteristics &phase, const mat &DR, const double &Time,
     //	Homogenization
 	//Compute the effective stress
 	umat_phase_M->sigma = zeros(6);
-    for (auto r : phase.sub_phases) {
+    for (auto &r : phase.sub_phases) {
 		umat_phase_M->sigma += r.sptr_shape->concentration*r.sptr_sv_global->sigma;
 	}
     
     umat_phase_M->Lt = zeros(6,6);
 	// Compute the effective tangent modulus, and the effective stress
-    for (auto r : phase.sub_phases) {
-        umat_sub_phases_M = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
+    for (auto &r : phase.sub_phases) {
+        umat_sub_phases_M = r.sv_global<state_variables_M>();
 		umat_phase_M->Lt += r.sptr_shape->concentration*(umat_sub_phases_M->Lt*r.sptr_multi->A);
 	}
     
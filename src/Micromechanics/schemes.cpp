@@ -48,18 +48,19 @@ namespace smart{
 void Lt_Homogeneous_E(phase_characteristics &phase) {
     
     //Compute the strain concentration tensor A
-    for(auto r : phase.sub_phases) {
+    for(auto &r : phase.sub_phases) {
         r.sptr_multi->A = eye(6,6);
     }
 }
 
 void DE_Homogeneous_E(phase_characteristics &phase) {
     
-    std::shared_ptr<state_variables_M> sv_r;
-    std::shared_ptr<state_variables_M> sv_eff = std::dynamic_pointer_cast<state_variables_M>(phase.sptr_sv_local);
+    state_variables_M *sv_r;
+    state_variables_M *sv_eff = phase.sv_local<state_variables_M>();
     
     //Compute the strain concentration tensor A
-    for(auto r : phase.sub_phases) {
+    for(auto &r : phase.sub_phases) {
+        sv_r = r.sv_global<state_variables_M>();
         r.sptr_multi->A = eye(6,6);
         sv_r->DEtot = r.sptr_multi->A*sv_eff->DEtot; //Recall that the global coordinates of subphases is the local coordinates of the generic phase
     }
@@ -70,18 +71,18 @@ void Lt_Mori_Tanaka(phase_characteristics &phase, const int &n_matrix) {
     mat sumT = zeros(6,6);
     mat inv_sumT = zeros(6,6);
 
-    std::shared_ptr<ellipsoid_multi> elli_multi;
-    std::shared_ptr<ellipsoid> elli;
+    ellipsoid_multi *elli_multi;
+    ellipsoid *elli;
     //ptr on the matrix properties
-    std::shared_ptr<state_variables_M> sv_0 = std::dynamic_pointer_cast<state_variables_M>(phase.sub_phases[n_matrix].sptr_sv_global);
-    std::shared_ptr<state_variables_M> sv_eff = std::dynamic_pointer_cast<state_variables_M>(phase.sptr_sv_local);
-    std::shared_ptr<state_variables_M> sv_r;
+    state_variables_M *sv_0 = phase.sub_phases[n_matrix].sv_global<state_variables_M>();
+    state_variables_M *sv_eff = phase.sv_local<state_variables_M>();
+    state_variables_M *sv_r;
     
     //Compute the Eshelby tensor and the interaction tensor for each phase
-    for(auto r : phase.sub_phases) {
-        elli_multi = std::dynamic_pointer_cast<ellipsoid_multi>(r.sptr_multi);
-        elli = std::dynamic_pointer_cast<ellipsoid>(r.sptr_shape);
-        sv_r = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
+    for(auto &r : phase.sub_phases) {
+        elli_multi = r.multi<ellipsoid_multi>();
+        elli = r.shape<ellipsoid>();
+        sv_r = r.sv_global<state_variables_M>();
         
         //Note The tangent modulus are turned in the coordinate system of the ellipspoid in the fillT function
         //Note The tangent modulus are turned in the coordinate system of the ellipspoid in the fillT function
@@ -97,8 +98,8 @@ void Lt_Mori_Tanaka(phase_characteristics &phase, const int &n_matrix) {
     inv_sumT = inv(sumT);
     
     //Compute the strain concentration tensor A
-    for(auto r : phase.sub_phases) {
-        elli_multi = std::dynamic_pointer_cast<ellipsoid_multi>(r.sptr_multi);
+    for(auto &r : phase.sub_phases) {
+        elli_multi = r.multi<ellipsoid_multi>();
         elli_multi->A = elli_multi->T*inv_sumT;
     }
 }
@@ -108,18 +109,18 @@ void Lt_Mori_Tanaka_iso(phase_characteristics &phase, const int &n_matrix) {
     mat sumT = zeros(6,6);
     mat inv_sumT = zeros(6,6);
     
-    std::shared_ptr<ellipsoid_multi> elli_multi;
-    std::shared_ptr<ellipsoid> elli;
+    ellipsoid_multi *elli_multi;
+    ellipsoid *elli;
     //ptr on the matrix properties
-    std::shared_ptr<state_variables_M> sv_0 = std::dynamic_pointer_cast<state_variables_M>(phase.sub_phases[n_matrix].sptr_sv_global);
-    std::shared_ptr<state_variables_M> sv_eff = std::dynamic_pointer_cast<state_variables_M>(phase.sptr_sv_local);
-    std::shared_ptr<state_variables_M> sv_r;
+    state_variables_M *sv_0 = phase.sub_phases[n_matrix].sv_global<state_variables_M>();
+    state_variables_M *sv_eff = phase.sv_local<state_variables_M>();
+    state_variables_M *sv_r;
     
     //Compute the Eshelby tensor and the interaction tensor for each phase
-    for(auto r : phase.sub_phases) {
-        elli_multi = std::dynamic_pointer_cast<ellipsoid_multi>(r.sptr_multi);
-        elli = std::dynamic_pointer_cast<ellipsoid>(r.sptr_shape);
-        sv_r = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
+    for(auto &r : phase.sub_phases) {
+        elli_multi = r.multi<ellipsoid_multi>();
+        elli = r.shape<ellipsoid>();
+        sv_r = r.sv_global<state_variables_M>();
         
         //Note The tangent modulus are turned in the coordinate system of the ellipspoid in the fillT function
         //Note The tangent modulus are turned in the coordinate system of the ellipspoid in the fillT function
@@ -135,8 +136,8 @@ void Lt_Mori_Tanaka_iso(phase_characteristics &phase, const int &n_matrix) {
     inv_sumT = inv(sumT);
     
     //Compute the strain concentration tensor A
-    for(auto r : phase.sub_phases) {
-        elli_multi = std::dynamic_pointer_cast<ellipsoid_multi>(r.sptr_multi);
+    for(auto &r : phase.sub_phases) {
+        elli_multi = r.multi<ellipsoid_multi>();
         elli_multi->A = elli_multi->T*inv_sumT;
     }
 }
@@ -146,18 +147,18 @@ void DE_Mori_Tanaka(phase_characteristics &phase, const int &n_matrix) {
     mat sumT = zeros(6,6);
     mat inv_sumT = zeros(6,6);
     
-    std::shared_ptr<ellipsoid_multi> elli_multi;
-    std::shared_ptr<ellipsoid> elli;
+    ellipsoid_multi *elli_multi;
+    ellipsoid *elli;
     //ptr on the matrix properties
-    std::shared_ptr<state_variables_M> sv_0 = std::dynamic_pointer_cast<state_variables_M>(phase.sub_phases[n_matrix].sptr_sv_global);
-    std::shared_ptr<state_variables_M> sv_eff = std::dynamic_pointer_cast<state_variables_M>(phase.sptr_sv_local);
-    std::shared_ptr<state_variables_M> sv_r;
+    state_variables_M *sv_0 = phase.sub_phases[n_matrix].sv_global<state_variables_M>();
+    state_variables_M *sv_eff = phase.sv_local<state_variables_M>();
+    state_variables_M *sv_r;
     
     //Compute the Eshelby tensor and the interaction tensor for each phase
-    for(auto r : phase.sub_phases) {
-        elli_multi = std::dynamic_pointer_cast<ellipsoid_multi>(r.sptr_multi);
-        elli = std::dynamic_pointer_cast<ellipsoid>(r.sptr_shape);
-        sv_r = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
+    for(auto &r : phase.sub_phases) {
+        elli_multi = r.multi<ellipsoid_multi>();
+        elli = r.shape<ellipsoid>();
+        sv_r = r.sv_global<state_variables_M>();
         
         //Note The tangent modulus are turned in the coordinate system of the ellipspoid in the fillT function
         if (r.sptr_matprops->number == n_matrix)
@@ -172,9 +173,9 @@ void DE_Mori_Tanaka(phase_characteristics &phase, const int &n_matrix) {
     inv_sumT = inv(sumT);
     
     //Compute the strain concentration tensor A
-    for(auto r : phase.sub_phases) {
-        elli_multi = std::dynamic_pointer_cast<ellipsoid_multi>(r.sptr_multi);
-        sv_r = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
+    for(auto &r : phase.sub_phases) {
+        elli_multi = r.multi<ellipsoid_multi>();
+        sv_r = r.sv_global<state_variables_M>();
         
         elli_multi->A = elli_multi->T*inv_sumT;
         sv_r->DEtot = elli_multi->A*sv_eff->DEtot; //Recall that the global coordinates of subphases is the local coordinates of the generic phase
@@ -186,18 +187,18 @@ void DE_Mori_Tanaka_iso(phase_characteristics &phase, const int &n_matrix) {
     mat sumT = zeros(6,6);
     mat inv_sumT = zeros(6,6);
     
-    std::shared_ptr<ellipsoid_multi> elli_multi;
-    std::shared_ptr<ellipsoid> elli;
+    ellipsoid_multi *elli_multi;
+    ellipsoid *elli;
     //ptr on the matrix properties
-    std::shared_ptr<state_variables_M> sv_0 = std::dynamic_pointer_cast<state_variables_M>(phase.sub_phases[n_matrix].sptr_sv_global);
-    std::shared_ptr<state_variables_M> sv_eff = std::dynamic_pointer_cast<state_variables_M>(phase.sptr_sv_local);
-    std::shared_ptr<state_variables_M> sv_r;
+    state_variables_M *sv_0 = phase.sub_phases[n_matrix].sv_global<state_variables_M>();
+    state_variables_M *sv_eff = phase.sv_local<state_variables_M>();
+    state_variables_M *sv_r;
     
     //Compute the Eshelby tensor and the interaction tensor for each phase
-    for(auto r : phase.sub_phases) {
-        elli_multi = std::dynamic_pointer_cast<ellipsoid_multi>(r.sptr_multi);
-        elli = std::dynamic_pointer_cast<ellipsoid>(r.sptr_shape);
-        sv_r = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
+    for(auto &r : phase.sub_phases) {
+        elli_multi = r.multi<ellipsoid_multi>();
+        elli = r.shape<ellipsoid>();
+        sv_r = r.sv_global<state_variables_M>();
         
         //Note The tangent modulus are turned in the coordinate system of the ellipspoid in the fillT function
         if (r.sptr_matprops->number == n_matrix)
@@ -212,9 +213,9 @@ void DE_Mori_Tanaka_iso(phase_characteristics &phase, const int &n_matrix) {
     inv_sumT = inv(sumT);
     
     //Compute the strain concentration tensor A
-    for(auto r : phase.sub_phases) {
-        elli_multi = std::dynamic_pointer_cast<ellipsoid_multi>(r.sptr_multi);
-        sv_r = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
+    for(auto &r : phase.sub_phases) {
+        elli_multi = r.multi<ellipsoid_multi>();
+        sv_r = r.sv_global<state_variables_M>();
         
         elli_multi->A = elli_multi->T*inv_sumT;
         sv_r->DEtot = elli_multi->A*sv_eff->DEtot; //Recall that the global coordinates of subphases is the local coordinates of the generic phase
@@ -223,11 +224,11 @@ void DE_Mori_Tanaka_iso(phase_characteristics &phase, const int &n_matrix) {
     
 void Lt_Self_Consistent(phase_characteristics &phase, const int &n_matrix, const bool &start, const int &option_start) {
     
-    std::shared_ptr<ellipsoid_multi> elli_multi;
-    std::shared_ptr<ellipsoid> elli;
+    ellipsoid_multi *elli_multi;
+    ellipsoid *elli;
     //ptr on the matrix properties
-    std::shared_ptr<state_variables_M> sv_r;
-    std::shared_ptr<state_variables_M> sv_eff = std::dynamic_pointer_cast<state_variables_M>(phase.sptr_sv_local);
+    state_variables_M *sv_r;
+    state_variables_M *sv_eff = phase.sv_local<state_variables_M>();
     
     //In the self_consistent scheme we need to have the effective tangent modulus first, based on some guessed initial concentration tensor.
     if(start) {
@@ -243,9 +244,9 @@ void Lt_Self_Consistent(phase_characteristics &phase, const int &n_matrix, const
         //Compute the effective tensor from the previous strain localization tensors
         mat Lt_eff = zeros(6,6);
         for(unsigned int i=0; i<phase.sub_phases.size(); i++) {
-            elli_multi = std::dynamic_pointer_cast<ellipsoid_multi>(phase.sub_phases[i].sptr_multi);
-            elli = std::dynamic_pointer_cast<ellipsoid>(phase.sub_phases[i].sptr_shape);
-            sv_r = std::dynamic_pointer_cast<state_variables_M>(phase.sub_phases[i].sptr_sv_global);
+            elli_multi = phase.sub_phases[i].multi<ellipsoid_multi>();
+            elli = phase.sub_phases[i].shape<ellipsoid>();
+            sv_r = phase.sub_phases[i].sv_global<state_variables_M>();
             Lt_eff += elli->concentration*elli_multi->A*sv_r->Lt;
         }
         sv_eff->Lt = Lt_eff;
@@ -254,9 +255,9 @@ void Lt_Self_Consistent(phase_characteristics &phase, const int &n_matrix, const
     mat sumA = zeros(6,6);
     //Compute the Eshelby tensor and the interaction tensor for each phase
     for(unsigned int i=0; i<phase.sub_phases.size(); i++) {
-        elli_multi = std::dynamic_pointer_cast<ellipsoid_multi>(phase.sub_phases[i].sptr_multi);
-        elli = std::dynamic_pointer_cast<ellipsoid>(phase.sub_phases[i].sptr_shape);
-        sv_r = std::dynamic_pointer_cast<state_variables_M>(phase.sub_phases[i].sptr_sv_global);
+        elli_multi = phase.sub_phases[i].multi<ellipsoid_multi>();
+        elli = phase.sub_phases[i].shape<ellipsoid>();
+        sv_r = phase.sub_phases[i].sv_global<state_variables_M>();
         
         //Note The tangent modulus are turned in the coordinate system of the ellipspoid in the fillT function
         if (phase.sub_phases[i].sptr_matprops->number == n_matrix)
@@ -270,9 +271,9 @@ void Lt_Self_Consistent(phase_characteristics &phase, const int &n_matrix, const
     
     for(unsigned int i=0; i<phase.sub_phases.size(); i++) {
         //Note The tangent modulus are turned in the coordinate system of the ellipspoid in the fillT function
-        elli_multi = std::dynamic_pointer_cast<ellipsoid_multi>(phase.sub_phases[i].sptr_multi);
-        elli = std::dynamic_pointer_cast<ellipsoid>(phase.sub_phases[i].sptr_shape);
-        sv_r = std::dynamic_pointer_cast<state_variables_M>(phase.sub_phases[i].sptr_sv_global);
+        elli_multi = phase.sub_phases[i].multi<ellipsoid_multi>();
+        elli = phase.sub_phases[i].shape<ellipsoid>();
+        sv_r = phase.sub_phases[i].sv_global<state_variables_M>();
         if (phase.sub_phases[i].sptr_matprops->number == n_matrix)
             elli_multi->A = (eye(6,6) - sumA)*(1./elli->concentration);
         else {
@@ -283,11 +284,11 @@ void Lt_Self_Consistent(phase_characteristics &phase, const int &n_matrix, const
     
 void DE_Self_Consistent(phase_characteristics &phase, const int &n_matrix, const bool &start, const int &option_start) {
     
-    std::shared_ptr<ellipsoid_multi> elli_multi;
-    std::shared_ptr<ellipsoid> elli;
+    ellipsoid_multi *elli_multi;
+    ellipsoid *elli;
     //ptr on the matrix properties
-    std::shared_ptr<state_variables_M> sv_r;
-    std::shared_ptr<state_variables_M> sv_eff = std::dynamic_pointer_cast<state_variables_M>(phase.sptr_sv_local);
+    state_variables_M *sv_r;
+    state_variables_M *sv_eff = phase.sv_local<state_variables_M>();
 
     //In the self_consistent scheme we need to have the effective tangent modulus first, based on some guessed initial concentration tensor.
     if(start) {
@@ -302,8 +303,8 @@ void DE_Self_Consistent(phase_characteristics &phase, const int &n_matrix, const
         
         //Compute the effective tensor from the previous strain localization tensors
         mat Lt_eff = zeros(6,6);
-        for(auto r : phase.sub_phases) {
-            sv_r = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
+        for(auto &r : phase.sub_phases) {
+            sv_r = r.sv_global<state_variables_M>();
             Lt_eff += r.sptr_shape->concentration*r.sptr_multi->A*sv_r->Lt;
         }
         sv_eff->Lt = Lt_eff;
@@ -312,9 +313,9 @@ void DE_Self_Consistent(phase_characteristics &phase, const int &n_matrix, const
     mat sumA = zeros(6,6);
     //Compute the Eshelby tensor and the interaction tensor for each phase
     for(unsigned int i=0; i<phase.sub_phases.size(); i++) {
-        elli_multi = std::dynamic_pointer_cast<ellipsoid_multi>(phase.sub_phases[i].sptr_multi);
-        elli = std::dynamic_pointer_cast<ellipsoid>(phase.sub_phases[i].sptr_shape);
-        sv_r = std::dynamic_pointer_cast<state_variables_M>(phase.sub_phases[i].sptr_sv_global);
+        elli_multi = phase.sub_phases[i].multi<ellipsoid_multi>();
+        elli = phase.sub_phases[i].shape<ellipsoid>();
+        sv_r = phase.sub_phases[i].sv_global<state_variables_M>();
         
         //Note The tangent modulus are turned in the coordinate system of the ellipspoid in the fillT function
         if (phase.sub_phases[i].sptr_matprops->number == n_matrix)
@@ -328,9 +329,9 @@ void DE_Self_Consistent(phase_characteristics &phase, const int &n_matrix, const
     
     for(unsigned int i=0; i<phase.sub_phases.size(); i++) {
         //Note The tangent modulus are turned in the coordinate system of the ellipspoid in the fillT function
-        elli_multi = std::dynamic_pointer_cast<ellipsoid_multi>(phase.sub_phases[i].sptr_multi);
-        elli = std::dynamic_pointer_cast<ellipsoid>(phase.sub_phases[i].sptr_shape);
-        sv_r = std::dynamic_pointer_cast<state_variables_M>(phase.sub_phases[i].sptr_sv_global);
+        elli_multi = phase.sub_phases[i].multi<ellipsoid_multi>();
+        elli = phase.sub_phases[i].shape<ellipsoid>();
+        sv_r = phase.sub_phases[i].sv_global<state_variables_M>();
         if (phase.sub_phases[i].sptr_matprops->number == n_matrix)
             elli_multi->A = (eye(6,6) - sumA)*(1./elli->concentration);
         else {
@@ -343,16 +344,16 @@ void DE_Self_Consistent(phase_characteristics &phase, const int &n_matrix, const
     
 void dE_Periodic_Layer(phase_characteristics &phase, const int &nbiter) {
     
-    std::shared_ptr<layer_multi> lay_multi;
-    std::shared_ptr<layer> lay;
+    layer_multi *lay_multi;
+    layer *lay;
     //ptr on the matrix properties
-    std::shared_ptr<state_variables_M> sv_r;
-    std::shared_ptr<state_variables_M> sv_eff = std::dynamic_pointer_cast<state_variables_M>(phase.sptr_sv_local);
+    state_variables_M *sv_r;
+    state_variables_M *sv_eff = phase.sv_local<state_variables_M>();
     
     mat Lt_loc = zeros(6,6);
     
     if (nbiter == 0) {
-        for (auto r : phase.sub_phases) {
+        for (auto &r : phase.sub_phases) {
             r.sptr_sv_global->DEtot = sv_eff->DEtot;
         }
     }
@@ -360,12 +361,12 @@ void dE_Periodic_Layer(phase_characteristics &phase, const int &nbiter) {
     //Compute the increment of strain
     mat sumDnn = zeros(3,3);
 	vec sumcDsig = zeros(3);
-    for(auto r : phase.sub_phases) {
+    for(auto &r : phase.sub_phases) {
         
-        sv_r = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
-        lay_multi = std::dynamic_pointer_cast<layer_multi>(r.sptr_multi);
-        lay = std::dynamic_pointer_cast<layer>(r.sptr_shape);
-        Lt_loc = rotate_g2l_L(sv_r->Lt, lay->psi_geom, lay->theta_geom, lay->phi_geom);
+        sv_r = r.sv_global<state_variables_M>();
+        lay_multi = r.multi<layer_multi>();
+        lay = r.shape<layer>();
+        Lt_loc = rotate_g2l_L(sv_r->Lt, lay->rotation());
         
         lay_multi->Dnn(0,0) = Lt_loc(0,0);
         lay_multi->Dnn(0,1) = Lt_loc(0,3);
@@ -377,32 +378,32 @@ void dE_Periodic_Layer(phase_characteristics &phase, const int &nbiter) {
         lay_multi->Dnn(2,1) = Lt_loc(4,3);
         lay_multi->Dnn(2,2) = Lt_loc(4,4);
         
-        mat sigma_local = rotate_g2l_stress(sv_r->sigma, lay->psi_geom, lay->theta_geom, lay->phi_geom);
+        mat sigma_local = rotate_g2l_stress(sv_r->sigma, lay->rotation());
         lay_multi->sigma_hat(0) = sigma_local(0);
         lay_multi->sigma_hat(1) = sigma_local(3);
         lay_multi->sigma_hat(2) = sigma_local(4);
     }
     
-    for(auto r : phase.sub_phases) {
-        lay_multi = std::dynamic_pointer_cast<layer_multi>(r.sptr_multi);
-        lay = std::dynamic_pointer_cast<layer>(r.sptr_shape);
+    for(auto &r : phase.sub_phases) {
+        lay_multi = r.multi<layer_multi>();
+        lay = r.shape<layer>();
         sumDnn += lay->concentration*inv(lay_multi->Dnn);
         sumcDsig += lay->concentration*inv(lay_multi->Dnn)*lay_multi->sigma_hat;
     }
     vec m = inv(sumDnn)*sumcDsig;
     
-    for(auto r : phase.sub_phases) {
+    for(auto &r : phase.sub_phases) {
         
-        sv_r = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
-        lay_multi = std::dynamic_pointer_cast<layer_multi>(r.sptr_multi);
+        sv_r = r.sv_global<state_variables_M>();
+        lay_multi = r.multi<layer_multi>();
         lay_multi->dzdx1 = inv(lay_multi->Dnn)*(m-lay_multi->sigma_hat);
-        lay = std::dynamic_pointer_cast<layer>(r.sptr_shape);
+        lay = r.shape<layer>();
         
         mat dEtot_local = zeros(6);
         dEtot_local(0) = lay_multi->dzdx1(0);
         dEtot_local(3) = lay_multi->dzdx1(1);
         dEtot_local(4) = lay_multi->dzdx1(2);
-        mat dEtot_global = rotate_l2g_strain(dEtot_local, lay->psi_geom, lay->theta_geom, lay->phi_geom);
+        mat dEtot_global = rotate_l2g_strain(dEtot_local, lay->rotation());
         
         sv_r->DEtot += dEtot_global;
     }
@@ -410,21 +411,21 @@ void dE_Periodic_Layer(phase_characteristics &phase, const int &nbiter) {
     
 void Lt_Periodic_Layer(phase_characteristics &phase) {
     
-    std::shared_ptr<layer_multi> lay_multi;
-    std::shared_ptr<layer> lay;
+    layer_multi *lay_multi;
+    layer *lay;
     //ptr on the matrix properties
-    std::shared_ptr<state_variables_M> sv_r;
+    state_variables_M *sv_r;
     
     mat Lt_loc = zeros(6,6);
     mat A_loc = zeros(6,6);
     
     //Compute the strain concentration tensor A
-    for(auto r : phase.sub_phases) {
+    for(auto &r : phase.sub_phases) {
         
-        sv_r = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
-        lay_multi = std::dynamic_pointer_cast<layer_multi>(r.sptr_multi);
-        lay = std::dynamic_pointer_cast<layer>(r.sptr_shape);
-        Lt_loc = rotate_g2l_L(sv_r->Lt, lay->psi_geom, lay->theta_geom, lay->phi_geom);
+        sv_r = r.sv_global<state_variables_M>();
+        lay_multi = r.multi<layer_multi>();
+        lay = r.shape<layer>();
+        Lt_loc = rotate_g2l_L(sv_r->Lt, lay->rotation());
         
         lay_multi->Dnn(0,0) = Lt_loc(0,0);
         lay_multi->Dnn(0,1) = Lt_loc(0,3);
@@ -449,18 +450,18 @@ void Lt_Periodic_Layer(phase_characteristics &phase) {
     
     mat sumDnn = zeros(3,3);
     mat sumDnt = zeros(3,3);
-    for(auto r : phase.sub_phases) {
-        lay_multi = std::dynamic_pointer_cast<layer_multi>(r.sptr_multi);
-        lay = std::dynamic_pointer_cast<layer>(r.sptr_shape);
+    for(auto &r : phase.sub_phases) {
+        lay_multi = r.multi<layer_multi>();
+        lay = r.shape<layer>();
         sumDnn += lay->concentration*inv(lay_multi->Dnn);
         sumDnt += lay->concentration*inv(lay_multi->Dnn)*lay_multi->Dnt;
     }
     mat m_n = inv(sumDnn);
     mat m_t = m_n*sumDnt;
 
-    for(auto r : phase.sub_phases) {
-        lay_multi = std::dynamic_pointer_cast<layer_multi>(r.sptr_multi);
-        lay = std::dynamic_pointer_cast<layer>(r.sptr_shape);        
+    for(auto &r : phase.sub_phases) {
+        lay_multi = r.multi<layer_multi>();
+        lay = r.shape<layer>();        
         lay_multi->dXn = inv(lay_multi->Dnn)*(m_n-lay_multi->Dnn);
         lay_multi->dXt = inv(lay_multi->Dnn)*(m_t-lay_multi->Dnt);
         
@@ -487,7 +488,7 @@ void Lt_Periodic_Layer(phase_characteristics &phase) {
         A_loc(4,4) += lay_multi->dXn(2,2);
         A_loc(4,5) += lay_multi->dXt(2,2);
 
-        lay_multi->A = rotate_l2g_A(A_loc, lay->psi_geom, lay->theta_geom, lay->phi_geom);
+        lay_multi->A = rotate_l2g_A(A_loc, lay->rotation());
     }
     
 }
@@ -20,6 +20,7 @@
 #include <armadillo>
 
 #include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Phase/tolerances.hpp>
 #include <smartplus/Libraries/Maths/lagrange.hpp>
 #include <smartplus/Libraries/Maths/rotation.hpp>
 #include <smartplus/Libraries/Continuum_Mechanics/contimech.hpp>
@@ -44,6 +45,8 @@ namespace smart {
 ///@param props(6) : deltaD Damage evolution parameter delta
 
 void umat_damage_LLD_0(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt, mat &L, vec &sigma_in, const mat &DR, const int &nprops, const vec &props, const int &nstatev, vec &statev, const double &T, const double &DT, const double &Time, const double &DTime, double &Wm, double &Wm_r, double &Wm_ir, double &Wm_d, const int &ndi, const int &nshr, const bool &start, const int &solver_type, double &tnew_dt) {
+    //Tolerances of the material being computed
+    const tolerances &tol = tolerances::current();
     
     UNUSED(nprops);
     UNUSED(nstatev);
@@ -108,7 +111,7 @@ void umat_damage_LLD_0(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt, m
         d_22 = 0.;
         d_12 = 0.;
         
-        p_ts = 10.*limit;
+        p_ts = 10.*tol.zero_limit;
         EP = zeros(6);
         sigma = zeros(6);
     }
@@ -218,14 +221,14 @@ void umat_damage_LLD_0(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt, m
     }
     
     //First we find the plasticity
-    for (compteur = 0; ((compteur < maxiter_umat) && (error > precision_umat)); compteur++) {
+    for (compteur = 0; ((compteur < tol.umat_maxiter) && (error > tol.umat_precision)); compteur++) {
         
         //Plasticity computations
                 //Compute the hardening
-        if (p_ts > limit)
+        if (p_ts > tol.zero_limit)
             Hp_ts = beta_ts*pow(p_ts, alpha_ts);
         else
-            Hp_ts = iota;
+            Hp_ts = tol.zero_iota;
         
         //effective stress
         sigma_eff = el_pred(L,Eel,ndi);
@@ -237,10 +240,10 @@ void umat_damage_LLD_0(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt, m
         //Compute the explicit flow direction
         Lambdap_ts = eta_stress(sigma_eff_ts);
         
-        if (p_ts > limit)
+        if (p_ts > tol.zero_limit)
             dPhip_tsdp_ts = -1.*alpha_ts*beta_ts*pow(p_ts, alpha_ts-1.);
         else
-            dPhip_tsdp_ts = iota;
+            dPhip_tsdp_ts = tol.zero_iota;
         
         dPhi_p_tsd_sigma = Theta_ts*eta_stress(sigma_eff_ts); //Here as well
         
@@ -259,7 +262,7 @@ void umat_damage_LLD_0(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt, m
         Eel = Etot + DEtot - alpha*(T+DT-Tinit) - EP;
     }
     
-    if(compteur == maxiter_umat)
+    if(compteur == tol.umat_maxiter)
         tnew_dt = 0.2;
     
     error = 1.;
@@ -299,7 +302,7 @@ void umat_damage_LLD_0(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt, m
     
     
     //So it is forced to enter the damage loop once
-    for (compteur = 0; ((compteur < maxiter_umat) && (error > precision_umat)); compteur++) {
+    for (compteur = 0; ((compteur < tol.umat_maxiter) && (error > tol.umat_precision)); compteur++) {
         
         mat L_tilde = L_ortho(E1,E2,E3,nu12,nu13,nu23,G12,G13,G23, "EnuG");
         
@@ -336,22 +339,22 @@ void umat_damage_LLD_0(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt, m
             sigma = L_tilde*Eel;
             
         
-        if (fabs(sigma(1)) < iota )
+        if (fabs(sigma(1)) < tol.zero_iota )
             Yd_22 = 0.;
         else
             Yd_22 = 0.5*(pow(Macaulay_p(sigma(1)),2.)/(E2_0*pow(1.-d_22,2.)));
 
-        if (fabs(sigma(2)) < iota )
+        if (fabs(sigma(2)) < tol.zero_iota )
             Yd_33 = 0.;
         else
             Yd_33 = 0.5*(pow(Macaulay_p(sigma(2)),2.)/(E2_0*pow(1.-d_22,2.)));
         
-        if (fabs(sigma(3)) < iota )
+        if (fabs(sigma(3)) < tol.zero_iota )
             Yd_12 = 0.;
         else
             Yd_12 = 0.5*(pow(sigma(3),2.)/(G12_0*pow(1.-d_12,2.)));
 
-        if (fabs(sigma(4)) < iota )
+        if (fabs(sigma(4)) < tol.zero_iota )
             Yd_13 = 0.;
         else
             Yd_13 = 0.5*(pow(sigma(4),2.)/(G12_0*pow(1.-d_12,2.)));
@@ -366,29 +369,29 @@ void umat_damage_LLD_0(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt, m
         lambda_22 = lagrange_pow_1(d_22, c_lambda, p0_lambda, n_lambda, alpha_lambda);
         
         //Preliminaries to compute damage the derivatives of Phi
-        if (fabs(sigma(1)) < iota )
+        if (fabs(sigma(1)) < tol.zero_iota )
             dYd_22dd = 0.;
         else
             dYd_22dd = -0.25*(pow(Macaulay_p(sigma(1)),2.)/(E2_0*pow(1-d_22,3.)));
 
-        if (fabs(sigma(2)) < iota )
+        if (fabs(sigma(2)) < tol.zero_iota )
             dYd_33dd = 0.;
         else
             dYd_33dd = -0.25*(pow(Macaulay_p(sigma(2)),2.)/(E2_0*pow(1-d_22,3.)));
         
-        if (fabs(sigma(3)) < iota )
+        if (fabs(sigma(3)) < tol.zero_iota )
             dYd_12dd = 0.;
         else
             dYd_12dd = -0.25*(pow(sigma(3),2.)/(G12_0*pow(1-d_12,3.)));
 
-        if (fabs(sigma(4)) < iota )
+        if (fabs(sigma(4)) < tol.zero_iota )
             dYd_13dd = 0.;
         else
             dYd_13dd = -0.25*(pow(sigma(4),2.)/(G12_0*pow(1-d_12,3.)));
 
         
         
-        if (fabs(Yd_12 + Yd_13 + b*(Yd_22 + Yd_33)) < iota ) {
+        if (fabs(Yd_12 + Yd_13 + b*(Yd_22 + Yd_33)) < tol.zero_iota ) {
             dY_tsdd_22 = 0.;
             dY_tsdd_12 = 0.;
         }
@@ -409,7 +412,7 @@ void umat_damage_LLD_0(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt, m
         dYts_d_Y12 = 0.;
         dYts_d_Y13 = 0.;
         
-        if (Y_ts > limit) {
+        if (Y_ts > tol.zero_limit) {
             dYts_d_Y22 = b/(2.*Y_ts);
             dYts_d_Y33 = b/(2.*Y_ts);
             dYts_d_Y12 = 1./(2.*Y_ts);
@@ -483,7 +486,7 @@ void umat_damage_LLD_0(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt, m
         G13 = G12_0*(1.-d_12);
     }
     
-    if(compteur == maxiter_umat)
+    if(compteur == tol.umat_maxiter)
         tnew_dt = 0.2;
     
     //Update constitutive parameters
@@ -534,7 +537,7 @@ void umat_damage_LLD_0(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt, m
 		dYts_d_Y12 = 0.;
 		dYts_d_Y13 = 0.;
 		
-		if (Y_ts > limit) {
+		if (Y_ts > tol.zero_limit) {
 			dYts_d_Y22 = b/(2.*Y_ts);
 			dYts_d_Y33 = b/(2.*Y_ts);
 			dYts_d_Y12 = 1./(2.*Y_ts);
@@ -631,11 +634,11 @@ void umat_damage_LLD_0(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt, m
 		vec op = zeros(3);
 		mat delta = eye(3,3);
 
-		if(Dd(0) > iota)
+		if(Dd(0) > tol.zero_iota)
 			op(0) = 1.;
-		if(Dd(1) > iota)
+		if(Dd(1) > tol.zero_iota)
 			op(1) = 1.;
-		if(Dp(0) > iota)
+		if(Dp(0) > tol.zero_iota)
 			op(2) = 1.;
 		
 		
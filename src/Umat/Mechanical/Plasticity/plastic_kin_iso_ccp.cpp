@@ -23,8 +23,12 @@
 
 #include <iostream>
 #include <fstream>
+#include <memory>
+#include <assert.h>
 #include <armadillo>
 #include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Phase/tolerances.hpp>
+#include <smartplus/Libraries/Phase/material_constants.hpp>
 #include <smartplus/Libraries/Continuum_Mechanics/contimech.hpp>
 #include <smartplus/Libraries/Continuum_Mechanics/constitutive.hpp>
 #include <smartplus/Libraries/Maths/rotation.hpp>
@@ -62,8 +66,17 @@ namespace smart {
 ///@brief statev[13] : Backstress 11: X(1,2)
 
 
+///@brief Constants of the model derived from the props: elastic stiffness and CTE tensors
+std::shared_ptr<material_constants> umat_plasticity_kin_iso_CCP_init(const vec &props)
+{
+    assert(props.n_elem >= 7);
+    return make_shared<isotropic_constants>(props(0), props(1), props(2));
+}
+
 void umat_plasticity_kin_iso_CCP(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt, mat &L, vec &sigma_in, const mat &DR, const int &nprops, const vec &props, const int &nstatev, vec &statev, const double &T, const double &DT, const double &Time, const double &DTime, double &Wm, double &Wm_r, double &Wm_ir, double &Wm_d, const int &ndi, const int &nshr, const bool &start, const int &solver_type, double &tnew_dt)                               
 {
+    //Tolerances of the material being computed
+    const tolerances &tol = tolerances::current();
     
     UNUSED(nprops);
     UNUSED(nstatev);
@@ -73,16 +86,17 @@ void umat_plasticity_kin_iso_CCP(const vec &Etot, const vec &DEtot, vec &sigma,
     UNUSED(tnew_dt);
     
     //From the props to the material properties
-    double E = props(0);
-    double nu= props(1);
-    double alpha_iso = props(2);
     double sigmaY = props(3);
     double k=props(4);
     double m=props(5);
     double kX = props(6);
     
+    //Constants derived from the props, precomputed once per material
+    shared_ptr<material_constants> sptr_constants;
+    const isotropic_constants *cst = current_constants<isotropic_constants>(props, umat_plasticity_kin_iso_CCP_init, sptr_constants);
+    
     //definition of the CTE tensor
-    vec alpha = alpha_iso*Ith();
+    const vec &alpha = cst->alpha;
        
     ///@brief Temperature initialization
     double T_init = statev(0);
@@ -113,7 +127,7 @@ void umat_plasticity_kin_iso_CCP(const vec &Etot, const vec &DEtot, vec &sigma,
     if(start)
     {
         //Elstic stiffness tensor
-        L = L_iso(E, nu, "Enu");
+        L = cst->L;
         T_init = T;
         vec vide = zeros(6);
         sigma = vide;
@@ -128,12 +142,12 @@ void umat_plasticity_kin_iso_CCP(const vec &Etot, const vec &DEtot, vec &sigma,
     }
     
     //Additional parameters and variables
-    vec X = kX*(a%Ir05());
+    vec X = kX*(a%cst->Ir05);
     
     double Hp=0.;
     double dHpdp=0.;
     
-    if (p > iota)	{
+    if (p > tol.zero_iota)	{
         dHpdp = m*k*pow(p, m-1);
         Hp = k*pow(p, m);
     }
@@ -183,10 +197,10 @@ void umat_plasticity_kin_iso_CCP(const vec &Etot, const vec &DEtot, vec &sigma,
     double error = 1.;
     
     //Loop
-    for (compteur = 0; ((compteur < maxiter_umat) && (error > precision_umat)); compteur++) {
+    for (compteur = 0; ((compteur < tol.umat_maxiter) && (error > tol.umat_precision)); compteur++) {
         
         p = s_j(0);
-        if (p > iota)	{
+        if (p > tol.zero_iota)	{
             dHpdp = m*k*pow(p, m-1);
             Hp = k*pow(p, m);
         }
@@ -196,7 +210,7 @@ void umat_plasticity_kin_iso_CCP(const vec &Etot, const vec &DEtot, vec &sigma,
         }
         dPhidsigma = eta_stress(sigma-X);
         dPhidp = -1.*dHpdp;
-        dPhida = -1.*kX*(eta_stress(sigma - X)%Ir05());
+        dPhida = -1.*kX*(eta_stress(sigma - X)%cst->Ir05);
         
         //compute Phi and the derivatives
         Phi(0) = Mises_stress(sigma-X) - Hp - sigmaY;
@@ -214,7 +228,7 @@ void umat_plasticity_kin_iso_CCP(const vec &Etot, const vec &DEtot, vec &sigma,
         s_j(0) += ds_j(0);
         EP = EP + ds_j(0)*Lambdap;
         a = a + ds_j(0)*Lambdaa;
-        X = kX*(a%Ir05());
+        X = kX*(a%cst->Ir05);
         
         //the stress is now computed using the relationship sigma = L(E-Ep)
         Eel = Etot + DEtot - alpha*(T + DT - T_init) - EP;
@@ -237,7 +251,7 @@ void umat_plasticity_kin_iso_CCP(const vec &Etot, const vec &DEtot, vec &sigma,
 		mat delta = eye(1,1);
     
 		for (int i=0; i<1; i++) {
-			if(Ds_j[i] > iota)
+			if(Ds_j[i] > tol.zero_iota)
 				op(i) = 1.;
 		}
     
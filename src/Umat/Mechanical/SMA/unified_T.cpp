@@ -22,9 +22,12 @@
 
 #include <iostream>
 #include <fstream>
+#include <memory>
 #include <assert.h>
 #include <armadillo>
 #include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Phase/tolerances.hpp>
+#include <smartplus/Libraries/Phase/material_constants.hpp>
 #include <smartplus/Libraries/Maths/lagrange.hpp>
 #include <smartplus/Libraries/Maths/rotation.hpp>
 #include <smartplus/Libraries/Continuum_Mechanics/contimech.hpp>
@@ -38,7 +41,16 @@ using namespace arma;
 
 namespace smart {
 
+///@brief Constants of the model derived from the props: elastic moduli and compliance tensors of the phases, difference of their CTE
+std::shared_ptr<material_constants> umat_sma_unified_T_init(const vec &props)
+{
+    assert(props.n_elem >= 28);
+    return make_shared<sma_constants>(props(1), props(2), props(3), props(4), props(5), props(6));
+}
+
 void umat_sma_unified_T(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt, const mat &DR, const int &nprops, const vec &props, const int &nstatev, vec &statev, const double &T, const double &DT, const double &Time, const double &DTime, double &Wm, double &Wm_r, double &Wm_ir, double &Wm_d, const int &ndi, const int &nshr, const bool &start, double &tnew_dt) {
+    //Tolerances of the material being computed
+    const tolerances &tol = tolerances::current();
     
     UNUSED(nprops);
     UNUSED(nstatev);
@@ -101,8 +113,6 @@ void umat_sma_unified_T(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt,
     int flagT = props(0);
     double E_A = props(1);
     double E_M = props(2);
-    double nu_A = props(3);
-    double nu_M= props(4);
     double alphaA_iso = props(5);
     double alphaM_iso = props(6);
     //parameters for Hcur
@@ -162,28 +172,29 @@ void umat_sma_unified_T(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt,
     double a3 = statev(15);
     double Y0t = statev(16);
     
+    //Constants derived from the props, precomputed once per material
+    shared_ptr<material_constants> sptr_constants;
+    const sma_constants *cst = current_constants<sma_constants>(props, umat_sma_unified_T_init, sptr_constants);
+    
     // ######################  Elastic compliance and stiffness #################################
     //defines K and mu explicitely
     //Find the elastic stiffness tensor that is dependent on fraction volume of martensite
-    double K_A = E_A/(3.*(1.-2*nu_A));
-    double mu_A = E_A/(2.*(1.+nu_A));
+    const double &K_A = cst->K_A;
+    const double &mu_A = cst->mu_A;
     
-    double K_M = E_M/(3.*(1.-2*nu_M));
-    double mu_M = E_M/(2.*(1.+nu_M));
+    const double &K_M = cst->K_M;
+    const double &mu_M = cst->mu_M;
     
     double K_eff = (K_A*K_M)/(xi*K_A + (1. - xi)*K_M);
     double mu_eff = (mu_A*mu_M)/(xi*mu_A + (1. - xi)*mu_M);
     
-    //defines M_A and M_M
-    mat M_A = M_iso(K_A, mu_A, "Kmu");
-    mat M_M = M_iso(K_M, mu_M, "Kmu");
     mat M = M_iso(K_eff, mu_eff, "Kmu");
     mat L = L_iso(K_eff, mu_eff, "Kmu");    
-    mat DM = M_M - M_A;
+    const mat &DM = cst->DM;
     
     //definition of the CTE tensor
-    vec alpha = (alphaM_iso*xi + alphaA_iso*(1.-xi))*Ith();
-    vec Dalpha = (alphaM_iso - alphaA_iso)*Ith();
+    vec alpha = (alphaM_iso*xi + alphaA_iso*(1.-xi))*cst->Ith;
+    const vec &Dalpha = cst->Dalpha;
 
     ///@brief Initialization
     if(start) {
@@ -192,7 +203,7 @@ void umat_sma_unified_T(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt,
         vec vide = zeros(6);
         sigma = zeros(6);
         ET = zeros(6);
-        xiF = limit;
+        xiF = tol.zero_limit;
         xiR = 0.;
         xi = xiF;
         
@@ -388,7 +399,7 @@ void umat_sma_unified_T(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt,
     double error = 1.;
     
     //Loop
-    for (compteur = 0; ((compteur < maxiter_umat) && (error > precision_umat)); compteur++) {
+    for (compteur = 0; ((compteur < tol.umat_maxiter) && (error > tol.umat_precision)); compteur++) {
         
         K_eff = (K_A*K_M) / (xi*K_A + (1. - xi)*K_M);
         mu_eff = (mu_A*mu_M) / (xi*mu_A + (1. - xi)*mu_M);
@@ -557,7 +568,7 @@ void umat_sma_unified_T(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt,
         DETF += ds_j(0)*lambdaTF;
         DETR += -1.*ds_j(1)*lambdaTR;
         
-        if((Mises_strain(ET) > precision_umat)&&(xi > precision_umat))
+        if((Mises_strain(ET) > tol.umat_precision)&&(xi > tol.umat_precision))
         {
             ETMean = dev(ET) / (xi);
         }
@@ -587,7 +598,7 @@ void umat_sma_unified_T(const vec &Etot, const vec &DEtot, vec &sigma, mat &Lt,
     mat delta = eye(2,2);
     
     for (int i=0; i<2; i++) {
-        if(Ds_j[i] > iota)
+        if(Ds_j[i] > tol.zero_iota)
             op(i) = 1.;
     }
     
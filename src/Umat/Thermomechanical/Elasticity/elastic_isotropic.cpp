@@ -21,8 +21,11 @@
 
 #include <iostream>
 #include <fstream>
+#include <memory>
+#include <assert.h>
 #include <armadillo>
 #include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Phase/material_constants.hpp>
 #include <smartplus/Libraries/Continuum_Mechanics/constitutive.hpp>
 
 using namespace std;
@@ -37,6 +40,13 @@ namespace smart{
 
 ///@brief No statev is required for thermoelastic constitutive law
 
+///@brief Constants of the model derived from the props: elastic stiffness, compliance and CTE tensors
+std::shared_ptr<material_constants> umat_elasticity_iso_T_init(const vec &props)
+{
+    assert(props.n_elem >= 5);
+    return make_shared<isotropic_constants>(props(2), props(3), props(4));
+}
+
 void umat_elasticity_iso_T(const vec &Etot, const vec &DEtot, vec &sigma, double &r, mat &dSdE, mat &dSdT, mat &drdE, mat &drdT, const mat &DR, const int &nprops, const vec &props, const int &nstatev, vec &statev, const double &T, const double &DT,const double &Time,const double &DTime, double &Wm, double &Wm_r, double &Wm_ir, double &Wm_d, double &Wt, double &Wt_r, double &Wt_ir, const int &ndi, const int &nshr, const bool &start, double &tnew_dt)
 {  	
 
@@ -53,18 +63,19 @@ void umat_elasticity_iso_T(const vec &Etot, const vec &DEtot, vec &sigma, double
 	//From the props to the material properties
     double rho = props(0);
     double c_p = props(1); // Make sure c_p has been identified at T = T_init
-    double E = props(2);
-	double nu = props(3);
-	double alpha_iso = props(4);
     
     double T_init = statev(0);
     
+    //Constants derived from the props, precomputed once per material
+    shared_ptr<material_constants> sptr_constants;
+    const isotropic_constants *cst = current_constants<isotropic_constants>(props, umat_elasticity_iso_T_init, sptr_constants);
+    
     //definition of the CTE tensor
-    vec alpha = alpha_iso*Ith();
+    const vec &alpha = cst->alpha;
     
 	// ######################  Elastic compliance and stiffness #################################			
 	//defines L
-	dSdE = L_iso(E, nu, "Enu");
+	dSdE = cst->L;
     dSdT = -1.*dSdE*alpha;
 	
 	if(start) { //Initialization
@@ -23,8 +23,12 @@
 
 #include <iostream>
 #include <fstream>
+#include <memory>
+#include <assert.h>
 #include <armadillo>
 #include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Phase/tolerances.hpp>
+#include <smartplus/Libraries/Phase/material_constants.hpp>
 #include <smartplus/Libraries/Continuum_Mechanics/contimech.hpp>
 #include <smartplus/Libraries/Continuum_Mechanics/constitutive.hpp>
 #include <smartplus/Libraries/Maths/rotation.hpp>
@@ -81,8 +85,17 @@ namespace smart {
     A_theta =
     */
 
+///@brief Constants of the model derived from the props: elastic stiffness, compliance and CTE tensors
+std::shared_ptr<material_constants> umat_plasticity_iso_CCP_T_init(const vec &props)
+{
+    assert(props.n_elem >= 8);
+    return make_shared<isotropic_constants>(props(2), props(3), props(4));
+}
+
 void umat_plasticity_iso_CCP_T(const vec &Etot, const vec &DEtot, vec &sigma, double &r, mat &dSdE, mat &dSdT, mat &drdE, mat &drdT, const mat &DR, const int &nprops, const vec &props, const int &nstatev, vec &statev, const double &T, const double &DT,const double &Time,const double &DTime, double &Wm, double &Wm_r, double &Wm_ir, double &Wm_d, double &Wt, double &Wt_r, double &Wt_ir, const int &ndi, const int &nshr, const bool &start, double &tnew_dt)
 {
+    //Tolerances of the material being computed
+    const tolerances &tol = tolerances::current();
 
     UNUSED(nprops);
     UNUSED(nstatev);
@@ -93,20 +106,21 @@ void umat_plasticity_iso_CCP_T(const vec &Etot, const vec &DEtot, vec &sigma, do
 	//From the props to the material properties
     double rho = props(0);
     double c_p = props(1);
-    double E = props(2);
-	double nu= props(3);
-	double alpha_iso = props(4);
 	double sigmaY = props(5);
 	double k=props(6);
 	double m=props(7);
     
+    //Constants derived from the props, precomputed once per material
+    shared_ptr<material_constants> sptr_constants;
+    const isotropic_constants *cst = current_constants<isotropic_constants>(props, umat_plasticity_iso_CCP_T_init, sptr_constants);
+    
     //definition of the CTE tensor
-    vec alpha = alpha_iso*Ith();
+    const vec &alpha = cst->alpha;
     
 	// ######################  Elastic compliance and stiffness #################################			
 	//defines L
-	mat L = L_iso(E, nu, "Enu");
-	mat M = M_iso(E, nu, "Enu");
+	const mat &L = cst->L;
+	const mat &M = cst->M;
     
     ///@brief Temperature initialization
     double T_init = statev(0);
@@ -148,7 +162,7 @@ void umat_plasticity_iso_CCP_T(const vec &Etot, const vec &DEtot, vec &sigma, do
     double Hp=0.;
     double dHpdp=0.;
 
-    if (p > iota)	{
+    if (p > tol.zero_iota)	{
         dHpdp = m*k*pow(p, m-1);
         Hp = k*pow(p, m);
     }
@@ -192,10 +206,10 @@ void umat_plasticity_iso_CCP_T(const vec &Etot, const vec &DEtot, vec &sigma, do
     double error = 1.;
     
     //Loop
-    for (compteur = 0; ((compteur < maxiter_umat) && (error > precision_umat)); compteur++) {
+    for (compteur = 0; ((compteur < tol.umat_maxiter) && (error > tol.umat_precision)); compteur++) {
         
         p = s_j(0);
-        if (p > iota)	{
+        if (p > tol.zero_iota)	{
             dHpdp = m*k*pow(p, m-1);
             Hp = k*pow(p, m);
         }
@@ -239,7 +253,7 @@ void umat_plasticity_iso_CCP_T(const vec &Etot, const vec &DEtot, vec &sigma, do
     mat delta = eye(1,1);
     
     for (int i=0; i<1; i++) {
-        if(Ds_j[i] > iota)
+        if(Ds_j[i] > tol.zero_iota)
         op(i) = 1.;
     }
     
@@ -23,8 +23,12 @@
 
 #include <iostream>
 #include <fstream>
+#include <memory>
+#include <assert.h>
 #include <armadillo>
 #include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Phase/tolerances.hpp>
+#include <smartplus/Libraries/Phase/material_constants.hpp>
 #include <smartplus/Libraries/Continuum_Mechanics/contimech.hpp>
 #include <smartplus/Libraries/Continuum_Mechanics/constitutive.hpp>
 #include <smartplus/Libraries/Maths/rotation.hpp>
@@ -64,8 +68,17 @@ namespace smart {
 ///@brief statev[13] : Backstress 11: X(1,2)
 
 
+///@brief Constants of the model derived from the props: elastic stiffness, compliance and CTE tensors
+std::shared_ptr<material_constants> umat_plasticity_kin_iso_CCP_T_init(const vec &props)
+{
+    assert(props.n_elem >= 9);
+    return make_shared<isotropic_constants>(props(2), props(3), props(4));
+}
+
 void umat_plasticity_kin_iso_CCP_T(const vec &Etot, const vec &DEtot, vec &sigma, double &r, mat &dSdE, mat &dSdT, mat &drdE, mat &drdT, const mat &DR, const int &nprops, const vec &props, const int &nstatev, vec &statev, const double &T, const double &DT,const double &Time,const double &DTime, double &Wm, double &Wm_r, double &Wm_ir, double &Wm_d, double &Wt, double &Wt_r, double &Wt_ir, const int &ndi, const int &nshr, const bool &start, double &tnew_dt)
 {
+    //Tolerances of the material being computed
+    const tolerances &tol = tolerances::current();
     
     UNUSED(nprops);
     UNUSED(nstatev);
@@ -76,21 +89,22 @@ void umat_plasticity_kin_iso_CCP_T(const vec &Etot, const vec &DEtot, vec &sigma
     //From the props to the material properties
     double rho = props(0);
     double c_p = props(1);
-    double E = props(2);
-    double nu= props(3);
-    double alpha_iso = props(4);
     double sigmaY = props(5);
     double k=props(6);
     double m=props(7);
     double kX = props(8);
     
+    //Constants derived from the props, precomputed once per material
+    shared_ptr<material_constants> sptr_constants;
+    const isotropic_constants *cst = current_constants<isotropic_constants>(props, umat_plasticity_kin_iso_CCP_T_init, sptr_constants);
+    
     //definition of the CTE tensor
-    vec alpha = alpha_iso*Ith();
+    const vec &alpha = cst->alpha;
     
     // ######################  Elastic compliance and stiffness #################################
     //defines L
-    mat L = L_iso(E, nu, "Enu");
-    mat M = M_iso(E, nu, "Enu");
+    const mat &L = cst->L;
+    const mat &M = cst->M;
     
     ///@brief Temperature initialization
     double T_init = statev(0);
@@ -139,12 +153,12 @@ void umat_plasticity_kin_iso_CCP_T(const vec &Etot, const vec &DEtot, vec &sigma
     
     //Additional parameters and variables
     double c_0 = rho*c_p;
-    vec X = kX*(a%Ir05());
+    vec X = kX*(a%cst->Ir05);
     
     double Hp=0.;
     double dHpdp=0.;
     
-    if (p > iota)	{
+    if (p > tol.zero_iota)	{
         dHpdp = m*k*pow(p, m-1);
         Hp = k*pow(p, m);
     }
@@ -194,10 +208,10 @@ void umat_plasticity_kin_iso_CCP_T(const vec &Etot, const vec &DEtot, vec &sigma
     double error = 1.;
     
     //Loop
-    for (compteur = 0; ((compteur < maxiter_umat) && (error > precision_umat)); compteur++) {
+    for (compteur = 0; ((compteur < tol.umat_maxiter) && (error > tol.umat_precision)); compteur++) {
         
         p = s_j(0);
-        if (p > iota)	{
+        if (p > tol.zero_iota)	{
             dHpdp = m*k*pow(p, m-1);
             Hp = k*pow(p, m);
         }
@@ -207,7 +221,7 @@ void umat_plasticity_kin_iso_CCP_T(const vec &Etot, const vec &DEtot, vec &sigma
         }
         dPhidsigma = eta_stress(sigma-X);
         dPhidp = -1.*dHpdp;
-        dPhida = -1.*kX*(eta_stress(sigma - X)%Ir05());
+        dPhida = -1.*kX*(eta_stress(sigma - X)%cst->Ir05);
         
         //compute Phi and the derivatives
         Phi(0) = Mises_stress(sigma-X) - Hp - sigmaY;
@@ -225,7 +239,7 @@ void umat_plasticity_kin_iso_CCP_T(const vec &Etot, const vec &DEtot, vec &sigma
         s_j(0) += ds_j(0);
         EP = EP + ds_j(0)*Lambdap;
         a = a + ds_j(0)*Lambdaa;
-        X = kX*(a%Ir05());
+        X = kX*(a%cst->Ir05);
         
         //the stress is now computed using the relationship sigma = L(E-Ep)
         Eel = Etot + DEtot - alpha*(T + DT - T_init) - EP;
@@ -246,7 +260,7 @@ void umat_plasticity_kin_iso_CCP_T(const vec &Etot, const vec &DEtot, vec &sigma
     mat delta = eye(1,1);
     
     for (int i=0; i<1; i++) {
-        if(Ds_j[i] > iota)
+        if(Ds_j[i] > tol.zero_iota)
         op(i) = 1.;
     }
     
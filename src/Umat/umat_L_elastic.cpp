@@ -42,26 +42,20 @@ namespace smart{
 void get_L_elastic(phase_characteristics &rve)
 {
     
-    string path_data = "data";
+    string path_data = rve.sptr_matprops->path_data;
     string inputfile; //file # that stores the microstructure properties
     
-    std::map<string, int> list_umat;
-    list_umat = {{"ELISO",1},{"ELIST",2},{"ELORT",3},{"MIHEN",100},{"MIMTN",101},{"MISCN",103},{"MIPLN",104}};
-    
-    int method = list_umat[rve.sptr_matprops->umat_name];
+    if (rve.sptr_matprops->umat_id == 0) {
+        rve.sptr_matprops->resolve_umat();
+    }
+    int method = rve.sptr_matprops->umat_id;
     
     //first we read the behavior of the phases & we construct the tensors if necessary
     switch (method) {
             
         case 100: case 101: case 103: {
             //Definition of the static vectors x,wx,y,wy
-            ellipsoid_multi::mp = rve.sptr_matprops->props(2);
-            ellipsoid_multi::np = rve.sptr_matprops->props(3);
-            ellipsoid_multi::x.set_size(ellipsoid_multi::mp);
-            ellipsoid_multi::wx.set_size(ellipsoid_multi::mp);
-            ellipsoid_multi::y.set_size(ellipsoid_multi::np);
-            ellipsoid_multi::wy.set_size(ellipsoid_multi::np);
-            points(ellipsoid_multi::x, ellipsoid_multi::wx, ellipsoid_multi::y, ellipsoid_multi::wy,ellipsoid_multi::mp, ellipsoid_multi::np);
+            ellipsoid_multi::set_points(rve.sptr_matprops->props(2), rve.sptr_matprops->props(3), rve.sptr_matprops->tol.micro_points);
             
             inputfile = "Nellipsoids" + to_string(int(rve.sptr_matprops->props(1))) + ".dat";
             read_ellipsoid(rve, path_data, inputfile);
@@ -113,14 +107,14 @@ void get_L_elastic(phase_characteristics &rve)
             break;
         }
         case 100: {
-            for (auto r : rve.sub_phases) {
+            for (auto &r : rve.sub_phases) {
                 get_L_elastic(r);
             }
             Lt_Homogeneous_E(rve);
             break;
         }
         case 101: {
-            for (auto r : rve.sub_phases) {
+            for (auto &r : rve.sub_phases) {
                 get_L_elastic(r);
             }
             int n_matrix = rve.sptr_matprops->props(4);
@@ -128,7 +122,7 @@ void get_L_elastic(phase_characteristics &rve)
             break;	
         }
         case 103: {
-            for (auto r : rve.sub_phases) {
+            for (auto &r : rve.sub_phases) {
                 get_L_elastic(r);
             }
             int n_matrix = rve.sptr_matprops->props(4);
@@ -138,14 +132,14 @@ void get_L_elastic(phase_characteristics &rve)
             int nbiter=0;
             double error = 1.;
             
-            while ((error > precision_micro)&&(nbiter <= maxiter_micro)) {
+            while ((error > rve.sptr_matprops->tol.micro_precision)&&(nbiter <= rve.sptr_matprops->tol.micro_maxiter)) {
                 Lt_n = umat_M->Lt;
-                for (auto r : rve.sub_phases) {
+                for (auto &r : rve.sub_phases) {
                     get_L_elastic(r);
                 }
                 Lt_Self_Consistent(rve, n_matrix, false, 1);
                 umat_M->Lt = zeros(6,6);
-                for (auto r : rve.sub_phases) {
+                for (auto &r : rve.sub_phases) {
                     umat_sub_phases_M = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
                     umat_M->Lt += r.sptr_shape->concentration*(umat_sub_phases_M->Lt*r.sptr_multi->A);
                 }
@@ -155,7 +149,7 @@ void get_L_elastic(phase_characteristics &rve)
             break;
         }
         case 104: {
-            for (auto r : rve.sub_phases) {
+            for (auto &r : rve.sub_phases) {
                 get_L_elastic(r);
             }
             Lt_Periodic_Layer(rve);
@@ -173,7 +167,7 @@ void get_L_elastic(phase_characteristics &rve)
 
             // Compute the effective tangent modulus, and the effective stress
             umat_M->Lt = zeros(6,6);
-            for (auto r : rve.sub_phases) {
+            for (auto &r : rve.sub_phases) {
                 umat_sub_phases_M = std::dynamic_pointer_cast<state_variables_M>(r.sptr_sv_global);
                 umat_M->Lt += r.sptr_shape->concentration*(umat_sub_phases_M->Lt*r.sptr_multi->A);
             }
@@ -0,0 +1,154 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file umat_registry.cpp
+///@brief Registry of the constitutive models: the name of a UMAT is resolved once into a function handle
+///@version 1.0
+
+#include <iostream>
+#include <string>
+#include <map>
+#include <dlfcn.h>
+#include <armadillo>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Umat/umat_registry.hpp>
+#include <smartplus/Umat/Mechanical/Elasticity/elastic_isotropic.hpp>
+#include <smartplus/Umat/Mechanical/Elasticity/elastic_transverse_isotropic.hpp>
+#include <smartplus/Umat/Mechanical/Elasticity/elastic_orthotropic.hpp>
+#include <smartplus/Umat/Mechanical/Plasticity/plastic_isotropic_ccp.hpp>
+#include <smartplus/Umat/Mechanical/Plasticity/plastic_kin_iso_ccp.hpp>
+#include <smartplus/Umat/Mechanical/SMA/unified_T.hpp>
+#include <smartplus/Umat/Mechanical/Damage/damage_LLD_0.hpp>
+#include <smartplus/Umat/Thermomechanical/Elasticity/elastic_isotropic.hpp>
+#include <smartplus/Umat/Thermomechanical/Elasticity/elastic_transverse_isotropic.hpp>
+#include <smartplus/Umat/Thermomechanical/Elasticity/elastic_orthotropic.hpp>
+#include <smartplus/Umat/Thermomechanical/Plasticity/plastic_isotropic_ccp.hpp>
+#include <smartplus/Umat/Thermomechanical/Plasticity/plastic_kin_iso_ccp.hpp>
+#include <smartplus/Umat/Thermomechanical/SMA/unified_T.hpp>
+#include <smartplus/Libraries/Phase/phase_characteristics.hpp>
+#include <smartplus/Libraries/Phase/state_variables_M.hpp>
+#include <smartplus/Libraries/Phase/state_variables_T.hpp>
+#include <smartplus/Micromechanics/multiphase.hpp>
+
+using namespace std;
+using namespace arma;
+
+namespace smart{
+
+//Signatures of the mechanical and thermomechanical constitutive models written in the SMART+ format
+typedef void (*umat_M_kernel)(const vec &, const vec &, vec &, mat &, mat &, vec &, const mat &, const int &, const vec &, const int &, vec &, const double &, const double &,const double &,const double &, double &, double &, double &, double &, const int &, const int &, const bool &, const int &, double &);
+typedef void (*umat_T_kernel)(const vec &, const vec &, vec &, double &, mat &, mat &, mat &, mat &, const mat &, const int &, const vec &, const int &, vec &, const double &, const double &,const double &,const double &, double &, double &, double &, double &, double &, double &, double &, const int &, const int &, const bool &, double &);
+
+//Adapters from the uniform signature to the SMART+ format, instantiated once per model
+template<umat_M_kernel umat> void umat_M_adapter(phase_characteristics &rve, const mat &DR, const double &Time, const double &DTime, const int &ndi, const int &nshr, const bool &start, const int &solver_type, double &tnew_dt)
+{
+    state_variables_M *umat_M = rve.sv_local<state_variables_M>();
+    umat(umat_M->Etot, umat_M->DEtot, umat_M->sigma, umat_M->Lt, umat_M->L, umat_M->sigma_in, DR, rve.sptr_matprops->nprops, rve.sptr_matprops->props, umat_M->nstatev, umat_M->statev, umat_M->T, umat_M->DT, Time, DTime, umat_M->Wm(0), umat_M->Wm(1), umat_M->Wm(2), umat_M->Wm(3), ndi, nshr, start, solver_type, tnew_dt);
+}
+
+template<umat_T_kernel umat> void umat_T_adapter(phase_characteristics &rve, const mat &DR, const double &Time, const double &DTime, const int &ndi, const int &nshr, const bool &start, const int &solver_type, double &tnew_dt)
+{
+    UNUSED(solver_type);
+    state_variables_T *umat_T = rve.sv_local<state_variables_T>();
+    umat(umat_T->Etot, umat_T->DEtot, umat_T->sigma, umat_T->r, umat_T->dSdE, umat_T->dSdT, umat_T->drdE, umat_T->drdT, DR, rve.sptr_matprops->nprops, rve.sptr_matprops->props, umat_T->nstatev, umat_T->statev, umat_T->T, umat_T->DT, Time, DTime, umat_T->Wm(0), umat_T->Wm(1), umat_T->Wm(2), umat_T->Wm(3), umat_T->Wt(0), umat_T->Wt(1), umat_T->Wt(2), ndi, nshr, start, tnew_dt);
+}
+
+void umat_sma_unified_T_adapter(phase_characteristics &rve, const mat &DR, const double &Time, const double &DTime, const int &ndi, const int &nshr, const bool &start, const int &solver_type, double &tnew_dt)
+{
+    UNUSED(solver_type);
+    state_variables_M *umat_M = rve.sv_local<state_variables_M>();
+    umat_sma_unified_T(umat_M->Etot, umat_M->DEtot, umat_M->sigma, umat_M->Lt, DR, rve.sptr_matprops->nprops, rve.sptr_matprops->props, umat_M->nstatev, umat_M->statev, umat_M->T, umat_M->DT, Time, DTime, umat_M->Wm(0), umat_M->Wm(1), umat_M->Wm(2), umat_M->Wm(3), ndi, nshr, start, tnew_dt);
+}
+
+template<int method> void umat_multi_adapter(phase_characteristics &rve, const mat &DR, const double &Time, const double &DTime, const int &ndi, const int &nshr, const bool &start, const int &solver_type, double &tnew_dt)
+{
+    UNUSED(solver_type);
+    umat_multi(rve, DR, Time, DTime, ndi, nshr, start, tnew_dt, method);
+}
+
+map<string, umat_entry> builtin_umats()
+{
+    map<string, umat_entry> list_umat;
+    list_umat["ELISO"] = {1, umat_M_adapter<umat_elasticity_iso>, umat_T_adapter<umat_elasticity_iso_T>, NULL, umat_elasticity_iso_T_init};
+    list_umat["ELIST"] = {2, umat_M_adapter<umat_elasticity_trans_iso>, umat_T_adapter<umat_elasticity_trans_iso_T>, NULL, NULL};
+    list_umat["ELORT"] = {3, umat_M_adapter<umat_elasticity_ortho>, umat_T_adapter<umat_elasticity_ortho_T>, NULL, NULL};
+    list_umat["EPICP"] = {4, umat_M_adapter<umat_plasticity_iso_CCP>, umat_T_adapter<umat_plasticity_iso_CCP_T>, umat_plasticity_iso_CCP_init, umat_plasticity_iso_CCP_T_init};
+    list_umat["EPKCP"] = {5, umat_M_adapter<umat_plasticity_kin_iso_CCP>, umat_T_adapter<umat_plasticity_kin_iso_CCP_T>, umat_plasticity_kin_iso_CCP_init, umat_plasticity_kin_iso_CCP_T_init};
+    list_umat["SMAUT"] = {6, umat_sma_unified_T_adapter, umat_T_adapter<umat_sma_unified_T_T>, umat_sma_unified_T_init, umat_sma_unified_T_T_init};
+    list_umat["LLDM0"] = {8, umat_M_adapter<umat_damage_LLD_0>, NULL, NULL, NULL};
+    list_umat["MIHEN"] = {100, umat_multi_adapter<100>, NULL, NULL, NULL};
+    list_umat["MIMTN"] = {101, umat_multi_adapter<101>, NULL, NULL, NULL};
+    list_umat["MISCN"] = {103, umat_multi_adapter<103>, NULL, NULL, NULL};
+    list_umat["MIPLN"] = {104, umat_multi_adapter<104>, NULL, NULL, NULL};
+    return list_umat;
+}
+
+//-------------------------------------------------------------
+map<string, umat_entry>& umat_library()
+//-------------------------------------------------------------
+{
+    static map<string, umat_entry> list_umat = builtin_umats();
+    return list_umat;
+}
+
+//-------------------------------------------------------------
+int register_umat(const string &umat_name, const int &id, umat_function umat_M, umat_function umat_T, umat_init_function init_M, umat_init_function init_T)
+//-------------------------------------------------------------
+{
+    map<string, umat_entry> &list_umat = umat_library();
+    int number = id;
+    if (number == 0) {
+        number = 1000;
+        for (auto &u : list_umat) {
+            if (u.second.id >= number)
+                number = u.second.id + 1;
+        }
+    }
+    list_umat[umat_name] = {number, umat_M, umat_T, init_M, init_T};
+    return number;
+}
+
+//-------------------------------------------------------------
+const umat_entry* find_umat(const string &umat_name)
+//-------------------------------------------------------------
+{
+    map<string, umat_entry> &list_umat = umat_library();
+    auto it = list_umat.find(umat_name);
+    if (it == list_umat.end())
+        return NULL;
+    return &(it->second);
+}
+
+//-------------------------------------------------------------
+void load_umat_plugin(const string &libname)
+//-------------------------------------------------------------
+{
+    void *handle = dlopen(libname.c_str(), RTLD_NOW | RTLD_GLOBAL);
+    if (handle == NULL) {
+        cout << "error: The umat library " << libname << " could not be opened : " << dlerror() << "\n";
+        exit(0);
+    }
+    void (*register_function)() = (void (*)()) dlsym(handle, SMARTPLUS_UMAT_PLUGIN_SYMBOL);
+    if (register_function == NULL) {
+        cout << "error: The umat library " << libname << " does not define " << SMARTPLUS_UMAT_PLUGIN_SYMBOL << "\n";
+        exit(0);
+    }
+    //The library stays open : the registered functions are used until the end of the program
+    register_function();
+}
+
+} //namespace smart
@@ -342,98 +342,123 @@ void abaqus2smart_T(double *stress, double *ddsdde, double *ddsddt, double *drpl
     
 }
     
-void select_umat_T(phase_characteristics &rve, const mat &DR,const double &Time,const double &DTime, const int &ndi, const int &nshr, const bool &start, const int &solver_type, double &tnew_dt)
+//Integration of an increment by the model, split locally into sub-increments when the model asks for a cutback
+//The sub-increments are halved on failure and doubled on success, down to 1/tol.umat_substeps of the increment (opt-in, tol.umat_substeps > 1)
+template<class S> void substep_umat(phase_characteristics &rve, umat_function umat, const mat &DR, const double &Time, const double &DTime, const int &ndi, const int &nshr, const bool &start, const int &solver_type, double &tnew_dt)
 {
-    UNUSED(solver_type);
-    std::map<string, int> list_umat;
-    list_umat = {{"ELISO",1},{"ELIST",2},{"ELORT",3},{"EPICP",4},{"EPKCP",5},{"SMAUT",9}};
-
-    rve.global2local();
-    auto umat_T = std::dynamic_pointer_cast<state_variables_T>(rve.sptr_sv_local);
+    const tolerances &tol = rve.sptr_matprops->tol;
+    //Only the models whose state is held by the phase itself are restarted locally (not the multiphase ones)
+    if ((tol.umat_substeps <= 1)||(rve.sub_phases.size() > 0)) {
+        umat(rve, DR, Time, DTime, ndi, nshr, start, solver_type, tnew_dt);
+        return;
+    }
     
-    switch (list_umat[rve.sptr_matprops->umat_name]) {
-        case 1: {
-            umat_elasticity_iso_T(umat_T->Etot, umat_T->DEtot, umat_T->sigma, umat_T->r, umat_T->dSdE, umat_T->dSdT, umat_T->drdE, umat_T->drdT, DR, rve.sptr_matprops->nprops, rve.sptr_matprops->props, umat_T->nstatev, umat_T->statev, umat_T->T, umat_T->DT, Time, DTime, umat_T->Wm(0), umat_T->Wm(1), umat_T->Wm(2), umat_T->Wm(3), umat_T->Wt(0), umat_T->Wt(1), umat_T->Wt(2), ndi, nshr, start, tnew_dt);
-            break;
-        }
-        case 2: {
-            umat_elasticity_trans_iso_T(umat_T->Etot, umat_T->DEtot, umat_T->sigma, umat_T->r, umat_T->dSdE, umat_T->dSdT, umat_T->drdE, umat_T->drdT, DR, rve.sptr_matprops->nprops, rve.sptr_matprops->props, umat_T->nstatev, umat_T->statev, umat_T->T, umat_T->DT, Time, DTime, umat_T->Wm(0), umat_T->Wm(1), umat_T->Wm(2), umat_T->Wm(3), umat_T->Wt(0), umat_T->Wt(1), umat_T->Wt(2), ndi, nshr, start, tnew_dt);
-            break;
-        }
-        case 3: {
-            umat_elasticity_ortho_T(umat_T->Etot, umat_T->DEtot, umat_T->sigma, umat_T->r, umat_T->dSdE, umat_T->dSdT, umat_T->drdE, umat_T->drdT, DR, rve.sptr_matprops->nprops, rve.sptr_matprops->props, umat_T->nstatev, umat_T->statev, umat_T->T, umat_T->DT, Time, DTime, umat_T->Wm(0), umat_T->Wm(1), umat_T->Wm(2), umat_T->Wm(3), umat_T->Wt(0), umat_T->Wt(1), umat_T->Wt(2), ndi, nshr, start, tnew_dt);
-            break;
-        }
-        case 4: {
-            umat_plasticity_iso_CCP_T(umat_T->Etot, umat_T->DEtot, umat_T->sigma, umat_T->r, umat_T->dSdE, umat_T->dSdT, umat_T->drdE, umat_T->drdT, DR, rve.sptr_matprops->nprops, rve.sptr_matprops->props, umat_T->nstatev, umat_T->statev, umat_T->T, umat_T->DT, Time, DTime, umat_T->Wm(0), umat_T->Wm(1), umat_T->Wm(2), umat_T->Wm(3), umat_T->Wt(0), umat_T->Wt(1), umat_T->Wt(2), ndi, nshr, start, tnew_dt);
-            break;
-        }
-        case 5: {
-            umat_plasticity_kin_iso_CCP_T(umat_T->Etot, umat_T->DEtot, umat_T->sigma, umat_T->r, umat_T->dSdE, umat_T->dSdT, umat_T->drdE, umat_T->drdT, DR, rve.sptr_matprops->nprops, rve.sptr_matprops->props, umat_T->nstatev, umat_T->statev, umat_T->T, umat_T->DT, Time, DTime, umat_T->Wm(0), umat_T->Wm(1), umat_T->Wm(2), umat_T->Wm(3), umat_T->Wt(0), umat_T->Wt(1), umat_T->Wt(2), ndi, nshr, start, tnew_dt);
-           break;
+    //tnew_dt may be shared with other phases (see umat_multi) : the attempts use a local value, and a failure is only merged into it
+    S *sv = rve.sv_local<S>();
+    S sv_0 = *sv;
+    double tnew_loc = 1.;
+    umat(rve, DR, Time, DTime, ndi, nshr, start, solver_type, tnew_loc);
+    if (tnew_loc >= 1.) {
+        return;
+    }
+    
+    //The state at the end of each sub-increment is the starting state of the next one
+    *sv = sv_0;
+    double done = 0.;
+    double fraction = 0.5;
+    double tnew_sub = 1.;
+    bool start_sub = start;
+    mat DR_sub = DR;
+    while (done < 1. - tol.zero_iota) {
+        if (fraction > 1. - done) {
+            fraction = 1. - done;
         }
-        case 9: {
-            umat_sma_unified_T_T(umat_T->Etot, umat_T->DEtot, umat_T->sigma, umat_T->r, umat_T->dSdE, umat_T->dSdT, umat_T->drdE, umat_T->drdT, DR, rve.sptr_matprops->nprops, rve.sptr_matprops->props, umat_T->nstatev, umat_T->statev, umat_T->T, umat_T->DT, Time, DTime, umat_T->Wm(0), umat_T->Wm(1), umat_T->Wm(2), umat_T->Wm(3), umat_T->Wt(0), umat_T->Wt(1), umat_T->Wt(2), ndi, nshr, start, tnew_dt);
-            break;
+        S sv_sub = *sv;
+        sv->Etot = sv_0.Etot + done*sv_0.DEtot;
+        sv->DEtot = fraction*sv_0.DEtot;
+        sv->T = sv_0.T + done*sv_0.DT;
+        sv->DT = fraction*sv_0.DT;
+        
+        tnew_sub = 1.;
+        umat(rve, DR_sub, Time + done*DTime, fraction*DTime, ndi, nshr, start_sub, solver_type, tnew_sub);
+        
+        if (tnew_sub < 1.) {
+            *sv = sv_sub;
+            if (0.5*fraction*tol.umat_substeps < 1.) {
+                //Even the smallest sub-increment fails : the cutback is left to the global solver
+                *sv = sv_0;
+                if (tnew_sub*fraction < tnew_dt)
+                    tnew_dt = tnew_sub*fraction;
+                return;
+            }
+            fraction *= 0.5;
         }
-        default: {
-            cout << "Error: The choice of Thermomechanical Umat could not be found in the umat library :" << rve.sptr_matprops->umat_name << "\n";
-                exit(0);
+        else {
+            done += fraction;
+            fraction *= 2.;
+            start_sub = false;
+            DR_sub = eye(3,3);
         }
     }
+    
+    //The stress, internal variables and works are the consolidated ones, the tangent is the one of the last sub-increment
+    sv->Etot = sv_0.Etot;
+    sv->DEtot = sv_0.DEtot;
+    sv->T = sv_0.T;
+    sv->DT = sv_0.DT;
+}
+    
+void select_umat_T(phase_characteristics &rve, const mat &DR,const double &Time,const double &DTime, const int &ndi, const int &nshr, const bool &start, const int &solver_type, double &tnew_dt)
+{
+    //The name of the model is looked up in the umat registry once, the handle is kept in the material characteristics
+    if (rve.sptr_matprops->umat_id == 0) {
+        rve.sptr_matprops->resolve_umat();
+    }
+    if (rve.sptr_matprops->umat_T == NULL) {
+        cout << "Error: The choice of Thermomechanical Umat could not be found in the umat library :" << rve.sptr_matprops->umat_name << "\n";
+        exit(0);
+    }
+
+    rve.at_start = false;   //The current values are about to be written : the next to_start copies the start values back
+    rve.global2local();
+    //The tolerances of the material are used by the model (and restored for the calling one, e.g. in a multiphase model)
+    const tolerances *tol_previous = tolerances::set_current(&rve.sptr_matprops->tol);
+    //The constants derived from the props are built at the first call of the model after an update of the material
+    if ((rve.sptr_matprops->sptr_constants_T == NULL)&&(rve.sptr_matprops->init_T != NULL)) {
+        rve.sptr_matprops->sptr_constants_T = rve.sptr_matprops->init_T(rve.sptr_matprops->props);
+    }
+    const material_constants *constants_previous = material_constants::set_current(rve.sptr_matprops->sptr_constants_T.get());
+    substep_umat<state_variables_T>(rve, rve.sptr_matprops->umat_T, DR, Time, DTime, ndi, nshr, start, solver_type, tnew_dt);
+    material_constants::set_current(constants_previous);
+    tolerances::set_current(tol_previous);
     rve.local2global();
     
 }
     
 void select_umat_M(phase_characteristics &rve, const mat &DR,const double &Time,const double &DTime, const int &ndi, const int &nshr, const bool &start, const int &solver_type, double &tnew_dt)
 {
-	
-    std::map<string, int> list_umat;
-    list_umat = {{"ELISO",1},{"ELIST",2},{"ELORT",3},{"EPICP",4},{"EPKCP",5},{"SMAUT",6},{"LLDM0",8},{"MIHEN",100},{"MIMTN",101},{"MISCN",103},{"MIPLN",104}};
-    
-        rve.global2local();
-        auto umat_M = std::dynamic_pointer_cast<state_variables_M>(rve.sptr_sv_local);
+    //The name of the model is looked up in the umat registry once, the handle is kept in the material characteristics
+    if (rve.sptr_matprops->umat_id == 0) {
+        rve.sptr_matprops->resolve_umat();
+    }
+    if (rve.sptr_matprops->umat_M == NULL) {
+        cout << "Error: The choice of Umat could not be found in the umat library :" << rve.sptr_matprops->umat_name << "\n";
+        exit(0);
+    }
     
-        switch (list_umat[rve.sptr_matprops->umat_name]) {
-                
-            case 1: {
-                umat_elasticity_iso(umat_M->Etot, umat_M->DEtot, umat_M->sigma, umat_M->Lt, umat_M->L, umat_M->sigma_in, DR, rve.sptr_matprops->nprops, rve.sptr_matprops->props, umat_M->nstatev, umat_M->statev, umat_M->T, umat_M->DT, Time, DTime, umat_M->Wm(0), umat_M->Wm(1), umat_M->Wm(2), umat_M->Wm(3), ndi, nshr, start, solver_type, tnew_dt);
-                 break;
-             }
-             case 2: {
-                umat_elasticity_trans_iso(umat_M->Etot, umat_M->DEtot, umat_M->sigma, umat_M->Lt, umat_M->L, umat_M->sigma_in, DR, rve.sptr_matprops->nprops, rve.sptr_matprops->props, umat_M->nstatev, umat_M->statev, umat_M->T, umat_M->DT, Time, DTime, umat_M->Wm(0), umat_M->Wm(1), umat_M->Wm(2), umat_M->Wm(3), ndi, nshr, start, solver_type, tnew_dt);
-                 break;
-             }
-             case 3: {
-                umat_elasticity_ortho(umat_M->Etot, umat_M->DEtot, umat_M->sigma, umat_M->Lt, umat_M->L, umat_M->sigma_in, DR, rve.sptr_matprops->nprops, rve.sptr_matprops->props, umat_M->nstatev, umat_M->statev, umat_M->T, umat_M->DT, Time, DTime, umat_M->Wm(0), umat_M->Wm(1), umat_M->Wm(2), umat_M->Wm(3), ndi, nshr, start, solver_type, tnew_dt);
-                 break;
-             }
-             case 4: {
-                umat_plasticity_iso_CCP(umat_M->Etot, umat_M->DEtot, umat_M->sigma, umat_M->Lt, umat_M->L, umat_M->sigma_in, DR, rve.sptr_matprops->nprops, rve.sptr_matprops->props, umat_M->nstatev, umat_M->statev, umat_M->T, umat_M->DT, Time, DTime, umat_M->Wm(0), umat_M->Wm(1), umat_M->Wm(2), umat_M->Wm(3), ndi, nshr, start, solver_type, tnew_dt);
-                 break;
-             }
-             case 5: {
-                umat_plasticity_kin_iso_CCP(umat_M->Etot, umat_M->DEtot, umat_M->sigma, umat_M->Lt, umat_M->L, umat_M->sigma_in, DR, rve.sptr_matprops->nprops, rve.sptr_matprops->props, umat_M->nstatev, umat_M->statev, umat_M->T, umat_M->DT, Time, DTime, umat_M->Wm(0), umat_M->Wm(1), umat_M->Wm(2), umat_M->Wm(3), ndi, nshr, start, solver_type, tnew_dt);
-                 break;
-             }
-            case 6: {
-                umat_sma_unified_T(umat_M->Etot, umat_M->DEtot, umat_M->sigma, umat_M->Lt, DR, rve.sptr_matprops->nprops, rve.sptr_matprops->props, umat_M->nstatev, umat_M->statev, umat_M->T, umat_M->DT, Time, DTime, umat_M->Wm(0), umat_M->Wm(1), umat_M->Wm(2), umat_M->Wm(3), ndi, nshr, start, tnew_dt);
-                break;
-            }
-            case 8: {
-                umat_damage_LLD_0(umat_M->Etot, umat_M->DEtot, umat_M->sigma, umat_M->Lt, umat_M->L, umat_M->sigma_in, DR, rve.sptr_matprops->nprops, rve.sptr_matprops->props, umat_M->nstatev, umat_M->statev, umat_M->T, umat_M->DT, Time, DTime, umat_M->Wm(0), umat_M->Wm(1), umat_M->Wm(2), umat_M->Wm(3), ndi, nshr, start, solver_type, tnew_dt);
-                break;
-            }
-            case 100: case 101: case 103: case 104: {
-                umat_multi(rve, DR, Time, DTime, ndi, nshr, start, tnew_dt, list_umat[rve.sptr_matprops->umat_name]);
-                break;
-            }
-            default: {
-                cout << "Error: The choice of Umat could not be found in the umat library :" << rve.sptr_matprops->umat_name << "\n";
-                exit(0);
-            }
-        }
-        rve.local2global();
+    rve.at_start = false;   //The current values are about to be written : the next to_start copies the start values back
+    rve.global2local();
+    //The tolerances of the material are used by the model (and restored for the calling one, e.g. in a multiphase model)
+    const tolerances *tol_previous = tolerances::set_current(&rve.sptr_matprops->tol);
+    //The constants derived from the props are built at the first call of the model after an update of the material
+    if ((rve.sptr_matprops->sptr_constants_M == NULL)&&(rve.sptr_matprops->init_M != NULL)) {
+        rve.sptr_matprops->sptr_constants_M = rve.sptr_matprops->init_M(rve.sptr_matprops->props);
+    }
+    const material_constants *constants_previous = material_constants::set_current(rve.sptr_matprops->sptr_constants_M.get());
+    substep_umat<state_variables_M>(rve, rve.sptr_matprops->umat_M, DR, Time, DTime, ndi, nshr, start, solver_type, tnew_dt);
+    material_constants::set_current(constants_previous);
+    tolerances::set_current(tol_previous);
+    rve.local2global();
 
 }
     
@@ -0,0 +1,88 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file Tcmaes.cpp
+///@brief Test for the CMA-ES that samples the offsprings of the identification
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "cmaes"
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <stdlib.h>
+#include <armadillo>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Identification/parameters.hpp>
+#include <smartplus/Libraries/Identification/generation.hpp>
+#include <smartplus/Libraries/Identification/cmaes.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace smart;
+
+//Minimizes the distance to a target with the CMA-ES, from the middle of the bounds [0,10]^n. Returns the best cost,
+//and checks that every individual sampled is within the bounds
+static double minimize(const vec &target, const int &niter, vec &p_best)
+{
+    int n_param = target.n_elem;
+    int lambda = 10;
+    vector<parameters> params(n_param);
+    for (int i=0; i<n_param; i++)
+        params[i] = parameters(i, 0., 10.);
+
+    srand(42);
+    cmaes cma(params, lambda, 0.3);
+    int id0 = 0;
+    int idnumber = 1;
+    generation gensons(lambda, n_param, id0);
+    double best = datum::inf;
+    for (int k=0; k<niter; k++) {
+        cma.sample(gensons, idnumber);
+        for (int i=0; i<lambda; i++) {
+            BOOST_REQUIRE(gensons.pop[i].p.min() >= 0.);
+            BOOST_REQUIRE(gensons.pop[i].p.max() <= 10.);
+            gensons.pop[i].cout = sum(square(gensons.pop[i].p - target));
+            if (gensons.pop[i].cout < best) {
+                best = gensons.pop[i].cout;
+                p_best = gensons.pop[i].p;
+            }
+        }
+        cma.update(gensons);
+    }
+    BOOST_CHECK_EQUAL(cma.niter, niter);
+    BOOST_CHECK_EQUAL(idnumber, 1 + niter*lambda);
+    return best;
+}
+
+BOOST_AUTO_TEST_CASE( optimum_within_bounds )
+{
+    vec target = {2., 3., 4., 5., 6.};
+    vec p_best;
+    double best = minimize(target, 200, p_best);
+    BOOST_CHECK_SMALL(best, 1.E-8);
+}
+
+BOOST_AUTO_TEST_CASE( optimum_out_of_bounds )
+{
+    //The last component of the target is above its maximal value : the best individual is on the bound
+    vec target = {2., 3., 4., 5., 12.};
+    vec p_best;
+    double best = minimize(target, 200, p_best);
+    BOOST_CHECK_CLOSE(best, 4., 1.E-2);
+    BOOST_CHECK_CLOSE(p_best(4), 10., 1.E-3);
+}
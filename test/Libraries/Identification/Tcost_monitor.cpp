@@ -0,0 +1,173 @@
+/* This file is part of SMART+.
+ 
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file Tcost_monitor.cpp
+///@brief Test for the cost function accumulated during the simulations
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "cost_monitor"
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <fstream>
+#include <string>
+#include <armadillo>
+#include <boost/filesystem.hpp>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Identification/parameters.hpp>
+#include <smartplus/Libraries/Identification/constants.hpp>
+#include <smartplus/Libraries/Identification/individual.hpp>
+#include <smartplus/Libraries/Identification/opti_data.hpp>
+#include <smartplus/Libraries/Identification/optimize.hpp>
+#include <smartplus/Libraries/Identification/cost_monitor.hpp>
+#include <smartplus/Libraries/Identification/script.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace smart;
+
+BOOST_AUTO_TEST_CASE( streaming_cost )
+{
+    //Two experimental files of 4 points with 2 informations, compared with the fields 5 and 7 of the records
+    int nfiles = 2;
+    vector<opti_data> data_exp(nfiles, opti_data(4, 2));
+    vector<opti_data> data_num(nfiles, opti_data(4, 2));
+    for (int i=0; i<nfiles; i++) {
+        data_exp[i].data = randu(4,2);
+        data_num[i].c_data = {5, 7};
+    }
+    int sizev = 16;
+    vec vexp = calcV(data_exp, data_exp, nfiles, sizev);
+    vec W = 1. + randu(sizev);
+    
+    //The records of a simulation : the numerical data are the fields 5 and 7
+    vector<mat> records(nfiles);
+    for (int i=0; i<nfiles; i++) {
+        records[i] = randu(8, 4);
+        data_num[i].data = records[i].rows(5,7).t();
+        data_num[i].data.shed_col(1);
+    }
+    vec vnum = calcV(data_num, data_exp, nfiles, sizev);
+    double cost_ref = calcC(vexp, vnum, W);
+    
+    //Without a bound, the cost of all the records is the one of calc_cost
+    cost_monitor monitor(W, data_num, data_exp, nfiles);
+    monitor.reset();
+    for (int i=0; i<nfiles; i++) {
+        monitor.begin(i);
+        for (int a=0; a<4; a++) {
+            BOOST_CHECK(monitor.check(records[i].col(a)));
+        }
+    }
+    BOOST_CHECK_CLOSE(monitor.cost, cost_ref, 1.E-9);
+    
+    //With a bound below the cost of the first point, the first record stops the simulation
+    cost_monitor bounded(W, data_num, data_exp, nfiles);
+    double cost_first = 0.;
+    for (int l=0; l<2; l++) {
+        cost_first += pow(data_exp[0].data(0,l) - records[0](data_num[0].c_data(l), 0), 2.)*W(l*4);
+    }
+    bounded.reset(0.5*cost_first);
+    BOOST_CHECK(!bounded.check(records[0].col(0)));
+    BOOST_CHECK_CLOSE(bounded.cost, cost_first, 1.E-9);
+    
+    //The records beyond the experimental data do not count
+    bounded.reset();
+    for (int a=0; a<4; a++) {
+        bounded.check(records[0].col(a));
+    }
+    double cost_file = bounded.cost;
+    BOOST_CHECK(bounded.check(randu(8)));
+    BOOST_CHECK_CLOSE(bounded.cost, cost_file, 1.E-9);
+}
+
+//Input files of a uniaxial tension of an isotropic elastic material, whose Young modulus is the parameter @0p
+static void write_inputs(const string &path_data, const string &path_keys, const string &format)
+{
+    boost::filesystem::create_directories(path_data);
+    boost::filesystem::create_directories(path_keys);
+    
+    ofstream essentials(path_data + "/solver_essentials.inp", ios::out);
+    essentials << "Solver_type_0_Newton_tangent_1_RNL\n0\n";
+    essentials.close();
+    
+    ofstream control(path_data + "/solver_control.inp", ios::out);
+    control << "div_tnew_dt_solver\t0.5\nmul_tnew_dt_solver\t2\nminiter_solver\t10\nmaxiter_solver\t100\n";
+    control << "inforce_solver\t1\nprecision_solver\t1.E-6\nlambda_solver\t10000.\n";
+    control.close();
+    
+    ofstream output(path_data + "/output.dat", ios::out);
+    output << "#Outpout_values\nMeca\t6\n0\t1\t2\t3\t4\t5\nT\t1\n\nNumber_of_wanted_internal_variables\t0\n\n";
+    output << "#Block\t#type_1_N_2_T\t#every\n1\t1\t1\n" << format;
+    output.close();
+    
+    ofstream path(path_data + "/path_id_1.txt", ios::out);
+    path << "#Initial_temperature\n293.15\n#Number_of_blocks\n1\n\n#Block\n1\n#Loading_type\n1\n#Repeat\n1\n#Steps\n1\n\n";
+    path << "#Mode\n1\n#Dn_init 1.\n#Dn_mini 0.02\n#Dn_inc 0.02\n#time\n1\n#Consigne\nE 0.01\nS 0 S 0\nS 0 S 0 S 0\n#Consigne_T\nT 293.15\n";
+    path.close();
+    
+    ofstream material(path_keys + "/material.dat", ios::out);
+    material << "Material\nName\tELISO\nNumber_of_material_parameters\t3\nNumber_of_internal_variables\t1\n\n";
+    material << "#Orientation\npsi\t0\ntheta\t0\nphi\t0\n\n#Mechanical\nE\t@0p\nnu\t0.3\nalpha\t0\n";
+    material.close();
+}
+
+BOOST_AUTO_TEST_CASE( launch_solver_monitor )
+{
+    //The files of the results are complete when the solver returns, although the monitor keeps the backend that wrote them
+    string path_data = "Tcost_monitor/data";
+    string path_keys = "Tcost_monitor/keys";
+    string folder = "Tcost_monitor/num_data";
+    boost::filesystem::create_directories(folder);
+    
+    //sigma_11 (field 14 of the records) of the 50 increments compared with 50 experimental points
+    int nfiles = 1;
+    int sizev = 50;
+    vector<opti_data> data_exp(nfiles, opti_data(50, 1));
+    data_exp[0].data = linspace(0., 350., 50);
+    vector<opti_data> data_num(nfiles, opti_data(50, 1));
+    data_num[0].c_data = {14};
+    data_num[0].ncolumns = 24;
+    vec vexp = calcV(data_exp, data_exp, nfiles, sizev);
+    vec W = ones(sizev);
+    vec vnum = zeros(sizev);
+    
+    vector<parameters> params(1);
+    params[0] = parameters(0, 50000., 90000., "@0p", 1, {"material.dat"});
+    vector<constants> consts;
+    individual ind(1, 1, 0.);
+    ind.p(0) = 70000.;
+    
+    vector<string> formats = {"", "Async 1\n"};
+    for (auto format : formats) {
+        write_inputs(path_data, path_keys, format);
+        run_simulation("SOLVE", ind, nfiles, params, consts, data_num, folder, "simul.txt", path_data, path_keys, "material.dat");
+        BOOST_REQUIRE_EQUAL(data_num[0].ndata, 50);
+        double cost_ref = calc_cost(vexp, vnum, W, data_num, data_exp, nfiles, sizev);
+        
+        std::shared_ptr<cost_monitor> monitor = std::make_shared<cost_monitor>(W, data_num, data_exp, nfiles);
+        monitor->reset();
+        run_simulation("SOLVE", ind, nfiles, params, consts, data_num, folder, "simul.txt", path_data, path_keys, "material.dat", monitor);
+        BOOST_CHECK(!monitor->stopped);
+        BOOST_CHECK(!monitor->sptr_backend);
+        BOOST_REQUIRE_EQUAL(data_num[0].ndata, 50);
+        double cost = calc_cost(vexp, vnum, W, data_num, data_exp, nfiles, sizev);
+        BOOST_CHECK_CLOSE(cost, cost_ref, 1.E-9);
+        BOOST_CHECK_CLOSE(monitor->cost, cost_ref, 1.E-3);
+    }
+}
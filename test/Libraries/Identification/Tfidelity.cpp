@@ -0,0 +1,134 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file Tfidelity.cpp
+///@brief Test for the screening of the individuals with cheaper solver controls, and for the state of the simulations run at the same time
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "fidelity"
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <string>
+#include <thread>
+#include <armadillo>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Phase/tolerances.hpp>
+#include <smartplus/Libraries/Homogenization/ellipsoid_multi.hpp>
+#include <smartplus/Libraries/Identification/read.hpp>
+#include <smartplus/Libraries/Solver/read.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace smart;
+
+BOOST_AUTO_TEST_CASE( read_fidelity_file )
+{
+    //Without the file, every individual is evaluated with the full controls
+    string screenfile;
+    int top = -1;
+    read_fidelity(screenfile, top, ".", "Tfidelity_none.inp");
+    BOOST_CHECK_EQUAL(screenfile, "");
+    BOOST_CHECK_EQUAL(top, 0);
+
+    ofstream fidelity("Tfidelity.inp", ios::out);
+    fidelity << "screen\tsolver_screen.inp\n";
+    fidelity << "top\t3\n";
+    fidelity.close();
+    read_fidelity(screenfile, top, ".", "Tfidelity.inp");
+    BOOST_CHECK_EQUAL(screenfile, "solver_screen.inp");
+    BOOST_CHECK_EQUAL(top, 3);
+}
+
+BOOST_AUTO_TEST_CASE( bounded_points )
+{
+    ellipsoid_multi::set_points(10, 12);
+    BOOST_CHECK_EQUAL(ellipsoid_multi::mp, 10);
+    BOOST_CHECK_EQUAL(ellipsoid_multi::np, 12);
+    BOOST_CHECK_EQUAL(ellipsoid_multi::x.n_elem, 10);
+    BOOST_CHECK_EQUAL(ellipsoid_multi::wy.n_elem, 12);
+
+    ellipsoid_multi::set_points(10, 12, 4);
+    BOOST_CHECK_EQUAL(ellipsoid_multi::mp, 4);
+    BOOST_CHECK_EQUAL(ellipsoid_multi::np, 4);
+    BOOST_CHECK_EQUAL(ellipsoid_multi::x.n_elem, 4);
+    BOOST_CHECK_EQUAL(ellipsoid_multi::y.n_elem, 4);
+
+    //A bound above the numbers of points of the props leaves them
+    ellipsoid_multi::set_points(3, 5, 8);
+    BOOST_CHECK_EQUAL(ellipsoid_multi::mp, 3);
+    BOOST_CHECK_EQUAL(ellipsoid_multi::np, 5);
+}
+
+BOOST_AUTO_TEST_CASE( screening_tolerances )
+{
+    //The tolerances of a screening control file change the global defaults : they are restored after the screened simulation (see launch_solver)
+    ofstream control("Tfidelity_screen.inp", ios::out);
+    control << "div_tnew_dt_solver\t0.5\n";
+    control << "mul_tnew_dt_solver\t2\n";
+    control << "miniter_solver\t10\n";
+    control << "maxiter_solver\t100\n";
+    control << "inforce_solver\t1\n";
+    control << "precision_solver\t1.E-4\n";
+    control << "lambda_solver\t10000.\n";
+    control << "precision_umat\t1.E-4\n";
+    control << "points_micro\t4\n";
+    control.close();
+
+    tolerances tol_defaults = tolerances::defaults();
+    double div_tnew_dt_solver = 0.;
+    double mul_tnew_dt_solver = 0.;
+    int miniter_solver = 0;
+    int maxiter_solver = 0;
+    int inforce_solver = 0;
+    double precision_solver = 0.;
+    double lambda_solver = 0.;
+    solver_control(div_tnew_dt_solver, mul_tnew_dt_solver, miniter_solver, maxiter_solver, inforce_solver, precision_solver, lambda_solver, ".", "Tfidelity_screen.inp");
+    BOOST_CHECK_EQUAL(tolerances::defaults().micro_points, 4);
+    BOOST_CHECK_CLOSE(tolerances::defaults().umat_precision, 1.E-4, 1.E-9);
+
+    tolerances::defaults() = tol_defaults;
+    BOOST_CHECK_EQUAL(tolerances::defaults().micro_points, points_micro);
+    BOOST_CHECK_CLOSE(tolerances::defaults().umat_precision, precision_umat, 1.E-9);
+    BOOST_CHECK_EQUAL(tolerances::defaults().umat_maxiter, maxiter_umat);
+}
+
+BOOST_AUTO_TEST_CASE( state_per_thread )
+{
+    //The individuals of a population are simulated by several threads : the integration points and the tolerances set by the solver
+    //controls of one simulation do not change the ones of the others
+    ellipsoid_multi::set_points(10, 12);
+    tolerances tol_defaults = tolerances::defaults();
+
+    int mp_thread = 0;
+    int micro_points_thread = 0;
+    std::thread worker([&]() {
+        ellipsoid_multi::set_points(10, 12, 4);
+        tolerances::defaults().micro_points = 4;
+        mp_thread = ellipsoid_multi::mp;
+        micro_points_thread = tolerances::defaults().micro_points;
+    });
+    worker.join();
+
+    BOOST_CHECK_EQUAL(mp_thread, 4);
+    BOOST_CHECK_EQUAL(micro_points_thread, 4);
+    BOOST_CHECK_EQUAL(ellipsoid_multi::mp, 10);
+    BOOST_CHECK_EQUAL(ellipsoid_multi::np, 12);
+    BOOST_CHECK_EQUAL(ellipsoid_multi::x.n_elem, 10);
+    BOOST_CHECK_EQUAL(tolerances::defaults().micro_points, tol_defaults.micro_points);
+}
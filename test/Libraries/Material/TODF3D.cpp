@@ -0,0 +1,103 @@
+/* This file is part of SMART+.
+ 
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file TODF3D.cpp
+///@brief Test for the orientation distribution functions over the three Euler angles
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "ODF3D"
+#include <boost/test/unit_test.hpp>
+
+#include <armadillo>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Material/peak.hpp>
+#include <smartplus/Libraries/Material/ODF3D.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace smart;
+
+BOOST_AUTO_TEST_CASE( misorientations )
+{
+    double alpha = 0.4;
+    BOOST_CHECK_SMALL( misorientation(0.3, 0.5, 0.2, 0.3, 0.5, 0.2), 1.E-6 );
+    BOOST_CHECK_CLOSE( misorientation(0., 0., 0., alpha, 0., 0.), alpha, 1.E-6 );
+    //psi and phi rotate around the same axis when theta is null
+    BOOST_CHECK_SMALL( misorientation(alpha, 0., 0., 0., 0., alpha), 1.E-6 );
+
+    mat angles = {{0.3, 0.3, 1.2}, {0.5, 0.5, 0.1}, {0.2, 0.2, 2.}};
+    vec weights = {0.2, 0.3, 0.5};
+    reduce_orientations(angles, weights, 1.E-3);
+    BOOST_CHECK_EQUAL( weights.n_elem, 2 );
+    BOOST_CHECK_CLOSE( accu(weights), 1., 1.E-9 );
+    BOOST_CHECK_CLOSE( weights(0), 0.5, 1.E-9 );
+}
+
+BOOST_AUTO_TEST_CASE( sampling )
+{
+    //Uniform ODF : the integral is the volume of the orientations, 8 pi^2
+    peak uniform(1, 7, 0., 1., 1., 1., zeros(1), zeros(1));
+    ODF3D odf_uniform(12, 12, 12);
+    odf_uniform.add_component(uniform, 0., 0., 0.);
+    odf_uniform.construct();
+    BOOST_CHECK_CLOSE( odf_uniform.norm, 8.*pi*pi, 1.E-6 );
+    
+    //Sharp texture component : the samples gather around its orientation
+    double psi = 1., theta = 0.8, phi = 2.;
+    peak gauss(1, 3, 0., 0.15, 0., 1., zeros(1), zeros(1));
+    ODF3D odf(36, 18, 36);
+    odf.add_component(gauss, psi, theta, phi);
+    
+    for (int method=0; method<2; method++) {
+        mat angles;
+        vec weights;
+        odf.sample(angles, weights, 500, method);
+        BOOST_CHECK_EQUAL( angles.n_cols, 500 );
+        BOOST_CHECK_CLOSE( accu(weights), 1., 1.E-9 );
+        
+        double mean_misorientation = 0.;
+        for (unsigned int i=0; i<weights.n_elem; i++) {
+            mean_misorientation += weights(i)*misorientation(angles(0,i), angles(1,i), angles(2,i), psi, theta, phi);
+        }
+        BOOST_CHECK( mean_misorientation < 0.5 );
+        
+        //The equal-weight samples share the cells of the grid : the phases are the distinct orientations
+        reduce_orientations(angles, weights, 0.);
+        BOOST_CHECK( weights.n_elem <= 500 );
+        BOOST_CHECK_CLOSE( accu(weights), 1., 1.E-6 );
+        if (method == 0)
+            BOOST_CHECK( weights.n_elem < 500 );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( vectorized_densities )
+{
+    //The densities evaluated on a vector match the pointwise ones
+    vec theta = linspace(-pi/2., pi/2., 41);
+    for (int method=3; method<=4; method++) {
+        peak p(1, method, 0.3, 0.2, 0.25, 1.5, zeros(1), zeros(1));
+        vec d_ODF = p.get_density_ODF(theta);
+        vec d_PDF = p.get_density_PDF(theta);
+        double err = 0.;
+        for (unsigned int i=0; i<theta.n_elem; i++) {
+            err += fabs(d_ODF(i) - p.get_density_ODF(theta(i)));
+            err += fabs(d_PDF(i) - p.get_density_PDF(theta(i)));
+        }
+        BOOST_CHECK_SMALL( err, 1.E-10 );
+    }
+}
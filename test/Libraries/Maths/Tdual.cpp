@@ -0,0 +1,106 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file Tdual.cpp
+///@brief Test for the dual numbers and the tangent of a return mapping
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "dual"
+#include <boost/test/unit_test.hpp>
+
+#include <armadillo>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Maths/dual.hpp>
+#include <smartplus/Libraries/Continuum_Mechanics/contimech.hpp>
+#include <smartplus/Libraries/Continuum_Mechanics/constitutive.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace smart;
+
+//Linear elasticity
+struct elastic_law {
+    mat L;
+    dual_vec<6> operator()(const dual_vec<6> &E) const {
+        return L*E;
+    }
+};
+
+//Mises plasticity with a linear isotropic hardening, radial return from a virgin state
+struct plastic_law {
+    mat L;
+    double G;
+    double sigmaY;
+    double H;
+    dual_vec<6> operator()(const dual_vec<6> &E) const {
+        dual_vec<6> sigma = L*E;
+        dual<6> f = Mises_stress(sigma) - sigmaY;
+        if (f > 0.) {
+            dual<6> dp = f/(3.*G + H);
+            sigma = sigma - L*(dp*eta_stress(sigma));
+        }
+        return sigma;
+    }
+};
+
+BOOST_AUTO_TEST_CASE( scalar )
+{
+    double x0 = 0.7;
+    double y0 = 1.3;
+    dual<2> x(x0, 0);
+    dual<2> y(y0, 1);
+    dual<2> f = x*y + sin(x)/y - 2.*exp(y) + sqrt(x);
+
+    BOOST_CHECK_CLOSE(f.val, x0*y0 + sin(x0)/y0 - 2.*exp(y0) + sqrt(x0), 1.E-9);
+    BOOST_CHECK_CLOSE(f.d[0], y0 + cos(x0)/y0 + 0.5/sqrt(x0), 1.E-9);
+    BOOST_CHECK_CLOSE(f.d[1], x0 - sin(x0)/(y0*y0) - 2.*exp(y0), 1.E-9);
+}
+
+BOOST_AUTO_TEST_CASE( voigt )
+{
+    vec v = {1., -2., 4., 0.5, -1.5, 3.};
+    dual_vec<6> a = constant_voigt<6>(v);
+
+    BOOST_CHECK_CLOSE(tr(a).val, tr(v), 1.E-9);
+    BOOST_CHECK_CLOSE(Mises_stress(a).val, Mises_stress(v), 1.E-9);
+    BOOST_CHECK_CLOSE(Mises_strain(a).val, Mises_strain(v), 1.E-9);
+    BOOST_CHECK_SMALL(norm(value<6>(eta_stress(a)) - eta_stress(v), 2), 1.E-9);
+    BOOST_CHECK_SMALL(norm(value<6>(dev(a)) - dev(v), 2), 1.E-9);
+}
+
+BOOST_AUTO_TEST_CASE( tangent )
+{
+    double E = 70000.;
+    double nu = 0.3;
+    vec Etot = {0.01, -0.003, -0.003, 0.002, 0.001, 0.};
+
+    elastic_law el;
+    el.L = L_iso(E, nu, "Enu");
+    BOOST_CHECK_SMALL(norm(tangent_dual(el, Etot) - el.L, "fro"), 1.E-9);
+
+    plastic_law pl;
+    pl.L = el.L;
+    pl.G = E/(2.*(1.+nu));
+    pl.sigmaY = 300.;
+    pl.H = 1000.;
+
+    //The state is plastic : the tangent differs from the elastic one and matches finite differences
+    mat Lt = tangent_dual(pl, Etot);
+    BOOST_CHECK(norm(Lt - pl.L, "fro") > 1.E3);
+    BOOST_CHECK_SMALL(check_tangent(pl, Etot), 1.E-5);
+}
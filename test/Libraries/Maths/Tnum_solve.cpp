@@ -0,0 +1,130 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file Tnum_solve.cpp
+///@brief Test for the solvers of the complementarity problems
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "num_solve"
+#include <boost/test/unit_test.hpp>
+
+#include <armadillo>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Phase/tolerances.hpp>
+#include <smartplus/Libraries/Maths/num_solve.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace smart;
+
+BOOST_AUTO_TEST_CASE( lu )
+{
+    mat A = {{0., 2., 1.}, {3., 1., -1.}, {1., -1., 4.}};
+    vec b = {1., 2., 3.};
+    vec x;
+    BOOST_CHECK(lu_solve(A, b, x));
+    BOOST_CHECK_SMALL(norm(A*x - b, 2), 1.E-12);
+
+    mat S = {{1., 2.}, {2., 4.}};
+    vec c = {1., 1.};
+    BOOST_CHECK(!lu_solve(S, c, x));
+}
+
+BOOST_AUTO_TEST_CASE( fischer_burmeister_sentinel )
+{
+    //Three mechanisms : the first one is active, the second one has Phi = Dp = 0 (large diagonal term of the system),
+    //the third one is inactive. The pivots of the inactive row must not be compared with the large diagonal term
+    mat denom = {{-1000., -200., 0.}, {-200., -800., 0.}, {0., 0., -500.}};
+    vec Phi = {500., 0., -100.};
+    vec Y_crit = {100., 100., 100.};
+    vec Dp = zeros(3);
+    vec dp;
+    double error = 0.;
+    Fischer_Burmeister_m(Phi, Y_crit, denom, Dp, dp, error);
+
+    //First row : FB = 2*Phi_0, dFB/dDp_0 = 2*denom_00 - |denom_00|
+    BOOST_CHECK_CLOSE(Dp(0), 1./3., 1.E-9);
+    BOOST_CHECK_SMALL(Dp(1), 1.E-12);
+    BOOST_CHECK_SMALL(Dp(2), 1.E-12);
+    BOOST_CHECK_CLOSE(error, 10., 1.E-9);
+}
+
+BOOST_AUTO_TEST_CASE( complementarity )
+{
+    //Radial return with a saturating hardening : Phi = sigma_trial - 3G*Dp - sigmaY - Q*(1-exp(-b*Dp))
+    double G = 26923.;
+    double sigmaY = 300.;
+    double Q = 200.;
+    double b = 50.;
+    double sigma_trial = 900.;
+
+    auto residual = [&](const vec &Dp, vec &Phi, mat &denom) {
+        Phi = zeros(1);
+        denom = zeros(1,1);
+        Phi(0) = sigma_trial - 3.*G*Dp(0) - sigmaY - Q*(1.-exp(-b*Dp(0)));
+        denom(0,0) = -3.*G - Q*b*exp(-b*Dp(0));
+    };
+    vec Y_crit = {sigmaY};
+
+    vec Dp = zeros(1);
+    complementarity_stats stats = complementarity_solve(residual, Y_crit, Dp);
+    BOOST_CHECK(stats.converged);
+    BOOST_CHECK(stats.niter > 0);
+    BOOST_CHECK(Dp(0) > 0.);
+    BOOST_CHECK_SMALL(sigma_trial - 3.*G*Dp(0) - sigmaY - Q*(1.-exp(-b*Dp(0))), 1.E-6);
+
+    //The tolerances of the material being computed bound the iterations
+    tolerances tol;
+    tol.umat_maxiter = 1;
+    const tolerances *tol_prev = tolerances::set_current(&tol);
+    vec Dp_bounded = zeros(1);
+    complementarity_stats stats_bounded = complementarity_solve(residual, Y_crit, Dp_bounded);
+    tolerances::set_current(tol_prev);
+    BOOST_CHECK_EQUAL(stats_bounded.niter, 1);
+    BOOST_CHECK(!stats_bounded.converged);
+
+    //Warm start from the solution : no iteration is needed
+    complementarity_stats stats_warm = complementarity_solve(residual, Y_crit, Dp);
+    BOOST_CHECK(stats_warm.converged);
+    BOOST_CHECK_EQUAL(stats_warm.niter, 0);
+
+    //Elastic case : the multiplier stays null
+    sigma_trial = 200.;
+    Dp = zeros(1);
+    stats = complementarity_solve(residual, Y_crit, Dp);
+    BOOST_CHECK(stats.converged);
+    BOOST_CHECK_SMALL(Dp(0), 1.E-12);
+}
+
+BOOST_AUTO_TEST_CASE( two_mechanisms )
+{
+    //Two coupled mechanisms, the second one is inactive at the solution
+    mat H = {{-1000., -200.}, {-200., -800.}};
+    vec Phi_0 = {500., -100.};
+    auto residual = [&](const vec &Dp, vec &Phi, mat &denom) {
+        Phi = Phi_0 + H*Dp;
+        denom = H;
+    };
+    vec Y_crit = {100., 100.};
+
+    vec Dp = zeros(2);
+    complementarity_stats stats = complementarity_solve(residual, Y_crit, Dp);
+    BOOST_CHECK(stats.converged);
+    BOOST_CHECK_CLOSE(Dp(0), 0.5, 1.E-4);
+    BOOST_CHECK_SMALL(Dp(1), 1.E-9);
+}
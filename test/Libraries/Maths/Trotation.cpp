@@ -150,3 +150,92 @@ BOOST_AUTO_TEST_CASE( rotation )
     BOOST_CHECK( norm(a1-a3,2) < 1.E-9 );
     
 }
+
+BOOST_AUTO_TEST_CASE( composed_rotation )
+{
+    double psi = 23.*(pi/180.);
+    double theta = 42.*(pi/180.);
+    double phi = 165.*(pi/180.);
+    
+    mat L = randu(6,6);
+    L = L*trans(L) + 6.*eye(6,6);
+    mat A = randu(6,6);
+    vec E = randu(6);
+    vec S = randu(6);
+    
+    //Composed matrices against the successive single-axis rotations
+    euler_Q Q(psi, theta, phi);
+    BOOST_CHECK( norm(rotate_g2l_L(L, Q) - rotate_g2l_L(L, psi, theta, phi),2) < 1.E-9 );
+    BOOST_CHECK( norm(rotate_l2g_L(L, Q) - rotate_l2g_L(L, psi, theta, phi),2) < 1.E-9 );
+    BOOST_CHECK( norm(rotate_g2l_M(L, Q) - rotate_g2l_M(L, psi, theta, phi),2) < 1.E-9 );
+    BOOST_CHECK( norm(rotate_l2g_M(L, Q) - rotate_l2g_M(L, psi, theta, phi),2) < 1.E-9 );
+    BOOST_CHECK( norm(rotate_g2l_A(A, Q) - rotate_g2l_A(A, psi, theta, phi),2) < 1.E-9 );
+    BOOST_CHECK( norm(rotate_l2g_A(A, Q) - rotate_l2g_A(A, psi, theta, phi),2) < 1.E-9 );
+    BOOST_CHECK( norm(rotate_g2l_B(A, Q) - rotate_g2l_B(A, psi, theta, phi),2) < 1.E-9 );
+    BOOST_CHECK( norm(rotate_l2g_B(A, Q) - rotate_l2g_B(A, psi, theta, phi),2) < 1.E-9 );
+    BOOST_CHECK( norm(rotate_g2l_strain(E, Q) - rotate_g2l_strain(E, psi, theta, phi),2) < 1.E-9 );
+    BOOST_CHECK( norm(rotate_l2g_strain(E, Q) - rotate_l2g_strain(E, psi, theta, phi),2) < 1.E-9 );
+    BOOST_CHECK( norm(rotate_g2l_stress(S, Q) - rotate_g2l_stress(S, psi, theta, phi),2) < 1.E-9 );
+    BOOST_CHECK( norm(rotate_l2g_stress(S, Q) - rotate_l2g_stress(S, psi, theta, phi),2) < 1.E-9 );
+    
+    //Active convention, as used for the orientation of the materials
+    euler_Q Q_a(psi, theta, phi, true);
+    vec E_a = rotate_strain(rotate_strain(rotate_strain(E, psi, axis_psi), theta, axis_theta), phi, axis_phi);
+    BOOST_CHECK( norm(rotate_g2l_strain(E, Q_a) - E_a,2) < 1.E-9 );
+    BOOST_CHECK( norm(rotate_l2g_strain(E_a, Q_a) - E,2) < 1.E-9 );
+    mat F = randu(3,3);
+    mat F_a = rotate_mat(rotate_mat(rotate_mat(F, psi, axis_psi), theta, axis_theta), phi, axis_phi);
+    BOOST_CHECK( norm(rotate_mat(F, Q_a.R_g2l) - F_a,2) < 1.E-9 );
+    BOOST_CHECK( norm(rotate_mat(F_a, Q_a.R_l2g) - F,2) < 1.E-9 );
+    
+    //The kernel may write in its input
+    mat L_r = L;
+    rotate_voigt(L_r, Q.QS_g2l, L_r, Q.QS_g2l);
+    BOOST_CHECK( norm(L_r - rotate_g2l_L(L, psi, theta, phi),2) < 1.E-9 );
+    
+    //The matrices follow the angles, and are the identity for null angles
+    Q.set(0., 0., 0.);
+    BOOST_CHECK( Q.identity );
+    BOOST_CHECK( norm(rotate_g2l_L(L, Q) - L,2) < 1.E-12 );
+    Q.set(phi, theta, psi);
+    BOOST_CHECK( norm(rotate_g2l_L(L, Q) - rotate_g2l_L(L, phi, theta, psi),2) < 1.E-9 );
+}
+
+BOOST_AUTO_TEST_CASE( batch_rotation )
+{
+    //Enough orientations to be split between threads
+    int N = 600;
+    vec psi = 2.*pi*randu(N);
+    vec theta = pi*randu(N);
+    vec phi = 2.*pi*randu(N);
+    
+    mat L = randu(6,6);
+    L = L*trans(L) + 6.*eye(6,6);
+    vec E = randu(6);
+    mat S = randu(6,N);
+    
+    rotation_batch rb(psi, theta, phi);
+    cube L_g2l = rb.rotate_g2l_L(L);
+    cube L_l2g = rb.rotate_l2g_L(L_g2l);
+    cube M_l2g = rb.rotate_l2g_M(L);
+    mat E_g2l = rb.rotate_g2l_strain(E);
+    mat S_l2g = rb.rotate_l2g_stress(S);
+    
+    double err = 0.;
+    for (int n=0; n<N; n++) {
+        err += norm(L_g2l.slice(n) - rotate_g2l_L(L, psi(n), theta(n), phi(n)),2);
+        err += norm(L_l2g.slice(n) - L,2);
+        err += norm(M_l2g.slice(n) - rotate_l2g_M(L, psi(n), theta(n), phi(n)),2);
+        err += norm(E_g2l.col(n) - rotate_g2l_strain(E, psi(n), theta(n), phi(n)),2);
+        err += norm(S_l2g.col(n) - rotate_l2g_stress(S.col(n), psi(n), theta(n), phi(n)),2);
+    }
+    BOOST_CHECK( err < 1.E-8 );
+    
+    //Quaternion of a rotation of alpha around the axis 3
+    double alpha = 0.7;
+    mat q = {cos(alpha/2.), 0., 0., sin(alpha/2.)};
+    q = trans(q);
+    rotation_batch rb_q(q);
+    BOOST_CHECK( norm(rb_q.rotate_g2l_L(L).slice(0) - rotateL(L, alpha, 3),2) < 1.E-9 );
+    BOOST_CHECK( norm(rb_q.rotate_g2l_strain(E).col(0) - rotate_strain(E, alpha, 3),2) < 1.E-9 );
+}
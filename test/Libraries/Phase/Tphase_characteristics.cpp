@@ -26,10 +26,15 @@
 #include <fstream>
 #include <iterator>
 #include <armadillo>
+#include <boost/filesystem.hpp>
 #include <smartplus/parameter.hpp>
 #include <smartplus/Libraries/Phase/phase_characteristics.hpp>
+#include <smartplus/Libraries/Phase/state_variables_M.hpp>
+#include <smartplus/Libraries/Phase/phase_arena.hpp>
 #include <smartplus/Libraries/Phase/read.hpp>
 #include <smartplus/Libraries/Phase/write.hpp>
+#include <smartplus/Libraries/Continuum_Mechanics/constitutive.hpp>
+#include <smartplus/Umat/umat_L_elastic.hpp>
 
 using namespace std;
 using namespace arma;
@@ -138,3 +143,118 @@ BOOST_AUTO_TEST_CASE( read_write )
     BOOST_CHECK_EQUAL_COLLECTIONS(b1_cylinder, e1_cylinder, b2_cylinder, e2_cylinder);
     
 }
+
+BOOST_AUTO_TEST_CASE( arena )
+{
+    string umat_name;
+    string path_data = "data";
+    vec props = {2,0};
+    
+    phase_characteristics rve;
+    rve.sptr_matprops->update(0, umat_name, 1, 0., 0., 0., props.n_elem, props);
+    rve.construct(0,1);
+    read_phase(rve, path_data, "Nphases0.dat");
+    
+    //Two levels : the second sub-phase is itself made of two phases
+    rve.sub_phases[1].sptr_matprops->update(1, umat_name, 1, 0., 0., 0., props.n_elem, props);
+    read_phase(rve.sub_phases[1], path_data, "Nphases0.dat");
+    
+    phase_arena pa(rve);
+    BOOST_CHECK_EQUAL(pa.size(), 5);
+    BOOST_CHECK_EQUAL(pa.parent(0), -1);
+    BOOST_CHECK_EQUAL(pa.nchildren(0), 2);
+    BOOST_CHECK_EQUAL(pa.first_child(0), 1);
+    BOOST_CHECK_EQUAL(pa.nchildren(2), 2);
+    BOOST_CHECK_EQUAL(pa.first_child(2), 3);
+    BOOST_CHECK_EQUAL(pa.parent(4), 2);
+    BOOST_CHECK_EQUAL(pa.depth(4), 2);
+    BOOST_CHECK(&pa(4) == &rve.sub_phases[1].sub_phases[1]);
+    
+    int nleaves = 0;
+    pa.visit_leaves([&nleaves](phase_characteristics &, const int &) { nleaves++; });
+    BOOST_CHECK_EQUAL(nleaves, 3);
+    
+    double sum_c = 0.;
+    pa.visit_children(2, [&sum_c](phase_characteristics &r, const int &) { sum_c += r.sptr_shape->concentration; });
+    BOOST_CHECK_CLOSE(sum_c, 1., 1.E-9);
+    
+    //The visitor works on the phases of the tree, not on copies
+    pa.visit([](phase_characteristics &r, const int &i) { r.sptr_matprops->number = 10*i; });
+    BOOST_CHECK_EQUAL(rve.sub_phases[1].sub_phases[0].sptr_matprops->number, 30);
+}
+
+BOOST_AUTO_TEST_CASE( start_values )
+{
+    phase_characteristics rve;
+    rve.construct(0,1);
+    rve.sptr_sv_global->update(zeros(6), zeros(6), zeros(6), zeros(6), eye(3,3), eye(3,3), 293.15, 0., 2, zeros(2), zeros(2));
+    rve.sptr_sv_local->update(zeros(6), zeros(6), zeros(6), zeros(6), eye(3,3), eye(3,3), 293.15, 0., 2, zeros(2), zeros(2));
+    rve.sub_phases_construct(2, 2, 1);
+    for (auto &r : rve.sub_phases) {
+        r.sptr_sv_global->update(zeros(6), zeros(6), zeros(6), zeros(6), eye(3,3), eye(3,3), 293.15, 0., 1, zeros(1), zeros(1));
+        r.sptr_sv_local->update(zeros(6), zeros(6), zeros(6), zeros(6), eye(3,3), eye(3,3), 293.15, 0., 1, zeros(1), zeros(1));
+        r.sptr_multi->A = eye(6,6);
+        r.sptr_multi->B = eye(6,6);
+    }
+    BOOST_CHECK(!rve.at_start);
+
+    //Commit of the current values
+    rve.sptr_sv_global->statev(0) = 1.;
+    rve.sub_phases[1].sptr_sv_global->statev(0) = 2.;
+    rve.set_start();
+    BOOST_CHECK(rve.at_start);
+    BOOST_CHECK_CLOSE(rve.sub_phases[1].sptr_sv_global->statev_start(0), 2., 1.E-12);
+
+    //Rollback after a write, as made by a umat : every phase goes back to its start values, whatever the flags of the sub-phases
+    rve.at_start = false;
+    rve.sptr_sv_global->statev(0) = 3.;
+    rve.sub_phases[1].sptr_sv_global->statev(0) = 4.;
+    rve.sub_phases[1].sptr_multi->A = ones(6,6);
+    rve.to_start();
+    BOOST_CHECK(rve.at_start);
+    BOOST_CHECK_CLOSE(rve.sptr_sv_global->statev(0), 1., 1.E-12);
+    BOOST_CHECK_CLOSE(rve.sub_phases[1].sptr_sv_global->statev(0), 2., 1.E-12);
+    BOOST_CHECK(norm(rve.sub_phases[1].sptr_multi->A - eye(6,6), 2) < 1.E-12);
+
+    //A deep copy does not assume anything on its state
+    phase_characteristics rve_copy;
+    rve_copy.copy(rve);
+    BOOST_CHECK(!rve_copy.at_start);
+}
+
+BOOST_AUTO_TEST_CASE( path_data )
+{
+    //The phases of a multiphase model are read from the data folder of its material, as the ones of the workers of an identification
+    string path_worker = "data_path_test";
+    boost::filesystem::create_directory(path_worker);
+    ofstream nellipsoids(path_worker + "/Nellipsoids0.dat");
+    nellipsoids << "Number\tCoatingof\tumat\tsave\tc\tpsi_mat\ttheta_mat\tphi_mat\ta1\ta2\ta3\tpsi_geom\ttheta_geom\tphi_geom\tnprops\tnstatev\tprops\n";
+    nellipsoids << "0\t0\tELISO\t1\t0.8\t0\t0\t0\t1\t1\t1\t0\t0\t0\t3\t1\t6000\t0.4\t0\n";
+    nellipsoids << "1\t0\tELISO\t1\t0.2\t0\t0\t0\t50\t1\t1\t0\t0\t0\t3\t1\t70000\t0.3\t0\n";
+    nellipsoids.close();
+    
+    vec props = {2,0,10,10};
+    std::vector<double> E_matrix = {3000., 6000.};
+    std::vector<string> folders = {"data", path_worker};
+    for (unsigned int i=0; i<folders.size(); i++) {
+        phase_characteristics rve;
+        rve.sptr_matprops->update(0, "MIHEN", 1, 0., 0., 0., props.n_elem, props);
+        rve.sptr_matprops->path_data = folders[i];
+        rve.construct(0,1);
+        rve.sptr_sv_global->update(zeros(6), zeros(6), zeros(6), zeros(6), zeros(3,3), zeros(3,3), 293.15, 0., 0, zeros(0), zeros(0));
+        get_L_elastic(rve);
+        
+        //The sub-phases keep the folder they were read from
+        for (auto &r : rve.sub_phases) {
+            BOOST_CHECK_EQUAL(r.sptr_matprops->path_data, folders[i]);
+        }
+        phase_characteristics rve_copy;
+        rve_copy.copy(rve);
+        BOOST_CHECK_EQUAL(rve_copy.sptr_matprops->path_data, folders[i]);
+        
+        auto sv_M = std::dynamic_pointer_cast<state_variables_M>(rve.sptr_sv_global);
+        mat Lt = 0.8*L_iso(E_matrix[i], 0.4, "Enu") + 0.2*L_iso(70000., 0.3, "Enu");
+        BOOST_CHECK(norm(sv_M->Lt - Lt,2) < 1.E-6*norm(Lt,2));
+    }
+    boost::filesystem::remove_all(path_worker);
+}
@@ -0,0 +1,147 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file Tcheckpoint.cpp
+///@brief Test for the save and restore of the state of a RVE and of the solver counters
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "checkpoint"
+#include <boost/test/unit_test.hpp>
+
+#include <armadillo>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Phase/phase_characteristics.hpp>
+#include <smartplus/Libraries/Phase/state_variables_M.hpp>
+#include <smartplus/Libraries/Geometry/ellipsoid.hpp>
+#include <smartplus/Libraries/Homogenization/ellipsoid_multi.hpp>
+#include <smartplus/Libraries/Solver/checkpoint.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace smart;
+
+static bool same(const mat &a, const mat &b)
+{
+    return ((a.n_rows == b.n_rows)&&(a.n_cols == b.n_cols)&&(accu(a != b) == 0));
+}
+
+//A RVE made of a matrix and two ellipsoidal inclusions, with arbitrary state variables
+static void build_rve(phase_characteristics &rve)
+{
+    vec props = {2., 1., 20., 20.};
+    rve.construct(0,1);
+    rve.sptr_matprops->update(0, "MIMTN", 1, 0., 0., 0., props.n_elem, props);
+    rve.sptr_sv_global->update(randu(6), randu(6), randu(6), randu(6), randu(3,3), randu(3,3), 293.15, 1., 2, randu(2), randu(2));
+    rve.sptr_sv_local->update(randu(6), randu(6), randu(6), randu(6), randu(3,3), randu(3,3), 293.15, 1., 2, randu(2), randu(2));
+    rve.sv_global<state_variables_M>()->Lt = randu(6,6);
+
+    rve.sub_phases_construct(2, 2, 1);
+    for (auto &r : rve.sub_phases) {
+        vec props_phase = {70000., 0.3, 1.E-5};
+        r.sptr_matprops->update(1, "ELISO", 1, 10., 20., 30., props_phase.n_elem, props_phase);
+        r.sptr_sv_global->update(randu(6), randu(6), randu(6), randu(6), randu(3,3), randu(3,3), 293.15, 0., 1, randu(1), randu(1));
+        r.sptr_sv_local->update(randu(6), randu(6), randu(6), randu(6), randu(3,3), randu(3,3), 293.15, 0., 1, randu(1), randu(1));
+        r.sptr_shape->concentration = 0.25;
+        r.shape<ellipsoid>()->a1 = 2.;
+        r.multi<ellipsoid_multi>()->T = randu(6,6);
+        r.sptr_multi->A = randu(6,6);
+    }
+}
+
+static void check_same(const phase_characteristics &a, const phase_characteristics &b)
+{
+    BOOST_REQUIRE_EQUAL(a.sub_phases.size(), b.sub_phases.size());
+    BOOST_CHECK(same(a.sptr_sv_global->Etot, b.sptr_sv_global->Etot));
+    BOOST_CHECK(same(a.sptr_sv_global->sigma, b.sptr_sv_global->sigma));
+    BOOST_CHECK(same(a.sptr_sv_global->statev, b.sptr_sv_global->statev));
+    BOOST_CHECK(same(a.sptr_sv_local->F1, b.sptr_sv_local->F1));
+    BOOST_CHECK(same(a.sv_global<state_variables_M>()->Lt, b.sv_global<state_variables_M>()->Lt));
+    for (unsigned int i=0; i<a.sub_phases.size(); i++) {
+        const phase_characteristics &ra = a.sub_phases[i];
+        const phase_characteristics &rb = b.sub_phases[i];
+        BOOST_CHECK(same(ra.sptr_sv_global->statev_start, rb.sptr_sv_global->statev_start));
+        BOOST_CHECK(same(ra.sptr_multi->A, rb.sptr_multi->A));
+        BOOST_CHECK(same(ra.multi<ellipsoid_multi>()->T, rb.multi<ellipsoid_multi>()->T));
+        BOOST_CHECK_EQUAL(ra.shape<ellipsoid>()->a1, rb.shape<ellipsoid>()->a1);
+        BOOST_CHECK_EQUAL(ra.sptr_shape->concentration, rb.sptr_shape->concentration);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( rollback )
+{
+    phase_characteristics rve;
+    build_rve(rve);
+    phase_characteristics rve_ref;
+    rve_ref.copy(rve);
+
+    phase_state ps;
+    ps.save(rve);
+    unsigned int nvalues = ps.data.size();
+
+    //Any change of the state is rolled back, bit for bit
+    rve.sptr_sv_global->Etot += 1.;
+    rve.sv_global<state_variables_M>()->Lt.zeros();
+    rve.sub_phases[1].sptr_sv_global->statev_start(0) = -1.;
+    rve.sub_phases[0].multi<ellipsoid_multi>()->T.eye();
+    ps.restore(rve);
+    check_same(rve, rve_ref);
+
+    //The buffer keeps its size when the same RVE is saved again
+    ps.save(rve);
+    BOOST_CHECK_EQUAL(ps.data.size(), nvalues);
+}
+
+BOOST_AUTO_TEST_CASE( save_load )
+{
+    phase_characteristics rve;
+    build_rve(rve);
+    rve.sub_phases[1].sptr_matprops->tol.micro_points = 8;
+
+    solver_checkpoint sc;
+    sc.kblock = 1;
+    sc.kcycle = 42;
+    sc.Time = 123.456789;
+    sc.tnew_dt = 0.5;
+    sc.Dtinc = 0.01;
+    sc.Dtinc_cur = 0.02;
+    sc.error = 1.E-8;
+    sc.residual = randu(6);
+    sc.o_ncount = 3;
+    sc.o_tcount = 0.3;
+    sc.save("Tcheckpoint.bin", rve);
+
+    //The RVE is built again with all its phases
+    solver_checkpoint sc_restart;
+    phase_characteristics rve_restart;
+    BOOST_REQUIRE(sc_restart.load("Tcheckpoint.bin", rve_restart));
+    check_same(rve, rve_restart);
+    BOOST_CHECK_EQUAL(rve_restart.sptr_matprops->umat_name, "MIMTN");
+    BOOST_CHECK(same(rve_restart.sub_phases[0].sptr_matprops->props, rve.sub_phases[0].sptr_matprops->props));
+    BOOST_CHECK_EQUAL(rve_restart.sub_phases[0].sptr_matprops->psi_mat, 10.);
+    BOOST_CHECK_EQUAL(rve_restart.sub_phases[1].sptr_matprops->tol.micro_points, 8);
+
+    BOOST_CHECK_EQUAL(sc_restart.kblock, 1);
+    BOOST_CHECK_EQUAL(sc_restart.kcycle, 42);
+    BOOST_CHECK_EQUAL(sc_restart.Time, sc.Time);
+    BOOST_CHECK_EQUAL(sc_restart.Dtinc_cur, sc.Dtinc_cur);
+    BOOST_CHECK(same(sc_restart.residual, sc.residual));
+    BOOST_CHECK_EQUAL(sc_restart.o_ncount, 3);
+
+    //No file, no restart
+    BOOST_CHECK(!sc_restart.load("Tcheckpoint_none.bin", rve_restart));
+}
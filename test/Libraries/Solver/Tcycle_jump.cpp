@@ -0,0 +1,108 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file Tcycle_jump.cpp
+///@brief Test for the extrapolation of the slow variables over several cycles
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "cycle_jump"
+#include <boost/test/unit_test.hpp>
+
+#include <armadillo>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Phase/phase_characteristics.hpp>
+#include <smartplus/Libraries/Phase/state_variables_M.hpp>
+#include <smartplus/Libraries/Solver/cycle_jump.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace smart;
+
+//State at the end of the cycle k : statev(0) = 1 + a*k + b*k^2, statev(1) constant, Wm(0) = 2*k
+static void set_cycle(phase_characteristics &rve, const double &k, const double &a, const double &b)
+{
+    state_variables_M *sv = rve.sv_global<state_variables_M>();
+    sv->statev(0) = 1. + a*k + b*k*k;
+    sv->statev(1) = 0.5;
+    sv->Wm(0) = 2.*k;
+}
+
+BOOST_AUTO_TEST_CASE( slow_variables )
+{
+    phase_characteristics rve;
+    rve.construct(0,1);
+    rve.sptr_sv_global->update(zeros(6), zeros(6), zeros(6), zeros(6), eye(3,3), eye(3,3), 0., 0., 2, zeros(2), zeros(2));
+    set_cycle(rve, 3., 0.1, 0.);
+
+    vec y;
+    Col<int> flags;
+    pack_slow_variables(rve, y, flags);
+    //statev and Wm of the global state variables, Wm of the local ones
+    BOOST_CHECK_EQUAL(y.n_elem, 10);
+    BOOST_CHECK_EQUAL(accu(flags), 2);
+
+    y(0) = 7.;
+    unpack_slow_variables(rve, y);
+    BOOST_CHECK_EQUAL(rve.sptr_sv_global->statev(0), 7.);
+}
+
+BOOST_AUTO_TEST_CASE( steady_evolution )
+{
+    phase_characteristics rve;
+    rve.construct(0,1);
+    rve.sptr_sv_global->update(zeros(6), zeros(6), zeros(6), zeros(6), eye(3,3), eye(3,3), 0., 0., 2, zeros(2), zeros(2));
+
+    cycle_jump cj(3, 5.E-2, 5, 10000);
+    for (int k=0; k<3; k++) {
+        set_cycle(rve, k, 1.E-3, 0.);
+        cj.record(rve, double(k));
+        BOOST_CHECK_EQUAL(cj.size(1000), 0);
+    }
+    set_cycle(rve, 3., 1.E-3, 0.);
+    cj.record(rve, 3.);
+
+    //The change of statev(0) over the jump is bounded by 5% : 0.05*1.003/1.E-3 cycles
+    int njump = cj.size(1000);
+    BOOST_CHECK_EQUAL(njump, 50);
+    BOOST_CHECK_EQUAL(cj.size(20), 20);
+
+    double DTime = cj.jump(rve, njump);
+    state_variables_M *sv = rve.sv_global<state_variables_M>();
+    BOOST_CHECK_CLOSE(DTime, 50., 1.E-9);
+    BOOST_CHECK_CLOSE(sv->statev(0), 1.053, 1.E-9);
+    BOOST_CHECK_CLOSE(sv->statev(1), 0.5, 1.E-9);
+    BOOST_CHECK_CLOSE(sv->Wm(0), 106., 1.E-9);
+    BOOST_CHECK_CLOSE(sv->statev_start(0), 1.053, 1.E-9);
+    BOOST_CHECK_EQUAL(cj.nrecords, 0);
+    BOOST_CHECK_EQUAL(cj.ncycles_jumped, 50);
+}
+
+BOOST_AUTO_TEST_CASE( transient_evolution )
+{
+    phase_characteristics rve;
+    rve.construct(0,1);
+    rve.sptr_sv_global->update(zeros(6), zeros(6), zeros(6), zeros(6), eye(3,3), eye(3,3), 0., 0., 2, zeros(2), zeros(2));
+
+    //The rate of statev(0) still changes a lot from one cycle to the next : no jump
+    cycle_jump cj(3, 5.E-2, 5, 10000);
+    for (int k=0; k<4; k++) {
+        set_cycle(rve, k, 1.E-3, 1.E-3);
+        cj.record(rve, double(k));
+    }
+    BOOST_CHECK_EQUAL(cj.size(1000), 0);
+}
@@ -0,0 +1,89 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file Tcycle_stabilization.cpp
+///@brief Test for the detection of a periodic response over the cycles of a block
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "cycle_stabilization"
+#include <boost/test/unit_test.hpp>
+
+#include <armadillo>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Phase/phase_characteristics.hpp>
+#include <smartplus/Libraries/Phase/state_variables_M.hpp>
+#include <smartplus/Libraries/Solver/cycle_stabilization.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace smart;
+
+//Integrates a cycle of 10 increments : sigma(0) = amplitude*sin, statev(0) accumulates the absolute strain increments and Wm(0) the work
+static bool run_cycle(phase_characteristics &rve, cycle_stabilization &cs, double &Time, const double &amplitude)
+{
+    cs.begin(rve, Time);
+    for (int k=1; k<=10; k++) {
+        double e_prev = 1.E-3*sin(2.*pi*(k-1)/10.);
+        double e = 1.E-3*sin(2.*pi*k/10.);
+        rve.sptr_sv_global->Etot(0) = e;
+        rve.sptr_sv_global->sigma(0) = amplitude*sin(2.*pi*k/10.);
+        rve.sptr_sv_global->statev(0) += fabs(e - e_prev);
+        rve.sv_global<state_variables_M>()->Wm(0) += 0.5*rve.sptr_sv_global->sigma(0)*(e - e_prev);
+        Time += 0.1;
+        cs.sample(rve);
+    }
+    return cs.end(Time);
+}
+
+BOOST_AUTO_TEST_CASE( periodic_response )
+{
+    phase_characteristics rve;
+    rve.construct(0,1);
+    rve.sptr_sv_global->update(zeros(6), zeros(6), zeros(6), zeros(6), eye(3,3), eye(3,3), 0., 0., 1, zeros(1), zeros(1));
+
+    cycle_stabilization cs(1.E-3, 2);
+    double Time = 0.;
+
+    //Hardening over the first cycles, then a stabilized loop. The accumulated statev does not prevent the detection
+    BOOST_CHECK(!run_cycle(rve, cs, Time, 100.));
+    BOOST_CHECK(!run_cycle(rve, cs, Time, 150.));
+    BOOST_CHECK(cs.errors(0) > 1.E-3);
+    BOOST_CHECK(!run_cycle(rve, cs, Time, 200.));
+    BOOST_CHECK(!run_cycle(rve, cs, Time, 200.));
+    BOOST_CHECK_EQUAL(cs.nperiodic, 1);
+    double Wm_cycle = rve.sv_global<state_variables_M>()->Wm(0);
+    BOOST_CHECK(run_cycle(rve, cs, Time, 200.));
+    BOOST_CHECK_SMALL(cs.errors.max(), 1.E-12);
+    BOOST_CHECK_CLOSE(cs.period, 1., 1.E-9);
+    BOOST_CHECK_EQUAL(cs.ncompared, 4);
+
+    //The skipped cycles accumulate the statev and the work as the last one
+    double p = rve.sptr_sv_global->statev(0);
+    double dp = p - cs.statev_cycle(0);
+    double Wm = rve.sv_global<state_variables_M>()->Wm(0);
+    BOOST_CHECK(dp > 1.E-4);
+    cs.skip(rve, 3);
+    BOOST_CHECK_CLOSE(rve.sptr_sv_global->statev(0), p + 3.*dp, 1.E-9);
+    BOOST_CHECK_CLOSE(rve.sptr_sv_global->statev_start(0), p + 3.*dp, 1.E-9);
+    BOOST_CHECK_SMALL(rve.sv_global<state_variables_M>()->Wm(0) - (Wm + 3.*(Wm - Wm_cycle)), 1.E-9);
+
+    //After a reset, the next cycle cannot be compared
+    cs.reset();
+    BOOST_CHECK(!run_cycle(rve, cs, Time, 200.));
+    BOOST_CHECK_EQUAL(cs.nperiodic, 0);
+}
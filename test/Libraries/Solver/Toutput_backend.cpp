@@ -0,0 +1,165 @@
+/* This file is part of SMART+.
+ 
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+///@file Toutput_backend.cpp
+///@brief Test for the binary output backend
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "output_backend"
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <armadillo>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Phase/phase_characteristics.hpp>
+#include <smartplus/Libraries/Phase/read.hpp>
+#include <smartplus/Libraries/Solver/output.hpp>
+#include <smartplus/Libraries/Solver/output_backend.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace smart;
+
+BOOST_AUTO_TEST_CASE( write_read_binary )
+{
+    string umat_name;
+    string path_data = "data";
+    vec props = {2,0};
+    
+    phase_characteristics rve;
+    rve.sptr_matprops->update(0, umat_name, 1, 0., 0., 0., props.n_elem, props);
+    rve.construct(0,1);
+    rve.sptr_sv_global->update(zeros(6), zeros(6), zeros(6), zeros(6), zeros(3,3), zeros(3,3), 293.15, 0., 0, zeros(0), zeros(0));
+    read_phase(rve, path_data, "Nphases0.dat");
+    
+    solver_output so(1);
+    so.o_nb_meca = 6;
+    so.o_meca = {0,1,2,3,4,5};
+    so.o_nb_T = 1;
+    so.o_nw_statev = -1;
+    so.o_wanted_statev = {-1};
+    
+    int nrecords = 5;
+    {
+        //Chunks of 2 records: the last chunk is incomplete
+        output_binary ob(2);
+        ob.open(rve, so, path_data, "results_global.txt", "global");
+        
+        //increment info + 3 phases x (T,Q,r + 6 Etot + 6 sigma + 4 Wm) + 1 statev per sub-phase
+        BOOST_CHECK_EQUAL(ob.nfields, 5 + 3*19 + 2);
+        
+        for (int inc=0; inc<nrecords; inc++) {
+            rve.sptr_sv_global->sigma(0) = 10.*inc;
+            rve.sub_phases[1].sptr_sv_global->Etot(2) = 0.01*inc;
+            rve.sub_phases[1].sptr_sv_global->statev(0) = -1.*inc;
+            ob.write(rve, so, 0, 0, 0, inc, 0.1*inc);
+        }
+    }
+    
+    std::vector<std::string> names;
+    Col<int> phases;
+    mat data;
+    read_output_binary(names, phases, data, path_data, "results_global.bin");
+    
+    BOOST_CHECK_EQUAL(int(data.n_rows), nrecords);
+    BOOST_CHECK_EQUAL(int(data.n_cols), 5 + 3*19 + 2);
+    BOOST_CHECK_EQUAL(names[0], "block");
+    BOOST_CHECK_EQUAL(phases(0), -1);
+    BOOST_CHECK_EQUAL(phases.max(), 2);
+    
+    uvec sigma_0 = find(phases == 0);
+    uvec Etot_1 = find(phases == 2);
+    for (int inc=0; inc<nrecords; inc++) {
+        BOOST_CHECK_EQUAL(data(inc,3), inc+1);
+        BOOST_CHECK_CLOSE(data(inc,4), 0.1*inc, 1.E-9);
+        BOOST_CHECK_EQUAL(names[sigma_0(9)], "sigma_0");
+        BOOST_CHECK_CLOSE(data(inc,sigma_0(9)), 10.*inc, 1.E-9);
+        BOOST_CHECK_EQUAL(names[Etot_1(5)], "Etot_2");
+        BOOST_CHECK_CLOSE(data(inc,Etot_1(5)), 0.01*inc, 1.E-9);
+        BOOST_CHECK_EQUAL(names[Etot_1.max()], "statev_0");
+        BOOST_CHECK_CLOSE(data(inc,Etot_1.max()), -1.*inc, 1.E-9);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( async_text )
+{
+    string umat_name;
+    string path_data = "data";
+    vec props = {2,0};
+    
+    phase_characteristics rve;
+    rve.sptr_matprops->update(0, umat_name, 1, 0., 0., 0., props.n_elem, props);
+    rve.construct(0,1);
+    rve.sptr_sv_global->update(zeros(6), zeros(6), zeros(6), zeros(6), zeros(3,3), zeros(3,3), 293.15, 0., 0, zeros(0), zeros(0));
+    read_phase(rve, path_data, "Nphases0.dat");
+    rve.sub_phases[0].sptr_matprops->number = 1;
+    rve.sub_phases[1].sptr_matprops->number = 2;
+    
+    solver_output so(1);
+    so.o_nb_meca = 6;
+    so.o_meca = {0,1,2,3,4,5};
+    so.o_nb_T = 1;
+    so.o_nw_statev = -1;
+    so.o_wanted_statev = {-1};
+    
+    //Synchronous text output, written by phase_characteristics::output
+    {
+        output_text ot;
+        ot.open(rve, so, path_data, "sync_global.txt", "global");
+        for (int inc=0; inc<50; inc++) {
+            rve.sptr_sv_global->sigma(0) = 10.*inc;
+            rve.sub_phases[0].sptr_sv_global->Etot(1) = 0.001*inc;
+            rve.sub_phases[1].sptr_sv_global->statev(0) = -1.*inc;
+            ot.write(rve, so, 0, 1, 2, inc, 0.02*inc);
+        }
+        ot.close();
+    }
+    
+    //Same results through a ring buffer of 2 snapshots, so that the solver has to wait for the writer thread
+    {
+        output_async oa(std::make_shared<output_text>(), 2);
+        oa.open(rve, so, path_data, "async_global.txt", "global");
+        for (int inc=0; inc<50; inc++) {
+            rve.sptr_sv_global->sigma(0) = 10.*inc;
+            rve.sub_phases[0].sptr_sv_global->Etot(1) = 0.001*inc;
+            rve.sub_phases[1].sptr_sv_global->statev(0) = -1.*inc;
+            oa.write(rve, so, 0, 1, 2, inc, 0.02*inc);
+        }
+    }   //oa is flushed when destroyed
+    rve.sptr_out_global = nullptr;
+    for (auto &r : rve.sub_phases) {
+        r.sptr_out_global = nullptr;
+    }
+    
+    std::vector<std::string> files = {"-0.txt", "-0-1.txt", "-0-2.txt"};
+    for (auto f : files) {
+        std::ifstream ifs_sync(path_data + "/sync_global" + f);
+        std::ifstream ifs_async(path_data + "/async_global" + f);
+        BOOST_CHECK(ifs_sync.good());
+        
+        std::istreambuf_iterator<char> b_sync(ifs_sync), e_sync;
+        std::istreambuf_iterator<char> b_async(ifs_async), e_async;
+        std::string s_sync(b_sync, e_sync);
+        std::string s_async(b_async, e_async);
+        
+        BOOST_CHECK(s_sync.size() > 0);
+        BOOST_CHECK_EQUAL(s_sync, s_async);
+    }
+}
@@ -0,0 +1,269 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file Tsensitivity.cpp
+///@brief Test for the forward sensitivities of the response of a RVE with respect to its props
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "sensitivity"
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+#include <armadillo>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Phase/phase_characteristics.hpp>
+#include <smartplus/Libraries/Phase/state_variables_M.hpp>
+#include <smartplus/Libraries/Solver/step_meca.hpp>
+#include <smartplus/Libraries/Solver/sensitivity.hpp>
+#include <smartplus/Umat/umat_smart.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace smart;
+
+//A RVE of a single material, initialized as the solver does at the beginning of a block (with the sensitivities, if any)
+static void build_rve(phase_characteristics &rve, solver_sensitivity *sensi, const string &umat_name, const vec &props, const int &nstatev)
+{
+    rve.construct(0,1);
+    rve.sptr_matprops->update(0, umat_name, 1, 0., 0., 0., props.n_elem, props);
+    rve.sptr_sv_global->update(zeros(6), zeros(6), zeros(6), zeros(6), eye(3,3), eye(3,3), 293.15, 0., nstatev, zeros(nstatev), zeros(nstatev));
+    rve.sptr_sv_local->update(zeros(6), zeros(6), zeros(6), zeros(6), eye(3,3), eye(3,3), 293.15, 0., nstatev, zeros(nstatev), zeros(nstatev));
+
+    double tnew_dt = 1.;
+    select_umat_M(rve, eye(3,3), 0., 0., 3, 3, true, 0, tnew_dt);
+    if (sensi != NULL)
+        sensi->begin(rve, eye(3,3), 0., 3, 3, 0);
+    rve.set_start();
+}
+
+//An isotropic elastic RVE (E, nu, alpha)
+static void build_rve(phase_characteristics &rve, solver_sensitivity &sensi)
+{
+    vec props = {70000., 0.3, 0.};
+    build_rve(rve, &sensi, "ELISO", props, 1);
+}
+
+//Converged increment : the strain increment DEtot satisfies the control cBC_meca, whose prescribed values do not depend on the props
+static void increment(phase_characteristics &rve, solver_sensitivity &sensi, const vec &DEtot, const Col<int> &cBC_meca, double &Time)
+{
+    double DTime = 1.;
+    double tnew_dt = 1.;
+    rve.sptr_sv_global->DEtot = DEtot;
+    rve.to_start();
+    select_umat_M(rve, eye(3,3), Time, DTime, 3, 3, false, 0, tnew_dt);
+    sensi.increment(rve, cBC_meca, zeros(6, sensi.size()), eye(3,3), Time, DTime, 3, 3, 0);
+    rve.set_start();
+    Time += DTime;
+}
+
+//Uniaxial loading up to the strain E11_load, unloading down to the stress S11_unload, then down to the strain E11_unload : the increments of the
+//second and the third steps depend on the state at their start, hence on the props
+static vector<step_meca> loading_path(const double &E11_load, const double &S11_unload, const double &E11_unload)
+{
+    Col<int> cBC_strain = {0, 1, 1, 1, 1, 1};
+    Col<int> cBC_stress = ones<Col<int> >(6);
+    vec BC_meca = zeros(6);
+    vector<step_meca> steps;
+
+    BC_meca(0) = E11_load;
+    steps.push_back(step_meca(1, 0.05, 0.05, 0.05, 1, cBC_strain, BC_meca, zeros(0,6), 293.15, 0, zeros(0)));
+    BC_meca(0) = S11_unload;
+    steps.push_back(step_meca(2, 0.05, 0.05, 0.05, 1, cBC_stress, BC_meca, zeros(0,6), 293.15, 0, zeros(0)));
+    BC_meca(0) = E11_unload;
+    steps.push_back(step_meca(3, 0.05, 0.05, 0.05, 1, cBC_strain, BC_meca, zeros(0,6), 293.15, 0, zeros(0)));
+    for (unsigned int i=0; i<steps.size(); i++)
+        steps[i].BC_Time = 1.;
+    return steps;
+}
+
+//Runs the steps as the solver does : the increments are generated at the start of each step, the stress components are solved with the tangent.
+//Returns the strain and the stress at the end of each step, with their derivatives if sensi is given
+static void simulate(const string &umat_name, const vec &props, const int &nstatev, vector<step_meca> steps, solver_sensitivity *sensi, mat &Etots, mat &sigmas, cube &dEtots, cube &dsigmas)
+{
+    phase_characteristics rve;
+    build_rve(rve, sensi, umat_name, props, nstatev);
+    state_variables_M *sv = rve.sv_global<state_variables_M>();
+
+    int nsteps = steps.size();
+    Etots = zeros(6, nsteps);
+    sigmas = zeros(6, nsteps);
+    if (sensi != NULL) {
+        dEtots = zeros(6, sensi->size(), nsteps);
+        dsigmas = zeros(6, sensi->size(), nsteps);
+    }
+
+    double Time = 0.;
+    double tnew_dt = 1.;
+    for (int s=0; s<nsteps; s++) {
+        step_meca &sm = steps[s];
+        sm.generate(Time, sv->Etot, sv->sigma, sv->T);
+        if (sensi != NULL)
+            sensi->generate(sm);
+
+        for (int inc=0; inc<sm.ninc; inc++) {
+            double DTime = sm.times(inc);
+            vec sigma_start = sv->sigma;
+            vec DEtot = zeros(6);
+            for (int k=0; k<6; k++) {
+                if (!sm.cBC_meca(k))
+                    DEtot(k) = sm.mecas(inc,k);
+            }
+
+            vec residual = zeros(6);
+            for (int iter=0; iter<100; iter++) {
+                sv->DEtot = DEtot;
+                rve.to_start();
+                select_umat_M(rve, eye(3,3), Time, DTime, 3, 3, false, 0, tnew_dt);
+                mat K = eye(6,6);
+                for (int k=0; k<6; k++) {
+                    if (sm.cBC_meca(k)) {
+                        residual(k) = sv->sigma(k) - sigma_start(k) - sm.mecas(inc,k);
+                        K.row(k) = sv->Lt.row(k);
+                    }
+                }
+                if (norm(residual, "inf") < 1.E-10)
+                    break;
+                DEtot -= solve(K, residual);
+            }
+            BOOST_REQUIRE(norm(residual, "inf") < 1.E-10);
+
+            if (sensi != NULL)
+                sensi->increment(rve, sm.cBC_meca, sensi->prescribed(inc, 1.), eye(3,3), Time, DTime, 3, 3, 0);
+            rve.set_start();
+            Time += DTime;
+        }
+
+        Etots.col(s) = sv->Etot;
+        sigmas.col(s) = sv->sigma;
+        if (sensi != NULL) {
+            dEtots.slice(s) = sensi->dEtot;
+            dsigmas.slice(s) = sensi->dsigma;
+        }
+    }
+}
+
+//Compares the derivatives at the end of each step with the centered finite differences of whole simulations. The derivatives are scaled by the
+//value of the parameter, so that the tolerances on the strains and on the stresses hold for every parameter
+static void check_path(const string &umat_name, const vec &props, const int &nstatev, const Col<int> &props_index, const vector<step_meca> &steps, const double &rel)
+{
+    solver_sensitivity sensi(props_index);
+    mat Etots;
+    mat sigmas;
+    cube dEtots;
+    cube dsigmas;
+    simulate(umat_name, props, nstatev, steps, &sensi, Etots, sigmas, dEtots, dsigmas);
+    BOOST_REQUIRE(sensi.active);
+
+    for (int p=0; p<sensi.size(); p++) {
+        double value = props(props_index(p));
+        double h = 1.E-5*value;
+        mat Etots_p;
+        mat sigmas_p;
+        mat Etots_m;
+        mat sigmas_m;
+        cube dummy;
+        vec props_p = props;
+        props_p(props_index(p)) += h;
+        simulate(umat_name, props_p, nstatev, steps, NULL, Etots_p, sigmas_p, dummy, dummy);
+        vec props_m = props;
+        props_m(props_index(p)) -= h;
+        simulate(umat_name, props_m, nstatev, steps, NULL, Etots_m, sigmas_m, dummy, dummy);
+
+        for (unsigned int s=0; s<steps.size(); s++) {
+            vec dEtot_fd = value*(Etots_p.col(s) - Etots_m.col(s))/(2.*h);
+            vec dsigma_fd = value*(sigmas_p.col(s) - sigmas_m.col(s))/(2.*h);
+            vec dEtot = value*dEtots.slice(s).col(p);
+            vec dsigma = value*dsigmas.slice(s).col(p);
+            BOOST_CHECK_SMALL(norm(dEtot - dEtot_fd, "inf"), rel*norm(dEtot_fd, "inf") + 1.E-9);
+            BOOST_CHECK_SMALL(norm(dsigma - dsigma_fd, "inf"), rel*norm(dsigma_fd, "inf") + 1.E-3);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( strain_control )
+{
+    Col<int> props_index = {0};
+    solver_sensitivity sensi(props_index);
+    phase_characteristics rve;
+    build_rve(rve, sensi);
+    BOOST_REQUIRE(sensi.active);
+
+    double Time = 0.;
+    vec DEtot = zeros(6);
+    DEtot(0) = 1.E-3;
+    Col<int> cBC_meca = zeros<Col<int> >(6);
+    increment(rve, sensi, DEtot, cBC_meca, Time);
+    increment(rve, sensi, DEtot, cBC_meca, Time);
+
+    //sigma = L(E,nu) Etot : dsigma/dE = sigma/E, the prescribed strain does not depend on E
+    vec sigma = rve.sptr_sv_global->sigma;
+    for (int k=0; k<3; k++)
+        BOOST_CHECK_CLOSE(sensi.dsigma(k,0), sigma(k)/70000., 1.E-3);
+    BOOST_CHECK_SMALL(norm(sensi.dEtot.col(0), 2), 1.E-12);
+}
+
+BOOST_AUTO_TEST_CASE( mixed_control )
+{
+    Col<int> props_index = {0, 1};
+    solver_sensitivity sensi(props_index);
+    phase_characteristics rve;
+    build_rve(rve, sensi);
+
+    //sigma_11 is prescribed, the other strain components are zero
+    double E = 70000.;
+    double nu = 0.3;
+    double L11 = E*(1.-nu)/((1.+nu)*(1.-2.*nu));
+    double Time = 0.;
+    vec DEtot = zeros(6);
+    DEtot(0) = 50./L11;
+    Col<int> cBC_meca = zeros<Col<int> >(6);
+    cBC_meca(0) = 1;
+    increment(rve, sensi, DEtot, cBC_meca, Time);
+    increment(rve, sensi, DEtot, cBC_meca, Time);
+    BOOST_REQUIRE_CLOSE(rve.sptr_sv_global->sigma(0), 100., 1.E-8);
+
+    //Etot_11 = sigma_11/L11 : dEtot_11/dE = -Etot_11/E, and the prescribed stress does not depend on the props
+    double Etot = rve.sptr_sv_global->Etot(0);
+    BOOST_CHECK_CLOSE(sensi.dEtot(0,0), -Etot/E, 1.E-3);
+    BOOST_CHECK_SMALL(sensi.dsigma(0,0), 1.E-6);
+    double dL11dnu = E*(2.*nu*(2.-nu))/pow((1.+nu)*(1.-2.*nu), 2.);
+    BOOST_CHECK_CLOSE(sensi.dEtot(0,1), -Etot*dL11dnu/L11, 1.E-2);
+    BOOST_CHECK_SMALL(sensi.dsigma(0,1), 1.E-6);
+}
+
+BOOST_AUTO_TEST_CASE( control_switches_elastic )
+{
+    //The strain of the third step is prescribed, although its start value depends on E and nu through the stress of the second step
+    vec props = {70000., 0.3, 0.};
+    Col<int> props_index = {0, 1};
+    check_path("ELISO", props, 1, props_index, loading_path(0.004, 100., 0.001), 1.E-4);
+}
+
+BOOST_AUTO_TEST_CASE( control_switches_plastic )
+{
+    //Linear isotropic hardening (E, nu, alpha, sigmaY, k, m) : yields in the first step, then unloads elastically under the two controls
+    vec props = {70000., 0.3, 0., 300., 5000., 1.};
+    Col<int> props_index = {0, 3, 4};
+    check_path("EPICP", props, 8, props_index, loading_path(0.01, 100., 0.006), 1.E-2);
+}
+
+BOOST_AUTO_TEST_CASE( outputfile )
+{
+    BOOST_CHECK_EQUAL(solver_sensitivity::outputfile("results_job.txt", 0), "results_job_dp1.txt");
+}
@@ -0,0 +1,147 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file Tsimulation_tree.cpp
+///@brief Test for the snapshots of the solver shared by the loading paths with a common prefix
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "simulation_tree"
+#include <boost/test/unit_test.hpp>
+
+#include <armadillo>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Phase/phase_characteristics.hpp>
+#include <smartplus/Libraries/Homogenization/ellipsoid_multi.hpp>
+#include <smartplus/Libraries/Solver/block.hpp>
+#include <smartplus/Libraries/Solver/step_meca.hpp>
+#include <smartplus/Libraries/Solver/simulation_tree.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace smart;
+
+//A loading path of two mechanical blocks : a uniaxial strain, then a uniaxial stress of the given amplitude
+static std::vector<block> two_blocks(const double &amplitude)
+{
+    Col<int> cBC_strain = zeros<Col<int> >(6);
+    Col<int> cBC_stress = ones<Col<int> >(6);
+    vec BC_1 = zeros(6);
+    BC_1(0) = 0.01;
+    vec BC_2 = zeros(6);
+    BC_2(0) = amplitude;
+
+    std::vector<shared_ptr<step> > steps_1 = {std::make_shared<step_meca>(1, 0.01, 1.E-6, 0.01, 1, cBC_strain, BC_1, zeros(1,6), 293.15, 0, zeros(1))};
+    std::vector<shared_ptr<step> > steps_2 = {std::make_shared<step_meca>(1, 0.01, 1.E-6, 0.01, 1, cBC_stress, BC_2, zeros(1,6), 293.15, 0, zeros(1))};
+    std::vector<block> blocks = {block(1, 1, 1, 1, steps_1), block(2, 1, 100, 1, steps_2)};
+    return blocks;
+}
+
+BOOST_AUTO_TEST_CASE( prefix_invalidation )
+{
+    solver_output so(2);
+    cycle_control cc(2);
+    vec controls = {0., 0.5, 2., 10., 100., 1., 1.E-6, 10000.};
+    vec props = {70000., 0.3, 1.E-5, 300., 500.};
+    vec props_fatigue = props;
+    props_fatigue(4) = 800.;
+
+    //Without information on the props, any change invalidates every prefix
+    Col<int> props_block;
+    std::vector<std::string> keys = prefix_keys("ELISO", props, 1, 0., 0., 0., controls, 293.15, two_blocks(100.), so, cc, props_block);
+    std::vector<std::string> keys_fatigue = prefix_keys("ELISO", props_fatigue, 1, 0., 0., 0., controls, 293.15, two_blocks(100.), so, cc, props_block);
+    BOOST_CHECK_EQUAL(keys.size(), 3);
+    BOOST_CHECK(keys[1] != keys_fatigue[1]);
+
+    //The last prop only affects the second block : the first block is shared
+    props_block = {1, 1, 1, 1, 2};
+    keys = prefix_keys("ELISO", props, 1, 0., 0., 0., controls, 293.15, two_blocks(100.), so, cc, props_block);
+    keys_fatigue = prefix_keys("ELISO", props_fatigue, 1, 0., 0., 0., controls, 293.15, two_blocks(100.), so, cc, props_block);
+    BOOST_CHECK(keys[1] == keys_fatigue[1]);
+    BOOST_CHECK(keys[2] != keys_fatigue[2]);
+
+    //A prop that affects the first block, or a change of its loading, invalidates it
+    vec props_elastic = props;
+    props_elastic(0) = 71000.;
+    std::vector<std::string> keys_elastic = prefix_keys("ELISO", props_elastic, 1, 0., 0., 0., controls, 293.15, two_blocks(100.), so, cc, props_block);
+    BOOST_CHECK(keys[1] != keys_elastic[1]);
+
+    std::vector<std::string> keys_path = prefix_keys("ELISO", props, 1, 0., 0., 0., controls, 293.15, two_blocks(200.), so, cc, props_block);
+    BOOST_CHECK(keys[1] == keys_path[1]);
+    BOOST_CHECK(keys[2] != keys_path[2]);
+
+    keys_path = prefix_keys("ELISO", props, 1, 0., 0., 0., controls, 300., two_blocks(100.), so, cc, props_block);
+    BOOST_CHECK(keys[1] != keys_path[1]);
+}
+
+BOOST_AUTO_TEST_CASE( snapshots )
+{
+    phase_characteristics rve;
+    rve.construct(0,1);
+    vec props = {70000., 0.3, 1.E-5};
+    rve.sptr_matprops->update(0, "ELISO", 1, 0., 0., 0., props.n_elem, props);
+    rve.sptr_sv_global->update(zeros(6), zeros(6), zeros(6), zeros(6), eye(3,3), eye(3,3), 293.15, 0., 1, zeros(1), zeros(1));
+    rve.sptr_sv_local->update(zeros(6), zeros(6), zeros(6), zeros(6), eye(3,3), eye(3,3), 293.15, 0., 1, zeros(1), zeros(1));
+
+    simulation_tree tree(2);
+    std::vector<vec> records = {ones(5)};
+
+    //The snapshot is a deep copy of the RVE
+    rve.sptr_sv_global->statev(0) = 1.;
+    tree.insert(solver_snapshot("a", 1, rve, 1., 1., 0, 0., records, records));
+    rve.sptr_sv_global->statev(0) = 2.;
+    tree.insert(solver_snapshot("b", 1, rve, 2., 1., 0, 0., records, records));
+
+    const solver_snapshot *ss = tree.find("a");
+    BOOST_REQUIRE(ss != NULL);
+    BOOST_CHECK_CLOSE(ss->rve.sptr_sv_global->statev(0), 1., 1.E-9);
+    BOOST_CHECK_CLOSE(ss->Time, 1., 1.E-9);
+    BOOST_CHECK_EQUAL(ss->records_global.size(), 1);
+
+    //"a" has been used last, so "b" is discarded when a third snapshot is kept
+    rve.sptr_sv_global->statev(0) = 3.;
+    tree.insert(solver_snapshot("c", 1, rve, 3., 1., 0, 0., records, records));
+    BOOST_CHECK_EQUAL(tree.snapshots.size(), 2);
+    BOOST_CHECK(tree.find("b") == NULL);
+    BOOST_CHECK(tree.find("a") != NULL);
+    BOOST_CHECK_CLOSE(tree.find("c")->rve.sptr_sv_global->statev(0), 3., 1.E-9);
+
+    //The integration points of the Eshelby tensors are the ones of the snapshot when the simulation resumes
+    ellipsoid_multi::mp = 2;
+    ellipsoid_multi::np = 3;
+    ellipsoid_multi::x = {0.1, 0.2};
+    ellipsoid_multi::wx = {0.5, 0.5};
+    ellipsoid_multi::y = {0.1, 0.2, 0.3};
+    ellipsoid_multi::wy = {0.3, 0.3, 0.4};
+    solver_snapshot ss_points("d", 1, rve, 4., 1., 0, 0., records, records);
+    ellipsoid_multi::mp = 1;
+    ellipsoid_multi::np = 1;
+    ellipsoid_multi::x = {0.7};
+    ellipsoid_multi::y = {0.7};
+    solver_snapshot(ss_points).restore_points();
+    BOOST_CHECK_EQUAL(ellipsoid_multi::mp, 2);
+    BOOST_CHECK_EQUAL(ellipsoid_multi::np, 3);
+    BOOST_CHECK_EQUAL(ellipsoid_multi::x.n_elem, 2);
+    BOOST_CHECK_CLOSE(ellipsoid_multi::y(2), 0.3, 1.E-9);
+    BOOST_CHECK_CLOSE(ellipsoid_multi::wy(2), 0.4, 1.E-9);
+
+    //A disabled tree keeps nothing
+    simulation_tree disabled;
+    BOOST_CHECK(!disabled.active());
+    disabled.insert(solver_snapshot("a", 1, rve, 1., 1., 0, 0., records, records));
+    BOOST_CHECK(disabled.find("a") == NULL);
+}
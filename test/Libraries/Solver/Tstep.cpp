@@ -0,0 +1,224 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file Tstep.cpp
+///@brief Test for the increments of the steps, compiled once and generated at each cycle
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "step"
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <string>
+#include <armadillo>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Libraries/Solver/step.hpp>
+#include <smartplus/Libraries/Solver/step_meca.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace smart;
+
+//Increments of a mechanical step as they were computed at each cycle before the compilation of the steps, from the controls cBC_meca and cBC_T
+//given in the input file (the static components of an incremental path file are only turned into stress-controlled ones afterwards)
+static void reference_generate(const step_meca &sm, const Col<int> &cBC_meca, const int &cBC_T, const double &mTime, const vec &mEtot, const vec &msigma, const double &mT, vec &times, vec &Ts, mat &mecas)
+{
+    int ninc = 0;
+    string buffer;
+    ifstream pathinc;
+    if (sm.mode == 3) {
+        pathinc.open(sm.file, ios::in);
+        while (!pathinc.eof()) {
+            getline(pathinc, buffer);
+            if (buffer != "")
+                ninc++;
+        }
+        pathinc.close();
+    }
+    else
+        ninc = std::round(1./sm.Dn_inc);
+
+    times = zeros(ninc);
+    Ts = zeros(ninc);
+    mecas = zeros(ninc, 6);
+
+    vec inc_coef = ones(ninc);
+    if (sm.mode == 2) {
+        double sum_ = 0.;
+        for (int k=0; k<ninc; k++) {
+            inc_coef(k) = cos(pi + (k+1)*2.*pi/(ninc+1))+1.;
+            sum_ += inc_coef(k);
+        }
+        inc_coef = inc_coef*ninc/sum_;
+    }
+
+    if (sm.mode < 3) {
+        for (int i=0; i<ninc; i++) {
+            Ts(i) = (sm.BC_T - mT)/ninc;
+            times(i) = sm.BC_Time/ninc;
+            for (int k=0; k<6; k++) {
+                if (cBC_meca(k) == 1)
+                    mecas(i,k) = inc_coef(i)*(sm.BC_meca(k)-msigma(k))/ninc;
+                else if (cBC_meca(k) == 0)
+                    mecas(i,k) = inc_coef(i)*(sm.BC_meca(k)-mEtot(k))/ninc;
+            }
+        }
+        return;
+    }
+
+    int size_BC = 8;
+    for (int k=0; k<6; k++) {
+        if (cBC_meca(k) == 2)
+            size_BC--;
+    }
+    if (cBC_T == 2)
+        size_BC--;
+
+    vec BC_file_n = zeros(size_BC);
+    vec BC_file = zeros(size_BC);
+    BC_file_n(0) = mTime;
+    int kT = 0;
+    if (cBC_T == 0) {
+        BC_file_n(kT+1) = mT;
+        kT++;
+    }
+    for (int k=0; k<6; k++) {
+        if (cBC_meca(k) == 0) {
+            BC_file_n(kT+1) = mEtot(k);
+            kT++;
+        }
+        if (cBC_meca(k) == 1) {
+            BC_file_n(kT+1) = msigma(k);
+            kT++;
+        }
+    }
+
+    pathinc.open(sm.file, ios::in);
+    for (int i=0; i<ninc; i++) {
+        pathinc >> buffer;
+        for (int j=0; j<size_BC; j++)
+            pathinc >> BC_file(j);
+
+        times(i) = BC_file(0) - BC_file_n(0);
+        kT = 0;
+        if (cBC_T == 0) {
+            Ts(i) = BC_file(kT+1) - BC_file_n(kT+1);
+            kT++;
+        }
+        for (int k=0; k<6; k++) {
+            if (cBC_meca(k) < 2) {
+                mecas(i,k) = BC_file(kT+1) - BC_file_n(kT+1);
+                kT++;
+            }
+        }
+        BC_file_n = BC_file;
+    }
+    pathinc.close();
+}
+
+//Generates the step at two cycles, from two different states, and compares with the reference
+static void check_cycles(step_meca &sm, const Col<int> &cBC_meca, const int &cBC_T)
+{
+    vec times_ref;
+    vec Ts_ref;
+    mat mecas_ref;
+    for (int cycle=0; cycle<2; cycle++) {
+        double mTime = 2.*cycle;
+        vec mEtot = (cycle+1)*linspace(0.001, 0.006, 6);
+        vec msigma = (cycle+1)*linspace(10., 60., 6);
+        double mT = 293.15 + 10.*cycle;
+
+        sm.generate(mTime, mEtot, msigma, mT);
+        reference_generate(sm, cBC_meca, cBC_T, mTime, mEtot, msigma, mT, times_ref, Ts_ref, mecas_ref);
+
+        BOOST_REQUIRE_EQUAL(sm.ninc, int(times_ref.n_elem));
+        BOOST_CHECK_SMALL(norm(sm.times - times_ref, "inf"), 1.E-12);
+        BOOST_CHECK_SMALL(norm(sm.Ts - Ts_ref, "inf"), 1.E-12);
+        BOOST_CHECK_SMALL(norm(sm.mecas - mecas_ref, "inf"), 1.E-12);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( linear_and_sinusoidal )
+{
+    Col<int> cBC_meca = {0, 1, 0, 1, 1, 1};
+    vec BC_meca = {0.01, 100., -0.005, 0., 0., 0.};
+    for (int mode=1; mode<3; mode++) {
+        step_meca sm(1, 0.1, 0.01, 0.25, mode, cBC_meca, BC_meca, zeros(0,6), 393.15, 0, zeros(0));
+        sm.BC_Time = 1.;
+        check_cycles(sm, cBC_meca, 0);
+        BOOST_CHECK_EQUAL(sm.ninc, 4);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( incremental_path_file )
+{
+    //Time, T, E11 and S22, the other components are static
+    string file = "Tstep_path.txt";
+    ofstream path(file, ios::out);
+    path << "1\t0.5\t300.\t0.001\t10.\n";
+    path << "2\t1.0\t310.\t0.003\t15.\n";
+    path << "3\t1.5\t305.\t0.002\t30.\n";
+    path.close();
+
+    Col<int> cBC_meca = {0, 1, 2, 2, 2, 2};
+    step_meca sm(1, 0.1, 0.01, 1., 3, cBC_meca, zeros(6), zeros(0,6), 0., 0, zeros(0));
+    sm.file = file;
+    //The columns of the file are the ones of the input controls at every cycle, although the static components are then stress-controlled
+    check_cycles(sm, cBC_meca, 0);
+    Col<int> cBC_static = {0, 1, 1, 1, 1, 1};
+    BOOST_CHECK(all(sm.cBC_meca == cBC_static));
+    BOOST_CHECK_EQUAL(sm.ninc, 3);
+}
+
+BOOST_AUTO_TEST_CASE( path_table_cache )
+{
+    string file = "Tstep_table.txt";
+    ofstream path(file, ios::out);
+    path << "1\t0.5\t0.001\n";
+    path << "2\t1.0\t0.002\n";
+    path.close();
+    std::shared_ptr<const mat> table = read_path_table(file, 2);
+    BOOST_CHECK_EQUAL(table->n_rows, 2);
+    BOOST_CHECK(read_path_table(file, 2) == table);
+
+    //Rewritten within the same second : the content of the file tells the change
+    path.open(file, ios::out);
+    path << "1\t0.5\t0.001\n";
+    path << "2\t1.0\t0.002\n";
+    path << "3\t1.5\t0.004\n";
+    path.close();
+    std::shared_ptr<const mat> table_new = read_path_table(file, 2);
+    BOOST_CHECK_EQUAL(table_new->n_rows, 3);
+    BOOST_CHECK_CLOSE((*table_new)(2,1), 0.004, 1.E-9);
+
+    //Same size, as the keyed files written by an identification for each individual
+    path.open(file, ios::out);
+    path << "1\t0.5\t0.001\n";
+    path << "2\t1.0\t0.002\n";
+    path << "3\t1.5\t0.005\n";
+    path.close();
+    table_new = read_path_table(file, 2);
+    BOOST_CHECK_CLOSE((*table_new)(2,1), 0.005, 1.E-9);
+
+    //The table held by a step stays valid once it is replaced or dropped from the cache
+    BOOST_CHECK_EQUAL(table->n_rows, 2);
+    for (int i=0; i<max_path_tables; i++)
+        read_path_table(file, i+3);
+    BOOST_CHECK_EQUAL(table_new->n_rows, 3);
+    BOOST_CHECK(read_path_table(file, 2) != table_new);
+}
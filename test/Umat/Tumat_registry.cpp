@@ -0,0 +1,235 @@
+/* This file is part of SMART+.
+
+ SMART+ is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ SMART+ is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with SMART+.  If not, see <http://www.gnu.org/licenses/>.
+
+ */
+
+///@file Tumat_registry.cpp
+///@brief Test for the registry of the constitutive models
+///@version 1.0
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "umat_registry"
+#include <boost/test/unit_test.hpp>
+
+#include <armadillo>
+#include <smartplus/parameter.hpp>
+#include <smartplus/Umat/umat_registry.hpp>
+#include <smartplus/Umat/umat_smart.hpp>
+#include <smartplus/Libraries/Phase/phase_characteristics.hpp>
+#include <smartplus/Libraries/Phase/state_variables_M.hpp>
+#include <smartplus/Libraries/Phase/material_constants.hpp>
+#include <smartplus/Libraries/Continuum_Mechanics/constitutive.hpp>
+#include <smartplus/Umat/Mechanical/Plasticity/plastic_isotropic_ccp.hpp>
+
+using namespace std;
+using namespace arma;
+using namespace smart;
+
+//A user model : sigma = 2*Etot
+void umat_user_test(phase_characteristics &rve, const mat &DR, const double &Time, const double &DTime, const int &ndi, const int &nshr, const bool &start, const int &solver_type, double &tnew_dt)
+{
+    UNUSED(DR);
+    UNUSED(Time);
+    UNUSED(DTime);
+    UNUSED(ndi);
+    UNUSED(nshr);
+    UNUSED(start);
+    UNUSED(solver_type);
+    UNUSED(tnew_dt);
+    auto sv = rve.sv_local<state_variables_M>();
+    sv->sigma = 2.*(sv->Etot + sv->DEtot);
+    sv->Lt = 2.*eye(6,6);
+}
+
+//A user model that records the tolerances it is given
+int maxiter_seen = 0;
+void umat_user_tolerances(phase_characteristics &rve, const mat &DR, const double &Time, const double &DTime, const int &ndi, const int &nshr, const bool &start, const int &solver_type, double &tnew_dt)
+{
+    UNUSED(rve);
+    UNUSED(DR);
+    UNUSED(Time);
+    UNUSED(DTime);
+    UNUSED(ndi);
+    UNUSED(nshr);
+    UNUSED(start);
+    UNUSED(solver_type);
+    UNUSED(tnew_dt);
+    maxiter_seen = tolerances::current().umat_maxiter;
+}
+
+//A user model that cannot integrate strain increments larger than 0.004 : sigma += 2*DEtot, statev(0) counts the increments
+void umat_user_cutback(phase_characteristics &rve, const mat &DR, const double &Time, const double &DTime, const int &ndi, const int &nshr, const bool &start, const int &solver_type, double &tnew_dt)
+{
+    UNUSED(DR);
+    UNUSED(Time);
+    UNUSED(DTime);
+    UNUSED(ndi);
+    UNUSED(nshr);
+    UNUSED(start);
+    UNUSED(solver_type);
+    auto sv = rve.sv_local<state_variables_M>();
+    if (norm(sv->DEtot, 2) > 0.004) {
+        tnew_dt = 0.5;
+        return;
+    }
+    sv->sigma += 2.*sv->DEtot;
+    sv->statev(0) += 1.;
+    sv->Lt = 2.*eye(6,6);
+}
+
+BOOST_AUTO_TEST_CASE( builtin )
+{
+    const umat_entry *eliso = find_umat("ELISO");
+    BOOST_REQUIRE(eliso != NULL);
+    BOOST_CHECK_EQUAL(eliso->id, 1);
+    BOOST_CHECK(eliso->umat_M != NULL);
+    BOOST_CHECK(eliso->umat_T != NULL);
+
+    const umat_entry *mimtn = find_umat("MIMTN");
+    BOOST_REQUIRE(mimtn != NULL);
+    BOOST_CHECK_EQUAL(mimtn->id, 101);
+    BOOST_CHECK(mimtn->umat_T == NULL);
+
+    BOOST_CHECK(find_umat("XXXXX") == NULL);
+
+    //The name is resolved when the material is defined
+    vec props = {70000., 0.3, 0.};
+    material_characteristics matprops(0, "ELISO", 1, 0., 0., 0., props.n_elem, props);
+    BOOST_CHECK_EQUAL(matprops.umat_id, 1);
+    BOOST_CHECK(matprops.umat_M == eliso->umat_M);
+
+    material_characteristics matprops2 = matprops;
+    BOOST_CHECK(matprops2.umat_T == eliso->umat_T);
+
+    matprops.update(0, "XXXXX", 1, 0., 0., 0., props.n_elem, props);
+    BOOST_CHECK_EQUAL(matprops.umat_id, -1);
+    BOOST_CHECK(matprops.umat_M == NULL);
+}
+
+BOOST_AUTO_TEST_CASE( user_umat )
+{
+    int id = register_umat("USERT", 0, umat_user_test, NULL);
+    BOOST_CHECK(id >= 1000);
+
+    vec props = {1.};
+    int nstatev = 0;
+    phase_characteristics rve;
+    rve.sptr_matprops->update(0, "USERT", 1, 0., 0., 0., props.n_elem, props);
+    BOOST_CHECK_EQUAL(rve.sptr_matprops->umat_id, id);
+
+    rve.construct(0,1);
+    vec Etot = {0.01, 0., 0., 0., 0., 0.};
+    rve.sptr_sv_global->update(Etot, zeros(6), zeros(6), zeros(6), eye(3,3), eye(3,3), 273.15, 0., nstatev, zeros(nstatev), zeros(nstatev));
+
+    double tnew_dt = 1.;
+    select_umat_M(rve, eye(3,3), 0., 1., 3, 3, true, 0, tnew_dt);
+
+    BOOST_CHECK_CLOSE(rve.sptr_sv_global->sigma(0), 0.02, 1.E-9);
+    BOOST_CHECK_CLOSE(rve.sv_global<state_variables_M>()->Lt(1,1), 2., 1.E-9);
+}
+
+BOOST_AUTO_TEST_CASE( material_tolerances )
+{
+    register_umat("USTOL", 0, umat_user_tolerances, NULL);
+
+    vec props = {1.};
+    int nstatev = 0;
+    phase_characteristics rve;
+    rve.sptr_matprops->update(0, "USTOL", 1, 0., 0., 0., props.n_elem, props);
+    rve.construct(0,1);
+    rve.sptr_sv_global->update(zeros(6), zeros(6), zeros(6), zeros(6), eye(3,3), eye(3,3), 273.15, 0., nstatev, zeros(nstatev), zeros(nstatev));
+    BOOST_CHECK_EQUAL(rve.sptr_matprops->tol.umat_maxiter, tolerances::defaults().umat_maxiter);
+
+    //Loose tolerances for this material only
+    rve.sptr_matprops->tol.umat_maxiter = 7;
+    double tnew_dt = 1.;
+    select_umat_M(rve, eye(3,3), 0., 1., 3, 3, true, 0, tnew_dt);
+    BOOST_CHECK_EQUAL(maxiter_seen, 7);
+
+    //Outside of a model, the global defaults apply
+    BOOST_CHECK_EQUAL(tolerances::current().umat_maxiter, tolerances::defaults().umat_maxiter);
+}
+
+BOOST_AUTO_TEST_CASE( substeps )
+{
+    register_umat("USSUB", 0, umat_user_cutback, NULL);
+
+    vec props = {1.};
+    int nstatev = 1;
+    vec DEtot = {0.01, 0., 0., 0., 0., 0.};
+    phase_characteristics rve;
+    rve.sptr_matprops->update(0, "USSUB", 1, 0., 0., 0., props.n_elem, props);
+    rve.construct(0,1);
+    rve.sptr_sv_global->update(zeros(6), DEtot, zeros(6), zeros(6), eye(3,3), eye(3,3), 273.15, 0., nstatev, zeros(nstatev), zeros(nstatev));
+
+    //Without sub-stepping, the cutback is returned to the solver
+    double tnew_dt = 1.;
+    select_umat_M(rve, eye(3,3), 0., 1., 3, 3, true, 0, tnew_dt);
+    BOOST_CHECK(tnew_dt < 1.);
+
+    //Not enough sub-increments allowed : the state is left untouched
+    rve.sptr_matprops->tol.umat_substeps = 2;
+    tnew_dt = 1.;
+    select_umat_M(rve, eye(3,3), 0., 1., 3, 3, true, 0, tnew_dt);
+    BOOST_CHECK(tnew_dt < 1.);
+    BOOST_CHECK_SMALL(rve.sptr_sv_global->sigma(0), 1.E-12);
+    BOOST_CHECK_SMALL(rve.sptr_sv_global->statev(0), 1.E-12);
+
+    //The increment is split into 4 sub-increments of 0.0025 and consolidated
+    rve.sptr_matprops->tol.umat_substeps = 8;
+    tnew_dt = 1.;
+    select_umat_M(rve, eye(3,3), 0., 1., 3, 3, true, 0, tnew_dt);
+    BOOST_CHECK_CLOSE(tnew_dt, 1., 1.E-9);
+    BOOST_CHECK_CLOSE(rve.sptr_sv_global->sigma(0), 0.02, 1.E-9);
+    BOOST_CHECK_CLOSE(rve.sptr_sv_global->statev(0), 4., 1.E-9);
+    BOOST_CHECK_CLOSE(rve.sptr_sv_global->DEtot(0), 0.01, 1.E-9);
+    BOOST_CHECK_SMALL(rve.sptr_sv_global->Etot(0), 1.E-12);
+}
+
+BOOST_AUTO_TEST_CASE( constants )
+{
+    vec props = {70000., 0.3, 1.E-5, 300., 1000., 0.3};
+    int nstatev = 8;
+    vec DEtot = {0.01, -0.005, -0.005, 0., 0., 0.};
+    phase_characteristics rve;
+    rve.sptr_matprops->update(0, "EPICP", 1, 0., 0., 0., props.n_elem, props);
+    rve.construct(0,1);
+    rve.sptr_sv_global->update(zeros(6), DEtot, zeros(6), zeros(6), eye(3,3), eye(3,3), 273.15, 0., nstatev, zeros(nstatev), zeros(nstatev));
+    BOOST_CHECK(rve.sptr_matprops->sptr_constants_M == NULL);
+
+    //The constants are built at the first call and kept for the next ones
+    double tnew_dt = 1.;
+    select_umat_M(rve, eye(3,3), 0., 1., 3, 3, true, 0, tnew_dt);
+    BOOST_REQUIRE(rve.sptr_matprops->sptr_constants_M != NULL);
+    const isotropic_constants *cst = dynamic_cast<const isotropic_constants*>(rve.sptr_matprops->sptr_constants_M.get());
+    BOOST_REQUIRE(cst != NULL);
+    BOOST_CHECK_SMALL(norm(cst->L - L_iso(70000., 0.3, "Enu"), "fro"), 1.E-9);
+    BOOST_CHECK(material_constants::current() == NULL);
+
+    //Same result as the model called directly, that computes its constants
+    vec sigma = zeros(6);
+    mat Lt = zeros(6,6);
+    mat L = zeros(6,6);
+    vec sigma_in = zeros(6);
+    vec statev = zeros(nstatev);
+    double Wm = 0., Wm_r = 0., Wm_ir = 0., Wm_d = 0.;
+    umat_plasticity_iso_CCP(zeros(6), DEtot, sigma, Lt, L, sigma_in, eye(3,3), props.n_elem, props, nstatev, statev, 273.15, 0., 0., 1., Wm, Wm_r, Wm_ir, Wm_d, 3, 3, true, 0, tnew_dt);
+    BOOST_CHECK_SMALL(norm(rve.sptr_sv_global->sigma - sigma, 2), 1.E-6);
+    BOOST_CHECK_SMALL(norm(rve.sptr_sv_global->statev - statev, 2), 1.E-9);
+
+    //A new set of props discards them
+    rve.sptr_matprops->update(0, "EPICP", 1, 0., 0., 0., props.n_elem, props);
+    BOOST_CHECK(rve.sptr_matprops->sptr_constants_M == NULL);
+}